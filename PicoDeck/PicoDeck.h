@@ -13,7 +13,6 @@
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_NeoPixel.h>
 // include TinyUSB or HID depending on USB stack option
 #if defined(USE_TINYUSB)
 #include <Adafruit_TinyUSB.h>
@@ -23,39 +22,247 @@
 
 #include "PicoDeckDefines.h"
 #include "PicoDeckDisplay.h"
+#include "PicoDeckPanels.h"
+#include "PicoDeckTrace.h"
+#include "PicoDeckLog.h"
+#include "PicoDeckStats.h"
+#include "PicoDeckConsole.h"
+#include "PicoDeckBoot.h"
+#include "PicoDeckPixels.h"
+#include "PicoDeckGovernor.h"
 
 #define POLL_RATE 1
 #define SAVE_INTERVAL 1000
 
-/// @brief      Set NeoPixel(s) color
-/// @param      int (x3)
-///             R, G, and B color values
+/// @brief      Fade NeoPixels to a page's colour, or off if it has none
+void PixelPageUpdate(const int &page);
+
+/// @brief      NeoPixel a button's press flashes, spreading the buttons evenly along the strip
+int PixelOfButton(const int &button);
+
+/// @brief      Switches keymaps & page count over to DeckCommon::Profile if it's loaded,
+///             else back to the compiled-in ones
+void ProfileUse();
+
+/// @brief      Starts switching to another profile slot; Core1 gets it ready, then ProfileSwap() puts it in use
+void ProfileSwitch(const int &slot);
+
+/// @brief      Slot after the one in use that has a profile stored, else slot 0; never one still being written
+int ProfileNextSlot();
+
+/// @brief      Buttons making up the profile chord: the page keys, if there are two or more
+/// @details    Only buttons that are page keys on their first page and don't report on any other,
+///             so holding the chord never sends the host anything.
+uint32_t ProfileChordKeys();
+
+/// @brief      Puts the profile Core1 got ready in use, and times the switch
+void ProfileSwap();
+
+/// @brief      Puts the profile Core1 checked over at boot in use, keeping the saved page
+void ProfileBoot();
+
+/// @brief      LightgunButtons::Keymap for a loaded profile
+uint16_t ProfileKeyCode(const int &button, const int &page);
+
+/// @brief      Serializes the compiled-in configuration as a profile blob
 /// @param      int
-///             Pixel number to set/start fill from
-/// @param      bool
-///             Set true to fill pixel array from pixel
-void PixelUpdate(const int &r, const int &g, const int &b, const int &pixel, const bool &fill = false);
+///             Pages to make; past the compiled-in ones, they're numbered copies of them over again
+/// @param      sink
+///             Takes the blob in order, a part at a time
+/// @return     Size of the blob
+uint32_t ProfileBuild(const int &pagesCount, void (*sink)(const uint8_t *data, const size_t &len));
+
+/// @brief      Slot a console command should store a profile in, from its optional slot argument
+/// @return     The slot, or -1 (having said why) if it can't be written to right now
+int ProfileStoreSlot(Stream &out, const int &argc, char **argv, const int &arg);
+
+/// @brief      Reports how storing a profile went, and switches to it if it's valid
+void ProfileStored(Stream &out, const int &slot, const bool &loaded);
+
+/// @brief      Push a command to Core1, counting it if the FIFO was full
+/// @param      uint32_t
+///             FifoCmds_e command, plus its data
+void FifoPush(const uint32_t &data);
 
 enum FifoCmds_e {
     DISP_BTN_PRESS = 0,
     DISP_PAGE_UPDATE = 1 << 24,
     DECK_SAVING = 2 << 24,
+    DISP_RENDER_AUDIT = 3 << 24,
+    DISP_DUMP = 4 << 24,
+    DISP_BENCH = 5 << 24,   // low byte is DeckDisplay::Bench_e, next two are the runs count
+    DISP_PAGES_RELOAD = 6 << 24,    // page data changed, low two bytes are the page to put back up
+    DISP_PROFILE_PREPARE = 7 << 24, // low byte is the profile slot
+    DISP_PROFILE_SWAP = 8 << 24,    // low two bytes are the page to put up
+    DISP_TIER = 9 << 24,            // low byte is the DeckGovernor::Tier_e to switch to
+    DECK_KEY_TOGGLE = 10 << 24,     // Core1 to Core0: low byte is the page, the next two the key cells whose icons flipped
+    DISP_REPLAY = 11 << 24,         // low byte is 1 when an input replay starts, 0 once it's over
+    DISP_FLASH_PARK = 12 << 24,     // low byte is 1 to park Core1 for a flash write (next byte tags the request), 0 to let it go
+    DECK_FLASH_PARKED = 13 << 24,   // Core1 to Core0: parked, low byte is the request's tag
     DISP_BTN_RELEASE = 1 << 30,
 };
 
+/// @brief      Handles what Core1 pushes back to Core0
+/// @param      uint32_t
+///             FifoCmds_e command, plus its data
+void Core0FifoHandle(const uint32_t &data);
+
+/// @brief      Saves prefs, then lets Core1 show the result (whoever asked for the save has it show it's saving)
+/// @return     Save result
+DeckPrefs::Errors_e PrefsSave();
+
+/// @brief      Whether flash can be written without holding anything up on this core
+/// @details    No keys held or settling, and no HID report waiting to go out; Core1 still has to be parked for it.
+bool FlashWindowOpen();
+
+/// @brief      Asks Core1 to finish what it's pushing to the display & panels, and park until let go
+/// @details    Doesn't wait, Core0FifoHandle() takes the answer and flashPark goes to Park_Held.
+void FlashParkAsk();
+
+/// @brief      Parks Core1 (asking if it hasn't been yet) and waits for it to say so; deckFlashPark, for every flash write
+void FlashParkWait();
+
+/// @brief      Lets Core1 carry on after a flash write, or a park that's no longer wanted
+void FlashRelease();
+
+/// @brief      Follows the USB bus state, replaying the key that woke the host once the bus resumes
+void UsbUpdate();
+
+/// @brief      How long Core0 can sleep for
+/// @return     ms until its next deadline, 0 if anything's in flight (keys settling, a report, save or profile waiting, a trace or log)
+unsigned long Core0IdleWait();
+
+/// @brief      Sleeps the calling core until a deadline, unless something wakes it first, and counts it
+/// @param      unsigned long
+///             ms to sleep for at most
+void CoreSleep(const unsigned long &ms);
+
+/// @brief      Button pin edge interrupt, wakes Core0 up and has the governor go back to full rate
+void PinEdge();
+
+/// @brief      Passes a governor tier change on to Core1 & the LEDs
+void GovernorApply();
+
+/// @brief      Asks a suspended host to wake up for a press
+/// @param      uint32_t
+///             Buttons just pressed; the first one is remembered as the key that woke the host
+void UsbWake(const uint32_t &pressed);
+
+/// @brief      Console command handlers, see DeckConsole::Commands
+void ConsoleFrameBuffer(Stream &out, const int &argc, char **argv);
+void ConsoleAudit(Stream &out, const int &argc, char **argv);
+void ConsoleIcons(Stream &out, const int &argc, char **argv);
+void ConsoleRates(Stream &out, const int &argc, char **argv);
+void ConsoleSave(Stream &out, const int &argc, char **argv);
+void ConsoleBench(Stream &out, const int &argc, char **argv);
+void ConsoleSet(Stream &out, const int &argc, char **argv);
+void ConsoleTrace(Stream &out, const int &argc, char **argv);
+void ConsoleLog(Stream &out, const int &argc, char **argv);
+void ConsoleProfile(Stream &out, const int &argc, char **argv);
+void ConsoleBoot(Stream &out, const int &argc, char **argv);
+
 //// System/Devices
 // TinyUSB devices interface object that's initialized in MainCoreSetup
 TinyUSBDevices_ TUSBDeviceSetup;
 
 DeckDisplay OLED;
 
-// Local (constant) neopixel object (defined in PicoDeckDefines.h, defaults to GPIO 28/RP2040 A2)
-Adafruit_NeoPixel neopixel = Adafruit_NeoPixel(6, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
+// Secondary key panels, mirroring key cells (or rows of them) on their own small displays
+DeckPanels keyPanels;
+
+// Secondary key panels descriptor
+// Panels can go on either I2C controller; ones on the bus the main display ISN'T on use PANEL_SDA/PANEL_SCL.
+// Spreading them across both means both get pushed at once, and same-address panels can sit behind a TCA9548A mux.
+// format is: {display type, bus (0 = Wire, 1 = Wire1), I2C address, mux channel (-1 for none), width, height, layout, key cell/row}
+inline std::vector<DeckPanels::Desc_t> DeckPanels::PanelDesc = {
+    // e.g. 0.49" 64x32 panels for the first row of keys, behind a mux on I2C0:
+    //{Adafruit_MultiDisplay::I2C_SSD1306, 0, 0x3C, 0, 64, 32, DeckPanels::Layout_KeyCell, 0},
+    //{Adafruit_MultiDisplay::I2C_SSD1306, 0, 0x3C, 1, 64, 32, DeckPanels::Layout_KeyCell, 1},
+    // or a 128x32 strip for the second row of keys, next to the main display on I2C1:
+    //{Adafruit_MultiDisplay::I2C_SSD1306, 1, 0x3D, -1, 128, 32, DeckPanels::Layout_KeyRow, 1},
+};
+
+// Button trace recorder/replayer, for reproducing input issues & loading the input->display pipeline
+DeckTrace inputTrace(buttons, ButtonCount);
+
+// Command console on the CDC port
+DeckConsole console;
+
+// What Core1 prints for the console, passed on to the port by Core0
+DeckConsoleRelay consoleRelay;
+
+// Console commands, format is: {name, help text, handler}
+inline std::vector<DeckConsole::Command_t> DeckConsole::Commands = {
+    {"fb",      "Print the display's render buffer as a PBM image",            ConsoleFrameBuffer},
+    {"audit",   "[img] Render audit of every display state",                   ConsoleAudit},
+    {"icons",   "List key icons & their sizes",                                ConsoleIcons},
+    {"rates",   "Loop passes, wakeups & active time per core, display bytes/s, since last asked", ConsoleRates},
+    {"save",    "Save prefs now, and time it",                                 ConsoleSave},
+    {"bench",   "poll|blit|display|pages [runs] Time a pipeline step",         ConsoleBench},
+    {"set",     "debounce|report|poll [value] Show or change a timing",        ConsoleSet},
+    {"trace",   "rec|gen <presses/s> <ms>|play|stop|dump Button traces",       ConsoleTrace},
+    {"log",     "Switch the port to the binary event log until it's closed",   ConsoleLog},
+    {"profile", "[use <slot>|build [slot]|gen <pages> [slot]|load <bytes> [slot]|clear <slot>] Show, switch or replace deck profiles", ConsoleProfile},
+    {"boot",    "When input, profile, USB, display & reports were first ready", ConsoleBoot},
+};
+
+// NeoPixel strip & its effects (pin defined in PicoDeckDefines.h, defaults to GPIO 28/RP2040 A2)
+DeckPixels pixels;
+
+// Pages in the compiled-in keymap (ButtonDesc), for when no profile's loaded
+int builtInPagesCount = 0;
+
+//// Profiles
+// Every profile slot; DeckCommon::Profile is whichever one's in use
+DeckProfile *profiles[PROFILE_SLOTS];
+
+// Slot being switched to (-1 if none), when it was asked for,
+// and Core0's longest loop pass since (i.e. the most an input was held up by the switch)
+int profileSwitching = -1;
+unsigned long profileSwitchStart = 0;
+unsigned long profileSwitchWorstPass = 0;
+
+// Slot Core1 has got ready to be swapped in, -1 if none
+volatile int profileStaged = -1;
+
+// Slot a console load is still being written to (-1 if none), which can't be switched to until it's done
+int profileStoring = -1;
+
+// Buttons held together to switch to the next profile (0 if the profile in use hasn't enough page keys),
+// and whether & since when they've all been held
+uint32_t profileChord = 0;
+bool profileChordHeld = false;
+unsigned long profileChordStart = 0;
 
 //// Saving
 // Flags true if there's data to save.
 bool canSave = false;
 
+// Flags true once a save is due, until both cores are quiet enough to write it out.
+bool savePending = false;
+
+// Flags true while the prefs journal's spare sector wants erasing, which gets a quiet moment of its own.
+bool erasePending = false;
+
+//// Flash writes
+enum FlashPark_e {
+    Park_None = 0,
+    Park_Asked,     // asked Core1 to park, no answer yet
+    Park_Held,      // Core1's parked, and stays so until FlashRelease()
+};
+
+// Where Core1 is with parking for a flash write; Core0 only
+FlashPark_e flashPark = Park_None;
+
+// Tag of the last park request, so an answer to one that's since been let go isn't taken for the current one
+uint8_t flashParkSeq = 0;
+
+// Core1: parked for a flash write, so nothing starts on the buses
+bool core1Parked = false;
+
+// Core1: tag of a park to tell Core0 about, once the FIFO has room (-1 if none)
+int core1ParkAck = -1;
+
 //// Timers/synchronization
 // Timestamp of last time save was checked.
 unsigned long lastSaveChecked = 0;
@@ -63,6 +270,49 @@ unsigned long lastSaveChecked = 0;
 // Timestamp of last USB packet update.
 unsigned long lastUSBpoll = 0;
 
+// ms between HID reports, POLL_RATE unless changed from the console
+unsigned long reportInterval = POLL_RATE;
+
+// ms Poll() waits between pin reads, 0 for every loop pass
+unsigned long pollMinTicks = 0;
+
+// Loop passes per core, for the console's rates
+volatile uint32_t loopCount[2] = {0, 0};
+
+// Sleeps per core and us spent asleep, for the console's rates
+volatile uint32_t sleepCount[2] = {0, 0};
+volatile uint32_t sleepUs[2] = {0, 0};
+
+// Time since the last key edge, and so how fast everything runs
+DeckGovernor governor;
+
+// Set by a pin edge interrupt, taken by the next loop pass
+volatile bool pinEdged = false;
+
+// Longest either core sleeps for at once, as a backstop for any deadline not accounted for
+#define SLEEP_MAX_MS 100
+
+// Timestamp of the oldest button edge not yet sent to the host, and whether there is one.
+unsigned long reportWaitStart = 0;
+bool reportWaiting = false;
+
+//// USB
+enum UsbState_e {
+    Usb_Unmounted = 0,
+    Usb_Mounted,
+    Usb_Suspended,
+};
+
+// Bus state as of the last loop pass; reports only go out while mounted
+UsbState_e usbState = Usb_Unmounted;
+
+// Button whose press asked the host to wake up (-1 if none), and when
+int wakeButton = -1;
+unsigned long wakeStart = 0;
+
+// Button whose press was replayed after resuming, released again once that report's out (-1 if none)
+int wakeReplay = -1;
+
 // Marker for received FIFO signal from opposite core
 uint32_t fifoData = 0;
 
@@ -84,6 +334,3 @@ enum ButtonMask_e {
     BtnMask_13 = 1 << 12,
     BtnMask_14 = 1 << 13
 };
-
-// button combo to enter pause mode
-static inline constexpr uint32_t EnterPauseModeBtnMask = BtnMask_4 | BtnMask_8;
\ No newline at end of file
@@ -30,35 +30,56 @@ void setup()
     TinyUSBDevice.setProductDescriptor(DEVICE_NAME);
     TinyUSBDevice.setID(DEVICE_VID, DEVICE_PID);
 
+    // Stats feature report, for monitoring without a serial console
+    TinyUSBDevices_::featureGet = DeckStats::FeatureGet;
+    TinyUSBDevices_::featureSet = DeckStats::FeatureSet;
+
     // Initializing the USB devices chunk.
+    // Enumeration carries on in the background; reports are held back until it's done (see loop())
     TUSBDeviceSetup.begin(POLL_RATE);
-    // wait until device mounted
-    while(!USBDevice.mounted()) yield();
 
-    DeckCommon::pagesCount = buttons.Begin();
-    #ifndef SERIAL_DEBUG
-    buttons.ReportEnable();
-    #endif // SERIAL_DEBUG
+    builtInPagesCount = buttons.Begin();
+    DeckCommon::pagesCount = buttons.pagesCount;
+
+    // edges wake Core0 up when it's asleep, Poll() still does all the reading
+    for(unsigned int b = 0; b < ButtonCount; ++b)
+        attachInterrupt(digitalPinToInterrupt(LightgunButtons::ButtonDesc[b].pin), PinEdge, CHANGE);
 
+    // prefs journal is read straight out of flash, so this is quick
     DeckCommon::Prefs = new DeckPrefs();
     buttons.page = DeckCommon::Prefs->curPage;
     buttons.pageWrap = DeckCommon::Prefs->pagesWrapAround;
 
-    // get Core1 (display) running
+    // a profile in flash takes over from the compiled-in configuration, once Core1 has checked it over
+    for(int slot = 0; slot < PROFILE_SLOTS; ++slot)
+        profiles[slot] = new DeckProfile(slot);
+    DeckCommon::Profile = profiles[DeckCommon::Prefs->profile];
+
+    // flash writes from here on wait for Core1 to get off the buses, and a journal left mid-compaction is tidied up
+    deckFlashPark = FlashParkWait;
+    erasePending = DeckCommon::Prefs->SpareDirty();
+
+    // get Core1 (profile, then display) going
     rp2040.fifo.push(0);
 
-    neopixel.begin();
+    DeckBoot::Mark(DeckBoot::Boot_InputReady);
+
+    pixels.Begin(NEOPIXEL_PIN);
     
-    if(DeckCommon::Prefs->curPage < DeckCommon::pagesCount)
-         PixelUpdate(DeckCommon::Prefs->pages.at(DeckCommon::Prefs->curPage).color, 0, true);
-    else PixelUpdate(0, 0, 0, 0, true);
+    PixelPageUpdate(DeckCommon::Prefs->curPage);
 }
 
 void setup1()
 {
-    // wait for signal from Core1, which should be after prefs have loaded
+    // wait for signal from Core0, which should be after prefs have loaded
     rp2040.fifo.pop();
 
+    // checksumming the profile is the slowest part of boot that input depends on, so it goes first;
+    // Core0 is polling meanwhile and puts it in use from loop()
+    DeckCommon::Profile->Begin(ButtonCount);
+    profileStaged = DeckCommon::Profile->Slot();
+    DeckWakeOther();
+
     // In case some I2C devices deadlock the program
     // (can happen due to bad pin mappings)
     Wire.setTimeout(100);
@@ -67,101 +88,923 @@ void setup1()
     // Unga bunga way of setting defaults
     // Maybe someday this can be made more dynamic, preferably in PicoDeckPrefs (ha)
     memset(OLED.keyPics, 0, sizeof(OLED.keyPics));
-    OLED.keyPics[0][0] = &DeckCommon::Prefs->bitmapsDB.at("em_angy");       OLED.keyPics[0][1] = &DeckCommon::Prefs->bitmapsDB.at("scene_brb");
-    OLED.keyPics[1][0] = &DeckCommon::Prefs->bitmapsDB.at("em_happy");      OLED.keyPics[1][1] = &DeckCommon::Prefs->bitmapsDB.at("scene_blank");
-    OLED.keyPics[2][0] = &DeckCommon::Prefs->bitmapsDB.at("em_smug");       OLED.keyPics[2][1] = &DeckCommon::Prefs->bitmapsDB.at("none");
-    OLED.keyPics[3][0] = &DeckCommon::Prefs->bitmapsDB.at("s_logo");        OLED.keyPics[3][1] = &DeckCommon::Prefs->bitmapsDB.at("washed");        OLED.keyPics[3][2] = &DeckCommon::Prefs->bitmapsDB.at("rec_start");
+    OLED.keyPics[0][0] = KEY_ICON("em_angy");       OLED.keyPics[0][1] = KEY_ICON("scene_brb");
+    OLED.keyPics[1][0] = KEY_ICON("em_happy");      OLED.keyPics[1][1] = KEY_ICON("scene_blank");
+    OLED.keyPics[2][0] = KEY_ICON("em_smug");       OLED.keyPics[2][1] = KEY_ICON("none");
+    OLED.keyPics[3][0] = KEY_ICON("s_logo");        OLED.keyPics[3][1] = KEY_ICON("washed");        OLED.keyPics[3][2] = KEY_ICON("rec_start");
 
-    OLED.keyPics[4][0] = &DeckCommon::Prefs->bitmapsDB.at("em_pout");       OLED.keyPics[4][1] = &DeckCommon::Prefs->bitmapsDB.at("scene_ar");
-    OLED.keyPics[5][0] = &DeckCommon::Prefs->bitmapsDB.at("em_norm");       OLED.keyPics[5][1] = &DeckCommon::Prefs->bitmapsDB.at("scene_gaming");
-    OLED.keyPics[6][0] = &DeckCommon::Prefs->bitmapsDB.at("em_stern");      OLED.keyPics[6][1] = &DeckCommon::Prefs->bitmapsDB.at("none");
-    OLED.keyPics[7][0] = &DeckCommon::Prefs->bitmapsDB.at("zoom");          OLED.keyPics[7][1] = &DeckCommon::Prefs->bitmapsDB.at("skit");          OLED.keyPics[7][2] = &DeckCommon::Prefs->bitmapsDB.at("mic_toggle");
+    OLED.keyPics[4][0] = KEY_ICON("em_pout");       OLED.keyPics[4][1] = KEY_ICON("scene_ar");
+    OLED.keyPics[5][0] = KEY_ICON("em_norm");       OLED.keyPics[5][1] = KEY_ICON("scene_gaming");
+    OLED.keyPics[6][0] = KEY_ICON("em_stern");      OLED.keyPics[6][1] = KEY_ICON("none");
+    OLED.keyPics[7][0] = KEY_ICON("zoom");          OLED.keyPics[7][1] = KEY_ICON("skit");          OLED.keyPics[7][2] = KEY_ICON("mic_toggle");
 
-    OLED.keyPics[8][0] = &DeckCommon::Prefs->bitmapsDB.at("em_think");      OLED.keyPics[8][1] = &DeckCommon::Prefs->bitmapsDB.at("volLow");
-    OLED.keyPics[9][0] = &DeckCommon::Prefs->bitmapsDB.at("em_sad");        OLED.keyPics[9][1] = &DeckCommon::Prefs->bitmapsDB.at("volMid");
-    OLED.keyPics[10][0] = &DeckCommon::Prefs->bitmapsDB.at("em_confuzz");   OLED.keyPics[10][1] = &DeckCommon::Prefs->bitmapsDB.at("volHi");
-    OLED.keyPics[11][0] = &DeckCommon::Prefs->bitmapsDB.at("pikohann");     OLED.keyPics[11][1] = &DeckCommon::Prefs->bitmapsDB.at("rallyx");       OLED.keyPics[11][2] = &DeckCommon::Prefs->bitmapsDB.at("rec_pause");
+    OLED.keyPics[8][0] = KEY_ICON("em_think");      OLED.keyPics[8][1] = KEY_ICON("volLow");
+    OLED.keyPics[9][0] = KEY_ICON("em_sad");        OLED.keyPics[9][1] = KEY_ICON("volMid");
+    OLED.keyPics[10][0] = KEY_ICON("em_confuzz");   OLED.keyPics[10][1] = KEY_ICON("volHi");
+    OLED.keyPics[11][0] = KEY_ICON("pikohann");     OLED.keyPics[11][1] = KEY_ICON("rallyx");       OLED.keyPics[11][2] = KEY_ICON("rec_pause");
 
+    #if defined(DISP_SPI) && defined(DISP_TFT)
+    if(OLED.Begin(DISP_SCK, DISP_MOSI, DISP_CS, DISP_DC, DISP_RST, Adafruit_MultiDisplay::SPI_ST7789, DISP_TFT_WIDTH, DISP_TFT_HEIGHT) == false) {
+    #elif defined(DISP_SPI)
+    if(OLED.Begin(DISP_SCK, DISP_MOSI, DISP_CS, DISP_DC, DISP_RST, Adafruit_MultiDisplay::SPI_SH1106) == false) {
+    #else
     if(OLED.Begin(DISP_SCL, DISP_SDA, Adafruit_MultiDisplay::I2C_SH1106) == false) {
+    #endif // DISP_SPI
         // Does this ever actually happen...?
         #ifdef SERIAL_DEBUG
         Serial.println("Display init error!");
         #endif // SERIAL_DEBUG
-    }
+    } else if(keyPanels.Begin(OLED.display->wire))
+        OLED.PanelsAttach(&keyPanels);
 }
 
 void loop() {
-    buttons.Poll(0);
+    const unsigned long passStart = micros();
+
+    // back to full rate before the pins are even read, so scanning slower while idle adds nothing to a press's latency
+    if(pinEdged) {
+        pinEdged = false;
+        if(governor.Activity(millis())) GovernorApply();
+    }
+
+    // Core1 hands saved-state changes back over the FIFO, so they're only ever written from here
+    uint32_t fromCore1;
+    while(rp2040.fifo.pop_nb(&fromCore1))
+        Core0FifoHandle(fromCore1);
+
+    inputTrace.PrePoll();
+    buttons.Poll(std::max<unsigned long>(pollMinTicks, governor.Current().pollTicks));
+    inputTrace.PostPoll();
+
+    // replayed edges never reach the host, or change anything that's saved; the reports they make go to the trace,
+    // a pass at a time, and it times them on its own clock
+    const bool replaying = inputTrace.mode == DeckTrace::Trace_Replay;
+    if(replaying && TinyUSBDevices.newReport) {
+        inputTrace.ReportCaptured((const uint8_t*)&Keyboard.keyReport(), sizeof(KeyReport));
+        TinyUSBDevices.newReport = false;
+    }
+
+    // traces don't come in through the pins, so their edges count as activity here
+    if((buttons.pressed | buttons.released) && governor.Activity(millis()))
+        GovernorApply();
+    else if(governor.Update(millis()))
+        GovernorApply();
+
+    if((buttons.pressed | buttons.released) && !replaying) {
+        const unsigned long now = micros();
+        for(uint32_t edges = buttons.pressed | buttons.released; edges; edges &= edges - 1)
+            DeckStats::Sample(DeckStats::Stage_Debounce, now - buttons.edgeTime[__builtin_ctz(edges)]);
+        if(!reportWaiting) {
+            reportWaitStart = now;
+            reportWaiting = true;
+        }
+    }
 
     if(buttons.pressed) {
-        rp2040.fifo.push(buttons.pressed | DISP_BTN_PRESS);
+        DeckLog::Event(DeckLog::Log_Press, buttons.pressed);
+        FifoPush(buttons.pressed | DISP_BTN_PRESS);
+        for(uint32_t pressed = buttons.pressed; pressed; pressed &= pressed - 1)
+            pixels.Flash(PixelOfButton(__builtin_ctz(pressed)), millis());
+        if(!replaying) {
+            UsbWake(buttons.pressed);
+            // the chord's page keys never go to the host, and it only counts once they've been held a moment
+            if(profileChord && buttons.debounced == profileChord && (buttons.pressed & profileChord)) {
+                profileChordHeld = true;
+                profileChordStart = millis();
+            }
+            // key icon toggles are saved too; if this press didn't flip any, the save is skipped
+            canSave = true;
+            lastSaveChecked = millis();
+        }
         #ifdef SERIAL_DEBUG
         for(int i = 0; i < (int)ButtonCount; ++i) if(buttons.pressed & 1 << i) {
-            if(LightgunButtons::ButtonDesc[i].keys.size() > buttons.page)
-                 Serial.printf("Pressed Button %d (Key: %d)\n", i+1, LightgunButtons::ButtonDesc[i].keys.at(buttons.page) & 0xFF);
+            if(LightgunButtons::KeyCode(i, buttons.page))
+                 Serial.printf("Pressed Button %d (Key: %d)\n", i+1, LightgunButtons::KeyCode(i, buttons.page) & 0xFF);
             else Serial.printf("Pressed Button %d (No keybind)\n", i+1);
             }
         #endif // SERIAL_DEBUG
     }
-    if(buttons.released)
-        rp2040.fifo.push(buttons.released | DISP_BTN_RELEASE);
+    if(buttons.released) {
+        DeckLog::Event(DeckLog::Log_Release, buttons.released);
+        FifoPush(buttons.released | DISP_BTN_RELEASE);
+    }
+
+    // anything let go or pressed alongside before then, and it was only ever the page keys' own flips
+    if(profileChordHeld && buttons.debounced != profileChord)
+        profileChordHeld = false;
+    else if(profileChordHeld && millis() - profileChordStart >= PROFILE_CHORD_HOLD_MS) {
+        profileChordHeld = false;
+        ProfileSwitch(ProfileNextSlot());
+    }
+
+    UsbUpdate();
+
+    // reports start once the host's there to take them and the keymap they go out with is settled
+    if(!DeckBoot::Reached(DeckBoot::Boot_UsbMounted) && DeckBoot::Reached(DeckBoot::Boot_ProfileReady) && usbState == Usb_Mounted) {
+        DeckBoot::Mark(DeckBoot::Boot_UsbMounted);
+        #ifndef SERIAL_DEBUG
+        buttons.ReportEnable();
+        #endif // SERIAL_DEBUG
+    }
 
-    if(millis() - lastUSBpoll >= POLL_RATE) {
+    if(millis() - lastUSBpoll >= reportInterval) {
         lastUSBpoll = millis();
-        buttons.SendReports();
+        // while suspended or unmounted this returns straight away, leaving the report pending for when the bus is back
+        if(buttons.SendReports()) {
+            DeckLog::Event(DeckLog::Log_Report);
+            DeckStats::Count(DeckStats::Count_Reports);
+            DeckBoot::Mark(DeckBoot::Boot_FirstReport);
+
+            if(wakeButton >= 0) {
+                DeckStats::Sample(DeckStats::Stage_WakeReport, micros() - wakeStart);
+                wakeButton = -1;
+            }
+            // the replayed press is out, so its release follows in the next report (unless it's been pressed again since)
+            if(wakeReplay >= 0) {
+                if(!(buttons.debounced & 1 << wakeReplay))
+                    buttons.ReportRelease(wakeReplay);
+                wakeReplay = -1;
+            }
+        }
+
+        // edges that don't change the report (unbound keys) still stop waiting here
+        if(reportWaiting && !TinyUSBDevices.newReport) {
+            DeckStats::Sample(DeckStats::Stage_Report, micros() - reportWaitStart);
+            reportWaiting = false;
+        // edges held back for the bus are Stage_WakeReport's to time, if anything's
+        } else if(reportWaiting && usbState != Usb_Mounted)
+            reportWaiting = false;
+    }
+
+    // swapped in only once nothing's held, so every key goes up with the same code it went down with
+    if(profileStaged >= 0 && !(buttons.debounced | buttons.debouncing)) {
+        if(profileSwitching >= 0) ProfileSwap();
+        else ProfileBoot();
     }
 
     if(buttons.page != DeckCommon::Prefs->curPage) {
         DeckCommon::Prefs->curPage = buttons.page;
-        rp2040.fifo.push(buttons.page | DISP_PAGE_UPDATE);
+        DeckLog::Event(DeckLog::Log_Page, buttons.page);
+        FifoPush(buttons.page | DISP_PAGE_UPDATE);
         
         #ifdef SERIAL_DEBUG
         Serial.printf("Switched to page %d\n", DeckCommon::Prefs->curPage+1);
         #endif // SERIAL_DEBUG
 
-        if(DeckCommon::Prefs->curPage < DeckCommon::pagesCount)
-             PixelUpdate(DeckCommon::Prefs->pages.at(DeckCommon::Prefs->curPage).color, 0, true);
-        else PixelUpdate(0, 0, 0, 0, true);
+        PixelPageUpdate(DeckCommon::Prefs->curPage);
         
         canSave = true;
         lastSaveChecked = millis();
     }
 
+    // LED effects go at their own fixed rate, and sending a frame never waits on the strip
+    pixels.Tick(millis());
+
     if(canSave && millis() - lastSaveChecked >= SAVE_INTERVAL) {
         canSave = false;
-        rp2040.fifo.push(DECK_SAVING);
-        DeckPrefs::Errors_e saveResult = DeckCommon::Prefs->Save();
-        rp2040.fifo.push(DECK_SAVING | (saveResult+1));
+        // state waits in RAM for a moment where writing it stalls nothing
+        if(DeckCommon::Prefs->Changed())
+             savePending = true;
+        else DeckStats::Count(DeckStats::Count_PrefsSkipped);
+    }
+
+    // flash writes wait for a moment that stalls nothing, then for Core1 to park; one erase or save per moment
+    const bool flashWanted = (savePending || erasePending) && FlashWindowOpen();
+    if(flashWanted && flashPark == Park_None) {
+        if(savePending) FifoPush(DECK_SAVING);
+        FlashParkAsk();
+    } else if(flashWanted && flashPark == Park_Held) {
+        if(savePending) {
+            savePending = false;
+            PrefsSave();
+        } else {
+            // if it fails, the next compaction erases it first anyway
+            DeckCommon::Prefs->SpareErase();
+            erasePending = false;
+        }
     }
+
+    // text parsing waits for a quiet moment, so it's never between a press and its report
+    if(!buttons.debouncing && !reportWaiting) {
+        console.Service(Serial, Serial.dtr());
+        // port closed partway through a profile upload: what got written can't be used
+        if(profileStoring >= 0 && !console.Receiving()) {
+            profiles[profileStoring]->StoreClear();
+            profileStoring = -1;
+        }
+    }
+
+    // Core1's console output, which only goes out as text
+    consoleRelay.Drain(Serial, Serial.dtr() && !console.binaryLog);
+
+    #ifndef SERIAL_DEBUG
+    // binary event log shares the CDC port with the console, and only runs once asked for by it
+    DeckLog::Drain(Serial, console.binaryLog);
+    #endif // SERIAL_DEBUG
+
+    if(inputTrace.replayDone) {
+        inputTrace.replayDone = false;
+        // Core1 draws the last edges and hashes the frame they left, then puts the saved page back up
+        FifoPush(DISP_REPLAY);
+    }
+    if(inputTrace.frameReady) {
+        inputTrace.frameReady = false;
+        inputTrace.ReplayCompare();
+        if(!console.binaryLog) inputTrace.Dump(Serial);
+    }
+
+    // the longest pass is how long an edge could've waited on this core during a switch
+    if(profileSwitching >= 0)
+        profileSwitchWorstPass = std::max(profileSwitchWorstPass, micros() - passStart);
+
+    // Core1's only held for as long as a write needs it, console ones included
+    if(flashPark != Park_None && !((savePending || erasePending) && FlashWindowOpen()))
+        FlashRelease();
+
+    ++loopCount[0];
+
+    // nothing in flight, so sleep until the next deadline; pin edges, USB and Core1 wake it sooner
+    const unsigned long idleWait = Core0IdleWait();
+    if(idleWait) CoreSleep(idleWait);
 }
 
 void loop1() {
-    if(rp2040.fifo.pop_nb(&fifoData)) switch(fifoData & 0xFF000000) {
-        case DISP_BTN_PRESS:
-        case DISP_BTN_RELEASE: if(OLED.display != nullptr) OLED.ButtonsUpdate(fifoData, fifoData & DISP_BTN_RELEASE); break;
-        case DISP_PAGE_UPDATE: if(OLED.display != nullptr) OLED.PageUpdate(fifoData & 0xFF); break;
-        case DECK_SAVING:
-            if(OLED.display != nullptr) OLED.SaveUpdate(fifoData & 0xFF);
+    if(rp2040.fifo.pop_nb(&fifoData)) {
+        DeckStats::FifoPopped(micros());
+        DeckLog::Event(DeckLog::Log_FifoCmd, fifoData >> 24);
+        // busy until IdleOps() finds nothing left to do
+        OLED.quiet = false;
+        switch(fifoData & 0xFF000000) {
+            case DISP_BTN_PRESS:
+            case DISP_BTN_RELEASE:
+                inputTrace.DisplayHandled(fifoData);
+                if(OLED.display != nullptr) OLED.ButtonsUpdate(fifoData, fifoData & DISP_BTN_RELEASE);
+                break;
+            case DISP_PAGE_UPDATE: if(OLED.display != nullptr) OLED.PageUpdate(fifoData & 0xFFFF); break;
+            case DISP_PAGES_RELOAD: if(OLED.display != nullptr) OLED.PagesReload(fifoData & 0xFFFF); break;
+            case DISP_PROFILE_PREPARE:
+            {
+                // checksumming a whole profile is the slow part of a switch, so it happens over here
+                DeckProfile *profile = profiles[fifoData & 0xFF];
+                profile->Begin(ButtonCount);
+                if(OLED.display != nullptr)
+                    OLED.ProfilePrepare(profile, profile->Loaded() ? profile->Pages() : builtInPagesCount, 0);
+                profileStaged = fifoData & 0xFF;
+                DeckWakeOther();
+                break;
+            }
+            case DISP_PROFILE_SWAP: if(OLED.display != nullptr) OLED.ProfileSwap(fifoData & 0xFFFF); break;
+            case DISP_TIER: if(OLED.display != nullptr) OLED.TierSet((DeckGovernor::Tier_e)(fifoData & 0xFF)); break;
+            case DISP_REPLAY:
+                if(fifoData & 1) {
+                    if(OLED.display != nullptr) OLED.ReplayBegin();
+                } else {
+                    inputTrace.FrameCaptured(OLED.display != nullptr ? OLED.ReplayEnd() : 0);
+                    DeckWakeOther();
+                }
+                break;
+            case DECK_SAVING:
+                if(OLED.display != nullptr) OLED.SaveUpdate(fifoData & 0xFF);
+                break;
+            case DISP_FLASH_PARK:
+                // a flash write's coming: whatever's on the buses finishes, and nothing new starts until it's done
+                core1Parked = fifoData & 1;
+                if(core1Parked) {
+                    if(OLED.display != nullptr) OLED.Park();
+                    core1ParkAck = (fifoData >> 8) & 0xFF;
+                }
+                break;
+            case DISP_RENDER_AUDIT:
+                if(OLED.display != nullptr) OLED.RenderAudit(consoleRelay, fifoData & 1);
+                break;
+            case DISP_DUMP:
+                if(OLED.display != nullptr) OLED.FrameDump(consoleRelay);
+                else consoleRelay.println("No display");
+                break;
+            case DISP_BENCH:
+                if(OLED.display != nullptr) OLED.Bench(consoleRelay, (DeckDisplay::Bench_e)(fifoData & 0xFF), (fifoData >> 8) & 0xFFFF);
+                else consoleRelay.println("No display");
+                break;
+            default: break;
+        }
+    }
+
+    if(OLED.display != nullptr && !core1Parked)
+        OLED.IdleOps();
+
+    // icon toggles go to Core0 to be saved; any the FIFO can't take right now wait for the next pass,
+    // rather than blocking on Core0 while it might be blocked on this core
+    for(int page = 0; page < PREFS_TOGGLE_PAGES; ++page) {
+        if(OLED.togglesPending[page] && rp2040.fifo.push_nb(DECK_KEY_TOGGLE | OLED.togglesPending[page] << 8 | page))
+            OLED.togglesPending[page] = 0;
+    }
+    if(core1ParkAck >= 0 && rp2040.fifo.push_nb(DECK_FLASH_PARKED | core1ParkAck))
+        core1ParkAck = -1;
+
+    ++loopCount[1];
+
+    // sleeps until the next frame's due, or Core0 pushes something
+    if(!rp2040.fifo.available()) {
+        // (parked, there's nothing to do but tell Core0 so)
+        const unsigned long idleWait = core1ParkAck >= 0 ? 0 :
+                                       OLED.display != nullptr && !core1Parked ? OLED.IdleWait(millis()) : SLEEP_MAX_MS;
+        if(idleWait) CoreSleep(idleWait);
+    }
+}
+
+unsigned long Core0IdleWait()
+{
+    // a report held back by a suspended or missing bus isn't in flight; the bus coming back is a USB interrupt
+    if(buttons.debouncing || buttons.settling || reportWaiting || (TinyUSBDevices.newReport && usbState == Usb_Mounted) ||
+       savePending || erasePending || profileSwitching >= 0 || profileStaged >= 0 || wakeReplay >= 0 ||
+       inputTrace.mode != DeckTrace::Trace_Off || console.binaryLog || Serial.available() || rp2040.fifo.available() || consoleRelay.Pending())
+        return 0;
+
+    const unsigned long now = millis();
+    unsigned long wait = std::min<unsigned long>({SLEEP_MAX_MS, pixels.Wait(now), governor.Wait(now)});
+    if(canSave)
+        wait = std::min<unsigned long>(wait, now - lastSaveChecked < SAVE_INTERVAL ? SAVE_INTERVAL - (now - lastSaveChecked) : 0);
+    if(profileChordHeld)
+        wait = std::min<unsigned long>(wait, now - profileChordStart < PROFILE_CHORD_HOLD_MS ? PROFILE_CHORD_HOLD_MS - (now - profileChordStart) : 0);
+    return wait;
+}
+
+void CoreSleep(const unsigned long &ms)
+{
+    const uint8_t core = DeckCoreNum();
+    const uint32_t start = DeckTimeUs();
+    DeckSleepUntil(start + std::min<unsigned long>(ms, SLEEP_MAX_MS) * 1000);
+    const uint32_t slept = DeckTimeUs() - start;
+
+    ++sleepCount[core];
+    sleepUs[core] += slept;
+    DeckStats::Sample(core ? DeckStats::Stage_Core1Sleep : DeckStats::Stage_Core0Sleep, slept);
+}
+
+void PinEdge()
+{
+    // taking the interrupt is what wakes the core, the loop does the rest
+    pinEdged = true;
+}
+
+void GovernorApply()
+{
+    DeckLog::Event(DeckLog::Log_Tier, governor.tier);
+    FifoPush(governor.tier | DISP_TIER);
+    pixels.Brightness(governor.Current().pixelsBrightness);
+}
+
+bool FlashWindowOpen()
+{
+    return !(buttons.debounced | buttons.debouncing) && !reportWaiting;
+}
+
+void FlashParkAsk()
+{
+    flashPark = Park_Asked;
+    FifoPush(DISP_FLASH_PARK | ++flashParkSeq << 8 | 1);
+}
+
+void FlashParkWait()
+{
+    if(flashPark == Park_None) FlashParkAsk();
+    while(flashPark != Park_Held) {
+        uint32_t fromCore1;
+        if(rp2040.fifo.pop_nb(&fromCore1)) Core0FifoHandle(fromCore1);
+        // Core1 could be printing, in which case it's waiting on this core to make room first
+        else {
+            consoleRelay.Drain(Serial, Serial.dtr() && !console.binaryLog);
+            DeckWaitOther();
+        }
+    }
+}
+
+void FlashRelease()
+{
+    flashPark = Park_None;
+    FifoPush(DISP_FLASH_PARK);
+}
+
+void Core0FifoHandle(const uint32_t &data)
+{
+    switch(data & 0xFF000000) {
+        case DECK_KEY_TOGGLE:
+            for(uint32_t cells = (data >> 8) & 0xFFFF; cells; cells &= cells - 1)
+                DeckCommon::Prefs->KeyToggle(__builtin_ctz(cells), data & 0xFF);
+            break;
+        case DECK_FLASH_PARKED:
+            if(flashPark == Park_Asked && (data & 0xFF) == flashParkSeq)
+                flashPark = Park_Held;
             break;
         default: break;
     }
+}
 
-    if(OLED.display != nullptr)
-        OLED.IdleOps();
+DeckPrefs::Errors_e PrefsSave()
+{
+    DeckLog::Event(DeckLog::Log_SaveStart);
+    const unsigned long saveStart = micros();
+    DeckPrefs::Errors_e saveResult = DeckCommon::Prefs->Save();
+    DeckStats::Sample(DeckStats::Stage_Save, micros() - saveStart);
+    DeckLog::Event(DeckLog::Log_SaveEnd, saveResult);
+    // a compaction leaves the full sector behind, erased in a quiet moment of its own
+    erasePending = DeckCommon::Prefs->SpareDirty();
+    FifoPush(DECK_SAVING | (saveResult+1));
+    return saveResult;
+}
+
+void FifoPush(const uint32_t &data)
+{
+    // a parked Core1 has to be let go before it's given anything else to do
+    if(flashPark != Park_None && (data & 0xFF000000) != DISP_FLASH_PARK)
+        FlashRelease();
+
+    DeckStats::FifoPushed(micros());
+    if(!rp2040.fifo.push_nb(data)) {
+        DeckLog::Event(DeckLog::Log_FifoFull, data >> 24);
+        DeckStats::Count(DeckStats::Count_FifoFull);
+        inputTrace.FifoFull();
+        // Core1 could be stuck printing, waiting on this core to make room before it takes anything else
+        while(!rp2040.fifo.push_nb(data)) {
+            consoleRelay.Drain(Serial, Serial.dtr() && !console.binaryLog);
+            DeckWaitOther();
+        }
+    }
+}
+
+void PixelPageUpdate(const int &page)
+{
+    const DeckPrefs::Pages_t *pageInfo = DeckCommon::PageInfo(page);
+    pixels.Fade(pageInfo != nullptr ? pageInfo->color : 0, millis());
 }
 
-void PixelUpdate(const uint32_t &rgb, const int &pixel, const bool &fill)
+int PixelOfButton(const int &button)
 {
-    const uint8_t r = rgb & 0xFF;
-    const uint8_t g = (rgb >> 8) & 0xFF;
-    const uint8_t b = (rgb >> 16) & 0xFF;
-    PixelUpdate(r, g, b, pixel, fill); 
+    return button * PIXELS_COUNT / (int)ButtonCount;
 }
 
-void PixelUpdate(const int &r, const int &g, const int &b, const int &pixel, const bool &fill)
+void ProfileUse()
 {
-    if(fill) neopixel.fill(Adafruit_NeoPixel::Color(r, g, b), pixel);
-    else neopixel.setPixelColor(pixel, r, g, b);
+    if(DeckCommon::Profile->Loaded()) {
+        LightgunButtons::Keymap = ProfileKeyCode;
+        buttons.pagesCount = DeckCommon::Profile->Pages();
+    } else {
+        LightgunButtons::Keymap = nullptr;
+        buttons.pagesCount = builtInPagesCount;
+    }
+    DeckCommon::pagesCount = buttons.pagesCount;
+    if(buttons.page >= buttons.pagesCount)
+        buttons.page = 0;
+    profileChord = ProfileChordKeys();
+    profileChordHeld = false;
+}
+
+void UsbUpdate()
+{
+    const UsbState_e state = !USBDevice.mounted() ? Usb_Unmounted :
+                             USBDevice.suspended() ? Usb_Suspended : Usb_Mounted;
+    if(state == usbState) return;
+
+    DeckLog::Event(DeckLog::Log_Usb, state);
+
+    // the wake key let go before the bus came back only had its press & release cancel out in the pending report,
+    // so its press goes out now (its release goes out after, in loop())
+    if(usbState == Usb_Suspended && state == Usb_Mounted && wakeButton >= 0 &&
+       !(buttons.debounced & 1 << wakeButton) && (buttons.report & 1 << wakeButton)) {
+        buttons.ReportPress(wakeButton);
+        wakeReplay = wakeButton;
+    }
+
+    if(state == Usb_Unmounted)
+        wakeButton = wakeReplay = -1;
+
+    usbState = state;
+}
+
+void UsbWake(const uint32_t &pressed)
+{
+    if(usbState != Usb_Suspended || wakeButton >= 0) return;
+
+    // only if the host allows it, or the press would be replayed whenever it happens to resume on its own
+    if(!USBDevice.remoteWakeup()) return;
+
+    wakeButton = __builtin_ctz(pressed);
+    wakeStart = micros();
+    DeckStats::Count(DeckStats::Count_Wakeups);
+}
+
+void ProfileBoot()
+{
+    profileStaged = -1;
+    ProfileUse();
+    DeckCommon::Prefs->curPage = buttons.page;
+    // display may have come up with the compiled-in pages, so it's caught up with the profile either way
+    FifoPush(buttons.page | DISP_PAGES_RELOAD);
+    PixelPageUpdate(buttons.page);
+    DeckBoot::Mark(DeckBoot::Boot_ProfileReady);
+}
+
+void ProfileSwitch(const int &slot)
+{
+    if(profileSwitching >= 0 || profileStaged >= 0 || slot == (int)DeckCommon::Profile->Slot() || slot == profileStoring) return;
+
+    profileSwitching = slot;
+    profileSwitchStart = micros();
+    profileSwitchWorstPass = 0;
+    // this core carries on with the current profile meanwhile
+    FifoPush(DISP_PROFILE_PREPARE | slot);
+}
+
+int ProfileNextSlot()
+{
+    const int active = DeckCommon::Profile->Slot();
+    int slot = active;
+    // slot 0's the built-in one when it's empty, unless it's still being written
+    do slot = (slot+1) % PROFILE_SLOTS;
+    while(slot != active && (slot == profileStoring || (slot && !profiles[slot]->Stored())));
+    return slot;
+}
+
+uint32_t ProfileChordKeys()
+{
+    uint32_t keys = 0;
+    for(unsigned int b = 0; b < ButtonCount; ++b) {
+        // LightgunButtons::Poll() flips pages by the first page's code, and reports whatever's above the page keys
+        const uint8_t first = DeckCommon::KeyCode(DeckCommon::Profile, b, 0) & 0xFF;
+        bool silent = first == LightgunButtons::LGB_PREV || first == LightgunButtons::LGB_NEXT;
+        for(int page = 1; silent && page < DeckCommon::pagesCount; ++page)
+            silent = (DeckCommon::KeyCode(DeckCommon::Profile, b, page) & 0xFF) <= LightgunButtons::LGB_PAGEKEYS;
+        if(silent) keys |= 1 << b;
+    }
+    return __builtin_popcount(keys) >= 2 ? keys : 0;
+}
+
+void ProfileSwap()
+{
+    const int slot = profileStaged;
+    profileStaged = -1;
+
+    DeckCommon::Profile = profiles[slot];
+    ProfileUse();
+    buttons.page = 0;
+    DeckCommon::Prefs->curPage = buttons.page;
+    DeckCommon::Prefs->profile = slot;
+    FifoPush(buttons.page | DISP_PROFILE_SWAP);
+    PixelPageUpdate(buttons.page);
+
+    canSave = true;
+    lastSaveChecked = millis();
+
+    const unsigned long switchTime = micros() - profileSwitchStart;
+    DeckStats::Sample(DeckStats::Stage_ProfileSwitch, switchTime);
+    DeckStats::Sample(DeckStats::Stage_SwitchPass, profileSwitchWorstPass);
+    DeckLog::Event(DeckLog::Log_Profile, slot);
+    profileSwitching = -1;
+
+    if(Serial.dtr() && !console.binaryLog)
+        Serial.printf("Profile %d in use (%d pages), switched in %lu us, longest input pass meanwhile %lu us\n",
+                      slot, DeckCommon::pagesCount, switchTime, profileSwitchWorstPass);
+}
+
+uint16_t ProfileKeyCode(const int &button, const int &page)
+{
+    return DeckCommon::KeyCode(DeckCommon::Profile, button, page);
+}
+
+uint32_t ProfileBuild(const int &pagesCount, void (*sink)(const uint8_t *data, const size_t &len))
+{
+    // every compiled-in icon a key uses, by name
+    std::vector<DeckProfile::Icon_t> icons;
+    const auto iconIndex = [&](const DeckPrefs::KeyBM_t *pic) -> uint8_t {
+        if(pic == nullptr) return PROFILE_NO_ICON;
+        for(const DeckPrefs::KeyIcon_t &builtIn : DeckPrefs::Icons) {
+            if(&builtIn.bm != pic) continue;
+            for(size_t i = 0; i < icons.size(); ++i)
+                if(!strcmp(builtIn.name, icons[i].name)) return i;
+            DeckProfile::Icon_t icon = {};
+            strncpy(icon.name, builtIn.name, sizeof(icon.name)-1);
+            icons.push_back(icon);
+            return icons.size()-1;
+        }
+        return PROFILE_NO_ICON;
+    };
+
+    DeckProfile::Header_t header = { PROFILE_MAGIC, PROFILE_VERSION, sizeof(DeckProfile::Header_t), 0, 0,
+                                     (uint16_t)pagesCount, (uint8_t)ButtonCount, 0, 0, 0, 0, 0, 0 };
+    header.pagesOffset = sizeof(header);
+    header.bindingsOffset = header.pagesOffset + pagesCount * sizeof(DeckProfile::Page_t);
+
+    // tables are made a page at a time and go straight out, so the whole blob never has to be in RAM;
+    // first time around only checksums them (and finds the icons), second time writes them after the header
+    uint32_t checksum = PROFILE_CHECKSUM_SEED;
+    bool writing = false;
+    const auto put = [&](const void *data, const size_t &len) {
+        if(writing) sink((const uint8_t*)data, len);
+        else checksum = DeckProfile::Checksum((const uint8_t*)data, len, checksum);
+    };
+
+    const auto tables = [&]() {
+        // pages past the compiled-in ones go around them again
+        for(int page = 0; page < pagesCount; ++page) {
+            DeckProfile::Page_t info = {};
+            const int builtIn = page % builtInPagesCount;
+            if(builtIn < (int)DeckCommon::Prefs->pages.size())
+                info = DeckCommon::Prefs->pages.at(builtIn);
+            if(page >= builtInPagesCount)
+                snprintf(info.name, sizeof(info.name), "Generated %d", page+1);
+            put(&info, sizeof(info));
+        }
+
+        for(int page = 0; page < pagesCount; ++page) {
+            const int builtIn = page % builtInPagesCount;
+            for(int i = 0, b = 0; b < (int)ButtonCount; ++b) {
+                DeckProfile::Binding_t binding = { DeckCommon::KeyCode(nullptr, b, builtIn), PROFILE_NO_ICON, 0 };
+                if(!DeckCommon::PageKey(nullptr, b)) {
+                    const DeckPrefs::KeyBM_t *pic = builtIn < OLED_KEYPICS_PAGES ? OLED.keyPics[i][builtIn] : nullptr;
+                    binding.icon = iconIndex(pic);
+                    // compiled-in icons toggle whenever they have a second half
+                    if(pic != nullptr && pic->isPacked) binding.flags |= DeckProfile::Bind_Toggle;
+                    ++i;
+                }
+                put(&binding, sizeof(binding));
+            }
+        }
+
+        put(icons.data(), icons.size() * sizeof(DeckProfile::Icon_t));
+    };
+
+    tables();
+    header.checksum = checksum;
+    header.icons = icons.size();
+    header.iconsOffset = header.bindingsOffset + pagesCount * ButtonCount * sizeof(DeckProfile::Binding_t);
+    header.size = header.iconsOffset + icons.size() * sizeof(DeckProfile::Icon_t);
+
+    writing = true;
+    put(&header, sizeof(header));
+    tables();
+    return header.size;
+}
 
-    neopixel.show();
-}
\ No newline at end of file
+int ProfileStoreSlot(Stream &out, const int &argc, char **argv, const int &arg)
+{
+    // the one after the one in use by default, so storing over and over flips between two
+    const int active = DeckCommon::Profile->Slot();
+    const int slot = argc > arg ? atoi(argv[arg]) : (active+1) % PROFILE_SLOTS;
+    if(slot < 0 || slot >= PROFILE_SLOTS)
+        out.printf("Slots are 0-%d\n", PROFILE_SLOTS-1);
+    // Core1 reads the profile in use (and the one it's getting ready) as it likes, so neither's rewritten under it
+    else if(slot == active)
+        out.printf("Profile %d is in use, 'profile use' another slot first\n", slot);
+    else if(profileSwitching >= 0 || profileStaged >= 0 || profileStoring >= 0)
+        out.println("Another profile is still being got ready");
+    else if(!profiles[slot]->StoreBegin())
+        out.println("Sketch overlaps the profile stores!");
+    else return slot;
+    return -1;
+}
+
+void ProfileStored(Stream &out, const int &slot, const bool &loaded)
+{
+    profileStoring = -1;
+    if(loaded) {
+        out.printf("Profile stored in slot %d, %d pages, %lu bytes; switching to it once no keys are held\n",
+                   slot, profiles[slot]->Pages(), (unsigned long)profiles[slot]->Size());
+        // Core1 checks it over & gets its pages ready, then it's swapped in, like any other switch
+        ProfileSwitch(slot);
+    } else {
+        // so it's not picked by the profile combo, only to come up as the built-in one
+        profiles[slot]->StoreClear();
+        out.printf("No valid profile, slot %d left empty\n", slot);
+    }
+}
+
+void ConsoleFrameBuffer(Stream &out, const int &argc, char **argv)
+{
+    FifoPush(DISP_DUMP);
+}
+
+void ConsoleAudit(Stream &out, const int &argc, char **argv)
+{
+    FifoPush(DISP_RENDER_AUDIT | (argc > 1 && !strcmp(argv[1], "img")));
+}
+
+void ConsoleIcons(Stream &out, const int &argc, char **argv)
+{
+    size_t total = 0;
+    for(const DeckPrefs::KeyIcon_t &icon : DeckPrefs::Icons) {
+        const DeckPrefs::KeyBM_t &bm = icon.bm;
+        size_t size = KEYBM_FRAME_SIZE * (bm.isPacked ? 2 : 1);
+        int frames = 1;
+        if(bm.sprite != nullptr) {
+            frames = bm.sprite->count;
+            // frame 0 is ptr itself
+            for(int i = 1; i < frames; ++i)
+                size += bm.sprite->frames[i].deltaRows ? bm.sprite->frames[i].deltaRows * (1 + KEYBM_ROW_BYTES) : KEYBM_FRAME_SIZE;
+        }
+        total += size;
+        out.printf("%-16s %s %2d frame(s) %5u bytes\n", icon.name, bm.isPacked ? "packed" : "      ", frames, (unsigned)size);
+    }
+    out.printf("%d icons, %u bytes\n", DeckPrefs::IconsCount, (unsigned)total);
+}
+
+void ConsoleRates(Stream &out, const int &argc, char **argv)
+{
+    static unsigned long lastTime = 0;
+    static uint32_t lastCount[2] = {0, 0};
+    static uint32_t lastSleeps[2] = {0, 0};
+    static uint32_t lastSleepUs[2] = {0, 0};
+    static uint32_t lastFlushBytes = 0;
+
+    const unsigned long now = millis();
+    const unsigned long elapsed = now - lastTime ? now - lastTime : 1;
+    for(int core = 0; core < 2; ++core) {
+        const uint32_t count = loopCount[core];
+        const uint32_t sleeps = sleepCount[core];
+        const uint32_t slept = sleepUs[core];
+        // active is whatever wasn't spent asleep
+        const uint64_t asleep = std::min<uint64_t>(slept - lastSleepUs[core], (uint64_t)elapsed * 1000);
+        out.printf("Core%d: %lu loops/s, %lu wakeups/s, %lu%% active\n", core,
+                   (unsigned long)((uint64_t)(count - lastCount[core]) * 1000 / elapsed),
+                   (unsigned long)((uint64_t)(sleeps - lastSleeps[core]) * 1000 / elapsed),
+                   (unsigned long)(100 - asleep / (elapsed * 10)));
+        lastCount[core] = count;
+        lastSleeps[core] = sleeps;
+        lastSleepUs[core] = slept;
+    }
+
+    const uint32_t flushBytes = DeckStats::Counter(DeckStats::Count_FlushBytes);
+    out.printf("Display: %lu bytes/s pushed, governor tier %s\n",
+               (unsigned long)((uint64_t)(flushBytes - lastFlushBytes) * 1000 / elapsed), governor.Current().name);
+    lastFlushBytes = flushBytes;
+    lastTime = now;
+}
+
+void ConsoleSave(Stream &out, const int &argc, char **argv)
+{
+    canSave = false;
+    savePending = false;
+    const bool changed = DeckCommon::Prefs->Changed();
+    const unsigned long start = micros();
+    FifoPush(DECK_SAVING);
+    const DeckPrefs::Errors_e result = PrefsSave();
+    out.printf("Save result %d, took %lu us%s (%lu journal records written so far)\n",
+               result, micros() - start, changed ? "" : ", nothing changed", (unsigned long)DeckCommon::Prefs->saves);
+}
+
+void ConsoleBench(Stream &out, const int &argc, char **argv)
+{
+    const int runs = argc > 2 ? constrain(atoi(argv[2]), 1, 0xFFFF) : 100;
+    if(argc < 2) {
+        out.println("bench poll|blit|display|pages [runs]");
+    } else if(!strcmp(argv[1], "poll")) {
+        // pins are read fresh every run; anything pressed meanwhile is only seen as a changed state afterwards
+        const unsigned long start = micros();
+        for(int i = 0; i < runs; ++i)
+            buttons.Poll(0);
+        out.printf("poll: %lu us avg over %d runs\n", (micros() - start) / runs, runs);
+        if(buttons.pressed | buttons.released)
+            out.println("(buttons changed during the bench, some edges may have been missed)");
+    } else if(!strcmp(argv[1], "blit")) {
+        FifoPush(DISP_BENCH | DeckDisplay::Bench_Blit | runs << 8);
+    } else if(!strcmp(argv[1], "display")) {
+        FifoPush(DISP_BENCH | DeckDisplay::Bench_Display | runs << 8);
+    } else if(!strcmp(argv[1], "pages")) {
+        FifoPush(DISP_BENCH | DeckDisplay::Bench_PageLoad | runs << 8);
+    } else out.printf("Unknown bench '%s'\n", argv[1]);
+}
+
+void ConsoleSet(Stream &out, const int &argc, char **argv)
+{
+    if(argc < 2) {
+        out.printf("debounce %d ticks, report %lu ms, poll %lu ms\n", buttons.debounceTicks, reportInterval, pollMinTicks);
+        return;
+    }
+
+    const bool setting = argc > 2;
+    const long value = setting ? atol(argv[2]) : 0;
+    if(!strcmp(argv[1], "debounce")) {
+        if(setting) buttons.debounceTicks = constrain(value, 1, 255);
+        out.printf("debounce %d ticks\n", buttons.debounceTicks);
+    } else if(!strcmp(argv[1], "report")) {
+        if(setting) reportInterval = constrain(value, 0, 1000);
+        out.printf("report %lu ms\n", reportInterval);
+    } else if(!strcmp(argv[1], "poll")) {
+        if(setting) pollMinTicks = constrain(value, 0, 1000);
+        out.printf("poll %lu ms\n", pollMinTicks);
+    } else out.printf("Unknown setting '%s'\n", argv[1]);
+}
+
+void ConsoleTrace(Stream &out, const int &argc, char **argv)
+{
+    if(argc < 2) {
+        out.println("trace rec|gen <presses/s> <ms> [seed]|play|stop|dump");
+    } else if(inputTrace.mode == DeckTrace::Trace_Replay && strcmp(argv[1], "stop")) {
+        out.println("Replay running, 'trace stop' it first");
+    } else if(!strcmp(argv[1], "rec")) {
+        inputTrace.RecordStart();
+        out.println("Recording inputs");
+    } else if(!strcmp(argv[1], "gen")) {
+        const int rate = argc > 2 ? atoi(argv[2]) : 10;
+        const int duration = argc > 3 ? atoi(argv[3]) : 5000;
+        // same seed, same trace, so a generated trace can be made again on another build to compare with
+        const uint32_t seed = argc > 4 ? strtoul(argv[4], nullptr, 0) : 1;
+        inputTrace.Generate(constrain(rate, 1, 1000), constrain(duration, 1, 600000), seed);
+        out.printf("Generated %d events\n", inputTrace.eventsCount);
+    } else if(!strcmp(argv[1], "play")) {
+        inputTrace.ReplayStart();
+        FifoPush(DISP_REPLAY | 1);
+        out.println("Replaying inputs");
+    } else if(!strcmp(argv[1], "stop")) {
+        // a replay lets go of whatever it's holding first, and dumps its results once it has
+        if(inputTrace.mode == DeckTrace::Trace_Replay) inputTrace.ReplayEnd();
+        else inputTrace.Stop();
+        out.printf("Stopped with %d events\n", inputTrace.eventsCount);
+    } else if(!strcmp(argv[1], "dump")) {
+        inputTrace.Dump(out, true);
+    } else out.printf("Unknown trace command '%s'\n", argv[1]);
+}
+
+void ConsoleLog(Stream &out, const int &argc, char **argv)
+{
+    #ifdef SERIAL_DEBUG
+    out.println("Binary log isn't available in SERIAL_DEBUG builds");
+    #else
+    out.println("Binary log starting, close the port to stop");
+    console.binaryLog = true;
+    #endif // SERIAL_DEBUG
+}
+
+void ConsoleBoot(Stream &out, const int &argc, char **argv)
+{
+    DeckBoot::Dump(out);
+}
+
+void ConsoleProfile(Stream &out, const int &argc, char **argv)
+{
+    if(argc < 2) {
+        const int active = DeckCommon::Profile->Slot();
+        if(DeckCommon::Profile->Loaded())
+             out.printf("Profile %d: %d pages, %lu bytes\n", active, DeckCommon::Profile->Pages(), (unsigned long)DeckCommon::Profile->Size());
+        else out.printf("Profile %d: built-in\n", active);
+        for(int slot = 0; slot < PROFILE_SLOTS; ++slot)
+            if(slot != active) out.printf("Slot %d: %s\n", slot, profiles[slot]->Stored() ? "stored" : "empty");
+    } else if(!strcmp(argv[1], "use")) {
+        const int slot = argc > 2 ? atoi(argv[2]) : -1;
+        if(slot < 0 || slot >= PROFILE_SLOTS)
+            out.printf("profile use <slot>, 0-%d\n", PROFILE_SLOTS-1);
+        else if(slot == (int)DeckCommon::Profile->Slot())
+            out.printf("Profile %d is already in use\n", slot);
+        else if(profileSwitching >= 0 || profileStaged >= 0)
+            out.println("Another profile is still being got ready");
+        else {
+            out.printf("Switching to profile %d once no keys are held\n", slot);
+            ProfileSwitch(slot);
+        }
+    } else if(!strcmp(argv[1], "build") || !strcmp(argv[1], "gen")) {
+        // largest page count that'll fit, even if every compiled-in icon gets used
+        static constexpr int maxPages = (PROFILE_STORE_SIZE - sizeof(DeckProfile::Header_t) - DeckPrefs::IconsCount * sizeof(DeckProfile::Icon_t)) /
+                                        (sizeof(DeckProfile::Page_t) + ButtonCount * sizeof(DeckProfile::Binding_t));
+        int pagesCount = builtInPagesCount;
+        int slotArg = 2;
+        if(!strcmp(argv[1], "gen")) {
+            pagesCount = argc > 2 ? atoi(argv[2]) : 0;
+            if(pagesCount < 1 || pagesCount > maxPages) {
+                out.printf("profile gen <pages> [slot], up to %d pages\n", maxPages);
+                return;
+            }
+            ++slotArg;
+        }
+
+        static int slot;
+        slot = ProfileStoreSlot(out, argc, argv, slotArg);
+        if(slot < 0) return;
+        ProfileBuild(pagesCount, [](const uint8_t *data, const size_t &len) { profiles[slot]->StoreWrite(data, len); });
+        ProfileStored(out, slot, profiles[slot]->StoreEnd(ButtonCount));
+    } else if(!strcmp(argv[1], "load")) {
+        const long size = argc > 2 ? atol(argv[2]) : 0;
+        if(size < (long)sizeof(DeckProfile::Header_t) || size > PROFILE_STORE_SIZE) {
+            out.printf("profile load <bytes> [slot], up to %d bytes\n", PROFILE_STORE_SIZE);
+            return;
+        }
+        profileStoring = ProfileStoreSlot(out, argc, argv, 3);
+        if(profileStoring < 0) return;
+        out.printf("Send %ld bytes\n", size);
+        console.Receive(size, [](Stream &port, const uint8_t *data, const size_t &len, const bool &done) {
+            const int slot = profileStoring;
+            profiles[slot]->StoreWrite(data, len);
+            if(done) ProfileStored(port, slot, profiles[slot]->StoreEnd(ButtonCount));
+        });
+    } else if(!strcmp(argv[1], "clear")) {
+        const int slot = argc > 2 ? atoi(argv[2]) : -1;
+        if(argc < 3 || slot < 0 || slot >= PROFILE_SLOTS)
+            out.printf("profile clear <slot>, 0-%d\n", PROFILE_SLOTS-1);
+        else if(slot == (int)DeckCommon::Profile->Slot())
+            out.printf("Profile %d is in use, 'profile use' another slot first\n", slot);
+        else if(slot == profileSwitching || slot == profileStaged || slot == profileStoring)
+            out.println("That profile is still being got ready");
+        else {
+            profiles[slot]->StoreClear();
+            out.printf("Slot %d cleared\n", slot);
+        }
+    } else out.printf("Unknown profile command '%s'\n", argv[1]);
+}
@@ -0,0 +1,110 @@
+/*!
+ * @file PicoDeckAnim.cpp
+ * @brief Frame-paced animation timeline for the Core1 display loop.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "PicoDeckAnim.h"
+
+DeckAnim::DeckAnim(const unsigned long &interval, const unsigned long &budget)
+    : frameInterval(interval), frameBudget(budget)
+{
+    memset(tracks, 0, sizeof(tracks));
+}
+
+void DeckAnim::Start(const Track_e &track, const int32_t &from, const int32_t &to, const unsigned long &duration,
+                     const unsigned long &now, const Tween_e &type, const bool &repeat, const unsigned long &delay)
+{
+    Tween_t &tween = tracks[track];
+    tween.start = now + delay;
+    tween.duration = duration ? duration : 1;
+    tween.from = from;
+    tween.to = to;
+    tween.value = from;
+    tween.type = type;
+    tween.repeat = repeat;
+    tween.active = true;
+    finished &= ~(1 << track);
+}
+
+uint32_t DeckAnim::Tick(const unsigned long &now)
+{
+    uint32_t changed = 0;
+    finished = 0;
+
+    for(int i = 0; i < ANIM_TRACKS; ++i) {
+        Tween_t &tween = tracks[i];
+        if(!tween.active || (long)(now - tween.start) < 0) continue;
+
+        unsigned long elapsed = now - tween.start;
+        if(elapsed >= tween.duration) {
+            if(tween.repeat) elapsed %= tween.duration;
+            else {
+                tween.active = false;
+                finished |= 1 << i;
+                changed |= 1 << i;
+                tween.value = tween.to;
+                continue;
+            }
+        }
+
+        int32_t value;
+        switch(tween.type) {
+        case Tween_EaseOut:
+        {
+            // 1 - (1 - t)^2, with t in 1/1024ths
+            const int32_t t = (elapsed << 10) / tween.duration;
+            const int32_t inv = 1024 - t;
+            value = tween.from + (((tween.to - tween.from) * (1024 - ((inv * inv) >> 10))) >> 10);
+            break;
+        }
+        case Tween_Step:
+            // inclusive of the end value, so each step gets an even share of the duration
+            value = tween.from + (int32_t)((elapsed * (unsigned long)(tween.to - tween.from + 1)) / tween.duration);
+            break;
+        default:
+            value = tween.from + (int32_t)(((int64_t)(tween.to - tween.from) * (int64_t)elapsed) / (int64_t)tween.duration);
+            break;
+        }
+
+        if(value != tween.value) {
+            tween.value = value;
+            changed |= 1 << i;
+        }
+    }
+
+    return changed;
+}
+
+void DeckAnim::FrameDone(const unsigned long &now, const unsigned long &workTime)
+{
+    if(workTime > frameBudget) ++framesOverBudget;
+
+    // first frame, nothing to have fallen behind on
+    if(!nextFrame) nextFrame = now;
+
+    nextFrame += frameInterval;
+    if((long)(now - nextFrame) >= 0) {
+        // fell behind: skip whatever's already past due and realign to now
+        framesDropped += (now - nextFrame) / frameInterval + 1;
+        nextFrame = now + frameInterval;
+    }
+}
+
+unsigned long DeckAnim::FrameWait(const unsigned long &now) const
+{
+    unsigned long wait = ~0UL;
+    for(const Tween_t &tween : tracks) {
+        if(!tween.active) continue;
+        const long until = (long)(tween.start - now);
+        wait = std::min(wait, until > 0 ? (unsigned long)until : 0UL);
+    }
+
+    // frames still only come round every interval, however soon a track wants one
+    return wait == ~0UL ? wait : std::max(wait, FrameIn(now));
+}
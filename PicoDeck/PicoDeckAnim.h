@@ -0,0 +1,111 @@
+/*!
+ * @file PicoDeckAnim.h
+ * @brief Frame-paced animation timeline for the Core1 display loop.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class DeckAnim {
+public:
+    /// @brief Fixed animation slots, one running tween each
+    enum Track_e {
+        Anim_BannerSlide = 0,   ///< Banner main->sub text slide, in pixels
+        Anim_PageSlide,         ///< Key grid slide-in offset on page change, in pixels
+        Anim_Fade,              ///< Display contrast
+        Anim_Blink,             ///< Save glyph on/off
+        Anim_StatusHold,        ///< How long a save result glyph lingers
+        ANIM_TRACKS
+    };
+
+    /// @brief How a tween gets from its start to end value
+    enum Tween_e {
+        Tween_Linear = 0,
+        Tween_EaseOut,          ///< Quadratic, fast start and slow settle
+        Tween_Step              ///< Whole steps from start to end value (e.g. blinking)
+    };
+
+    typedef struct Tween_s {
+        unsigned long start;    ///< millis() timestamp when the tween starts moving
+        unsigned long duration; ///< Length of one run, in ms
+        int32_t from;
+        int32_t to;
+        int32_t value;          ///< Value as of the last Tick()
+        uint8_t type;           ///< Tween_e
+        bool active;
+        bool repeat;            ///< Loop back to start when finished instead of stopping
+    } Tween_t;
+
+    /// @brief Constructor
+    /// @param interval Frame period, in ms
+    /// @param budget Time a frame's work is allowed to take, in us
+    DeckAnim(const unsigned long &interval, const unsigned long &budget);
+
+    /// @brief Begins (or restarts) a track
+    /// @param delay Time to hold at the start value before moving, in ms
+    void Start(const Track_e &track, const int32_t &from, const int32_t &to, const unsigned long &duration,
+               const unsigned long &now, const Tween_e &type = Tween_Linear, const bool &repeat = false, const unsigned long &delay = 0);
+
+    /// @brief Halts a track where it is, without flagging it as finished
+    void Stop(const Track_e &track) { tracks[track].active = false; }
+
+    bool Active(const Track_e &track) const { return tracks[track].active; }
+
+    /// @brief Whether any track is still running (or waiting out its delay)
+    bool Running() const {
+        for(const Tween_t &tween : tracks)
+            if(tween.active) return true;
+        return false;
+    }
+
+    int32_t Value(const Track_e &track) const { return tracks[track].value; }
+
+    /// @brief Advances every active track to the given time
+    /// @details Values are derived from elapsed time rather than per-tick steps,
+    /// so a late or skipped frame just jumps ahead instead of slowing the animation down.
+    /// @return Bitmask of tracks whose value changed (or finished) this tick
+    uint32_t Tick(const unsigned long &now);
+
+    /// @brief Bitmask of tracks that ran to completion in the last Tick()
+    uint32_t finished = 0;
+
+    /// @brief Whether the next frame is due
+    bool FrameDue(const unsigned long &now) const { return (long)(now - nextFrame) >= 0; }
+
+    /// @brief Changes the frame period, bringing the next frame forward if it's now further off than one period
+    void Interval(const unsigned long &interval, const unsigned long &now) {
+        frameInterval = interval;
+        if((long)(nextFrame - now) > (long)interval) nextFrame = now;
+    }
+
+    /// @brief ms until the next frame's due, 0 if it already is
+    unsigned long FrameIn(const unsigned long &now) const { return FrameDue(now) ? 0 : nextFrame - now; }
+
+    /// @brief ms until animating needs the next frame, 0 if it's already due
+    /// @details Tracks still waiting out their delay don't need frames until they start moving, and with nothing
+    /// running there's no frame to wait for at all (~0UL); whatever changes next comes with its own wakeup.
+    unsigned long FrameWait(const unsigned long &now) const;
+
+    /// @brief Schedules the next frame after finishing this one's render & flush
+    /// @details Frames we're already late for are dropped rather than queued up.
+    /// @param now millis() at the end of the frame
+    /// @param workTime How long the frame took, in us
+    void FrameDone(const unsigned long &now, const unsigned long &workTime);
+
+    /// @brief Count of frames skipped due to running late
+    uint32_t framesDropped = 0;
+
+    /// @brief Count of frames whose work took longer than the budget
+    uint32_t framesOverBudget = 0;
+
+private:
+    Tween_t tracks[ANIM_TRACKS];
+
+    unsigned long frameInterval;
+    unsigned long frameBudget;
+    unsigned long nextFrame = 0;
+};
@@ -0,0 +1,52 @@
+/*!
+ * @file PicoDeckBoot.h
+ * @brief Boot timeline: when each part of the deck first became usable, counted from reset.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "PicoDeckPlatform.h"
+
+/// @brief Timestamps of one-off boot milestones, from either core.
+/// @details Each milestone is only ever written once (the first time it's reached), so there's no locking.
+class DeckBoot {
+public:
+    enum Milestone_e {
+        Boot_InputReady = 0,    ///< Button pins set up & being polled
+        Boot_ProfileReady,      ///< Keymap (compiled-in or profile) checked over & in use
+        Boot_UsbMounted,        ///< Host has configured the device, reports are enabled from here
+        Boot_FirstFrame,        ///< First frame pushed to the display
+        Boot_FirstReport,       ///< First HID report sent
+        BOOT_MILESTONES
+    };
+
+    /// @brief Records a milestone as reached now, unless it already was
+    static inline void Mark(const Milestone_e &milestone) {
+        if(!times[milestone])
+            times[milestone] = DeckTimeUs() | 1;
+    }
+
+    /// @brief Whether a milestone's been reached
+    static inline bool Reached(const Milestone_e &milestone) { return times[milestone] != 0; }
+
+    /// @brief Prints every milestone in us since reset, or that it hasn't been reached yet
+    static void Dump(Print &out) {
+        for(int i = 0; i < BOOT_MILESTONES; ++i) {
+            if(times[i]) out.printf("%-14s %lu us\n", names[i], (unsigned long)times[i]);
+            else out.printf("%-14s -\n", names[i]);
+        }
+    }
+
+private:
+    // us since reset (the low bit's always set so 0 can mean not yet)
+    static inline volatile uint32_t times[BOOT_MILESTONES];
+
+    static constexpr const char *names[BOOT_MILESTONES] = {
+        "input ready", "profile ready", "usb mounted", "first frame", "first report"
+    };
+};
@@ -12,6 +12,7 @@
 #include <TinyUSB_Devices.h>
 
 #include "PicoDeckPrefs.h"
+#include "PicoDeckProfile.h"
 
 class DeckCommon {
 public:
@@ -19,6 +20,33 @@ public:
     static inline DeckPrefs *Prefs;
 
     static inline int pagesCount;
+
+    // Loaded deck profile, if any (else, the configuration below & in DeckPrefs is used)
+    static inline DeckProfile *Profile;
+
+    /// @brief Name & colour of a page, from the profile if one's loaded
+    /// @return nullptr if the page has none
+    static inline const DeckPrefs::Pages_t *PageInfo(const unsigned int &page) {
+        if(Profile != nullptr && Profile->Loaded())
+            return page < Profile->Pages() ? &Profile->Page(page) : nullptr;
+        return page < Prefs->pages.size() ? &Prefs->pages.at(page) : nullptr;
+    }
+
+    /// @brief A button's report code on a page, from a profile if it's loaded, else the compiled-in keymap
+    /// @details Takes the profile rather than going by Profile, since Core1 draws from the one its pages came from,
+    /// which is another one than Core0's for the length of a switch.
+    /// @return The code, or 0 if the button has nothing on that page
+    static inline uint16_t KeyCode(const DeckProfile *profile, const unsigned int &button, const unsigned int &page) {
+        if(profile != nullptr && profile->Loaded())
+            return page < profile->Pages() ? profile->Binding(page, button).code : 0;
+        const std::vector<uint16_t> &keys = LightgunButtons::ButtonDesc[button].keys;
+        return keys.size() > page ? keys.at(page) : 0;
+    }
+
+    /// @brief Whether a button's a page key rather than a key cell, going by its first page like LightgunButtons::Poll()
+    static inline bool PageKey(const DeckProfile *profile, const unsigned int &button) {
+        return (KeyCode(profile, button, 0) & 0xFF) < LightgunButtons::LGB_PAGEKEYS;
+    }
 };
 
 // Button descriptor
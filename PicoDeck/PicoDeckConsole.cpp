@@ -0,0 +1,130 @@
+/*!
+ * @file PicoDeckConsole.cpp
+ * @brief Line-based command console on the USB CDC port, next to the keyboard.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include <algorithm>
+
+#include "PicoDeckConsole.h"
+
+void DeckConsole::Service(Stream &port, const bool &open)
+{
+    if(!open) {
+        connected = false;
+        binaryLog = false;
+        receiveLeft = 0;
+        return;
+    }
+
+    if(!connected) {
+        connected = true;
+        length = 0;
+        port.print("PicoDeck console, 'help' for commands\n> ");
+    }
+
+    if(binaryLog) return;
+
+    if(receiveLeft) {
+        uint8_t data[CONSOLE_BYTES_PER_PASS];
+        size_t n = 0;
+        while(n < sizeof(data) && n < receiveLeft && port.available())
+            data[n++] = port.read();
+        if(!n) return;
+
+        receiveLeft -= n;
+        receiveSink(port, data, n, !receiveLeft);
+        if(!receiveLeft) port.print("> ");
+        return;
+    }
+
+    for(int n = 0; n < CONSOLE_BYTES_PER_PASS && port.available(); ++n) {
+        const int c = port.read();
+        if(c == '\r' || c == '\n') {
+            if(!length) continue;
+            line[length] = '\0';
+            length = 0;
+
+            Execute(port);
+            if(binaryLog || receiveLeft) return;
+            port.print("> ");
+            // one command per pass at most
+            return;
+        } else if(c == '\b' || c == 0x7F) {
+            if(length) --length;
+        } else if(length < CONSOLE_LINE_MAX-1 && c >= ' ')
+            line[length++] = c;
+    }
+}
+
+void DeckConsole::Receive(const size_t &len, void (*sink)(Stream &out, const uint8_t *data, const size_t &len, const bool &done))
+{
+    receiveLeft = len;
+    receiveSink = sink;
+}
+
+void DeckConsole::Execute(Stream &out)
+{
+    char *argv[CONSOLE_ARGS_MAX];
+    int argc = 0;
+    for(char *tok = strtok(line, " \t"); tok != nullptr && argc < CONSOLE_ARGS_MAX; tok = strtok(nullptr, " \t"))
+        argv[argc++] = tok;
+    if(!argc) return;
+
+    if(!strcmp(argv[0], "help")) {
+        for(const Command_t &cmd : Commands)
+            out.printf("%-8s %s\n", cmd.name, cmd.help);
+        return;
+    }
+
+    for(const Command_t &cmd : Commands) {
+        if(!strcmp(argv[0], cmd.name)) {
+            cmd.run(out, argc, argv);
+            return;
+        }
+    }
+
+    out.printf("Unknown command '%s'\n", argv[0]);
+}
+
+size_t DeckConsoleRelay::write(const uint8_t *buffer, size_t size)
+{
+    for(size_t i = 0; i < size; ++i) {
+        while((uint16_t)(head - tail) >= CONSOLE_RELAY_SIZE) {
+            if(!listening) return size;
+            DeckWaitOther();
+        }
+        ring[head & (CONSOLE_RELAY_SIZE-1)] = buffer[i];
+        // byte has to land before the reader can see it
+        DeckMemoryBarrier();
+        head = head + 1;
+    }
+    // Core0 may be asleep with nothing else to do
+    DeckWakeOther();
+    return size;
+}
+
+void DeckConsoleRelay::Drain(Stream &out, const bool &open)
+{
+    listening = open;
+    const uint16_t end = head;
+    // head has to be read before the bytes it covers
+    DeckMemoryBarrier();
+
+    uint16_t start = tail;
+    if(!open) start = end;
+    int room = open ? out.availableForWrite() : 0;
+    while(start != end && room > 0) {
+        // up to the end of the ring at most, the wrapped part goes out on the next loop
+        const int at = start & (CONSOLE_RELAY_SIZE-1);
+        const int count = std::min({ (int)(uint16_t)(end - start), CONSOLE_RELAY_SIZE - at, room });
+        out.write(ring + at, count);
+        start += count;
+        room -= count;
+    }
+    tail = start;
+}
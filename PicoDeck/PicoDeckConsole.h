@@ -0,0 +1,89 @@
+/*!
+ * @file PicoDeckConsole.h
+ * @brief Line-based command console on the USB CDC port, next to the keyboard.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <Arduino.h>
+
+#include "PicoDeckPlatform.h"
+
+#define CONSOLE_LINE_MAX 64
+// command name + arguments
+#define CONSOLE_ARGS_MAX 5
+// bytes taken in per Service() call, so a pasted wall of text can't hold up a loop pass
+#define CONSOLE_BYTES_PER_PASS 16
+// text Core1 can have waiting for Core0 to print, must be a power of two
+#define CONSOLE_RELAY_SIZE 2048
+
+class DeckConsole {
+public:
+    typedef struct Command_s {
+        const char *name;
+        const char *help;   // arguments & what it does, for "help"
+        void (*run)(Stream &out, const int &argc, char **argv);    // argv[0] is the command's name
+    } Command_t;
+
+    // Command table, defined in PicoDeck.h
+    static std::vector<Command_t> Commands;
+
+    /// @brief Takes in a few bytes from the port, and runs the command once a line is complete
+    /// @details Never waits on the port. Meant to be called only when there's no input in flight,
+    /// commands themselves run to completion when their line ends.
+    /// @param open Whether a host has the port open (i.e. DTR); closing it also ends binary log mode
+    void Service(Stream &port, const bool &open);
+
+    /// @brief Hands the next len bytes on the port to sink, instead of taking them in as commands
+    /// @details For uploads. sink is called as bytes come in, with done set for the last of them;
+    /// if the port's closed first, the rest is never asked for.
+    void Receive(const size_t &len, void (*sink)(Stream &out, const uint8_t *data, const size_t &len, const bool &done));
+
+    /// @brief Whether a Receive() is still waiting on bytes
+    bool Receiving() const { return receiveLeft; }
+
+    /// @brief Set while the port carries the binary DeckLog stream instead of text
+    /// @details Text input is ignored until the host closes the port.
+    bool binaryLog = false;
+
+private:
+    /// @brief Splits the line into arguments and runs its command
+    void Execute(Stream &out);
+
+    // upload in progress, if any
+    size_t receiveLeft = 0;
+    void (*receiveSink)(Stream &out, const uint8_t *data, const size_t &len, const bool &done) = nullptr;
+
+    char line[CONSOLE_LINE_MAX];
+    int length = 0;
+    bool connected = false;
+};
+
+/// @brief Console text from Core1, handed to Core0 to print so only Core0 ever writes to the port.
+/// @details One writer (Core1) and one reader (Drain() on Core0), lock-free. A writer with a full ring waits for
+/// Core0 to make room, unless nobody's listening, in which case the text's thrown away like the port would.
+class DeckConsoleRelay : public Print {
+public:
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    /// @brief Passes on as much waiting text as the port has room for, never blocks
+    /// @details Meant to be run every pass of Core0's loop, and while Core0 waits on Core1.
+    /// @param listening Whether there's a host to print for right now (text mode, port open)
+    void Drain(Stream &out, const bool &listening);
+
+    /// @brief Whether there's text waiting
+    bool Pending() const { return head != tail; }
+
+private:
+    uint8_t ring[CONSOLE_RELAY_SIZE];
+    volatile uint16_t head = 0;     // written by Core1
+    volatile uint16_t tail = 0;     // written by Drain()
+    volatile bool listening = true;
+};
@@ -20,4 +20,22 @@
 
 // to keep orig display pin determination code
 #define DISP_SDA 18
-#define DISP_SCL 19
\ No newline at end of file
+#define DISP_SCL 19
+
+// Uncomment to use an SPI variant of the display instead, on the pins below (SPI0)
+//#define DISP_SPI
+#define DISP_SCK  18
+#define DISP_MOSI 19
+#define DISP_CS   17
+#define DISP_DC   22
+#define DISP_RST  26
+
+// Uncomment (alongside DISP_SPI) for an ST7789 colour TFT of this size on the same pins instead
+//#define DISP_TFT
+#define DISP_TFT_WIDTH  240
+#define DISP_TFT_HEIGHT 240
+
+// pins for whichever I2C controller the main display ISN'T on, only used if secondary key panels are put on it
+// (defaults to I2C0, since the main display is on I2C1)
+#define PANEL_SDA 20
+#define PANEL_SCL 21
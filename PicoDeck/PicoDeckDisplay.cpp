@@ -8,17 +8,18 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <SPI.h>
+#include <utility>
 
 #include "PicoDeckDisplay.h"
+#include "PicoDeckPanels.h"
+#include "PicoDeckLog.h"
+#include "PicoDeckStats.h"
+#include "PicoDeckBoot.h"
 
 bool DeckDisplay::Begin(const int &scl, const int &sda, const Adafruit_MultiDisplay::ScreenType_e &displayType)
 {
-    // Clear out any currently active display, if any
-    if(display != nullptr) {
-        delete display;
-        display = nullptr;
-        screenState = Screen_Init;
-    }
+    DisplayRelease();
 
     TwoWire *twi;
 
@@ -45,13 +46,50 @@ bool DeckDisplay::Begin(const int &scl, const int &sda, const Adafruit_MultiDisp
 
     display = new Adafruit_MultiDisplay(twi, displayType);
 
+    return DisplayInit();
+}
+
+bool DeckDisplay::Begin(const int &sck, const int &mosi, const int &cs, const int &dc, const int &rst, const Adafruit_MultiDisplay::ScreenType_e &displayType,
+                        const uint16_t &panelW, const uint16_t &panelH)
+{
+    DisplayRelease();
+
+    SPIClass *spi;
+
+    // SCK/TX are every 4th pin from GPIO 2/3, alternating between SPI0 and SPI1 every 8 pins
+    if(sck >= 0 && mosi >= 0 && cs >= 0 && dc >= 0) {
+        if((sck & 3) == 2 && (mosi & 3) == 3 && (sck & 8) == (mosi & 8)) {
+            // SCK/TX are indeed on verified correct pins
+            spi = (sck & 8) ? &SPI1 : &SPI;
+        } else return false;
+    } else return false;
+
+    spi->setSCK(sck);
+    spi->setTX(mosi);
+
+    display = new Adafruit_MultiDisplay(spi, displayType, dc, rst, cs, panelW, panelH);
+
+    return DisplayInit();
+}
+
+void DeckDisplay::DisplayRelease()
+{
+    if(display != nullptr) {
+        delete display;
+        display = nullptr;
+        screenState = Screen_Init;
+        topBannHWScrolling = false;
+    }
+}
+
+bool DeckDisplay::DisplayInit()
+{
     if(display->begin()) {
+        pages->Begin(&keyPics[0][0], OLED_KEYPICS_PAGES, DeckCommon::Profile);
         // init backbufs
-        memset(topBannerBackupBitmap, 0, sizeof(topBannerBackupBitmap));
         memset(keyBoxBitmaps, 0, sizeof(keyBoxBitmaps));
-        memset(keyBoxesPushedStatus, 0, sizeof(keyBoxesPushedStatus));
-        topBannerBufMain.setTextWrap(false);
-        topBannerBufSub.setTextWrap(false);
+        topBannerBufA.setTextWrap(false);
+        topBannerBufB.setTextWrap(false);
         keyBoxBuf.setFont(&Sega7x7);
         keyBoxBuf.setTextWrap(false);
 
@@ -62,79 +100,317 @@ bool DeckDisplay::Begin(const int &scl, const int &sda, const Adafruit_MultiDisp
 
 void DeckDisplay::TopPanelUpdate(const char *mainText, const PanelTextAlign_e &textAlign, const char *subText, const PanelTextAlign_e &subAlign)
 {
+    // drawn on the next frame
+    ui.SetBanner(mainText, textAlign, subText, subAlign);
+}
+
+void DeckDisplay::BannerRender()
+{
+    const DeckUI::Banner_t &banner = ui.model.banner;
+
+    // controller has to stop rotating before its RAM can be rewritten
+    if(topBannHWScrolling) {
+        BusClaim();
+        display->stopScroll();
+        topBannHWScrolling = false;
+    }
+
     // draw text in banner canvas
-    topBannerBufMain.fillScreen(BLACK);
-    topBannerBufMain.setFont(&Sega7x7);
-    switch(textAlign) {
-    case Align_Left:
-        topBannerBufMain.setCursor(0, 3+SEGAFONT7_HEIGHT);
-        break;
-    case Align_Center:
-    case Align_Right:
-    {
-        int16_t x, y;
-        uint16_t w, h;
-        topBannerBufMain.getTextBounds(mainText, 0, SEGAFONT7_HEIGHT, &x, &y, &w, &h);
-        switch(textAlign) {
-        case Align_Center: topBannerBufMain.setCursor(64-(w >> 1), 3+SEGAFONT7_HEIGHT); break;
-        case Align_Right:  topBannerBufMain.setCursor(128-w, 3+SEGAFONT7_HEIGHT);       break;
-        default: break;
-        }
-        break;
+    BannerTextRender(topBannerBufMain, banner.mainText, banner.mainAlign);
+
+    topBannMirrored = !banner.hasSub;
+    if(topBannMirrored) memcpy(topBannerBufSub->getBuffer(), topBannerBufMain->getBuffer(), ((topBannerBufMain->width()+7) >> 3) * topBannerBufMain->height());
+    else BannerTextRender(topBannerBufSub, banner.subText, banner.subAlign);
+
+    // reset slide animation state, and copy from banner canvas to display render buffer
+    topBannX = 0;
+    BannerBlit();
+    BannerSlideQueue();
+    ui.BannerDrawn();
+}
+
+void DeckDisplay::BannerBlit()
+{
+    display->fillRect(0, 0, 128, 15, BLACK);
+    if(topBannX) display->drawBitmap(topBannX-128, 0, topBannerBufSub->getBuffer(), topBannerBufSub->width(), topBannerBufSub->height(), WHITE);
+    display->drawBitmap(topBannX, 0, topBannerBufMain->getBuffer(), topBannerBufMain->width(), topBannerBufMain->height(), WHITE);
+
+    // banner covers wherever a status glyph was
+    ui.drawn.status = DeckUI::Glyph_None;
+    // mark that banner's been updated
+    topBannUpdated = true;
+}
+
+void DeckDisplay::BannerSlideQueue()
+{
+    if(!animationsOn) return;
+    anim.Start(DeckAnim::Anim_BannerSlide, 0, 128, OLED_SCROLL_TIME, millis(), DeckAnim::Tween_Linear, false, OLED_SCROLL_INTERVAL);
+}
+
+void DeckDisplay::BannerTextRender(GFXcanvas1 *canvas, const char *text, const uint8_t &align)
+{
+    int x = 0;
+    switch(align) {
+    case Align_Center: x = 64-(DeckText::TextWidth(text) >> 1); break;
+    case Align_Right:  x = 128-DeckText::TextWidth(text);       break;
+    default: break;
     }
+
+    canvas->fillScreen(BLACK);
+    DeckText::TextBlit(canvas->getBuffer(), (canvas->width()+7) >> 3, canvas->height(), x, 3+SEGAFONT7_HEIGHT, text);
+}
+
+void DeckDisplay::KeyRender(const int &cell)
+{
+    if(ui.KeyContentDirty(cell)) {
+        KeyContentRender(ui.model.keys[cell]);
+        KeySpriteRestart(cell, ui.model.keys[cell]);
+
+        // cache unpressed contents, so presses/releases are just an inverted blit
+        memcpy(keyBoxBitmaps[cell], keyBoxBuf.getBuffer(), sizeof(keyBoxBitmaps[cell]));
     }
-    topBannerBufMain.print(mainText);
-    
-    
-    if(subText == nullptr) memcpy(topBannerBufSub.getBuffer(), topBannerBufMain.getBuffer(), ((topBannerBufMain.width()+7) >> 3) * topBannerBufMain.height());
-    else {
-        topBannerBufSub.fillScreen(BLACK);
-        topBannerBufSub.setFont(&Sega7x7);
-        switch(subAlign) {
-        case Align_Left:
-            topBannerBufSub.setCursor(0, 3+SEGAFONT7_HEIGHT);
-            break;
-        case Align_Center:
-        case Align_Right:
-        {
-            int16_t x, y;
-            uint16_t w, h;
-            topBannerBufSub.getTextBounds(subText, 0, SEGAFONT7_HEIGHT, &x, &y, &w, &h);
-            switch(subAlign) {
-            case Align_Center: topBannerBufSub.setCursor(64-(w >> 1), 3+SEGAFONT7_HEIGHT); break;
-            case Align_Right:  topBannerBufSub.setCursor(128-w, 3+SEGAFONT7_HEIGHT);       break;
-            default: break;
+
+    ui.KeyDrawn(cell);
+    KeyBlit(cell);
+}
+
+void DeckDisplay::KeyContentRender(const DeckUI::KeyCell_t &key)
+{
+    keyBoxBuf.fillScreen(BLACK);
+    if(!key.binding) return;
+
+    if(key.icon != nullptr)
+        keyBoxBuf.drawBitmap(0, 0, DeckUI::KeyFrame(key) ? key.icon->ptr+KEYBM_FRAME_SIZE : key.icon->ptr, keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+    else if(DeckCommon::Prefs->keyPicNullptrToText) {
+        uint8_t *buf = keyBoxBuf.getBuffer();
+        const int stride = (OLED_KEY_BOX_WIDTH+7) >> 3;
+        if(key.binding & 0xFF00) {
+            // modifier glyphs live at 0x80-0x87, in the same bit order as the binding's high byte
+            char mods[9];
+            int m = 0;
+            for(int k = 0; k < 8; ++k)
+                if(key.binding & (0x0100 << k)) mods[m++] = (char)(0x80+k);
+            mods[m] = '\0';
+            DeckText::TextBlit(buf, stride, OLED_KEY_BOX_HEIGHT, 3, SEGAFONT7_HEIGHT, mods);
+
+            DeckText::LabelBlit(buf, stride, OLED_KEY_BOX_HEIGHT, 7, SEGAFONT7_HEIGHT+1+SEGAFONT7_HEIGHT, key.binding & 0xFF);
+        } else DeckText::LabelBlit(buf, stride, OLED_KEY_BOX_HEIGHT, 4, 4+SEGAFONT7_HEIGHT, key.binding & 0xFF);
+    }
+}
+
+void DeckDisplay::KeySpriteRestart(const int &cell, const DeckUI::KeyCell_t &key)
+{
+    // animations always (re)start from their first frame
+    if(key.binding && key.icon != nullptr && key.icon->sprite != nullptr) {
+        spriteFrame[cell] = 0;
+        spriteNext[cell] = millis() + key.icon->sprite->frames[0].duration;
+    }
+}
+
+void DeckDisplay::KeyBlit(const int &cell)
+{
+    const DeckUI::KeyCell_t &key = ui.drawn.keys[cell];
+
+    // only bound keys with a pixmap (or text fallback) have anything to highlight
+    const bool hasContents = key.icon != nullptr || DeckCommon::Prefs->keyPicNullptrToText;
+
+    memcpy(keyBoxBuf.getBuffer(), keyBoxBitmaps[cell], sizeof(keyBoxBitmaps[cell]));
+    if(key.pressed && hasContents) {
+        uint8_t *buf = keyBoxBuf.getBuffer();
+        for(int p = 0; p < (int)sizeof(keyBoxBitmaps[cell]); ++p)
+            buf[p] = ~buf[p];
+    }
+
+    const int xOffset = 32*(cell % OLED_KEYS_COLUMNS) + keysSlideX;
+    const int yOffset = 16+(16*(cell / OLED_KEYS_COLUMNS));
+
+    display->fillRect(xOffset, yOffset, keyBoxBuf.width(), keyBoxBuf.height(), BLACK);
+    display->drawBitmap(xOffset, yOffset, keyBoxBuf.getBuffer(), keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+
+    if(panels != nullptr)
+        panels->KeyDraw(cell, keyBoxBitmaps[cell], key.pressed && hasContents);
+
+    screenUpdated = true;
+}
+
+void DeckDisplay::KeyRowsBlit(const int &cell, const uint16_t &rows)
+{
+    const DeckUI::KeyCell_t &key = ui.drawn.keys[cell];
+    const bool inverted = key.pressed && (key.icon != nullptr || DeckCommon::Prefs->keyPicNullptrToText);
+
+    const int xOffset = 32*(cell % OLED_KEYS_COLUMNS) + keysSlideX;
+    const int yOffset = 16+(16*(cell / OLED_KEYS_COLUMNS));
+
+    // blit each run of consecutive changed rows in one go
+    for(int r = 0; r < OLED_KEY_BOX_HEIGHT; ++r) {
+        if(!(rows & (1 << r))) continue;
+
+        int runEnd = r;
+        while(runEnd+1 < OLED_KEY_BOX_HEIGHT && (rows & (1 << (runEnd+1)))) ++runEnd;
+
+        uint8_t *buf = keyBoxBuf.getBuffer();
+        const int runBytes = (runEnd - r + 1) * KEYBM_ROW_BYTES;
+        memcpy(buf, keyBoxBitmaps[cell] + r * KEYBM_ROW_BYTES, runBytes);
+        if(inverted)
+            for(int p = 0; p < runBytes; ++p)
+                buf[p] = ~buf[p];
+
+        display->fillRect(xOffset, yOffset+r, OLED_KEY_BOX_WIDTH, runEnd - r + 1, BLACK);
+        display->drawBitmap(xOffset, yOffset+r, buf, OLED_KEY_BOX_WIDTH, runEnd - r + 1, WHITE);
+
+        r = runEnd;
+    }
+
+    if(panels != nullptr)
+        panels->KeyDraw(cell, keyBoxBitmaps[cell], inverted);
+
+    screenUpdated = true;
+}
+
+uint16_t DeckDisplay::SpriteFrameApply(const int &cell, const KeySpriteFrame_t &frame)
+{
+    uint16_t rows = 0;
+    uint8_t *bmp = keyBoxBitmaps[cell];
+
+    if(!frame.deltaRows) {
+        // full frame, but still only take (and later blit) rows that differ
+        for(int r = 0; r < OLED_KEY_BOX_HEIGHT; ++r) {
+            if(memcmp(bmp + r * KEYBM_ROW_BYTES, frame.data + r * KEYBM_ROW_BYTES, KEYBM_ROW_BYTES)) {
+                memcpy(bmp + r * KEYBM_ROW_BYTES, frame.data + r * KEYBM_ROW_BYTES, KEYBM_ROW_BYTES);
+                rows |= 1 << r;
             }
-            break;
         }
+    } else {
+        const uint8_t *rec = frame.data;
+        for(int d = 0; d < frame.deltaRows; ++d, rec += 1 + KEYBM_ROW_BYTES) {
+            if(rec[0] >= OLED_KEY_BOX_HEIGHT) continue;
+            memcpy(bmp + rec[0] * KEYBM_ROW_BYTES, rec + 1, KEYBM_ROW_BYTES);
+            rows |= 1 << rec[0];
         }
-        topBannerBufSub.print(subText);
     }
 
-    // draw header line in display buffer if not there
-    if(!display->getPixel(0, 15)) display->drawFastHLine(0, 15, 128, WHITE);
-    // copy from banner canvas to display render buffer
-    display->drawBitmap(0, 0, topBannerBufMain.getBuffer(), topBannerBufMain.width(), topBannerBufMain.height(), WHITE);
+    return rows;
+}
 
-    // mark that banner's been updated
+void DeckDisplay::SpritesUpdate(const unsigned long &now)
+{
+    int rowsLeft = OLED_SPRITE_ROWS_BUDGET;
+
+    for(int n = 0; n < UI_KEY_CELLS; ++n) {
+        const int cell = (spriteStartCell + n) % UI_KEY_CELLS;
+        const DeckUI::KeyCell_t &key = ui.drawn.keys[cell];
+        if(!key.binding || key.icon == nullptr || key.icon->sprite == nullptr ||
+           (long)(now - spriteNext[cell]) < 0) continue;
+
+        if(rowsLeft <= 0) {
+            // out of budget, this key's first in line next frame (and catches up on what it missed then)
+            spriteStartCell = cell;
+            DeckStats::Count(DeckStats::Count_SpritesDeferred);
+            return;
+        }
+
+        // deltas have to be applied in order, so catch up on every frame that's come due - but blit only once
+        const KeySprite_t *sprite = key.icon->sprite;
+        uint16_t rows = 0;
+        for(int f = 0; f < sprite->count && (long)(now - spriteNext[cell]) >= 0; ++f) {
+            spriteFrame[cell] = (spriteFrame[cell] + 1) % sprite->count;
+            rows |= SpriteFrameApply(cell, sprite->frames[spriteFrame[cell]]);
+            spriteNext[cell] += sprite->frames[spriteFrame[cell]].duration ? sprite->frames[spriteFrame[cell]].duration : 1;
+        }
+        // more than a whole loop behind, don't bother catching up on the rest
+        if((long)(now - spriteNext[cell]) >= 0)
+            spriteNext[cell] = now + sprite->frames[spriteFrame[cell]].duration;
+
+        if(rows) {
+            KeyRowsBlit(cell, rows);
+            rowsLeft -= __builtin_popcount(rows);
+        }
+    }
+
+    spriteStartCell = 0;
+}
+
+void DeckDisplay::KeysBlit()
+{
+    display->fillRect(0, 16, 128, 48, BLACK);
+
+    for(int i = 0; i < UI_KEY_CELLS; ++i)
+        KeyBlit(i);
+
+    if(ui.drawn.separators & DeckUI::Sep_KeysRightCol)
+        display->drawFastVLine(95+keysSlideX, 16, 48, WHITE);
+
+    screenUpdated = true;
+}
+
+void DeckDisplay::StatusRender()
+{
+    display->fillRect(128-SAVEGLYPH_WIDTH, 0, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, BLACK);
+
+    switch(ui.model.status) {
+    case DeckUI::Glyph_None:
+        // clear dangling save glyph (and rerender top panel text)
+        BannerBlit();
+        break;
+    case DeckUI::Glyph_Saving:
+        display->drawBitmap(128-SAVEGLYPH_WIDTH, 0, saveGlyph, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, WHITE);
+        break;
+    case DeckUI::Glyph_SaveSuccess:
+        display->drawBitmap(128-SAVEGLYPH_WIDTH, 0, saveSuccessGlyph, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, WHITE);
+        break;
+    default: break;
+    }
+
+    ui.drawn.status = ui.model.status;
     topBannUpdated = true;
-    // reset slide animation state
-    topBannX = 0;
-    topBannScrolling = false;
-    lastScrollTimestamp = millis();
+}
+
+void DeckDisplay::Render()
+{
+    if(ui.BannerDirty()) BannerRender();
+
+    if(ui.model.separators != ui.drawn.separators) {
+        const uint8_t changed = ui.model.separators ^ ui.drawn.separators;
+        if(changed & DeckUI::Sep_HeaderLine) {
+            display->drawFastHLine(0, 15, 128, (ui.model.separators & DeckUI::Sep_HeaderLine) ? WHITE : BLACK);
+            topBannUpdated = true;
+        }
+        if(changed & DeckUI::Sep_KeysRightCol) {
+            display->drawFastVLine(95, 16, 48, (ui.model.separators & DeckUI::Sep_KeysRightCol) ? WHITE : BLACK);
+            screenUpdated = true;
+        }
+        ui.drawn.separators = ui.model.separators;
+    }
+
+    for(int i = 0; i < UI_KEY_CELLS; ++i)
+        if(ui.KeyDirty(i)) KeyRender(i);
+
+    if(ui.model.status != ui.drawn.status) StatusRender();
 }
 
 void DeckDisplay::ScreenModeChange(const ScreenMode_e &screenMode)
 {
+    if(topBannHWScrolling) {
+        BusClaim();
+        display->stopScroll();
+        topBannHWScrolling = false;
+    }
+
+    display->flushWait();
     display->fillScreen(BLACK);
+    ui.Invalidate();
+    anim.Stop(DeckAnim::Anim_PageSlide);
+    keysSlideX = 0;
 
-    idleTimestamp = millis();
     if(screenState != screenMode) {
         screenState = screenMode;
 
         switch(screenMode) {
             case Screen_Default:
+                // show the page as-is, no sliding in
+                lastPage = DeckCommon::Prefs->curPage;
                 PageUpdate(DeckCommon::Prefs->curPage);
+                Render();
                 break;
             /*
             case Screen_Saving:
@@ -161,163 +437,253 @@ void DeckDisplay::ScreenModeChange(const ScreenMode_e &screenMode)
             default: break;
         }
 
+        BusClaim();
         display->display();
+        DeckBoot::Mark(DeckBoot::Boot_FirstFrame);
         screenUpdated = false;
         topBannUpdated = false;
         // constitutes a wakeup
-        if(oledDimmed) display->dim(false);
-        oledDimmed = false;
-        timeoutTimestamp = millis();
+        Wake();
     }
 }
 
-void DeckDisplay::IdleOps()
+void DeckDisplay::Wake()
 {
-    if(millis() - idleTimestamp > OLED_IDLE_INTERVAL) {
-        idleTimestamp = millis();
+    if(oledOff) {
+        BusClaim();
+        display->power(true);
+        oledOff = false;
+    }
+    if(oledDimmed) {
+        anim.Stop(DeckAnim::Anim_Fade);
+        BusClaim();
+        display->dim(false);
+    }
+    oledDimmed = false;
+}
 
-        switch(screenState) {
-        case Screen_Default:
-            if(topBannScrolling) TopPanelScroll();
-            else if(millis() - lastScrollTimestamp > OLED_SCROLL_INTERVAL) {
-                topBannScrolling = true;
-                TopPanelScroll();
-            }
-            break;
-        default: break;
-        }
+void DeckDisplay::TierSet(const DeckGovernor::Tier_e &tier)
+{
+    const DeckGovernor::Tier_t &settings = DeckGovernor::Tiers[tier];
+    const unsigned long now = millis();
+    anim.Interval(settings.frameInterval, now);
 
-        if(saving) {
-            if(saveResult == DeckPrefs::Error_None) {
-                if(topBannUpdated) {
-                    // clear space out for save glyph so it overlays previous contents
-                    display->fillRect(128-SAVEGLYPH_WIDTH, 0, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, BLACK);
-                    display->drawBitmap(128-SAVEGLYPH_WIDTH, 0, saveGlyph, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, WHITE);
-                }
-            } else {
-                if(millis() - saveResultTimestamp > OLED_SAVING_TIME) {
-                    saving = false;
-                    if(!topBannUpdated) {
-                        // clear dangling save glyph since it's finished (and rerender top panel text)
-                        display->fillRect(128-SAVEGLYPH_WIDTH, 0, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, BLACK);
-                        display->drawBitmap(0, 0, topBannerBufMain.getBuffer(), topBannerBufMain.width(), topBannerBufMain.height(), WHITE);
-                        screenUpdated = true;
-                        topBannUpdated = true;
-                    }
-                } else if(topBannUpdated) {
-                    // make sure save glyph is overlayed atop any previously rendered contents
-                    display->fillRect(128-SAVEGLYPH_WIDTH, 0, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, BLACK);
-                    switch(saveResult) {
-                        case DeckPrefs::Error_Success:
-                            display->drawBitmap(128-SAVEGLYPH_WIDTH, 0, saveSuccessGlyph, SAVEGLYPH_WIDTH, SAVEGLYPH_HEIGHT, WHITE);
-                            break;
-                        default: break;
-                    }
-                }
+    if(settings.animations != animationsOn) {
+        animationsOn = settings.animations;
+        if(animationsOn) BannerSlideQueue();
+        else {
+            // banner goes back to rest, rather than freezing mid-slide
+            anim.Stop(DeckAnim::Anim_BannerSlide);
+            if(topBannHWScrolling) TopPanelScrollStop();
+            else if(topBannX) {
+                topBannX = 0;
+                BannerBlit();
             }
         }
+    }
 
-        if(screenUpdated) {
-            display->display();
-            screenUpdated = false;
-            topBannUpdated = false;
-        }
+    if(tier < DeckGovernor::Tier_Dimmed) Wake();
+    else if(!oledDimmed) {
+        anim.Start(DeckAnim::Anim_Fade, display->contrastMax(), display->contrastDim(), OLED_FADE_TIME, now);
+        oledDimmed = true;
+    }
 
-        if(!oledDimmed && millis() - timeoutTimestamp > OLED_TIMEOUT) {
-            display->dim(true);
-            oledDimmed = true;
-        }
+    if(tier >= DeckGovernor::Tier_Off && !oledOff) {
+        BusClaim();
+        display->power(false);
+        oledOff = true;
     }
 }
 
-void DeckDisplay::TopPanelScroll()
+void DeckDisplay::IdleOps()
 {
-    //display->fillRect(0, 3, 128, SEGAFONT7_HEIGHT, BLACK);
-    display->fillRect(0, 0, 128, 15, BLACK);
+    // panel transfers run off DMA, so keep their queues moving every pass rather than once a frame
+    if(panels != nullptr)
+        panels->Service();
+
+    const unsigned long now = millis();
+    if(!anim.FrameDue(now)) {
+        // spare time between frames goes to loading the pages either side of this one, one page per pass
+        if(pages->PrefetchStep()) return;
+        quiet = display->flushDone();
+        return;
+    }
+    quiet = false;
+    const unsigned long frameStart = micros();
+    DeckLog::Event(DeckLog::Log_FrameStart);
+
+    // an SPI push from the last frame may still be reading the render buffer
+    display->flushWait();
+
+    // everything due this tick gets applied to the render buffer first, then flushed once
+    uint32_t changed = anim.Tick(now);
+
+    if(saving) {
+        if(saveResult == DeckPrefs::Error_None)
+            ui.model.status = anim.Value(DeckAnim::Anim_Blink) ? DeckUI::Glyph_None : DeckUI::Glyph_Saving;
+        else if(anim.finished & (1 << DeckAnim::Anim_StatusHold)) {
+            saving = false;
+            ui.model.status = DeckUI::Glyph_None;
+        } else ui.model.status = (saveResult == DeckPrefs::Error_Success) ? DeckUI::Glyph_SaveSuccess : DeckUI::Glyph_SaveError;
+    }
 
-    if(topBannX >= 128) {
-        // scrolling has finished
-        topBannX = 0;
-        topBannScrolling = false;
-        lastScrollTimestamp = millis();
-        // swap sub and main bitmaps
-        memcpy(topBannerBackupBitmap, topBannerBufMain.getBuffer(), sizeof(topBannerBackupBitmap));
-        memcpy(topBannerBufMain.getBuffer(), topBannerBufSub.getBuffer(), sizeof(topBannerBackupBitmap));
-        memcpy(topBannerBufSub.getBuffer(), topBannerBackupBitmap, sizeof(topBannerBackupBitmap));
-    } else display->drawBitmap(topBannX-128, 0, topBannerBufSub.getBuffer(), topBannerBufSub.width(), topBannerBufSub.height(), WHITE);
+    // anything about to be drawn means the controller's rotation has to be halted first
+    // (and not started again this frame, with the slide it was part of requeued for later)
+    if(topBannHWScrolling && (saving || ui.Dirty() || anim.Active(DeckAnim::Anim_PageSlide))) {
+        TopPanelScrollStop();
+        changed &= ~(1 << DeckAnim::Anim_BannerSlide);
+    }
 
-    display->drawBitmap(topBannX++, 0, topBannerBufMain.getBuffer(), topBannerBufMain.width(), topBannerBufMain.height(), WHITE);
+    switch(screenState) {
+    case Screen_Default:
+        if(changed & (1 << DeckAnim::Anim_BannerSlide)) {
+            if(topBannHWScrolling) {
+                if(anim.finished & (1 << DeckAnim::Anim_BannerSlide)) TopPanelScrollStop();
+            } else if(!topBannX && topBannMirrored && !saving && display->hwScrollSupported() &&
+                      !(anim.finished & (1 << DeckAnim::Anim_BannerSlide))) {
+                // banner only rotates back around to itself, so let the controller do the stepping
+                BusClaim();
+                display->startScrollRight(0, 1);
+                topBannHWScrolling = true;
+            } else TopPanelScroll();
+        }
 
-    screenUpdated = true;
-    topBannUpdated = true;
-}
+        if(changed & (1 << DeckAnim::Anim_PageSlide)) {
+            keysSlideX = anim.Value(DeckAnim::Anim_PageSlide);
+            KeysBlit();
+        }
+        break;
+    default: break;
+    }
 
-void DeckDisplay::ButtonsUpdate(const uint32_t &btnsMap, const bool &isReleased)
-{
-    for(int i = 0, b = 0, x = 0, y = 0; b < (int)ButtonCount; ++b) {
-        if(LightgunButtons::ButtonDesc[b].keys.at(0) < LightgunButtons::LGB_PAGEKEYS) continue;
+    if(changed & (1 << DeckAnim::Anim_Fade)) {
+        BusClaim();
+        display->setContrast(anim.Value(DeckAnim::Anim_Fade));
+    }
 
-        // invert btn bitmap to match state (if not already matching)
-        // check top-leftmost pixel - on = pressed previously, off = wasn't pressed
-        if(btnsMap & (1 << b)) {
-            if(keyPics[i][DeckCommon::Prefs->curPage] != nullptr) {
-                // flip perpetual status of this button's icon
-                if(!isReleased && keyPics[i][DeckCommon::Prefs->curPage]->isPacked)
-                    keyBoxesPushedStatus[i][DeckCommon::Prefs->curPage] = !keyBoxesPushedStatus[i][DeckCommon::Prefs->curPage];
+    // whatever's changed in the UI model, plus status glyph (if any) atop whatever the banner last drew
+    const unsigned long renderStart = micros();
+    Render();
+    DeckStats::Sample(DeckStats::Stage_Render, micros() - renderStart);
 
-                if(( isReleased && keyBoxBitmaps[i][0] != keyPics[i][DeckCommon::Prefs->curPage]->ptr[0]) ||
-                   (!isReleased && keyBoxBitmaps[i][0] == keyPics[i][DeckCommon::Prefs->curPage]->ptr[0])) {
-                    for(int p = 0; p < (int)sizeof(keyBoxBitmaps[i]); ++p)
-                        keyBoxBitmaps[i][p] = ~keyBoxBitmaps[i][p];
+    if(screenState == Screen_Default && animationsOn)
+        SpritesUpdate(now);
 
-                    int xOffset = 32*x;
-                    int yOffset = 16+(16*y);
+    if(screenUpdated) {
+        DeckLog::Event(DeckLog::Log_Push, 0x0007);
+        const unsigned long flushStart = micros();
+        BusClaim();
+        display->display();
+        DeckStats::Sample(DeckStats::Stage_Flush, micros() - flushStart);
+        DeckStats::Count(DeckStats::Count_FlushBytes, display->pushedBytes);
+        DeckBoot::Mark(DeckBoot::Boot_FirstFrame);
+        screenUpdated = false;
+        topBannUpdated = false;
+    } else if(topBannUpdated) {
+        DeckLog::Event(DeckLog::Log_Push, 0x0001);
+        const unsigned long flushStart = micros();
+        BusClaim();
+        // banner occupies the top two pages (rows 0-15), no need to push the keys grid with it
+        display->displayPages(0, 1);
+        DeckStats::Sample(DeckStats::Stage_Flush, micros() - flushStart);
+        DeckStats::Count(DeckStats::Count_FlushBytes, display->pushedBytes);
+        topBannUpdated = false;
+    }
 
-                    display->fillRect(xOffset, yOffset, keyBoxBuf.width(), keyBoxBuf.height(), BLACK);
-                    display->drawBitmap(xOffset, yOffset, keyBoxBitmaps[i], keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+    const unsigned long workTime = micros() - frameStart;
+    DeckLog::Event(DeckLog::Log_FrameEnd, std::min(workTime, 0xFFFFUL));
+    DeckStats::Sample(DeckStats::Stage_Frame, workTime);
 
-                    screenUpdated = true;
-                }
+    const uint32_t dropped = anim.framesDropped;
+    const uint32_t overBudget = anim.framesOverBudget;
+    anim.FrameDone(millis(), workTime);
+    DeckStats::Count(DeckStats::Count_FramesDropped, anim.framesDropped - dropped);
+    DeckStats::Count(DeckStats::Count_FramesOverBudget, anim.framesOverBudget - overBudget);
+}
 
-                if(isReleased && keyPics[i][DeckCommon::Prefs->curPage]->isPacked) {
-                    if(  memcmp(keyBoxBitmaps[i], keyPics[i][DeckCommon::Prefs->curPage]->ptr,    sizeof(keyBoxBitmaps[0])))
-                         memcpy(keyBoxBitmaps[i], keyPics[i][DeckCommon::Prefs->curPage]->ptr,    sizeof(keyBoxBitmaps[0]));
-                    else memcpy(keyBoxBitmaps[i], keyPics[i][DeckCommon::Prefs->curPage]->ptr+64, sizeof(keyBoxBitmaps[0]));
+unsigned long DeckDisplay::IdleWait(const unsigned long &now) const
+{
+    if(!quiet || (panels != nullptr && !panels->Idle())) return 0;
+
+    // tracks keep frames coming while they run; otherwise it's only a change still to draw,
+    // or an animated key icon's next frame - anything else new arrives over the FIFO, which wakes this core anyway
+    unsigned long wait = anim.FrameWait(now);
+    if(ui.Dirty() || screenUpdated || topBannUpdated) return anim.FrameIn(now);
+
+    if(screenState == Screen_Default && animationsOn) {
+        for(int cell = 0; cell < UI_KEY_CELLS; ++cell) {
+            const DeckUI::KeyCell_t &key = ui.drawn.keys[cell];
+            if(!key.binding || key.icon == nullptr || key.icon->sprite == nullptr) continue;
+            const unsigned long spriteWait = (long)(spriteNext[cell] - now) > 0 ? spriteNext[cell] - now : 0;
+            wait = std::min(wait, std::max(spriteWait, anim.FrameIn(now)));
+        }
+    }
+    return wait;
+}
 
-                    int xOffset = 32*x;
-                    int yOffset = 16+(16*y);
+void DeckDisplay::BusClaim()
+{
+    // main display's driver talks to the bus directly, so panel DMA sharing it has to step aside first
+    if(panels != nullptr)
+        panels->BusRelease(display->wire);
+}
 
-                    display->fillRect(xOffset, yOffset, keyBoxBuf.width(), keyBoxBuf.height(), BLACK);
-                    display->drawBitmap(xOffset, yOffset, keyBoxBitmaps[i], keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+void DeckDisplay::TopPanelScroll()
+{
+    if(anim.finished & (1 << DeckAnim::Anim_BannerSlide)) {
+        // scrolling has finished, swap sub and main bitmaps
+        topBannX = 0;
+        std::swap(topBannerBufMain, topBannerBufSub);
+        BannerSlideQueue();
+    } else topBannX = anim.Value(DeckAnim::Anim_BannerSlide);
+
+    BannerBlit();
+}
+
+void DeckDisplay::TopPanelScrollStop()
+{
+    BusClaim();
+    display->stopScroll();
+    topBannHWScrolling = false;
 
-                    screenUpdated = true;
-                }
-            } else if(DeckCommon::Prefs->keyPicNullptrToText && ((isReleased && (keyBoxBitmaps[i][0] & 1)) || (!isReleased && !(keyBoxBitmaps[i][0] & 1)))) {
-                for(int p = 0; p < (int)sizeof(keyBoxBitmaps[i]); ++p)
-                    keyBoxBitmaps[i][p] = ~keyBoxBitmaps[i][p];
+    // controller RAM is left rotated by some arbitrary amount, so rerender the banner at rest
+    topBannX = 0;
+    BannerBlit();
+    BannerSlideQueue();
+}
 
-                int xOffset = 32*x;
-                int yOffset = 16+(16*y);
+void DeckDisplay::ButtonsUpdate(const uint32_t &btnsMap, const bool &isReleased)
+{
+    for(int i = 0, b = 0; b < (int)ButtonCount; ++b) {
+        // cells are laid out from the shown pages' keymap, which is another than Core0's partway through a switch
+        if(DeckCommon::PageKey(pages->Profile(), b)) continue;
 
-                display->fillRect(xOffset, yOffset, keyBoxBuf.width(), keyBoxBuf.height(), BLACK);
-                display->drawBitmap(xOffset, yOffset, keyBoxBitmaps[i], keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+        if(btnsMap & (1 << b)) {
+            DeckUI::KeyCell_t &key = ui.model.keys[i];
 
-                screenUpdated = true;
+            // flip perpetual status of this button's icon (Core0 saves it once it's heard)
+            if(!isReleased && KeyToggles(i)) {
+                key.toggled = !key.toggled;
+                if(!replaying) togglesPending[lastPage] ^= 1 << i;
             }
+
+            key.pressed = !isReleased;
         }
 
         ++i;
-        // increment/loop around current row and column for next btn
-        if(x < 3) ++x;
-        else {
-            x = 0;
-            ++y;
-        }
     }
+
+    // drawn on the next frame
     // constitutes a wakeup
-    if(oledDimmed) display->dim(false);
-    oledDimmed = false;
-    timeoutTimestamp = millis();
+    Wake();
+}
+
+bool DeckDisplay::KeyToggles(const int &cell)
+{
+    // only the first pages' toggles are kept
+    const DeckUI::KeyCell_t &key = ui.model.keys[cell];
+    return key.icon != nullptr && key.icon->isPacked && lastPage < PREFS_TOGGLE_PAGES &&
+           (pages->Get(lastPage).toggles & (1 << cell));
 }
 
 void DeckDisplay::PageUpdate(const uint32_t &page)
@@ -325,68 +691,115 @@ void DeckDisplay::PageUpdate(const uint32_t &page)
     // reject page num if over amount of pages
     if(page >= (uint)DeckCommon::pagesCount) return;
 
-    display->fillScreen(BLACK);
-
-    char pageStr[40];
-    if(DeckCommon::Prefs->pages.size() > page && DeckCommon::Prefs->pages.at(page).name[0] != 0)
-         sprintf(pageStr, "Page %d: %s", (int8_t)page+1, DeckCommon::Prefs->pages.at(page).name);
-    else sprintf(pageStr, "Page %d", (int8_t)page+1);
+    const uint32_t misses = pages->misses;
+    const unsigned long loadStart = micros();
+    const DeckPages::Page_t &resident = pages->Get(page);
+    DeckStats::Sample(DeckStats::Stage_PageLoad, micros() - loadStart);
+    DeckStats::Count(DeckStats::Count_PageMisses, pages->misses - misses);
+    // neighbours get loaded in between frames, so the next flip either way is already resident
+    pages->PrefetchAround(page, DeckCommon::pagesCount);
+
+    // room for the longest name after any page number
+    char pageStr[48];
+    const DeckPrefs::Pages_t *pageInfo = resident.info;
+    if(pageInfo != nullptr && pageInfo->name[0] != 0)
+         snprintf(pageStr, sizeof(pageStr), "Page %d: %.23s", (int)page+1, pageInfo->name);
+    else snprintf(pageStr, sizeof(pageStr), "Page %d", (int)page+1);
 
     if(page == (uint)DeckCommon::pagesCount-1)
-         TopPanelUpdate(pageStr, Align_Center, "<-Prev Page", Align_Left);
+         ui.SetBanner(pageStr, Align_Center, "<-Prev Page", Align_Left);
     else if(!page)
-         TopPanelUpdate(pageStr, Align_Center, "Next Page ->", Align_Right);
-    else TopPanelUpdate(pageStr, Align_Center, "<-Prev        Next->", Align_Center);
-
-    //display->drawFastVLine(31, 16, 48, WHITE);
-    //display->drawFastVLine(63, 16, 48, WHITE);
-    display->drawFastVLine(95, 16, 48, WHITE);
-    //display->drawFastHLine(0, 31, 128, WHITE);
-    //display->drawFastHLine(0, 47, 128, WHITE);
-
-    for(int i = 0, b = 0, x = 0, y = 0; b < (int)ButtonCount; ++b) {
-        if((LightgunButtons::ButtonDesc[b].keys.at(0) & 0xFF) < LightgunButtons::LGB_PAGEKEYS) continue;
-
-        keyBoxBuf.fillScreen(BLACK);
-
-        if(LightgunButtons::ButtonDesc[b].keys.size() > page && LightgunButtons::ButtonDesc[b].keys.at(page)) {
-            if(keyPics[i][page] != nullptr) {
-                keyBoxBuf.drawBitmap(0, 0, keyBoxesPushedStatus[i][page] ? keyPics[i][page]->ptr+64 : keyPics[i][page]->ptr, keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
-            } else if(DeckCommon::Prefs->keyPicNullptrToText) {
-                if(LightgunButtons::ButtonDesc[b].keys.at(page) & 0xFF00) {
-                    keyBoxBuf.setCursor(3, SEGAFONT7_HEIGHT);
-                    for(int k = 0; k < 8; ++k)
-                        if(LightgunButtons::ButtonDesc[b].keys.at(page) & (0x0100 << k)) keyBoxBuf.write((char)0x80+k);
-                    
-                    keyBoxBuf.setCursor(7, SEGAFONT7_HEIGHT+1+SEGAFONT7_HEIGHT);
-                } else keyBoxBuf.setCursor(4, 4+SEGAFONT7_HEIGHT);
-                keyBoxBuf.print(keyStrings[(LightgunButtons::ButtonDesc[b].keys.at(page) & 0xFF)-0x20]);
-            }
-        }
+         ui.SetBanner(pageStr, Align_Center, "Next Page ->", Align_Right);
+    else ui.SetBanner(pageStr, Align_Center, "<-Prev        Next->", Align_Center);
 
-        // copy finished canvas to this button's backbuffer
-        memcpy(keyBoxBitmaps[i], keyBoxBuf.getBuffer(), sizeof(keyBoxBitmaps[i]));
-        ++i;
+    ui.model.separators = DeckUI::Sep_HeaderLine | DeckUI::Sep_KeysRightCol;
 
-        int xOffset = 32*x;
-        int yOffset = 16+(16*y);
+    for(int i = 0; i < UI_KEY_CELLS; ++i) {
+        DeckUI::KeyCell_t &key = ui.model.keys[i];
+        key.binding = resident.codes[i];
+        key.icon = key.binding ? resident.icons[i] : nullptr;
+        key.toggled = DeckCommon::Prefs->KeyToggled(i, page);
+        key.pressed = false;
+    }
 
-        // render btn to display buffer
-        display->fillRect(xOffset, yOffset, keyBoxBuf.width(), keyBoxBuf.height(), BLACK);
-        display->drawBitmap(xOffset, yOffset, keyBoxBuf.getBuffer(), keyBoxBuf.width(), keyBoxBuf.height(), WHITE);
+    if(page != lastPage && DeckCommon::Prefs->pageSlide) {
+        // slide in from the side of the page key that was pressed
+        const bool forward = (page == lastPage+1) || (!page && lastPage == (uint)DeckCommon::pagesCount-1);
+        keysSlideX = forward ? 128 : -128;
+        anim.Start(DeckAnim::Anim_PageSlide, keysSlideX, 0, OLED_PAGESLIDE_TIME, millis(), DeckAnim::Tween_EaseOut);
+        display->flushWait();
+        display->fillRect(0, 16, 128, 48, BLACK);
+    }
+    lastPage = page;
 
-        if(x < 3) ++x;
-        else {
-            x = 0;
-            ++y;
+    // colour panels take on the page's colour for its keys
+    if(pageInfo != nullptr)
+        display->setTint(DeckTFT::Region_Keys, pageInfo->color);
+
+    // only cells that differ from the previous page get redrawn, on the next frame
+    // constitutes a wakeup
+    Wake();
+}
+
+void DeckDisplay::PagesReload(const uint32_t &page)
+{
+    pages->Invalidate();
+    // no sliding in, it's the same page with new contents
+    lastPage = page;
+    PageUpdate(page);
+}
+
+void DeckDisplay::ProfilePrepare(const DeckProfile *profile, const int &pagesCount, const int &page)
+{
+    shadowPages->Begin(&keyPics[0][0], OLED_KEYPICS_PAGES, profile);
+    const DeckPages::Page_t &resident = shadowPages->Get(page);
+    shadowPages->PrefetchAround(page, pagesCount);
+    while(shadowPages->PrefetchStep());
+
+    // keys as PageUpdate() will have them once swapped in, rendered into the shadow cache
+    for(int i = 0; i < UI_KEY_CELLS; ++i) {
+        DeckUI::KeyCell_t &key = shadowKeys[i];
+        key.binding = resident.codes[i];
+        key.icon = key.binding ? resident.icons[i] : nullptr;
+        key.toggled = DeckCommon::Prefs->KeyToggled(i, page);
+        key.pressed = false;
+
+        KeyContentRender(key);
+        memcpy(shadowBitmaps[i], keyBoxBuf.getBuffer(), sizeof(shadowBitmaps[i]));
+    }
+    shadowPage = page;
+}
+
+void DeckDisplay::ProfileSwap(const int &page)
+{
+    std::swap(pages, shadowPages);
+
+    // no sliding in, it's a different deck rather than the next page over
+    lastPage = page;
+    PageUpdate(page);
+
+    // keys rendered ahead of time only need blitting, unless something changed them since (e.g. a toggle)
+    if(shadowPage == page) {
+        for(int i = 0; i < UI_KEY_CELLS; ++i) {
+            const DeckUI::KeyCell_t &want = ui.model.keys[i];
+            const DeckUI::KeyCell_t &have = shadowKeys[i];
+            if(want.binding != have.binding || want.icon != have.icon || DeckUI::KeyFrame(want) != DeckUI::KeyFrame(have))
+                continue;
+
+            memcpy(keyBoxBitmaps[i], shadowBitmaps[i], sizeof(keyBoxBitmaps[i]));
+            KeySpriteRestart(i, want);
+            ui.KeyContentCached(i);
         }
     }
+    shadowPage = -1;
+}
 
-    screenUpdated = true;
-    // constitutes a wakeup
-    if(oledDimmed) display->dim(false);
-    oledDimmed = false;
-    timeoutTimestamp = millis();
+void DeckDisplay::Park()
+{
+    display->flushWait();
+    if(panels != nullptr)
+        panels->BusesSettle();
+    quiet = true;
 }
 
 void DeckDisplay::SaveUpdate(uint32_t save)
@@ -394,8 +807,191 @@ void DeckDisplay::SaveUpdate(uint32_t save)
     saving = true;
     if(save) {
         saveResult = (DeckPrefs::Errors_e)--save;
-        saveResultTimestamp = millis();
-    } else saveResult = DeckPrefs::Error_None;
-    topBannUpdated = true;
-    screenUpdated = true;
-}
\ No newline at end of file
+        anim.Stop(DeckAnim::Anim_Blink);
+        anim.Start(DeckAnim::Anim_StatusHold, 0, 1, OLED_SAVING_TIME, millis());
+    } else {
+        saveResult = DeckPrefs::Error_None;
+        anim.Start(DeckAnim::Anim_Blink, 0, 1, OLED_BLINK_TIME*2, millis(), DeckAnim::Tween_Step, true);
+    }
+}
+
+void DeckDisplay::PanelsAttach(DeckPanels *keyPanels)
+{
+    panels = keyPanels;
+    ui.Invalidate();
+}
+
+void DeckDisplay::RenderAudit(Print &out, const bool &images)
+{
+    if(screenState != Screen_Default) {
+        out.println("Render audit only runs on the default screen");
+        return;
+    }
+
+    char label[40];
+    unsigned long start;
+    const int shownPage = lastPage;
+
+    display->flushWait();
+    if(topBannHWScrolling) TopPanelScrollStop();
+
+    // keys have to be at rest, and pages put up without sliding in
+    anim.Stop(DeckAnim::Anim_PageSlide);
+    keysSlideX = 0;
+
+    for(int page = 0; page < DeckCommon::pagesCount; ++page) {
+        lastPage = page;
+        PageUpdate(page);
+        start = micros();
+        Render();
+        snprintf(label, sizeof(label), "p%d", page+1);
+        RenderAuditLine(out, label, micros() - start, images);
+
+        for(int i = 0, b = 0; b < (int)ButtonCount; ++b) {
+            if(DeckCommon::PageKey(pages->Profile(), b)) continue;
+
+            // presses are made on the cell's model directly and put back after, never through ButtonsUpdate(),
+            // so the audit can't flip a saved toggle or have one passed on to Core0
+            DeckUI::KeyCell_t &key = ui.model.keys[i];
+            const DeckUI::KeyCell_t atRest = key;
+            const bool toggles = KeyToggles(i);
+
+            // two-stage icons flip on each press, so go around twice to see both stages
+            const int rounds = (key.icon != nullptr && key.icon->isPacked) ? 2 : 1;
+            for(int r = 0; r < rounds; ++r) {
+                if(toggles) key.toggled = !key.toggled;
+                key.pressed = true;
+                start = micros();
+                Render();
+                snprintf(label, sizeof(label), "p%d k%d press%s", page+1, i+1, r ? "2" : "");
+                RenderAuditLine(out, label, micros() - start, images);
+
+                key.pressed = false;
+                start = micros();
+                Render();
+                snprintf(label, sizeof(label), "p%d k%d release%s", page+1, i+1, r ? "2" : "");
+                RenderAuditLine(out, label, micros() - start, images);
+            }
+
+            key = atRest;
+            ++i;
+        }
+
+        // banner halfway through sliding over to its sub text
+        topBannX = 64;
+        start = micros();
+        BannerBlit();
+        snprintf(label, sizeof(label), "p%d scroll", page+1);
+        RenderAuditLine(out, label, micros() - start, images);
+        topBannX = 0;
+        BannerBlit();
+    }
+
+    // back to whatever page was up, as it was; a page change meanwhile is still waiting in the FIFO
+    lastPage = shownPage;
+    PageUpdate(shownPage);
+}
+
+void DeckDisplay::FrameDump(Print &out)
+{
+    display->flushWait();
+    RenderAuditLine(out, "frame", 0, true);
+}
+
+void DeckDisplay::Bench(Print &out, const Bench_e &bench, const int &runs)
+{
+    if(screenState != Screen_Default || runs <= 0) return;
+    display->flushWait();
+
+    unsigned long slowest = 0;
+    // page loads go all over, so none of them are resident (xorshift, same sequence every run)
+    uint32_t seed = 2463534242;
+
+    const unsigned long start = micros();
+    for(int r = 0; r < runs; ++r) {
+        switch(bench) {
+        case Bench_Blit:
+            KeysBlit();
+            break;
+        case Bench_Display:
+            BusClaim();
+            display->display();
+            display->flushWait();
+            break;
+        case Bench_PageLoad:
+        {
+            seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+            pages->Invalidate();
+            const unsigned long loadStart = micros();
+            pages->Get(seed % DeckCommon::pagesCount);
+            slowest = std::max(slowest, micros() - loadStart);
+            break;
+        }
+        default: break;
+        }
+    }
+    const unsigned long elapsed = micros() - start;
+
+    static constexpr const char *names[BENCH_TYPES] = { "blit", "display", "pages" };
+    if(bench == Bench_PageLoad) {
+        out.printf("%s: %lu us avg, %lu us max over %d runs, %d pages\n", names[bench], elapsed / runs, slowest, runs, DeckCommon::pagesCount);
+        // whatever's up has to be resident again for the next key press
+        pages->Get(lastPage);
+        pages->PrefetchAround(lastPage, DeckCommon::pagesCount);
+    } else out.printf("%s: %lu us avg over %d runs\n", names[bench], elapsed / runs, runs);
+}
+
+uint32_t DeckDisplay::FrameHash()
+{
+    const uint8_t *buf = display->getBuffer();
+    // TFT canvas is a bit per pixel too, just row-major
+    const int size = display->width * ((display->height+7) >> 3);
+
+    uint32_t hash = 2166136261;
+    for(int i = 0; i < size; ++i)
+        hash = (hash ^ buf[i]) * 16777619;
+    return hash;
+}
+
+void DeckDisplay::ReplayBegin()
+{
+    replaying = true;
+}
+
+uint32_t DeckDisplay::ReplayEnd()
+{
+    replaying = false;
+
+    display->flushWait();
+    Render();
+    // banner at rest with its main text, however far along sliding it was
+    BannerRender();
+    Render();
+    const uint32_t hash = FrameHash();
+
+    // back to the saved toggles with nothing held, drawn on the next frame
+    PageUpdate(lastPage);
+    Wake();
+    return hash;
+}
+
+void DeckDisplay::RenderAuditLine(Print &out, const char *label, const unsigned long &renderTime, const bool &images)
+{
+    const uint8_t *buf = display->getBuffer();
+
+    out.printf("%s: %08lx %lu us\n", label, (unsigned long)FrameHash(), renderTime);
+    if(!images) return;
+
+    out.printf("P1\n# %s\n%d %d\n", label, display->width, display->height);
+    for(int y = 0; y < display->height; ++y) {
+        char row[256];
+        for(int x = 0; x < display->width; ++x) {
+            // TFT canvas is row-major, OLED buffers are in 8px-tall pages
+            const bool on = display->isTFT() ? buf[y * (display->width >> 3) + (x >> 3)] & (0x80 >> (x & 7))
+                                             : buf[(y >> 3) * display->width + x] & (1 << (y & 7));
+            row[x] = on ? '1' : '0';
+        }
+        row[display->width] = '\0';
+        out.println(row);
+    }
+}
@@ -10,16 +10,33 @@
 
 #include <stdint.h>
 #include <Wire.h>
+#include <SPI.h>
 #include <Adafruit_SSD1306.h>
 #include <Adafruit_SH110X.h>
 
 #include "PicoDeckDefines.h"
 #include "PicoDeckCommon.h"
+#include "PicoDeckUI.h"
+#include "PicoDeckAnim.h"
+#include "PicoDeckText.h"
+#include "PicoDeckTFT.h"
+#include "PicoDeckPages.h"
+#include "PicoDeckGovernor.h"
 #include "fontSega7x7.h"
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 
+// largest I2C transfer (incl. control byte) used for partial page pushes, matches Adafruit_SSD1306's WIRE_MAX
+#define OLED_WIRE_MAX 32
+// I2C clock the drivers push at, and drop back to afterwards (the Adafruit drivers' own default for in between)
+#define OLED_I2C_RATE 1000000
+#define OLED_I2C_RATE_AFTER 100000
+// SPI clock for the SPI variants, SSD1306/SH110X are rated for 10MHz but run fine well past it
+#define OLED_SPI_RATE 16000000
+// ST7789/ILI9341 are much quicker on the uptake
+#define TFT_SPI_RATE 40000000
+
 class Adafruit_MultiDisplay {
 public:
     enum ScreenType_e {
@@ -27,6 +44,11 @@ public:
         I2C_SSD1306 = 0,
         I2C_SH1106,
         I2C_SH1107,
+        SPI_SSD1306,
+        SPI_SH1106,
+        SPI_SH1107,
+        SPI_ST7789,
+        SPI_ILI9341,
         DISPLAY_TYPES_COUNT
     };
 
@@ -34,20 +56,73 @@ public:
     Adafruit_SSD1306 *display1306 = nullptr;
     Adafruit_SH1106G *display1106 = nullptr;
     Adafruit_SH1107 *display1107 = nullptr;
+    DeckTFT *displayTFT = nullptr;
+
+    // bus used by the display, kept for partial page pushes that bypass the full display() path
+    TwoWire *wire = nullptr;
+
+    // bus & control pins used by SPI variants, whose frames are pushed by DMA instead of the drivers' byte loops
+    SPIClass *spi = nullptr;
+    int8_t dcPin = -1;
+    int8_t csPin = -1;
+    uint32_t spiRate = OLED_SPI_RATE;
+    // set while a DMA push is still reading from the render buffer
+    bool spiPending = false;
+
+    // bytes the last display()/displayPages() sent: pages of the render buffer, or the RGB565 tiles a TFT streamed
+    uint32_t pushedBytes = 0;
+
+    // panel geometry & I2C address, the main display is always the default 128x64 @ 0x3C
+    uint8_t width = SCREEN_WIDTH;
+    uint8_t height = SCREEN_HEIGHT;
+    uint8_t address = 0x3C;
+
+    // I2C clock while pushing, and what the bus is left at after, as the driver was set up with
+    uint32_t i2cRate = OLED_I2C_RATE;
+    uint32_t i2cRateAfter = OLED_I2C_RATE_AFTER;
 
     // constructor
-    Adafruit_MultiDisplay(TwoWire *twi, const ScreenType_e &displayType)
-        : dispType(displayType)
+    Adafruit_MultiDisplay(TwoWire *twi, const ScreenType_e &displayType,
+                          const uint8_t &w = SCREEN_WIDTH, const uint8_t &h = SCREEN_HEIGHT, const uint8_t &addr = 0x3C,
+                          const uint32_t &clkDuring = OLED_I2C_RATE, const uint32_t &clkAfter = OLED_I2C_RATE_AFTER)
+        : dispType(displayType), wire(twi), width(w), height(h), address(addr), i2cRate(clkDuring), i2cRateAfter(clkAfter)
     {
         switch(displayType) {
         case I2C_SSD1306:
-            display1306 = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, twi, -1, 1000000);
+            display1306 = new Adafruit_SSD1306(w, h, twi, -1, clkDuring, clkAfter);
             break;
         case I2C_SH1106:
-            display1106 = new Adafruit_SH1106G(SCREEN_WIDTH, SCREEN_HEIGHT, twi, -1, 1000000);
+            display1106 = new Adafruit_SH1106G(w, h, twi, -1, clkDuring, clkAfter);
             break;
         case I2C_SH1107:
-            display1107 = new Adafruit_SH1107(SCREEN_WIDTH, SCREEN_HEIGHT, twi, -1, 1000000);
+            display1107 = new Adafruit_SH1107(w, h, twi, -1, clkDuring, clkAfter);
+            break;
+        default: break;
+        }
+    }
+
+    // constructor (SPI variants)
+    // panel size only applies to TFTs, which still render the same 128x64 layout - just scaled up & colourized
+    Adafruit_MultiDisplay(SPIClass *spiBus, const ScreenType_e &displayType, const int8_t &dc, const int8_t &rst, const int8_t &cs,
+                          const uint16_t &panelW = SCREEN_WIDTH, const uint16_t &panelH = SCREEN_HEIGHT, const uint32_t &bitrate = 0)
+        : dispType(displayType), spi(spiBus), dcPin(dc), csPin(cs)
+    {
+        spiRate = bitrate ? bitrate : (isTFT() ? TFT_SPI_RATE : OLED_SPI_RATE);
+        switch(displayType) {
+        case SPI_SSD1306:
+            display1306 = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, spiBus, dc, rst, cs, spiRate);
+            break;
+        case SPI_SH1106:
+            display1106 = new Adafruit_SH1106G(SCREEN_WIDTH, SCREEN_HEIGHT, spiBus, dc, rst, cs, spiRate);
+            break;
+        case SPI_SH1107:
+            display1107 = new Adafruit_SH1107(SCREEN_WIDTH, SCREEN_HEIGHT, spiBus, dc, rst, cs, spiRate);
+            break;
+        case SPI_ST7789:
+            displayTFT = new DeckTFT(spiBus, DeckTFT::TFT_ST7789, panelW, panelH, dc, rst, cs, spiRate);
+            break;
+        case SPI_ILI9341:
+            displayTFT = new DeckTFT(spiBus, DeckTFT::TFT_ILI9341, panelW, panelH, dc, rst, cs, spiRate);
             break;
         default: break;
         }
@@ -55,10 +130,16 @@ public:
 
     // destructor: cleanup
     ~Adafruit_MultiDisplay() {
+        flushWait();
         switch(dispType) {
-        case I2C_SSD1306: delete display1306; break;
-        case I2C_SH1106: delete display1106; break;
-        case I2C_SH1107: delete display1107; break;
+        case I2C_SSD1306:
+        case SPI_SSD1306: delete display1306; break;
+        case I2C_SH1106:
+        case SPI_SH1106: delete display1106; break;
+        case I2C_SH1107:
+        case SPI_SH1107: delete display1107; break;
+        case SPI_ST7789:
+        case SPI_ILI9341: delete displayTFT; break;
         default: break;
         }
     }
@@ -66,11 +147,17 @@ public:
     bool begin() {
         switch(dispType) {
             case I2C_SSD1306:
-                return display1306->begin(SSD1306_SWITCHCAPVCC, 0x3C);
+            case SPI_SSD1306:
+                return display1306->begin(SSD1306_SWITCHCAPVCC, address);
             case I2C_SH1106:
-                return display1106->begin();
+            case SPI_SH1106:
+                return display1106->begin(address);
             case I2C_SH1107:
-                return display1107->begin();
+            case SPI_SH1107:
+                return display1107->begin(address);
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                return displayTFT->Begin();
             default: return false;
         }
     }
@@ -79,7 +166,10 @@ public:
         #ifdef SERIAL_DEBUG
         unsigned long preDispTS = millis();
         #endif // SERIAL_DEBUG
-        switch(dispType) {
+        pushedBytes = width * (height >> 3);
+        if(isTFT()) pushedBytes = displayTFT->Flush(0, (height >> 3) - 1);
+        else if(isSPI()) spiFlush(0, (height >> 3) - 1);
+        else switch(dispType) {
             case I2C_SSD1306:
                 display1306->display(); break;
             case I2C_SH1106:
@@ -93,14 +183,241 @@ public:
         #endif // SERIAL_DEBUG
     }
 
+    /// @brief Pushes only the given range of 8px-tall pages from the render buffer
+    /// @details SSD1306's display() always sends the whole 1KB frame, so it gets its own addressed transfer here;
+    /// SH110X (GrayOLED) already tracks a dirty window and only sends the pages that were drawn to.
+    void displayPages(const uint8_t &first, const uint8_t &last) {
+        pushedBytes = width * (last - first + 1);
+        if(isTFT()) {
+            pushedBytes = displayTFT->Flush(first, last);
+            return;
+        } else if(isSPI()) {
+            spiFlush(first, last);
+            return;
+        }
+
+        switch(dispType) {
+            case I2C_SSD1306:
+            {
+                display1306->ssd1306_command(SSD1306_PAGEADDR);
+                display1306->ssd1306_command(first);
+                display1306->ssd1306_command(last);
+                display1306->ssd1306_command(SSD1306_COLUMNADDR);
+                display1306->ssd1306_command(0);
+                display1306->ssd1306_command(width-1);
+
+                const uint8_t *ptr = display1306->getBuffer() + first * width;
+                uint16_t count = (last - first + 1) * width;
+
+                wire->setClock(i2cRate);
+                wire->beginTransmission(address);
+                wire->write((uint8_t)0x40);
+                uint8_t bytesOut = 1;
+                while(count--) {
+                    if(bytesOut >= OLED_WIRE_MAX) {
+                        wire->endTransmission();
+                        wire->beginTransmission(address);
+                        wire->write((uint8_t)0x40);
+                        bytesOut = 1;
+                    }
+                    wire->write(*ptr++);
+                    ++bytesOut;
+                }
+                wire->endTransmission();
+                wire->setClock(i2cRateAfter);
+                break;
+            }
+            case I2C_SH1106:
+                display1106->display(); break;
+            case I2C_SH1107:
+                display1107->display(); break;
+            default: break;
+        }
+    }
+
+    /// @brief Whether this is one of the SPI variants
+    bool isSPI() const { return dispType >= SPI_SSD1306 && dispType <= SPI_SH1107; }
+
+    /// @brief Whether this is one of the colour TFTs, which stream tiles from a 1bpp canvas instead of having a framebuffer
+    bool isTFT() const { return dispType == SPI_ST7789 || dispType == SPI_ILI9341; }
+
+    /// @brief Blocks until a DMA push started by display()/displayPages() has finished reading the render buffer
+    /// @details Must be called before drawing into the render buffer, or sending commands, while SPI pushes may be in flight.
+    void flushWait() {
+        if(isTFT()) displayTFT->FlushWait();
+        if(!spiPending) return;
+        while(!DeckSPIDone(spi)) tight_loop_contents();
+        digitalWrite(csPin, HIGH);
+        spi->endTransaction();
+        spiPending = false;
+    }
+
+    /// @brief Whether nothing's left in flight from the last display()/displayPages(), without waiting on it
+    bool flushDone() const { return spi == nullptr || DeckSPIDone(spi); }
+
+    /// @brief Pushes pages first through last of the render buffer over SPI, leaving the last DMA transfer running
+    /// @details SSD1306 takes the whole range as one window and one transfer; SH110X only has page addressing,
+    /// so each page gets its own command/data pair, with D/C flipped in between.
+    void spiFlush(const uint8_t &first, const uint8_t &last) {
+        flushWait();
+
+        uint8_t *buf = getBuffer();
+        uint8_t cmds[6];
+
+        spi->beginTransaction(SPISettings(spiRate, MSBFIRST, SPI_MODE0));
+        digitalWrite(csPin, LOW);
+
+        switch(dispType) {
+            case SPI_SSD1306:
+                pageCommands(first, cmds);
+                cmds[2] = last;
+                digitalWrite(dcPin, LOW);
+                spi->transfer(cmds, nullptr, 6);
+                digitalWrite(dcPin, HIGH);
+                DeckSPISend(spi, buf + first * width, (last - first + 1) * width);
+                break;
+            case SPI_SH1106:
+            case SPI_SH1107:
+                for(uint8_t page = first; page <= last; ++page) {
+                    if(page != first)
+                        while(!DeckSPIDone(spi)) tight_loop_contents();
+
+                    const uint8_t count = pageCommands(page, cmds);
+                    digitalWrite(dcPin, LOW);
+                    spi->transfer(cmds, nullptr, count);
+                    digitalWrite(dcPin, HIGH);
+                    DeckSPISend(spi, buf + page * width, width);
+                }
+                break;
+            default: break;
+        }
+
+        // CS stays low until flushWait() sees the last transfer out
+        spiPending = true;
+    }
+
+    /// @brief Render buffer of the active driver, page-major (width bytes per 8px-tall page)
+    uint8_t *getBuffer() {
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306: return display1306->getBuffer();
+            case I2C_SH1106:
+            case SPI_SH1106: return display1106->getBuffer();
+            case I2C_SH1107:
+            case SPI_SH1107: return display1107->getBuffer();
+            // row-major, unlike the OLEDs
+            case SPI_ST7789:
+            case SPI_ILI9341: return displayTFT->canvas.getBuffer();
+            default: return nullptr;
+        }
+    }
+
+    /// @brief Builds the command bytes that point controller RAM writes at the start of a page
+    /// @details For callers that push pages themselves (e.g. over DMA) instead of through display().
+    /// @param page 8px-tall page to address
+    /// @param cmds Output, at least 6 bytes
+    /// @return Number of command bytes written
+    uint8_t pageCommands(const uint8_t &page, uint8_t *cmds) {
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306:
+            {
+                // 64px-wide glass sits in the middle of the controller's 128 columns
+                const uint8_t colStart = (width == 64) ? 32 : 0;
+                cmds[0] = SSD1306_PAGEADDR;   cmds[1] = page;     cmds[2] = page;
+                cmds[3] = SSD1306_COLUMNADDR; cmds[4] = colStart; cmds[5] = colStart + width-1;
+                return 6;
+            }
+            case I2C_SH1106:
+            case SPI_SH1106:
+            case I2C_SH1107:
+            case SPI_SH1107:
+            {
+                // SH1106 has 132 columns of RAM, with the glass starting at column 2
+                const uint8_t colStart = (dispType == I2C_SH1106 || dispType == SPI_SH1106) ? 2 : 0;
+                cmds[0] = 0xB0 + page;
+                cmds[1] = 0x10 | (colStart >> 4);
+                cmds[2] = colStart & 0x0F;
+                return 3;
+            }
+            default: return 0;
+        }
+    }
+
+    /// @brief Whether the controller can rotate a page range on its own (without RAM rewrites per step)
+    bool hwScrollSupported() { return dispType == I2C_SSD1306 || dispType == SPI_SSD1306; }
+
+    /// @brief Starts continuous hardware right-rotation of pages first through last
+    /// @details Stepping is every two frames (fastest the SSD1306 allows).
+    /// Display RAM must not be written while this is active - call stopScroll() first.
+    void startScrollRight(const uint8_t &first, const uint8_t &last) {
+        flushWait();
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306:
+                display1306->ssd1306_command(SSD1306_RIGHT_HORIZONTAL_SCROLL);
+                display1306->ssd1306_command(0x00);
+                display1306->ssd1306_command(first);
+                display1306->ssd1306_command(0x07); // 2 frames per step
+                display1306->ssd1306_command(last);
+                display1306->ssd1306_command(0x00);
+                display1306->ssd1306_command(0xFF);
+                display1306->ssd1306_command(SSD1306_ACTIVATE_SCROLL);
+                break;
+            default: break;
+        }
+    }
+
+    /// @brief Stops hardware scrolling; scrolled pages must be pushed again afterwards
+    void stopScroll() {
+        flushWait();
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306:
+                display1306->stopscroll(); break;
+            default: break;
+        }
+    }
+
+    /// @brief Switches the glass on or off; controller RAM (and so what's shown once it's back on) is kept
+    void power(const bool &on) {
+        flushWait();
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306:
+                display1306->ssd1306_command(on ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF); break;
+            case I2C_SH1106:
+            case SPI_SH1106:
+                display1106->oled_command(on ? SH110X_DISPLAYON : SH110X_DISPLAYOFF); break;
+            case I2C_SH1107:
+            case SPI_SH1107:
+                display1107->oled_command(on ? SH110X_DISPLAYON : SH110X_DISPLAYOFF); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                // DISPON/DISPOFF
+                displayTFT->Command(on ? 0x29 : 0x28);
+                break;
+            default: break;
+        }
+    }
+
     void invertDisplay(const bool &i) {
+        flushWait();
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->invertDisplay(i); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->invertDisplay(i); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->invertDisplay(i); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                // ST7789 glass is already inverted, so normal is INVON there
+                displayTFT->Command((i != (displayTFT->controller == DeckTFT::TFT_ST7789)) ? 0x21 : 0x20);
+                break;
             default: break;
         }
     }
@@ -108,26 +425,100 @@ public:
     // only SSD1306 has a predefined dim function (which sets contrast to 0x8F), with no public "set contrast" method
     // SH1106 also seems to have virtually no range in contrast - 0x2F seems to have the same effect as 0x01
     void dim(const bool &dim) {
+        flushWait();
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->dim(dim); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setContrast(dim ? 0x01 : 0xFF);
                 break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setContrast(dim ? 0x2F : 0x4F);
                 break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                setContrast(dim ? contrastDim() : contrastMax());
+                break;
+            default: break;
+        }
+    }
+
+    /// @brief Sets raw contrast level, for fading between contrastMax() and contrastDim()
+    void setContrast(const uint8_t &level) {
+        flushWait();
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306:
+                display1306->ssd1306_command(SSD1306_SETCONTRAST);
+                display1306->ssd1306_command(level);
+                break;
+            case I2C_SH1106:
+            case SPI_SH1106:
+                display1106->setContrast(level); break;
+            case I2C_SH1107:
+            case SPI_SH1107:
+                display1107->setContrast(level); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                // display brightness (WRDISBV), for modules whose backlight follows the controller
+                displayTFT->Command(0x51, &level, 1);
+                break;
             default: break;
         }
     }
 
+    /// @brief Sets the foreground colour of a layout region, only colour TFTs have any use for it
+    /// @param rgb Colour packed as 0x00BBGGRR, same as page colours
+    void setTint(const DeckTFT::Region_e &region, const uint32_t &rgb) {
+        if(isTFT()) displayTFT->SetTint(region, rgb);
+    }
+
+    /// @brief Contrast level matching dim(false)
+    uint8_t contrastMax() {
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306: return 0xCF;
+            case I2C_SH1106:
+            case SPI_SH1106: return 0xFF;
+            case I2C_SH1107:
+            case SPI_SH1107: return 0x4F;
+            case SPI_ST7789:
+            case SPI_ILI9341: return 0xFF;
+            default: return 0;
+        }
+    }
+
+    /// @brief Contrast level matching dim(true)
+    uint8_t contrastDim() {
+        switch(dispType) {
+            case I2C_SSD1306:
+            case SPI_SSD1306: return 0x00;
+            case I2C_SH1106:
+            case SPI_SH1106: return 0x01;
+            case I2C_SH1107:
+            case SPI_SH1107: return 0x2F;
+            case SPI_ST7789:
+            case SPI_ILI9341: return 0x10;
+            default: return 0;
+        }
+    }
+
     void cp437(const bool &x) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->cp437(x); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.cp437(x); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->cp437(x); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->cp437(x); break;
             default: break;
         }
@@ -136,10 +527,16 @@ public:
     void drawFastVLine(const int16_t &x, const int16_t &y, const int16_t &h, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawFastVLine(x, y, h, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawFastVLine(x, y, h, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawFastVLine(x, y, h, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawFastVLine(x, y, h, color); break;
             default: break;
         }
@@ -148,10 +545,16 @@ public:
     void drawFastHLine(const int16_t &x, const int16_t &y, const int16_t &w, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawFastHLine(x, y, w, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawFastHLine(x, y, w, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawFastHLine(x, y, w, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawFastHLine(x, y, w, color); break;
             default: break;
         }
@@ -160,10 +563,16 @@ public:
     void fillRect(const int16_t &x, const int16_t &y, const int16_t &w, const int16_t &h, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->fillRect(x, y, w, h, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.fillRect(x, y, w, h, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->fillRect(x, y, w, h, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->fillRect(x, y, w, h, color); break;
             default: break;
         }
@@ -172,10 +581,16 @@ public:
     void fillScreen(const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->fillScreen(color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.fillScreen(color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->fillScreen(color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->fillScreen(color); break;
             default: break;
         }
@@ -184,10 +599,16 @@ public:
     void drawLine(const int16_t &x0, const int16_t &y0, const int16_t &x1, const int16_t &y1, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawLine(x0, y0, x1, y1, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawLine(x0, y0, x1, y1, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawLine(x0, y0, x1, y1, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawLine(x0, y0, x1, y1, color); break;
             default: break;
         }
@@ -196,10 +617,16 @@ public:
     void drawRect(const int16_t &x, const int16_t &y, const int16_t &w, const int16_t &h, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawRect(x, y, w, h, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawRect(x, y, w, h, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawRect(x, y, w, h, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawRect(x, y, w, h, color); break;
             default: break;
         }
@@ -208,10 +635,16 @@ public:
     void drawBitmap(const int16_t &x, const int16_t &y, const uint8_t bitmap[], const int16_t &w, const int16_t &h, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawBitmap(x, y, bitmap, w, h, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawBitmap(x, y, bitmap, w, h, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawBitmap(x, y, bitmap, w, h, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawBitmap(x, y, bitmap, w, h, color); break;
             default: break;
         }
@@ -220,10 +653,16 @@ public:
     void drawBitmap(const int16_t &x, const int16_t &y, uint8_t *bitmap, const int16_t &w, const int16_t &h, const uint16_t &color) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->drawBitmap(x, y, bitmap, w, h, color); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.drawBitmap(x, y, bitmap, w, h, color); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->drawBitmap(x, y, bitmap, w, h, color); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->drawBitmap(x, y, bitmap, w, h, color); break;
             default: break;
         }
@@ -232,10 +671,16 @@ public:
     void setTextSize(const uint8_t &s) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setTextSize(s); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setTextSize(s); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setTextSize(s); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setTextSize(s); break;
             default: break;
         }
@@ -244,10 +689,16 @@ public:
     void setFont(const GFXfont *f = NULL) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setFont(f); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setFont(f); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setFont(f); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setFont(f); break;
             default: break;
         }
@@ -256,10 +707,16 @@ public:
     void setCursor(const int16_t &x, const int16_t &y) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setCursor(x, y); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setCursor(x, y); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setCursor(x, y); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setCursor(x, y); break;
             default: break;
         }
@@ -268,10 +725,16 @@ public:
     void setTextColor(const uint16_t &c) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setTextColor(c); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setTextColor(c); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setTextColor(c); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setTextColor(c); break;
             default: break;
         }
@@ -280,10 +743,16 @@ public:
     void setTextColor(const uint16_t &c, const uint16_t &bg) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setTextColor(c, bg); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setTextColor(c, bg); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setTextColor(c, bg); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setTextColor(c, bg); break;
             default: break;
         }
@@ -292,10 +761,16 @@ public:
     void setTextWrap(const bool &w) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->setTextWrap(w); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.setTextWrap(w); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->setTextWrap(w); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->setTextWrap(w); break;
             default: break;
         }
@@ -304,10 +779,16 @@ public:
     void print(const char *str) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->print(str); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.print(str); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->print(str); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->print(str); break;
             default: break;
         }
@@ -316,10 +797,16 @@ public:
     void println(const char *str) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->println(str); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.println(str); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->println(str); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->println(str); break;
             default: break;
         }
@@ -328,10 +815,16 @@ public:
     int16_t getCursorX() {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 return display1306->getCursorX();
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                return displayTFT->canvas.getCursorX();
             case I2C_SH1106:
+            case SPI_SH1106:
                 return display1106->getCursorX();
             case I2C_SH1107:
+            case SPI_SH1107:
                 return display1107->getCursorX();
             default: return 0;
         }
@@ -340,10 +833,16 @@ public:
     int16_t getCursorY() {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 return display1306->getCursorY();
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                return displayTFT->canvas.getCursorY();
             case I2C_SH1106:
+            case SPI_SH1106:
                 return display1106->getCursorY();
             case I2C_SH1107:
+            case SPI_SH1107:
                 return display1107->getCursorY();
             default: return 0;
         }
@@ -352,10 +851,16 @@ public:
     bool getPixel(const int16_t &x, const int16_t &y) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 return display1306->getPixel(x, y);
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                return displayTFT->canvas.getPixel(x, y);
             case I2C_SH1106:
+            case SPI_SH1106:
                 return display1106->getPixel(x, y);
             case I2C_SH1107:
+            case SPI_SH1107:
                 return display1107->getPixel(x, y);
             default: return false;
         }
@@ -364,16 +869,24 @@ public:
     void getTextBounds(const char *str, const int16_t &x, const int16_t &y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
         switch(dispType) {
             case I2C_SSD1306:
+            case SPI_SSD1306:
                 display1306->getTextBounds(str, x, y, x1, y1, w, h); break;
+            case SPI_ST7789:
+            case SPI_ILI9341:
+                displayTFT->canvas.getTextBounds(str, x, y, x1, y1, w, h); break;
             case I2C_SH1106:
+            case SPI_SH1106:
                 display1106->getTextBounds(str, x, y, x1, y1, w, h); break;
             case I2C_SH1107:
+            case SPI_SH1107:
                 display1107->getTextBounds(str, x, y, x1, y1, w, h); break;
             default: break;
         }
     }
 };
 
+class DeckPanels;
+
 class DeckDisplay {
 public:
     enum ScreenMode_e {
@@ -390,42 +903,198 @@ public:
         Align_Right
     };
 
+    enum Bench_e {
+        Bench_Blit = 0,     ///< Key grid blit into the render buffer
+        Bench_Display,      ///< Full render buffer push to the display
+        Bench_PageLoad,     ///< Loading a page that isn't resident, spread over every page
+        BENCH_TYPES
+    };
+
     /// @brief Verifies display pins validity to pass to display constructor, then starts up the display
     /// @return success (true) or fail (false)
     bool Begin(const int &scl, const int &sda, const Adafruit_MultiDisplay::ScreenType_e &displayType);
 
+    /// @brief Verifies SPI display pins validity to pass to display constructor, then starts up the display
+    /// @details For the SPI_* display types; CS/DC/RST can be any free GPIO (RST -1 if tied to the board's reset).
+    /// Panel size is only for colour TFTs, which show the same layout scaled up to fit.
+    /// @return success (true) or fail (false)
+    bool Begin(const int &sck, const int &mosi, const int &cs, const int &dc, const int &rst, const Adafruit_MultiDisplay::ScreenType_e &displayType,
+               const uint16_t &panelW = SCREEN_WIDTH, const uint16_t &panelH = SCREEN_HEIGHT);
+
     /// @brief Update top panel with primary and (optional) secondary text buffers with alignment options
     void TopPanelUpdate(const char *mainText, const PanelTextAlign_e &textAlign = Align_Left, const char *subText = nullptr, const PanelTextAlign_e &subAlign = Align_Left);
 
     /// @brief Clear screen for different operational states
     void ScreenModeChange(const ScreenMode_e &screenMode);
 
-    /// @brief Perform maintenance operations (WIP)
-    /// @details For when values aren't being updated, but still want to change something on the screen
-    /// (i.e. small text printouts when health/ammo empty)
+    /// @brief Runs one display frame, if it's due
+    /// @details Advances the animation timeline, then renders and flushes everything that changed
+    /// since the last frame in one go. Frames that can't be kept up with are dropped.
     void IdleOps();
 
-    /// @brief Scrolls primary and secondary text buffers across the top banner by 1px per call
-    /// @details Should be called continuously until the second text buffer has reached its desired position
+    /// @brief ms Core1 can sleep for before IdleOps() has anything to do, 0 if it should keep being called
+    /// @details Only ever non-zero once a frame's been pushed & nothing else is pending (pages to prefetch, panel transfers).
+    /// ~0UL while there's nothing animating or left to draw, so it's down to the FIFO (or the sleep cap) to wake it.
+    unsigned long IdleWait(const unsigned long &now) const;
+
+    /// @brief Moves primary and secondary text buffers across the top banner to the slide animation's current position
+    /// @details Swaps the two buffers once the slide has finished
     void TopPanelScroll();
 
-    /// @brief Inverts and blits polled buttons' bitmaps' atop the current displayed inputs page
+    /// @brief Halts an active hardware banner scroll and redraws the banner at its resting position
+    void TopPanelScrollStop();
+
+    /// @brief Sets polled buttons' pressed state in the UI model, and renders the keys that changed
     void ButtonsUpdate(const uint32_t &btnsMap, const bool &isReleased);
 
     /// @brief Updates bindings based on the desired page, derived from LGB's Buttons Descriptor
+    /// @details Only key cells whose contents differ from the previous page are redrawn
     void PageUpdate(const uint32_t &page);
 
+    /// @brief Applies a governor tier's frame rate & animations, and dims or switches off the display for it
+    void TierSet(const DeckGovernor::Tier_e &tier);
+
+    /// @brief Drops every resident page and puts the current one back up, for when the pages themselves changed
+    void PagesReload(const uint32_t &page);
+
+    /// @brief Gets another profile's pages ready in the shadow set, with a page's keys already rendered
+    /// @details The active pages & what's on screen are left alone, so this can run while the current profile's still in use.
+    /// @param profile Profile to prepare, already checked over by DeckProfile::Begin()
+    void ProfilePrepare(const DeckProfile *profile, const int &pagesCount, const int &page);
+
+    /// @brief Swaps the prepared profile's pages in and puts a page up, blitting the keys rendered ahead of time
+    void ProfileSwap(const int &page);
+
+    /// @brief Draws everything in the UI model that differs from what was last drawn
+    void Render();
+
+    /// @brief Waits out every push in flight, to the display & panels alike, so no bus is left mid-transaction
+    /// @details For parking ahead of a flash write; IdleOps() is what starts the next ones, once it runs again.
+    void Park();
+
     /// @brief Sets save status to be reported during IdleOps()
     void SaveUpdate(uint32_t save);
 
+    /// @brief Starts mirroring key cells onto secondary panels, redrawing everything once so they start in sync
+    void PanelsAttach(DeckPanels *keyPanels);
+
+    /// @brief Renders every page, every key's pressed/toggled states, and a mid-slide banner, one after another
+    /// @details Prints a line per state with a hash of the render buffer and how long the render took,
+    /// so two builds' outputs can be diffed to check a rendering change is pixel-exact (and faster).
+    /// Nothing gets pushed to the display and no toggle is saved; the shown page is put back afterwards
+    /// and drawn on the next frame.
+    /// @param images Also print each state as a plain PBM (P1) image
+    void RenderAudit(Print &out, const bool &images = false);
+
+    /// @brief Prints the render buffer as it is right now, as a plain PBM (P1) image
+    void FrameDump(Print &out);
+
+    /// @brief FNV-1a of the render buffer as it is right now
+    uint32_t FrameHash();
+
+    /// @brief Input replay starting: icon toggles from here on are only shown, never passed on to be saved
+    void ReplayBegin();
+
+    /// @brief Input replay over: draws its last edges, hashes the frame, then puts the page back up as saved
+    /// @details The banner's drawn at rest for the hash, so it doesn't depend on how far a slide had got.
+    /// @return FrameHash() of the frame the replay left
+    uint32_t ReplayEnd();
+
+    /// @brief Times a render/push step over a number of runs and prints the average
+    /// @details None of them change what's on screen. Page loads also print the slowest one,
+    /// which should stay flat no matter how many pages there are.
+    void Bench(Print &out, const Bench_e &bench, const int &runs);
+
     /// @brief Multiple displays wrapper singleton
     /// @details Used to check validity of whether a display is active or not
     Adafruit_MultiDisplay *display = nullptr;
 
-    // array of keyboxes with a defined pixmap (else, fallback to font)
-    DeckPrefs::KeyBM_t *keyPics[12][3];
+    /// @brief Secondary per-key/per-row panels, if any are attached
+    DeckPanels *panels = nullptr;
+
+    // array of keyboxes with a defined pixmap (else, fallback to font), for the compiled-in pages
+    // (a loaded profile brings its own icons)
+    #define OLED_KEYPICS_PAGES 3
+    const DeckPrefs::KeyBM_t *keyPics[12][OLED_KEYPICS_PAGES];
+
+    /// @brief Set while Core1 is between frames with no display push in flight, and so can sleep
+    bool quiet = false;
+
+    /// @brief Key cells whose icons flipped since Core0 last heard about it, per page
+    /// @details Core0 owns the saved toggles (DeckPrefs::KeyToggle()), so loop1() passes these on and clears them.
+    uint16_t togglesPending[PREFS_TOGGLE_PAGES] = {};
+
+    /// @brief Set between ReplayBegin() and ReplayEnd()
+    bool replaying = false;
 
 private:
+    /// @brief Renders banner text from the UI model into the banner canvases and render buffer
+    void BannerRender();
+
+    /// @brief Clears a banner canvas and draws a line of text into it with the given alignment
+    void BannerTextRender(GFXcanvas1 *canvas, const char *text, const uint8_t &align);
+
+    /// @brief Renders a single key cell from the UI model
+    void KeyRender(const int &cell);
+
+    /// @brief Draws a key's (unpressed) contents into keyBoxBuf
+    void KeyContentRender(const DeckUI::KeyCell_t &key);
+
+    /// @brief Starts a key's animated icon over from its first frame, if it has one
+    void KeySpriteRestart(const int &cell, const DeckUI::KeyCell_t &key);
+
+    /// @brief Overlays (or clears) the status glyph from the UI model atop the banner
+    void StatusRender();
+
+    /// @brief Draws the banner canvases into the render buffer at the current slide position
+    void BannerBlit();
+
+    /// @brief Schedules the next banner slide after OLED_SCROLL_INTERVAL
+    void BannerSlideQueue();
+
+    /// @brief Draws a key cell's cached contents (inverted if pressed) at the current page slide offset
+    void KeyBlit(const int &cell);
+
+    /// @brief Redraws the whole key grid at the current page slide offset
+    void KeysBlit();
+
+    /// @brief Steps animated key icons whose current frame has run out
+    /// @details Only rows that changed get blitted, up to OLED_SPRITE_ROWS_BUDGET per frame across all keys.
+    void SpritesUpdate(const unsigned long &now);
+
+    /// @brief Applies a sprite frame to a key's cached contents
+    /// @return Bitmask of rows that changed
+    uint16_t SpriteFrameApply(const int &cell, const KeySpriteFrame_t &frame);
+
+    /// @brief Draws only the given rows of a key cell's cached contents
+    void KeyRowsBlit(const int &cell, const uint16_t &rows);
+
+    /// @brief Clears out any currently active display
+    void DisplayRelease();
+
+    /// @brief Starts up a newly constructed display and the render state
+    bool DisplayInit();
+
+    /// @brief Undims the display (and switches it back on) if the governor had it dimmed
+    void Wake();
+
+    /// @brief Waits for panel transfers on the main display's bus to finish, before blocking driver calls
+    void BusClaim();
+
+    /// @brief Whether pressing a key cell of the shown page flips its icon
+    bool KeyToggles(const int &cell);
+
+    /// @brief Prints one RenderAudit() state: label, render buffer hash & render time (and the buffer as PBM, if asked)
+    void RenderAuditLine(Print &out, const char *label, const unsigned long &renderTime, const bool &images);
+
+    /// @brief What should be on screen vs. what currently is
+    DeckUI ui;
+
+    /// @brief The few pages that are resolved & ready to flip to, and the same for a profile about to be swapped in
+    DeckPages pageSets[2];
+    DeckPages *pages = &pageSets[0];
+    DeckPages *shadowPages = &pageSets[1];
+
     enum SavingTypes_e {
         SAVE_STARTED = 0,
         SAVE_FAILED,
@@ -443,11 +1112,16 @@ private:
     //bool altAddr = false;
 
     // canvas objects for the top banner's main and subtext (scrolling)
-    GFXcanvas1 topBannerBufMain = GFXcanvas1(128, 15);
-    GFXcanvas1 topBannerBufSub = GFXcanvas1(128, 15);
-    uint8_t topBannerBackupBitmap[((128+7) >> 3) * 15];
+    // always accessed through the Main/Sub pointers, so swapping them at the end of a scroll is just a pointer swap
+    GFXcanvas1 topBannerBufA = GFXcanvas1(128, 15);
+    GFXcanvas1 topBannerBufB = GFXcanvas1(128, 15);
+    GFXcanvas1 *topBannerBufMain = &topBannerBufA;
+    GFXcanvas1 *topBannerBufSub = &topBannerBufB;
 
-    // singleton canvas for keybox objects, and all-in-one buffer for all 12 available keys
+    // set when sub text is a copy of main text, i.e. a scroll is a pure rotation that the controller can do by itself
+    bool topBannMirrored = false;
+
+    // singleton canvas for keybox objects, and all-in-one cache of all 12 available keys' unpressed contents
     #define OLED_KEY_BOX_WIDTH 31
     #define OLED_KEY_BOX_HEIGHT 16
     #define OLED_KEYS_COLUMNS 4
@@ -455,27 +1129,49 @@ private:
     GFXcanvas1 keyBoxBuf = GFXcanvas1(OLED_KEY_BOX_WIDTH, OLED_KEY_BOX_HEIGHT);
     uint8_t keyBoxBitmaps[OLED_KEYS_COLUMNS * OLED_KEYS_ROWS][((OLED_KEY_BOX_WIDTH+7) >> 3) * OLED_KEY_BOX_HEIGHT];
 
-    // marker of keys (with dual-stage pics) that have been last pressed
-    bool keyBoxesPushedStatus[12][3];
+    // page of the shadow set rendered ahead of time (-1 if none), its keys, and their contents laid out like the above
+    DeckUI::KeyCell_t shadowKeys[UI_KEY_CELLS];
+    uint8_t shadowBitmaps[UI_KEY_CELLS][((OLED_KEY_BOX_WIDTH+7) >> 3) * OLED_KEY_BOX_HEIGHT];
+    int shadowPage = -1;
+
+    // animated key icons' current frame and when it's up, plus where the next frame's round-robin starts from
+    uint8_t spriteFrame[UI_KEY_CELLS];
+    unsigned long spriteNext[UI_KEY_CELLS];
+    uint8_t spriteStartCell = 0;
+    #define OLED_SPRITE_ROWS_BUDGET 48
 
-    // timestamps for periodic tasks in IdleOps()
-    unsigned long idleTimestamp = 0;
+    // frame pacing (ms) and per-frame work budget (us) for IdleOps(), plus every timed effect
     #define OLED_IDLE_INTERVAL 16
+    #define OLED_FRAME_BUDGET 12000
+    DeckAnim anim = DeckAnim(OLED_IDLE_INTERVAL, OLED_FRAME_BUDGET);
 
-    // OLED dimmer (defaults to ~30min)
+    // OLED dimmer (DeckGovernor's Tier_Dimmed, after ~30min), fades out over OLED_FADE_TIME; and switched off entirely (Tier_Off)
     bool oledDimmed = false;
-    unsigned long timeoutTimestamp = 0;
+    bool oledOff = false;
     #define OLED_TIMEOUT 1800000
+    #define OLED_FADE_TIME 1000
 
-    int topBannX;
-    bool topBannScrolling = false;
-    unsigned long lastScrollTimestamp = 0;
+    // banner slide position, and time for one full 128px lap
+    // (matches SSD1306 hardware scrolling at 2 frames/step, so either can be used)
+    int topBannX = 0;
     #define OLED_SCROLL_INTERVAL 5000
+    #define OLED_SCROLL_TIME 2560
+
+    // hardware banner rotation (SSD1306)
+    bool topBannHWScrolling = false;
+
+    // banner slides & animated key icons, off in the governor's quieter tiers
+    bool animationsOn = true;
+
+    // key grid offset while a new page slides in
+    int keysSlideX = 0;
+    uint32_t lastPage = 0;
+    #define OLED_PAGESLIDE_TIME 160
 
     // Set true when save glyph should be visible (either neutral, failed or success)
     bool saving = false;
-    unsigned long saveResultTimestamp = 0;
     #define OLED_SAVING_TIME 2000
+    #define OLED_BLINK_TIME 250
     DeckPrefs::Errors_e saveResult = DeckPrefs::Error_None;
 
     //// Graphics
@@ -529,232 +1225,4 @@ private:
         0xff, 0xe0, 0x91, 0xf0, 0x91, 0xe8, 0x91, 0xe4, 0x91, 0xe4, 0x9f, 0xe5, 0x80, 0x03, 0x80, 0x86, 
 	    0x80, 0x4c, 0x9f, 0xb8, 0x90, 0x14, 0x97, 0xa4, 0x90, 0x24, 0xff, 0xfc
     };
-
-    // any method accessing this should always decrement the pointer by 0x20, which is where this map starts
-    static inline const char *keyStrings[] = {
-        "   ", // 0x20 - space
-        " ! ",
-        " \" ",
-        " # ",
-        " $ ",
-        " % ",
-        " & ",
-        " ' ",
-        " ( ",
-        " ) ",
-        " * ",
-        " + ",
-        " , ",
-        " - ",
-        " . ",
-        " / ",
-        "#0 ",
-        "#1 ",
-        "#2 ",
-        "#3 ",
-        "#4 ",
-        "#5 ",
-        "#6 ",
-        "#7 ",
-        "#8 ",
-        "#9 ",
-        " : ",
-        " ; ",
-        " < ",
-        " = ",
-        " > ",
-        " ? ",
-        " @ ",
-        " A ",
-        " B ",
-        " C ",
-        " D ",
-        " E ",
-        " F ",
-        " G ",
-        " H ",
-        " I ",
-        " J ",
-        " K ",
-        " L ",
-        " M ",
-        " N ",
-        " O ",
-        " P ",
-        " Q ",
-        " R ",
-        " S ",
-        " T ",
-        " U ",
-        " V ",
-        " W ",
-        " X ",
-        " Y ",
-        " Z ",
-        " [ ",
-        " \\ ",
-        " ] ",
-        " ^ ",
-        " _ ",
-        " ` ",
-        " a ",
-        " b ",
-        " c ",
-        " d ",
-        " e ",
-        " f ",
-        " g ",
-        " h ",
-        " i ",
-        " j ",
-        " k ",
-        " l ",
-        " m ",
-        " n ",
-        " o ",
-        " p ",
-        " q ",
-        " r ",
-        " s ",
-        " t ",
-        " u ",
-        " v ",
-        " w ",
-        " x ",
-        " y ",
-        " z ",
-        " { ",
-        " | ",
-        " } ",
-        " ~ ",
-        "   ", // 0x7F - last ASCII printable
-        "CTRL",// 0x80 - left modifiers
-        "SHFT",
-        "ALT",
-        "META",
-        "CTRL",// 0x84 - right modifiers
-        "SHFT",
-        "ALT",
-        "META",
-        "",    // 0x88 - nothing
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",    // 0x90
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",    // 0xA0
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "ENTR",    // 0xB0 - Return/Enter
-        "ESC",
-        "RUB",
-        "TAB",
-        "",        // 0xB4 - nothing
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",        // 0xC0
-        "CAPS",    // 0xC1 - caps lock
-        "F1",
-        "F2",
-        "F3",
-        "F4",
-        "F5",
-        "F6",
-        "F7",
-        "F8",
-        "F9",
-        "F10",
-        "F11",
-        "F12",
-        "",       // 0xCE
-        "",
-        "",       // 0xD0
-        "INS",    // 0xD1 - insert
-        "",
-        "PgUp",
-        "DEL",
-        "END",
-        "PgDn",   // 0xD6 - page down
-        "Rght",
-        "Left",
-        "Dwn",
-        "Up",     // 0xDA - Up Arrow
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",       // 0xE0
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "",
-        "F13",    // 0xF0 - F13
-        "F14",
-        "F15",
-        "F16",
-        "F17",
-        "F18",
-        "F19",
-        "F20",
-        "F21",
-        "F22",
-        "F23",
-        "F24",    // 0xFB - F24
-        "",
-        "",
-        "",
-        ""
-    };
 };
@@ -0,0 +1,53 @@
+/*!
+ * @file PicoDeckGovernor.cpp
+ * @brief Activity governor: steps the display, LEDs and pin scanning down through tiers while nothing's pressed.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "PicoDeckGovernor.h"
+#include "PicoDeckDisplay.h"
+
+// {name, after, frame interval, animations, LED brightness, ms between pin reads}
+// dimming kicks in at the same OLED_TIMEOUT it always has, the governor just also stops animations there
+const DeckGovernor::Tier_t DeckGovernor::Tiers[GOVERNOR_TIERS] = {
+    {"active",  0,                  OLED_IDLE_INTERVAL, true,  255, 0},
+    {"idle",    60000,              33,                 true,  128, 1},
+    {"dimmed",  OLED_TIMEOUT,       100,                false, 32,  2},
+    {"off",     OLED_TIMEOUT * 2,   500,                false, 0,   4},
+};
+
+bool DeckGovernor::Activity(const unsigned long &now)
+{
+    lastActivity = now;
+    return Enter(Tier_Active, now);
+}
+
+bool DeckGovernor::Update(const unsigned long &now)
+{
+    // one tier at a time, each entered when it would have taken over, so a late call still splits the time right
+    bool changed = false;
+    while(tier + 1 < GOVERNOR_TIERS && now - lastActivity >= Tiers[tier + 1].after)
+        changed |= Enter((Tier_e)(tier + 1), lastActivity + Tiers[tier + 1].after);
+    return changed;
+}
+
+unsigned long DeckGovernor::Wait(const unsigned long &now) const
+{
+    if(tier + 1 >= GOVERNOR_TIERS) return ~0UL;
+
+    const unsigned long idle = now - lastActivity;
+    const unsigned long after = Tiers[tier + 1].after;
+    return idle < after ? after - idle : 0;
+}
+
+bool DeckGovernor::Enter(const Tier_e &next, const unsigned long &now)
+{
+    if(next == tier) return false;
+
+    tierTime[tier] += now - tierSince;
+    tierSince = now;
+    tier = next;
+    return true;
+}
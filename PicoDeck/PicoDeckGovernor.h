@@ -0,0 +1,66 @@
+/*!
+ * @file PicoDeckGovernor.h
+ * @brief Activity governor: steps the display, LEDs and pin scanning down through tiers while nothing's pressed.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/// @brief Tracks time since the last key edge, and which tier that puts the deck in.
+/// @details Tiers only ever step down one threshold at a time as time passes, but any activity
+/// goes straight back to Tier_Active. Core0 only; Core1 gets told about tier changes over the FIFO.
+class DeckGovernor {
+public:
+    enum Tier_e {
+        Tier_Active = 0,    ///< Keys in use
+        Tier_Idle,          ///< Nothing pressed for a bit: slower frames, dimmer LEDs
+        Tier_Dimmed,        ///< Display dimmed, no animations
+        Tier_Off,           ///< Display & LEDs off
+        GOVERNOR_TIERS
+    };
+
+    typedef struct Tier_s {
+        const char *name;
+        unsigned long after;        // ms since the last activity before this tier takes over
+        uint16_t frameInterval;     // ms between display frames
+        bool animations;            // banner slides & animated key icons
+        uint8_t pixelsBrightness;   // 0-255
+        uint8_t pollTicks;          // ms between pin reads, a pin edge still wakes it straight away
+    } Tier_t;
+
+    static const Tier_t Tiers[GOVERNOR_TIERS];
+
+    /// @brief Marks a key edge, going straight back to Tier_Active
+    /// @return Whether the tier changed
+    bool Activity(const unsigned long &now);
+
+    /// @brief Steps down to whichever tier the time since the last activity calls for
+    /// @details However long it's been since the last call, tiers passed through on the way still get their share of TimeIn().
+    /// @return Whether the tier changed
+    bool Update(const unsigned long &now);
+
+    /// @brief ms until the next tier takes over if nothing happens, for sleeping until then
+    unsigned long Wait(const unsigned long &now) const;
+
+    /// @brief Settings of the tier the deck's in
+    const Tier_t &Current() const { return Tiers[tier]; }
+
+    /// @brief ms spent in a tier, counting the time so far in the current one
+    unsigned long TimeIn(const Tier_e &which, const unsigned long &now) const {
+        return tierTime[which] + (which == tier ? now - tierSince : 0);
+    }
+
+    Tier_e tier = Tier_Active;
+
+private:
+    /// @brief Moves to a tier, keeping count of the time spent in the one it's leaving
+    bool Enter(const Tier_e &next, const unsigned long &now);
+
+    unsigned long lastActivity = 0;
+    unsigned long tierSince = 0;
+    unsigned long tierTime[GOVERNOR_TIERS] = {};
+};
@@ -0,0 +1,67 @@
+/*!
+ * @file PicoDeckLog.cpp
+ * @brief Binary event log for profiling both cores while the deck runs normally, drained over USB CDC.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+
+#include "PicoDeckLog.h"
+
+void DeckLog::Drain(Stream &out, const bool &listening)
+{
+    if(!listening) {
+        if(enabled) {
+            enabled = false;
+            for(Ring_t &ring : rings) {
+                ring.tail = ring.head;
+                ring.droppedSent = ring.dropped;
+            }
+        }
+        return;
+    }
+
+    int room = out.availableForWrite() / sizeof(Record_t);
+
+    if(!enabled) {
+        if(!room) return;
+        const Record_t sync = { DeckTimeUs(), Log_Sync, DeckCoreNum(), LOG_SYNC_WORD };
+        out.write((const uint8_t*)&sync, sizeof(sync));
+        --room;
+        for(Ring_t &ring : rings) {
+            ring.tail = ring.head;
+            ring.droppedSent = ring.dropped;
+        }
+        enabled = true;
+    }
+
+    for(int core = 0; core < 2 && room > 0; ++core) {
+        Ring_t &ring = rings[core];
+
+        if(ring.dropped != ring.droppedSent) {
+            const uint16_t dropped = ring.dropped;
+            const Record_t lost = { DeckTimeUs(), Log_Dropped, (uint8_t)core, (uint16_t)(dropped - ring.droppedSent) };
+            out.write((const uint8_t*)&lost, sizeof(lost));
+            ring.droppedSent = dropped;
+            if(!--room) break;
+        }
+
+        const uint16_t head = ring.head;
+        // head has to be read before the records it covers
+        DeckMemoryBarrier();
+
+        uint16_t tail = ring.tail;
+        while(tail != head && room > 0) {
+            // up to the end of the ring at most, the wrapped part goes out on the next pass
+            const int start = tail & (LOG_RING_RECORDS-1);
+            const int count = std::min({ (int)(uint16_t)(head - tail), LOG_RING_RECORDS - start, room });
+            out.write((const uint8_t*)&ring.records[start], count * sizeof(Record_t));
+            tail += count;
+            room -= count;
+        }
+        ring.tail = tail;
+    }
+}
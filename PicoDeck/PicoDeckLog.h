@@ -0,0 +1,102 @@
+/*!
+ * @file PicoDeckLog.h
+ * @brief Binary event log for profiling both cores while the deck runs normally, drained over USB CDC.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <Arduino.h>
+
+#include "PicoDeckPlatform.h"
+
+// records held per core, must be a power of two (8 bytes each, so 4KB total)
+#define LOG_RING_RECORDS 256
+// payload of the Log_Sync record the stream (re)starts with, for finding record boundaries
+#define LOG_SYNC_WORD 0xA55A
+
+/// @brief Lock-free per-core event rings, each written only by its own core and read only by Drain().
+/// @details Logging an event is a flag check, a timer register read and an 8 byte store - no locks, no formatting.
+/// Nothing is logged until a host asks for it with the console's "log" command, and Drain() never waits on USB,
+/// so HID reporting behaves exactly the same with a host listening or not.
+///
+/// Stream format is raw Record_t's, little endian, 8 bytes each: u32 time (us), u8 event, u8 core, u16 payload.
+/// The stream starts with a Log_Sync record every time logging starts. Cores are drained in turns,
+/// so records are only in order per core - sort by time (minding the 32-bit wrap every ~71 minutes) for a timeline.
+class DeckLog {
+public:
+    enum Event_e {
+        Log_Sync = 0,       ///< Stream start, payload LOG_SYNC_WORD
+        Log_Dropped,        ///< Records this core lost to a full ring, payload count (timed when drained, not when lost)
+        Log_Press,          ///< Buttons newly pressed, payload button mask
+        Log_Release,        ///< Buttons newly released, payload button mask
+        Log_Report,         ///< HID report sent
+        Log_FifoFull,       ///< Core0 had to wait pushing to Core1, payload command (top byte)
+        Log_Page,           ///< Page switched, payload page
+        Log_SaveStart,
+        Log_SaveEnd,        ///< payload DeckPrefs::Errors_e
+        Log_FifoCmd,        ///< Core1 took a command, payload command (top byte)
+        Log_FrameStart,
+        Log_FrameEnd,       ///< payload frame work time in us, saturated
+        Log_Push,           ///< Render buffer pushed to the display, payload first page << 8 | last page
+        Log_Profile,        ///< Profile swapped in, payload slot
+        Log_Usb,            ///< USB bus state changed, payload UsbState_e (0 unmounted, 1 mounted, 2 suspended)
+        Log_Tier,           ///< Governor tier changed, payload DeckGovernor::Tier_e
+        LOG_EVENTS
+    };
+    static constexpr const char *EventNames[] = {
+        "sync", "dropped", "press", "release", "report", "fifo_full", "page", "save_start",
+        "save_end", "fifo_cmd", "frame_start", "frame_end", "push", "profile", "usb", "tier"
+    };
+
+    typedef struct Record_s {
+        uint32_t time;
+        uint8_t event;
+        uint8_t core;
+        uint16_t payload;
+    } Record_t;
+
+    /// @brief Logs an event on the calling core, or counts it as dropped if that core's ring is full
+    static inline void Event(const uint8_t &event, const uint16_t &payload = 0) {
+        if(!enabled) return;
+
+        const uint8_t core = DeckCoreNum();
+        Ring_t &ring = rings[core];
+        const uint16_t head = ring.head;
+        if((uint16_t)(head - ring.tail) >= LOG_RING_RECORDS) {
+            ++ring.dropped;
+            return;
+        }
+
+        ring.records[head & (LOG_RING_RECORDS-1)] = { DeckTimeUs(), event, core, payload };
+        // record has to land before the reader can see it
+        DeckMemoryBarrier();
+        ring.head = head + 1;
+    }
+
+    /// @brief Writes out as many whole records as the port has room for, never blocks
+    /// @details Meant to be run every pass of Core0's loop. Logging starts once listening is set; clearing it stops,
+    /// and throws away whatever was still queued.
+    /// @param listening Whether a host wants the binary stream on the port right now
+    static void Drain(Stream &out, const bool &listening);
+
+    /// @brief Set while a host is listening
+    static inline volatile bool enabled = false;
+
+private:
+    typedef struct Ring_s {
+        Record_t records[LOG_RING_RECORDS];
+        volatile uint16_t head;     // written by the owning core
+        volatile uint16_t tail;     // written by Drain()
+        volatile uint16_t dropped;  // written by the owning core
+        uint16_t droppedSent;       // written by Drain()
+    } Ring_t;
+
+    static inline Ring_t rings[2];
+};
+
+static_assert(sizeof(DeckLog::EventNames) / sizeof(DeckLog::EventNames[0]) == DeckLog::LOG_EVENTS, "an event has no name");
+static_assert(sizeof(DeckLog::Record_t) == 8, "records go out as they're laid out in memory");
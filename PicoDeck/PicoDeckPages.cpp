@@ -0,0 +1,119 @@
+/*!
+ * @file PicoDeckPages.cpp
+ * @brief Small working set of resolved pages, so page count can grow without RAM or flip time growing with it.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "PicoDeckPages.h"
+
+void DeckPages::Begin(const DeckPrefs::KeyBM_t *const *keyPics, const int &pagesStride, const DeckProfile *pagesProfile)
+{
+    builtInPics = keyPics;
+    builtInStride = pagesStride;
+    profile = pagesProfile;
+    Invalidate();
+}
+
+const DeckPages::Page_t &DeckPages::Get(const int &page)
+{
+    Page_t *slot = Find(page);
+    if(slot != nullptr) ++hits;
+    else {
+        ++misses;
+        slot = &Victim();
+        Load(*slot, page);
+    }
+
+    slot->lastUsed = ++useCount;
+    current = page;
+    return *slot;
+}
+
+void DeckPages::PrefetchAround(const int &page, const int &count)
+{
+    if(count <= 1) return;
+
+    // same wraparound as the page keys, even if wrapping's off (going back to the start is still likely)
+    prefetch[0] = page+1 < count ? page+1 : 0;
+    prefetch[1] = page > 0 ? page-1 : count-1;
+}
+
+bool DeckPages::PrefetchStep()
+{
+    for(int &page : prefetch) {
+        if(page < 0) continue;
+
+        const int next = page;
+        page = -1;
+        if(Find(next) != nullptr) continue;
+
+        Page_t &slot = Victim();
+        Load(slot, next);
+        slot.lastUsed = useCount;
+        ++prefetches;
+        return true;
+    }
+    return false;
+}
+
+void DeckPages::Invalidate()
+{
+    for(Page_t &slot : slots) {
+        slot.page = -1;
+        slot.lastUsed = 0;
+    }
+    prefetch[0] = prefetch[1] = -1;
+    current = -1;
+}
+
+DeckPages::Page_t &DeckPages::Victim()
+{
+    // the page that's up never goes, even if prefetches came after it
+    Page_t *victim = nullptr;
+    for(Page_t &slot : slots) {
+        if(current >= 0 && slot.page == current) continue;
+        if(victim == nullptr || slot.lastUsed < victim->lastUsed) victim = &slot;
+    }
+    return *victim;
+}
+
+DeckPages::Page_t *DeckPages::Find(const int &page)
+{
+    for(Page_t &slot : slots)
+        if(slot.page == page) return &slot;
+    return nullptr;
+}
+
+void DeckPages::Load(Page_t &slot, const int &page)
+{
+    const bool fromProfile = profile != nullptr && profile->Loaded();
+
+    slot.page = page;
+    if(fromProfile)
+         slot.info = page < profile->Pages() ? &profile->Page(page) : nullptr;
+    else slot.info = page < (int)DeckCommon::Prefs->pages.size() ? &DeckCommon::Prefs->pages.at(page) : nullptr;
+    slot.toggles = 0;
+
+    for(int i = 0, b = 0; b < (int)ButtonCount && i < UI_KEY_CELLS; ++b) {
+        if(DeckCommon::PageKey(profile, b)) continue;
+
+        // straight from where the pages come from rather than LightgunButtons' keymap, which may be another profile's
+        slot.codes[i] = DeckCommon::KeyCode(profile, b, page);
+        slot.icons[i] = nullptr;
+        if(fromProfile) {
+            const DeckProfile::Binding_t &binding = profile->Binding(page, b);
+            const char *name = profile->IconName(binding);
+            if(name != nullptr) slot.icons[i] = DeckPrefs::IconByName(name);
+            if(binding.flags & DeckProfile::Bind_Toggle) slot.toggles |= 1 << i;
+        } else {
+            if(builtInPics != nullptr && page < builtInStride)
+                slot.icons[i] = builtInPics[i * builtInStride + page];
+            // compiled-in icons toggle whenever they have a second half
+            slot.toggles |= 1 << i;
+        }
+
+        ++i;
+    }
+}
@@ -0,0 +1,82 @@
+/*!
+ * @file PicoDeckPages.h
+ * @brief Small working set of resolved pages, so page count can grow without RAM or flip time growing with it.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "PicoDeckCommon.h"
+#include "PicoDeckUI.h"
+
+// pages kept resolved at once: the current one, both its neighbours, and one more so flipping back & forth never misses
+#define PAGES_RESIDENT 4
+
+/// @brief Pages resolved into what the display needs (codes, icons, toggle semantics), for only a few pages at a time.
+/// @details Page data itself stays wherever it lives (the profile in flash, or the compiled-in tables) and is only
+/// looked at when a page is loaded in here. Loading is a fixed amount of work per key whatever the page count,
+/// and neighbours of the page that's up are loaded ahead of time while the display is idle, so flips are hits.
+/// Core1 only.
+class DeckPages {
+public:
+    typedef struct Page_s {
+        int page;                               // -1 while empty
+        const DeckPrefs::Pages_t *info;         // name & colour, nullptr if the page has none
+        uint16_t codes[UI_KEY_CELLS];           // report code per key cell, 0 if unbound
+        const DeckPrefs::KeyBM_t *icons[UI_KEY_CELLS];
+        uint16_t toggles;                       // key cells whose icon flips on every press
+        uint32_t lastUsed;
+    } Page_t;
+
+    /// @brief Empties the working set, has to come before anything else
+    /// @param keyPics Compiled-in key icons, [cell][page] for the first pagesStride pages
+    /// @param pagesProfile Profile the pages come from, used if it's loaded (else it's the compiled-in ones)
+    void Begin(const DeckPrefs::KeyBM_t *const *keyPics, const int &pagesStride, const DeckProfile *pagesProfile);
+
+    /// @brief A page, loaded in place of the least recently used one if it isn't resident
+    const Page_t &Get(const int &page);
+
+    /// @brief Queues up a page's neighbours to be loaded ahead of time
+    /// @param count Pages there are, for wrapping around
+    void PrefetchAround(const int &page, const int &count);
+
+    /// @brief Loads one queued page, if there's any
+    /// @return Whether a page was loaded
+    bool PrefetchStep();
+
+    /// @brief Drops everything resident, for when the pages themselves changed (e.g. a new profile)
+    void Invalidate();
+
+    /// @brief Profile the pages come from
+    const DeckProfile *Profile() const { return profile; }
+
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t prefetches = 0;
+
+private:
+    /// @brief Resolves a page into a slot
+    void Load(Page_t &slot, const int &page);
+
+    /// @return The resident slot holding a page, or nullptr
+    Page_t *Find(const int &page);
+
+    /// @return Least recently used slot, other than the current page's
+    Page_t &Victim();
+
+    Page_t slots[PAGES_RESIDENT] = {};
+    uint32_t useCount = 0;
+    // last page handed out by Get(), -1 if none
+    int current = -1;
+
+    // pages queued up by PrefetchAround(), -1 if none
+    int prefetch[2] = {-1, -1};
+
+    const DeckPrefs::KeyBM_t *const *builtInPics = nullptr;
+    int builtInStride = 0;
+    const DeckProfile *profile = nullptr;
+};
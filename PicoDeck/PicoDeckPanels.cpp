@@ -0,0 +1,297 @@
+/*!
+ * @file PicoDeckPanels.cpp
+ * @brief Secondary per-key/per-row OLED panels, pushed over DMA on both I2C controllers at once.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <algorithm>
+
+#include "PicoDeckPanels.h"
+#include "PicoDeckStats.h"
+
+int DeckPanels::Begin(TwoWire *mainWire)
+{
+    buses[0].wire = &Wire;
+    buses[1].wire = &Wire1;
+    for(Bus_t &bus : buses) {
+        bus.dma.channel = -1;
+        bus.panel = -1;
+        bus.step = Step_Next;
+        bus.muxChannel = -1;
+        bus.cursor = 0;
+        bus.fastClock = false;
+    }
+
+#if DECK_HAS_I2C_DMA
+    bool busStarted[PANEL_BUSES] = {};
+
+    for(const Desc_t &desc : PanelDesc) {
+        if(panelsCount >= PANELS_MAX) break;
+        if(desc.bus >= PANEL_BUSES || desc.type >= Adafruit_MultiDisplay::SPI_SSD1306) continue;
+        Bus_t &bus = buses[desc.bus];
+
+        // the main display's bus is already running, pins can only be set on the other one before it starts
+        if(bus.wire != mainWire && !busStarted[desc.bus]) {
+            bus.wire->setSDA(PANEL_SDA);
+            bus.wire->setSCL(PANEL_SCL);
+            bus.wire->begin();
+        }
+        busStarted[desc.bus] = true;
+
+        // init sequence is sent the ordinary blocking way, it's only once
+        MuxSelect(bus, desc.muxChannel);
+        Adafruit_MultiDisplay *display = new Adafruit_MultiDisplay(bus.wire, desc.type, desc.width, desc.height, desc.address);
+        if(!display->begin()) {
+            delete display;
+            continue;
+        }
+
+        Panel_t &panel = panels[panelsCount++];
+        panel.display = display;
+        panel.desc = desc;
+        panel.retries = 0;
+        panel.online = true;
+
+        // begin() leaves a cleared buffer, but the glass still has whatever was in RAM
+        memset(display->getBuffer(), 0, desc.width * ((desc.height+7) >> 3));
+        panel.dirtyPages = (1 << ((desc.height+7) >> 3)) - 1;
+
+        if(desc.layout == Layout_KeyCell) {
+            panel.scale = std::min(desc.width / OLED_KEY_BOX_WIDTH, desc.height / OLED_KEY_BOX_HEIGHT);
+            if(!panel.scale) panel.scale = 1;
+            panel.originX = (desc.width - OLED_KEY_BOX_WIDTH * panel.scale) / 2;
+        } else {
+            panel.scale = 1;
+            panel.originX = (desc.width - 32 * OLED_KEYS_COLUMNS) / 2;
+        }
+        panel.originY = (desc.height - OLED_KEY_BOX_HEIGHT * panel.scale) / 2;
+
+        if(bus.dma.channel < 0)
+            DeckI2CClaim(bus.dma, bus.wire);
+    }
+
+    // leave muxes closed, so nothing behind them answers to the main display's address
+    for(Bus_t &bus : buses)
+        MuxSelect(bus, -1);
+#else
+    // no way to push panels in the background, and blocking pushes would stall every frame
+    (void)mainWire;
+#endif // DECK_HAS_I2C_DMA
+
+    return panelsCount;
+}
+
+void DeckPanels::KeyDraw(const int &cell, const uint8_t *bitmap, const bool &inverted)
+{
+    for(int p = 0; p < panelsCount; ++p) {
+        Panel_t &panel = panels[p];
+        if(!panel.online) continue;
+
+        int slotX = panel.originX;
+        switch(panel.desc.layout) {
+        case Layout_KeyCell:
+            if(cell != panel.desc.index) continue;
+            break;
+        case Layout_KeyRow:
+            if(cell / OLED_KEYS_COLUMNS != panel.desc.index) continue;
+            slotX += 32 * (cell % OLED_KEYS_COLUMNS);
+            break;
+        }
+
+        const int width = panel.desc.width;
+        const int height = panel.desc.height;
+        const int scale = panel.scale;
+        uint8_t *fb = panel.display->getBuffer();
+
+        // panel RAM is page-vertical, so go bit by bit and only touch bytes that differ
+        for(int y = 0; y < OLED_KEY_BOX_HEIGHT * scale; ++y) {
+            const int py = panel.originY + y;
+            if(py < 0 || py >= height) continue;
+
+            const uint8_t *src = bitmap + (y / scale) * KEYBM_ROW_BYTES;
+            uint8_t *col = fb + (py >> 3) * width;
+            const uint8_t mask = 1 << (py & 7);
+
+            for(int x = 0; x < OLED_KEY_BOX_WIDTH * scale; ++x) {
+                const int px = slotX + x;
+                if(px < 0 || px >= width) continue;
+
+                const int sx = x / scale;
+                const bool on = ((src[sx >> 3] >> (7 - (sx & 7))) & 1) != inverted;
+                if(((col[px] & mask) != 0) != on) {
+                    col[px] ^= mask;
+                    panel.dirtyPages |= 1 << (py >> 3);
+                }
+            }
+        }
+    }
+}
+
+void DeckPanels::Service()
+{
+    for(int b = 0; b < PANEL_BUSES; ++b) {
+        Bus_t &bus = buses[b];
+        if(bus.dma.channel < 0 || !BusIdle(bus)) continue;
+        BusAdvance(b);
+    }
+}
+
+void DeckPanels::BusRelease(TwoWire *wire)
+{
+    for(Bus_t &bus : buses) {
+        if(bus.wire != wire || bus.dma.channel < 0) continue;
+
+        while(!BusIdle(bus)) tight_loop_contents();
+
+        // a page caught between its address and data transactions starts over afterwards
+        if(bus.step != Step_Next) {
+            panels[bus.panel].dirtyPages |= 1 << bus.page;
+            bus.step = Step_Next;
+        }
+
+        MuxSelect(bus, -1);
+        bus.fastClock = false;
+    }
+}
+
+void DeckPanels::BusesSettle()
+{
+    // the rest of the queue just goes out once Service() runs again
+    for(Bus_t &bus : buses)
+        if(bus.dma.channel >= 0)
+            while(!BusIdle(bus)) tight_loop_contents();
+}
+
+bool DeckPanels::Idle() const
+{
+    for(int p = 0; p < panelsCount; ++p)
+        if(panels[p].online && panels[p].dirtyPages) return false;
+
+    // a bus holds onto its panel until Service() sees the transfer through
+    for(const Bus_t &bus : buses)
+        if(bus.panel >= 0) return false;
+
+    return true;
+}
+
+void DeckPanels::BusStart(Bus_t &bus, const uint8_t &addr, const int &len)
+{
+#if DECK_HAS_I2C_DMA
+    DeckI2CSend(bus.dma, addr, bus.xfer, len);
+#endif // DECK_HAS_I2C_DMA
+}
+
+bool DeckPanels::BusIdle(Bus_t &bus)
+{
+#if DECK_HAS_I2C_DMA
+    switch(DeckI2CPoll(bus.dma)) {
+    case DeckI2C_Aborted:
+        // NACK'd: the rest of this page was dropped, so requeue it
+        ++aborts;
+        DeckStats::Count(DeckStats::Count_PanelAborts);
+
+        if(bus.panel >= 0) {
+            Panel_t &panel = panels[bus.panel];
+            if(++panel.retries >= PANEL_RETRIES_MAX) panel.online = false;
+            else panel.dirtyPages |= 1 << bus.page;
+            bus.panel = -1;
+        }
+        bus.step = Step_Next;
+        bus.muxChannel = -1;
+        return false;
+    case DeckI2C_Busy:
+        return false;
+    default:
+        return true;
+    }
+#else
+    return true;
+#endif // DECK_HAS_I2C_DMA
+}
+
+void DeckPanels::BusAdvance(const int &b)
+{
+    Bus_t &bus = buses[b];
+
+    switch(bus.step) {
+    case Step_Next:
+    {
+        // previous page (if any) made it out
+        if(bus.panel >= 0) {
+            panels[bus.panel].retries = 0;
+            bus.panel = -1;
+        }
+
+        for(int n = 1; n <= panelsCount; ++n) {
+            const int p = (bus.cursor + n) % panelsCount;
+            const Panel_t &panel = panels[p];
+            if(panel.desc.bus == b && panel.online && panel.dirtyPages) {
+                bus.panel = p;
+                bus.cursor = p;
+                break;
+            }
+        }
+        if(bus.panel < 0) return;
+
+        // display drivers drop the clock back down after their own transfers
+        if(!bus.fastClock) {
+            bus.wire->setClock(PANEL_I2C_CLOCK);
+            bus.fastClock = true;
+        }
+
+        Panel_t &panel = panels[bus.panel];
+        bus.page = __builtin_ctz(panel.dirtyPages);
+        // cleared now, so anything drawn while this page is in flight queues it again
+        panel.dirtyPages &= ~(1 << bus.page);
+
+        if(panel.desc.muxChannel != bus.muxChannel) {
+            bus.xfer[0] = panel.desc.muxChannel < 0 ? 0 : 1 << panel.desc.muxChannel;
+            bus.muxChannel = panel.desc.muxChannel;
+            bus.step = Step_Address;
+            BusStart(bus, PANEL_MUX_ADDR, 1);
+            return;
+        }
+    }
+    // fall through
+    case Step_Address:
+    {
+        Panel_t &panel = panels[bus.panel];
+        uint8_t cmds[6];
+        const int count = panel.display->pageCommands(bus.page, cmds);
+
+        bus.xfer[0] = 0x00; // Co = 0, D/C = 0: command stream
+        for(int i = 0; i < count; ++i)
+            bus.xfer[1+i] = cmds[i];
+        bus.step = Step_Data;
+        BusStart(bus, panel.desc.address, count + 1);
+        break;
+    }
+    case Step_Data:
+    {
+        Panel_t &panel = panels[bus.panel];
+        const int width = panel.desc.width;
+        const uint8_t *src = panel.display->getBuffer() + bus.page * width;
+
+        bus.xfer[0] = 0x40; // Co = 0, D/C = 1: data stream
+        for(int i = 0; i < width; ++i)
+            bus.xfer[1+i] = src[i];
+        bus.step = Step_Next;
+        BusStart(bus, panel.desc.address, width + 1);
+        break;
+    }
+    }
+}
+
+void DeckPanels::MuxSelect(Bus_t &bus, const int8_t &channel)
+{
+    if(channel == bus.muxChannel) return;
+
+    bus.wire->beginTransmission(PANEL_MUX_ADDR);
+    bus.wire->write(channel < 0 ? 0 : 1 << channel);
+    bus.wire->endTransmission();
+    bus.muxChannel = channel;
+}
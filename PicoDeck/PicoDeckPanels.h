@@ -0,0 +1,125 @@
+/*!
+ * @file PicoDeckPanels.h
+ * @brief Secondary per-key/per-row OLED panels, pushed over DMA on both I2C controllers at once.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <Wire.h>
+
+#include "PicoDeckPlatform.h"
+#include "PicoDeckDisplay.h"
+
+#define PANELS_MAX 16
+// I2C0 (Wire) & I2C1 (Wire1)
+#define PANEL_BUSES 2
+// TCA9548A-style mux, channel select is a single byte bitmask
+#define PANEL_MUX_ADDR 0x70
+// longest single transaction: control byte + one full 128px page
+#define PANEL_XFER_MAX (1 + 128)
+// SSD1306/SH1106 both cope with fast-mode plus in practice
+#define PANEL_I2C_CLOCK 1000000
+// consecutive aborted transfers before a panel is considered unplugged
+#define PANEL_RETRIES_MAX 3
+
+class DeckPanels {
+public:
+    enum Layout_e {
+        Layout_KeyCell = 0, // one key cell, magnified to fit the panel
+        Layout_KeyRow,      // a whole row of key cells, side by side at 1:1
+    };
+
+    typedef struct Desc_s {
+        Adafruit_MultiDisplay::ScreenType_e type;
+        uint8_t bus;        // 0 = Wire (I2C0), 1 = Wire1 (I2C1)
+        uint8_t address;
+        int8_t muxChannel;  // -1 if wired straight to the bus
+        uint8_t width;
+        uint8_t height;
+        Layout_e layout;
+        uint8_t index;      // key cell or key row, per layout
+    } Desc_t;
+
+    // Panel descriptors, defined in PicoDeck.h
+    static std::vector<Desc_t> PanelDesc;
+
+    /// @brief Brings up every panel in PanelDesc, skipping any that don't respond
+    /// @param mainWire Bus of the main display, whose pins are already set up; the other bus uses PANEL_SDA/PANEL_SCL
+    /// @return Number of panels online, always 0 where there's no I2C DMA
+    int Begin(TwoWire *mainWire);
+
+    /// @brief Draws a key cell into every panel mirroring it, marking only pages whose bytes actually changed
+    /// @param cell Key cell index
+    /// @param bitmap Row-major 31x16 key box contents
+    /// @param inverted Draw highlighted (pressed)
+    void KeyDraw(const int &cell, const uint8_t *bitmap, const bool &inverted);
+
+    /// @brief Moves each bus's transfer queue along by one transaction if that bus is free, never blocks
+    /// @details Both controllers are kicked from the same call, so pages go out on Wire and Wire1 concurrently.
+    void Service();
+
+    /// @brief Waits out any transfer in flight on a bus and deselects its mux, so blocking Wire calls can use it
+    /// @param wire Bus about to be used by the caller
+    void BusRelease(TwoWire *wire);
+
+    /// @brief Waits out every bus's transfer in flight without starting another, e.g. ahead of a flash write
+    void BusesSettle();
+
+    /// @brief Whether there's nothing being pushed or waiting to be, i.e. Service() can go uncalled for a while
+    bool Idle() const;
+
+    // transfers aborted by NACKs/arbitration loss since boot
+    unsigned int aborts = 0;
+
+private:
+    typedef struct Panel_s {
+        Adafruit_MultiDisplay *display;
+        Desc_t desc;
+        uint16_t dirtyPages;    // one bit per 8px-tall page still to be pushed
+        uint8_t scale;          // key box magnification
+        int16_t originX;        // top-left of the first key box slot
+        int16_t originY;
+        uint8_t retries;
+        bool online;
+    } Panel_t;
+
+    enum Step_e {
+        Step_Next = 0,  // pick the next dirty page on this bus
+        Step_Address,   // point the panel's RAM at that page
+        Step_Data,      // push the page
+    };
+
+    typedef struct Bus_s {
+        TwoWire *wire;
+        DeckI2CDma_t dma;       // channel's -1 if no panels on this bus
+        int8_t panel;           // panel being pushed, -1 if none
+        uint8_t page;
+        Step_e step;
+        int8_t muxChannel;      // channel currently selected, -1 if none
+        uint8_t cursor;         // round-robin position, so no one panel starves the others
+        bool fastClock;         // set to PANEL_I2C_CLOCK since the bus was last handed over
+        uint16_t xfer[PANEL_XFER_MAX]; // I2C DATA_CMD words, fed to the controller's TX FIFO by DMA
+    } Bus_t;
+
+    /// @brief Starts pushing len words of the bus's xfer buffer to a target, ending in a STOP
+    void BusStart(Bus_t &bus, const uint8_t &addr, const int &len);
+
+    /// @brief Whether the bus has finished its last transaction, handling aborts along the way
+    bool BusIdle(Bus_t &bus);
+
+    /// @brief Starts the next transaction queued on a free bus, if any
+    void BusAdvance(const int &b);
+
+    /// @brief Blocking mux channel select, for init & bus handover
+    void MuxSelect(Bus_t &bus, const int8_t &channel);
+
+    Panel_t panels[PANELS_MAX];
+    int panelsCount = 0;
+
+    Bus_t buses[PANEL_BUSES];
+};
@@ -0,0 +1,233 @@
+/*!
+ * @file PicoDeckPixels.cpp
+ * @brief NeoPixel strip fed by PIO & DMA, with a fixed-rate, fixed-point effects engine on top.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+
+#include "PicoDeckPixels.h"
+
+const uint8_t DeckPixels::gamma[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+      3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+      7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+     13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+     20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+     30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+     42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+     58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+     76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+     97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+    122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+    150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+    182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+    218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+
+#if DECK_HAS_PIO_PIXELS
+// PIO clocks per bit: low 3, high 2, then high 5 more for a 1 or low 5 for a 0 (800KHz at 8MHz)
+#define PIXELS_BIT_CYCLES 10
+
+// pico-examples' ws2812 program (pioasm output), bits come in from the top of autopulled 24-bit words
+static const uint16_t ws2812Instructions[] = {
+            //     .wrap_target
+    0x6221, //  0: out    x, 1            side 0 [2]
+    0x1123, //  1: jmp    !x, 3           side 1 [1]
+    0x1400, //  2: jmp    0               side 1 [4]
+    0xa442, //  3: nop                    side 0 [4]
+            //     .wrap
+};
+
+static const struct pio_program ws2812Program = {
+    .instructions = ws2812Instructions,
+    .length = 4,
+    .origin = -1,
+};
+#endif // DECK_HAS_PIO_PIXELS
+
+DeckPixels::DeckPixels(const uint8_t &level)
+{
+    Brightness(level);
+}
+
+bool DeckPixels::Begin(const int &pin)
+{
+#if DECK_HAS_PIO_PIXELS
+    PIO pio = pio0;
+    if(!pio_can_add_program(pio, &ws2812Program)) pio = pio1;
+    if(!pio_can_add_program(pio, &ws2812Program)) return false;
+
+    const int sm = pio_claim_unused_sm(pio, false);
+    if(sm < 0) return false;
+    const unsigned int offset = pio_add_program(pio, &ws2812Program);
+
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    pio_sm_config config = pio_get_default_sm_config();
+    sm_config_set_wrap(&config, offset, offset + ws2812Program.length - 1);
+    sm_config_set_sideset(&config, 1, false, false);
+    sm_config_set_sideset_pins(&config, pin);
+    sm_config_set_out_shift(&config, false, true, 24);
+    sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+    sm_config_set_clkdiv(&config, clock_get_hz(clk_sys) / (800000.0f * PIXELS_BIT_CYCLES));
+    pio_sm_init(pio, sm, offset, &config);
+    pio_sm_set_enabled(pio, sm, true);
+
+    dmaChannel = dma_claim_unused_channel(false);
+    if(dmaChannel < 0) {
+        // no use holding on to the state machine & program without a channel to feed them
+        pio_sm_set_enabled(pio, sm, false);
+        pio_sm_unclaim(pio, sm);
+        pio_remove_program(pio, &ws2812Program, offset);
+        return false;
+    }
+
+    dma_channel_config dmaConfig = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&dmaConfig, true);
+    channel_config_set_write_increment(&dmaConfig, false);
+    channel_config_set_dreq(&dmaConfig, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dmaChannel, &dmaConfig, &pio->txf[sm], shown, PIXELS_COUNT, false);
+
+    // strip powers up in whatever state, so the first frame goes out even if it's all off
+    memset(shown, 0xFF, sizeof(shown));
+    settled = false;
+    return true;
+#else
+    (void)pin;
+    return false;
+#endif // DECK_HAS_PIO_PIXELS
+}
+
+void DeckPixels::Brightness(const uint8_t &level)
+{
+    for(int i = 0; i < 256; ++i)
+        levels[i] = (gamma[i] * (level + 1)) >> 8;
+    settled = false;
+}
+
+void DeckPixels::Fade(const uint32_t &rgb, const uint32_t &now)
+{
+    // from wherever it is, so a page flip mid-fade carries on smoothly
+    fadeFrom = Base(now);
+    fadeTo = {(uint8_t)(rgb & 0xFF), (uint8_t)((rgb >> 8) & 0xFF), (uint8_t)((rgb >> 16) & 0xFF)};
+    fadeStart = now;
+    lastActivity = now;
+    settled = false;
+}
+
+void DeckPixels::Flash(const int &pixel, const uint32_t &now)
+{
+    if(pixel < 0 || pixel >= PIXELS_COUNT) return;
+
+    flashStart[pixel] = now;
+    flashes |= 1 << pixel;
+    lastActivity = now;
+    settled = false;
+}
+
+bool DeckPixels::Tick(const uint32_t &now)
+{
+    if((int32_t)(now - nextFrame) < 0) return false;
+
+    // frames we're already late for are dropped rather than caught up on
+    nextFrame += PIXELS_FRAME_MS;
+    if((int32_t)(now - nextFrame) >= 0) nextFrame = now + PIXELS_FRAME_MS;
+
+    // settling doesn't cover breathing, which starts by itself once things have been idle long enough
+    if(settled && !Breathing(now)) return false;
+
+    const bool moving = Render(now);
+    if(!memcmp(frame, shown, sizeof(frame))) {
+        settled = !moving;
+        return false;
+    }
+
+    const bool sent = Send();
+    settled = !moving && sent;
+    return sent;
+}
+
+uint32_t DeckPixels::Wait(const uint32_t &now) const
+{
+    const uint32_t frameWait = (int32_t)(nextFrame - now) > 0 ? nextFrame - now : 0;
+    if(!settled || Breathing(now)) return frameWait;
+
+    // settled & unlit, nothing happens until something's started; settled & lit, nothing until breathing starts
+    if(!(fadeTo.r | fadeTo.g | fadeTo.b) || !levels[0xFF]) return UINT32_MAX;
+    return PIXELS_BREATHE_AFTER - (now - lastActivity);
+}
+
+bool DeckPixels::Breathing(const uint32_t &now) const
+{
+    return now - lastActivity >= PIXELS_BREATHE_AFTER && (fadeTo.r | fadeTo.g | fadeTo.b) && levels[0xFF];
+}
+
+uint32_t DeckPixels::Breath(const uint32_t &elapsed)
+{
+    const uint32_t half = PIXELS_BREATHE_MS / 2;
+    const uint32_t phase = elapsed % PIXELS_BREATHE_MS;
+    // out, then back in
+    const uint32_t wave = phase < half ? 256 - (phase << 8) / half : ((phase - half) << 8) / half;
+    return PIXELS_BREATHE_FLOOR + (((256 - PIXELS_BREATHE_FLOOR) * wave) >> 8);
+}
+
+DeckPixels::Rgb_t DeckPixels::Base(const uint32_t &now) const
+{
+    const uint32_t t = Progress(now - fadeStart, PIXELS_FADE_MS);
+    return {Mix(fadeFrom.r, fadeTo.r, t), Mix(fadeFrom.g, fadeTo.g, t), Mix(fadeFrom.b, fadeTo.b, t)};
+}
+
+bool DeckPixels::Render(const uint32_t &now)
+{
+    const Rgb_t base = Base(now);
+    bool moving = Progress(now - fadeStart, PIXELS_FADE_MS) < 256;
+
+    // breathing an unlit (or fully dimmed) strip would only ever come out black
+    uint32_t breath = 256;
+    const uint32_t idle = now - lastActivity;
+    if(idle >= PIXELS_BREATHE_AFTER && (base.r | base.g | base.b) && levels[0xFF]) {
+        breath = Breath(idle - PIXELS_BREATHE_AFTER);
+        moving = true;
+    }
+
+    for(int p = 0; p < PIXELS_COUNT; ++p) {
+        uint32_t flash = 0;
+        if(flashes & 1 << p) {
+            const uint32_t t = Progress(now - flashStart[p], PIXELS_FLASH_MS);
+            if(t < 256) {
+                flash = 256 - t;
+                moving = true;
+            } else flashes &= ~(1 << p);
+        }
+
+        const uint8_t r = Mix(Mix(0, base.r, breath), 0xFF, flash);
+        const uint8_t g = Mix(Mix(0, base.g, breath), 0xFF, flash);
+        const uint8_t b = Mix(Mix(0, base.b, breath), 0xFF, flash);
+        frame[p] = (uint32_t)levels[g] << 24 | (uint32_t)levels[r] << 16 | (uint32_t)levels[b] << 8;
+    }
+
+    return moving;
+}
+
+bool DeckPixels::Send()
+{
+#if DECK_HAS_PIO_PIXELS
+    if(dmaChannel < 0) return false;
+    // ~30us a pixel, so this only happens if frames are coming far faster than PIXELS_FPS
+    if(dma_channel_is_busy(dmaChannel)) return false;
+
+    memcpy(shown, frame, sizeof(shown));
+    dma_channel_transfer_from_buffer_now(dmaChannel, shown, PIXELS_COUNT);
+#else
+    memcpy(shown, frame, sizeof(shown));
+#endif // DECK_HAS_PIO_PIXELS
+    ++framesSent;
+    return true;
+}
@@ -0,0 +1,139 @@
+/*!
+ * @file PicoDeckPixels.h
+ * @brief NeoPixel strip fed by PIO & DMA, with a fixed-rate, fixed-point effects engine on top.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "PicoDeckPlatform.h"
+
+// LEDs on the strip
+#define PIXELS_COUNT 6
+
+// Effect frames per second; the strip latches in well under a frame, so one is always done by the next
+#define PIXELS_FPS 50
+#define PIXELS_FRAME_MS (1000 / PIXELS_FPS)
+
+// Default brightness the gamma table gets scaled by, 0-255
+#define PIXELS_BRIGHTNESS 255
+
+// ms a page colour crossfade takes
+#define PIXELS_FADE_MS 300
+
+// ms a press's flash takes to decay back to the page colour
+#define PIXELS_FLASH_MS 250
+
+// ms with nothing pressed before the strip starts breathing, and ms per breath
+#define PIXELS_BREATHE_AFTER 10000
+#define PIXELS_BREATHE_MS 4000
+
+// Dimmest point of a breath, out of 256
+#define PIXELS_BREATHE_FLOOR 64
+
+/// @brief Drives the deck's WS2812 strip without ever waiting on it.
+/// @details Effects are worked out in 8.8 fixed point at a fixed frame rate, and only sent when a frame differs
+/// from what's already showing. Sending hands a copy of the frame to DMA, which feeds a PIO state machine
+/// doing the WS2812 timing, so the calling core is never held up for the transfer.
+/// Without PIO (i.e. off-target), frames are still worked out the same, they just don't go anywhere.
+class DeckPixels {
+public:
+    typedef struct Rgb_s {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    } Rgb_t;
+
+    /// @brief Constructor
+    /// @param level Brightness, 0-255
+    DeckPixels(const uint8_t &level = PIXELS_BRIGHTNESS);
+
+    /// @brief Claims a PIO state machine & DMA channel for the strip
+    /// @return Whether frames will actually go out
+    bool Begin(const int &pin);
+
+    /// @brief Rebuilds the output table for a brightness, 0-255
+    void Brightness(const uint8_t &level);
+
+    /// @brief Crossfades the whole strip from wherever it is now to a colour
+    /// @param rgb Packed as 0xBBGGRR, the same as DeckPrefs::Pages_t::color
+    void Fade(const uint32_t &rgb, const uint32_t &now);
+
+    /// @brief Flashes a pixel white, decaying back to the base colour; counts as activity, so breathing stops too
+    void Flash(const int &pixel, const uint32_t &now);
+
+    /// @brief Works out a frame if one's due and anything's moving, and sends it if it changed
+    /// @param now millis()
+    /// @return Whether a frame went out
+    bool Tick(const uint32_t &now);
+
+    /// @brief ms until Tick() could next have anything to send, for sleeping until then
+    uint32_t Wait(const uint32_t &now) const;
+
+    /// @brief The last frame worked out, one pixel per word, GRB from the top byte down (as the PIO shifts it out)
+    const uint32_t *Frame() const { return frame; }
+
+    /// @return a + (b - a) * t/256
+    static inline uint8_t Mix(const uint8_t &a, const uint8_t &b, const uint32_t &t) {
+        return a + ((((int32_t)b - a) * (int32_t)t) >> 8);
+    }
+
+    /// @return How far elapsed is through span, 0-256
+    static inline uint32_t Progress(const uint32_t &elapsed, const uint32_t &span) {
+        return elapsed >= span ? 256 : (elapsed << 8) / span;
+    }
+
+    /// @brief Breathing level some time into breathing, from 256 down to PIXELS_BREATHE_FLOOR and back
+    /// @details Just a triangle wave; the gamma table's curve is what makes it look eased.
+    static uint32_t Breath(const uint32_t &elapsed);
+
+    /// @brief Output level for a channel value, gamma corrected & brightness scaled
+    uint8_t Level(const uint8_t &value) const { return levels[value]; }
+
+    /// @brief Frames that actually went out to the strip
+    uint32_t framesSent = 0;
+
+private:
+    /// @brief Fills frame for a point in time
+    /// @return Whether anything's still moving, i.e. later frames could differ
+    bool Render(const uint32_t &now);
+
+    /// @return Base colour (page colour, mid-fade) at a point in time
+    Rgb_t Base(const uint32_t &now) const;
+
+    /// @brief Whether the strip's been left alone long enough to breathe, and is lit (& bright enough) to breathe with
+    bool Breathing(const uint32_t &now) const;
+
+    /// @brief Hands the frame to DMA, unless the last one's still going
+    bool Send();
+
+    // gamma 2.6, 0-255 in & out
+    static const uint8_t gamma[256];
+
+    // gamma scaled by brightness
+    uint8_t levels[256];
+
+    Rgb_t fadeFrom = {0, 0, 0};
+    Rgb_t fadeTo = {0, 0, 0};
+    uint32_t fadeStart = 0;
+
+    uint32_t flashStart[PIXELS_COUNT] = {};
+    uint32_t flashes = 0;               // pixels mid-flash
+
+    // last press or page change, for when breathing starts
+    uint32_t lastActivity = 0;
+
+    uint32_t nextFrame = 0;
+    // nothing moving & the last frame went out, so frames can be skipped until something starts again (or breathing's due)
+    bool settled = false;
+
+    uint32_t frame[PIXELS_COUNT] = {};
+    // copy DMA reads from, i.e. what's on the strip
+    uint32_t shown[PIXELS_COUNT] = {};
+
+    int dmaChannel = -1;
+};
@@ -0,0 +1,327 @@
+/*!
+ * @file PicoDeckPlatform.h
+ * @brief The few RP2040/arduino-pico specifics the deck modules lean on, kept behind one seam.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#include "PicoDeckStats.h"
+
+/// @brief Where a background I2C transfer's got to, as DeckI2CPoll() sees it
+enum DeckI2CState_e {
+    DeckI2C_Busy = 0,
+    DeckI2C_Idle,       ///< Last transfer's done (or there wasn't one)
+    DeckI2C_Aborted     ///< Last transfer was NACK'd/lost arbitration, and the rest of it dropped
+};
+
+// Sectors the prefs journal ping-pongs between
+#define DECK_FLASH_PREFS_SECTORS 2
+// Sectors set aside for the profile stores, just below the prefs journal
+#define DECK_FLASH_PROFILE_SECTORS 64
+
+// Everything else the modules use (digitalRead, millis/micros, Wire, SPI, LittleFS, the GFX drivers)
+// is plain Arduino API, so anything that provides those can build them - only what's below is core-specific.
+
+/// @brief Run before every flash erase/program once set, and only returns with the other core parked for it
+/// @details The sketch's hook (a FIFO request & acknowledgement) lets the other core get off the buses first,
+/// rather than being stopped wherever it happens to be.
+inline void (*deckFlashPark)() = nullptr;
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/i2c.h>
+#include <hardware/dma.h>
+#include <hardware/timer.h>
+#include <hardware/sync.h>
+#include <hardware/flash.h>
+#include <hardware/pio.h>
+#include <hardware/clocks.h>
+#include <pico/time.h>
+
+// start of the LittleFS partition (the EEPROM sector's, when there's none), and the end of the sketch image
+extern "C" uint8_t _FS_start;
+extern "C" uint8_t __flash_binary_end;
+
+// raw I2C controller registers + DMA, for pushing secondary panels without blocking
+#define DECK_HAS_I2C_DMA 1
+
+// PIO state machine + DMA, for driving the NeoPixels without blocking
+#define DECK_HAS_PIO_PIXELS 1
+
+/// @brief An I2C controller's TX FIFO fed by a DMA channel, for writing to a target without blocking
+typedef struct DeckI2CDma_s {
+    i2c_inst_t *i2c;
+    int channel;                // -1 until claimed
+    dma_channel_config config;
+} DeckI2CDma_t;
+
+/// @brief Claims a DMA channel for a bus's controller (the bus has to have been begun already)
+inline void DeckI2CClaim(DeckI2CDma_t &dma, TwoWire *wire)
+{
+    dma.i2c = wire == &Wire ? i2c0 : i2c1;
+    dma.channel = dma_claim_unused_channel(true);
+    dma.config = dma_channel_get_default_config(dma.channel);
+    channel_config_set_transfer_data_size(&dma.config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma.config, true);
+    channel_config_set_write_increment(&dma.config, false);
+    channel_config_set_dreq(&dma.config, i2c_get_dreq(dma.i2c, true));
+}
+
+/// @brief Points the controller at a target and starts DMA of len DATA_CMD words, the last one getting a STOP
+/// @param words Must stay put until DeckI2CPoll() says it's done
+inline void DeckI2CSend(DeckI2CDma_t &dma, const uint8_t &addr, uint16_t *words, const int &len)
+{
+    i2c_hw_t *hw = i2c_get_hw(dma.i2c);
+
+    // target can only be changed with the controller disabled
+    if(hw->tar != addr) {
+        hw->enable = 0;
+        hw->tar = addr;
+        hw->enable = 1;
+    }
+
+    words[len-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    dma_channel_configure(dma.channel, &dma.config, &hw->data_cmd, words, len, true);
+}
+
+/// @brief Whether the last DeckI2CSend() is still going, finished, or was aborted (reported just the once)
+inline DeckI2CState_e DeckI2CPoll(DeckI2CDma_t &dma)
+{
+    i2c_hw_t *hw = i2c_get_hw(dma.i2c);
+
+    if(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // controller's flushed its FIFO, so stop feeding it the rest
+        dma_channel_abort(dma.channel);
+        (void)hw->clr_tx_abrt;
+        return DeckI2C_Aborted;
+    }
+
+    return !dma_channel_is_busy(dma.channel) &&
+           (hw->status & I2C_IC_STATUS_TFE_BITS) &&
+           !(hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS) ? DeckI2C_Idle : DeckI2C_Busy;
+}
+
+/// @brief Starts a non-blocking SPI write of len bytes (arduino-pico DMA transfer)
+inline void DeckSPISend(SPIClass *spi, const void *buf, const size_t &len)
+{
+    spi->transferAsync(buf, nullptr, len);
+}
+
+/// @brief Whether the last DeckSPISend() has finished reading its buffer
+inline bool DeckSPIDone(SPIClass *spi)
+{
+    return spi->finishedAsync();
+}
+
+/// @brief Low 32 bits of the us timer, a single register read (micros() goes through the 64-bit latch)
+inline uint32_t DeckTimeUs() { return timer_hw->timerawl; }
+
+/// @brief Which core this is running on
+inline uint8_t DeckCoreNum() { return rp2040.cpuid(); }
+
+/// @brief Orders memory accesses between the cores
+inline void DeckMemoryBarrier() { __dmb(); }
+
+/// @brief Sleeps the calling core (WFE) until an interrupt, an event from the other core, or a DeckTimeUs() deadline
+/// @details Can wake early (any event does it), so callers just look for work again; never wakes later than the deadline.
+inline void DeckSleepUntil(const uint32_t &until)
+{
+    const int32_t left = until - DeckTimeUs();
+    if(left > 0) best_effort_wfe_or_timeout(make_timeout_time_us(left));
+}
+
+/// @brief Wakes the other core out of DeckSleepUntil() (FIFO pushes already do this themselves)
+inline void DeckWakeOther() { __sev(); }
+
+/// @brief One turn of a spin waiting on the other core to do something
+inline void DeckWaitOther() { tight_loop_contents(); }
+
+#define DECK_FLASH_SECTOR_SIZE FLASH_SECTOR_SIZE
+#define DECK_FLASH_PAGE_SIZE FLASH_PAGE_SIZE
+
+/// @brief The prefs journal's DECK_FLASH_PREFS_SECTORS sectors, just below the filesystem and outside the sketch image
+inline const uint8_t *DeckFlashRegion() { return &_FS_start - DECK_FLASH_PREFS_SECTORS * FLASH_SECTOR_SIZE; }
+
+/// @brief The profile stores' DECK_FLASH_PROFILE_SECTORS sectors, just below DeckFlashRegion()
+/// @details Not part of the image, so a UF2 neither carries them nor wipes them.
+inline const uint8_t *DeckFlashProfiles() { return DeckFlashRegion() - DECK_FLASH_PROFILE_SECTORS * FLASH_SECTOR_SIZE; }
+
+/// @brief Whether the sketch image ends before DeckFlashProfiles(), so writing to either region can't overwrite it
+inline bool DeckFlashRegionFree() { return &__flash_binary_end <= DeckFlashProfiles(); }
+
+/// @brief Erases one DECK_FLASH_SECTOR_SIZE sector back to 0xFF
+/// @details Nothing can run from flash meanwhile, so Core1 is parked and interrupts are off for the whole erase:
+/// USB goes unanswered for all of it (~45ms typical), which Stage_IrqOff keeps track of.
+/// @param sector Sector aligned address, as mapped by XIP
+inline void DeckFlashErase(const uint8_t *sector)
+{
+    if(deckFlashPark != nullptr) deckFlashPark();
+    noInterrupts();
+    const uint32_t start = DeckTimeUs();
+    rp2040.idleOtherCore();
+    flash_range_erase((intptr_t)sector - XIP_BASE, DECK_FLASH_SECTOR_SIZE);
+    rp2040.resumeOtherCore();
+    const uint32_t irqOff = DeckTimeUs() - start;
+    interrupts();
+    DeckStats::Sample(DeckStats::Stage_IrqOff, irqOff);
+}
+
+/// @brief Programs one DECK_FLASH_PAGE_SIZE page, bits can only go from 1 to 0
+/// @param dest Page aligned address, as mapped by XIP
+inline void DeckFlashProgram(const uint8_t *dest, const uint8_t *page)
+{
+    if(deckFlashPark != nullptr) deckFlashPark();
+    noInterrupts();
+    const uint32_t start = DeckTimeUs();
+    rp2040.idleOtherCore();
+    flash_range_program((intptr_t)dest - XIP_BASE, page, DECK_FLASH_PAGE_SIZE);
+    rp2040.resumeOtherCore();
+    const uint32_t irqOff = DeckTimeUs() - start;
+    interrupts();
+    DeckStats::Sample(DeckStats::Stage_IrqOff, irqOff);
+}
+#else
+#define DECK_HAS_PIO_PIXELS 0
+
+#ifndef DECK_HOST
+inline void tight_loop_contents() {}
+#endif
+
+#ifdef DECK_HOST
+// the host's SPI shim can hold async transfers in flight like DMA, so it goes the same way as on the deck
+inline void DeckSPISend(SPIClass *spi, const void *buf, const size_t &len)
+{
+    spi->transferAsync(buf, nullptr, len);
+}
+
+inline bool DeckSPIDone(SPIClass *spi) { return spi->finishedAsync(); }
+#else
+// no async transfers elsewhere, so sends just block and are always done
+inline void DeckSPISend(SPIClass *spi, const void *buf, const size_t &len)
+{
+    spi->transfer(buf, nullptr, len);
+}
+
+inline bool DeckSPIDone(SPIClass *) { return true; }
+#endif
+
+inline uint32_t DeckTimeUs() { return micros(); }
+
+inline void DeckMemoryBarrier() { __sync_synchronize(); }
+
+#ifdef DECK_HOST
+#include <DeckHost.h>
+
+// host build: both cores are emulated on one thread, sleeps just tell it how far the clock can jump
+inline uint8_t DeckCoreNum() { return DeckHost::core; }
+
+inline void DeckSleepUntil(const uint32_t &until) { DeckHost::SleepUntil(until); }
+
+inline void DeckWakeOther() { DeckHost::Wake(!DeckHost::core); }
+
+// one thread, so the other core has to be run for whatever's being waited on to happen
+inline void DeckWaitOther() { DeckHost::RunOther(); }
+
+// flash operations take their (typical) time out of the virtual clock
+inline void DeckFlashBusy(const uint32_t &us) { DeckHost::now += us; }
+
+// spinning on a transfer going on in the background, which only finishes if the clock moves
+inline void tight_loop_contents() { DeckHost::now += 1; }
+
+// panels are pushed through the Wire shim, with the bus held busy for as long as the bytes would take
+#define DECK_HAS_I2C_DMA 1
+
+typedef struct DeckI2CDma_s {
+    TwoWire *wire;
+    int channel;                // -1 until claimed
+    uint32_t busyUntil;
+    bool aborted;
+} DeckI2CDma_t;
+
+inline void DeckI2CClaim(DeckI2CDma_t &dma, TwoWire *wire)
+{
+    dma.wire = wire;
+    dma.channel = 0;
+    dma.busyUntil = DeckTimeUs();
+    dma.aborted = false;
+}
+
+inline void DeckI2CSend(DeckI2CDma_t &dma, const uint8_t &addr, uint16_t *words, const int &len)
+{
+    const uint64_t busTime = dma.wire->busTimeUs;
+    dma.wire->beginTransmission(addr);
+    for(int i = 0; i < len; ++i)
+        dma.wire->write((uint8_t)words[i]);
+    dma.aborted = dma.wire->endTransmission() != 0;
+    dma.busyUntil = DeckTimeUs() + (uint32_t)(dma.wire->busTimeUs - busTime);
+}
+
+inline DeckI2CState_e DeckI2CPoll(DeckI2CDma_t &dma)
+{
+    if((int32_t)(DeckTimeUs() - dma.busyUntil) < 0) return DeckI2C_Busy;
+    if(!dma.aborted) return DeckI2C_Idle;
+    dma.aborted = false;
+    return DeckI2C_Aborted;
+}
+#else
+#define DECK_HAS_I2C_DMA 0
+
+typedef struct DeckI2CDma_s {
+    int channel;                // never claimed, there's nothing to push panels with
+} DeckI2CDma_t;
+
+inline uint8_t DeckCoreNum() { return 0; }
+
+// nothing to sleep on, so callers just carry on polling like they would've anyway
+inline void DeckSleepUntil(const uint32_t &) {}
+
+inline void DeckWakeOther() {}
+
+inline void DeckWaitOther() {}
+
+inline void DeckFlashBusy(const uint32_t &) {}
+#endif // DECK_HOST
+
+#define DECK_FLASH_SECTOR_SIZE 4096
+#define DECK_FLASH_PAGE_SIZE 256
+
+// typical W25Q16JV timings (the Pico's flash)
+#define DECK_FLASH_ERASE_US 45000
+#define DECK_FLASH_PROGRAM_US 400
+
+// RAM stand-in for flash that behaves like NOR flash does (erases to 0xFF, programming only clears bits)
+alignas(DECK_FLASH_SECTOR_SIZE) inline uint8_t deckFlashSim[(DECK_FLASH_PROFILE_SECTORS + DECK_FLASH_PREFS_SECTORS) * DECK_FLASH_SECTOR_SIZE];
+inline const bool deckFlashSimInit = (memset(deckFlashSim, 0xFF, sizeof(deckFlashSim)), true);
+
+inline const uint8_t *DeckFlashRegion() { return deckFlashSim + DECK_FLASH_PROFILE_SECTORS * DECK_FLASH_SECTOR_SIZE; }
+
+inline const uint8_t *DeckFlashProfiles() { return deckFlashSim; }
+
+inline bool DeckFlashRegionFree() { return true; }
+
+inline void DeckFlashErase(const uint8_t *sector)
+{
+    if(deckFlashPark != nullptr) deckFlashPark();
+    memset(const_cast<uint8_t*>(sector), 0xFF, DECK_FLASH_SECTOR_SIZE);
+    DeckFlashBusy(DECK_FLASH_ERASE_US);
+    DeckStats::Sample(DeckStats::Stage_IrqOff, DECK_FLASH_ERASE_US);
+}
+
+inline void DeckFlashProgram(const uint8_t *dest, const uint8_t *page)
+{
+    if(deckFlashPark != nullptr) deckFlashPark();
+    for(size_t i = 0; i < DECK_FLASH_PAGE_SIZE; ++i)
+        const_cast<uint8_t*>(dest)[i] &= page[i];
+    DeckFlashBusy(DECK_FLASH_PROGRAM_US);
+    DeckStats::Sample(DeckStats::Stage_IrqOff, DECK_FLASH_PROGRAM_US);
+}
+#endif // ARDUINO_ARCH_RP2040
@@ -9,13 +9,18 @@
  * @date 2025
  */
 
+#include <algorithm>
+#include <string.h>
+
 #include "PicoDeckPrefs.h"
+#include "PicoDeckStats.h"
+
+static_assert(DECK_FLASH_PAGE_SIZE % sizeof(DeckPrefs::Record_t) == 0, "journal records can't straddle flash pages");
 
 DeckPrefs::DeckPrefs()
 {
-    if(InitFS() != Error_Success)
-        Serial.println("Flash error!");
-    else Load();
+    // the journal's read straight out of flash, LittleFS only gets mounted if it has to fall back on the old file
+    Load();
 }
 
 DeckPrefs::Errors_e DeckPrefs::InitFS()
@@ -27,6 +32,49 @@ DeckPrefs::Errors_e DeckPrefs::InitFS()
 
 DeckPrefs::Errors_e DeckPrefs::Load()
 {
+    if(!DeckFlashRegionFree()) {
+        Serial.println("Sketch overlaps the prefs sectors!");
+        return Error_NoStorage;
+    }
+
+    // the newest record is in whichever sector has the highest save count; the other's either erased,
+    // or (if a power cut came mid-compaction) holding older ones that get erased before it's used again
+    unsigned int used[DECK_FLASH_PREFS_SECTORS] = {};
+    for(int sector = 0; sector < DECK_FLASH_PREFS_SECTORS; ++sector) {
+        const uint8_t *flash = Sector(sector);
+        const Record_t *journal = (const Record_t*)flash;
+
+        // slots fill in order, so the first fully erased one is where the journal ends
+        for(used[sector] = 0; used[sector] < PREFS_JOURNAL_RECORDS; ++used[sector]) {
+            const uint8_t *slot = flash + used[sector] * sizeof(Record_t);
+            if(std::all_of(slot, slot + sizeof(Record_t), [](const uint8_t &b) { return b == 0xFF; }))
+                break;
+
+            const Record_t &record = journal[used[sector]];
+            if(record.magic == PREFS_RECORD_MAGIC && record.check == Checksum(record) &&
+               (!lastValid || record.saves > last.saves)) {
+                last = record;
+                lastValid = true;
+                journalSector = sector;
+            }
+        }
+    }
+    journalNext = used[journalSector];
+    spareDirty = used[(journalSector + 1) % DECK_FLASH_PREFS_SECTORS] > 0;
+
+    if(lastValid) {
+        curPage = last.curPage;
+        profile = last.profile < PROFILE_SLOTS ? last.profile : 0;
+        keyToggles = last.toggles;
+        saves = last.saves;
+        return Error_Success;
+    }
+
+    // nothing journaled yet, carry over the page from the old settings file
+    if(InitFS() != Error_Success) {
+        Serial.println("Flash error!");
+        return Error_NoData;
+    }
     File prefsFile = LittleFS.open("/Prefs.conf", "r");
     if(prefsFile) {
         curPage = prefsFile.read();
@@ -35,12 +83,99 @@ DeckPrefs::Errors_e DeckPrefs::Load()
     } else return Error_NoData;
 }
 
+bool DeckPrefs::Changed() const
+{
+    return !lastValid || last.curPage != curPage || last.profile != profile || last.toggles != keyToggles;
+}
+
 DeckPrefs::Errors_e DeckPrefs::Save()
 {
-    File prefsFile = LittleFS.open("/Prefs.conf", "w");
-    if(prefsFile) {
-        prefsFile.write((uint8_t)curPage);
-        prefsFile.close();
-        return Error_Success;
-    } else return Error_NoData;
+    if(!Changed()) return Error_Success;
+    if(!DeckFlashRegionFree()) return Error_NoStorage;
+
+    Record_t record = { PREFS_RECORD_MAGIC, 0, (uint16_t)curPage, saves+1, keyToggles, (uint8_t)profile, {} };
+    record.check = Checksum(record);
+
+    // both cores are held up from here until the page is programmed
+    const uint32_t stallStart = DeckTimeUs();
+    if(journalNext < PREFS_JOURNAL_RECORDS) {
+        // a bad slot is just skipped over, the next save goes in the one after it
+        if(!Program(Sector(journalSector), journalNext++, record)) {
+            DeckStats::Sample(DeckStats::Stage_FlashStall, DeckTimeUs() - stallStart);
+            return Error_Write;
+        }
+    } else {
+        // full: this record alone is the whole state, so it starts the spare sector off; the full one's left
+        // for SpareErase() to take care of in a moment of its own, so no save has to wait behind an erase
+        const int spare = (journalSector + 1) % DECK_FLASH_PREFS_SECTORS;
+        const uint8_t *flash = Sector(spare);
+        // (unless there was no such moment since the last time round)
+        if(spareDirty || !std::all_of(flash, flash + DECK_FLASH_SECTOR_SIZE, [](const uint8_t &b) { return b == 0xFF; })) {
+            DeckFlashErase(flash);
+            DeckStats::Count(DeckStats::Count_PrefsErases);
+            spareDirty = false;
+        }
+        if(!Program(flash, 0, record)) {
+            // spare's left dirty, so it's erased & tried again on the next save
+            spareDirty = true;
+            DeckStats::Sample(DeckStats::Stage_FlashStall, DeckTimeUs() - stallStart);
+            return Error_Write;
+        }
+
+        journalSector = spare;
+        journalNext = 1;
+        spareDirty = true;
+    }
+    DeckStats::Sample(DeckStats::Stage_FlashStall, DeckTimeUs() - stallStart);
+
+    last = record;
+    lastValid = true;
+    saves = record.saves;
+    return Error_Success;
+}
+
+DeckPrefs::Errors_e DeckPrefs::SpareErase()
+{
+    if(!spareDirty) return Error_Success;
+    if(!DeckFlashRegionFree()) return Error_NoStorage;
+
+    const uint8_t *flash = Sector((journalSector + 1) % DECK_FLASH_PREFS_SECTORS);
+    const uint32_t stallStart = DeckTimeUs();
+    DeckFlashErase(flash);
+    DeckStats::Count(DeckStats::Count_PrefsErases);
+    DeckStats::Sample(DeckStats::Stage_FlashStall, DeckTimeUs() - stallStart);
+
+    spareDirty = !std::all_of(flash, flash + DECK_FLASH_SECTOR_SIZE, [](const uint8_t &b) { return b == 0xFF; });
+    return spareDirty ? Error_Erase : Error_Success;
+}
+
+const uint8_t *DeckPrefs::Sector(const int &sector)
+{
+    return DeckFlashRegion() + sector * DECK_FLASH_SECTOR_SIZE;
+}
+
+bool DeckPrefs::Program(const uint8_t *sector, const unsigned int &slot, const Record_t &record)
+{
+    // flash programs whole pages; the rest of this one is programmed with what it already holds, which leaves it be
+    const size_t offset = slot * sizeof(Record_t);
+    const size_t pageStart = offset & ~(size_t)(DECK_FLASH_PAGE_SIZE-1);
+    uint8_t page[DECK_FLASH_PAGE_SIZE];
+    memcpy(page, sector + pageStart, DECK_FLASH_PAGE_SIZE);
+    memcpy(page + offset - pageStart, &record, sizeof(record));
+    DeckFlashProgram(sector + pageStart, page);
+    DeckStats::Count(DeckStats::Count_PrefsProgrammed, DECK_FLASH_PAGE_SIZE);
+
+    return !memcmp(sector + offset, &record, sizeof(record));
+}
+
+uint8_t DeckPrefs::Checksum(const Record_t &record)
+{
+    Record_t r = record;
+    r.check = 0;
+    const uint8_t *bytes = (const uint8_t*)&r;
+    uint8_t sum = 0;
+    for(size_t i = 0; i < sizeof(r); ++i)
+        sum += bytes[i];
+    // so an all-zero record doesn't pass
+    return ~sum;
 }
@@ -12,12 +12,22 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
 #include <string_view>
 #include <FS.h>
 #include <LittleFS.h>
 
 #include "blockImages.h"
+#include "PicoDeckPlatform.h"
+#include "PicoDeckProfile.h"
+
+// Prefs are journaled into the platform's raw flash region: fixed-size records of the whole saved state
+// are appended into one of its two sectors, and once that's full the latest state goes into the other one
+// before the full one's erased - so a power cut at any point still leaves an intact copy behind.
+// (changes whenever Record_t does; records from before are skipped, like torn ones)
+#define PREFS_RECORD_MAGIC 0xD3
+#define PREFS_JOURNAL_RECORDS (DECK_FLASH_SECTOR_SIZE / sizeof(DeckPrefs::Record_t))
+// pages of key toggle states kept, matching DeckDisplay::keyPics (OLED_KEYPICS_PAGES)
+#define PREFS_TOGGLE_PAGES 3
 
 class DeckPrefs
 {
@@ -41,16 +51,50 @@ public:
     Errors_e InitFS();
 
     /// @brief Load Previously Saved Data
+    /// @details Takes the newest intact journal record in either sector, or the page from the old /Prefs.conf if there's none yet.
     Errors_e Load();
 
     /// @brief Save Data to Flash
+    /// @details Appends one record to the journal, or does nothing at all if nothing changed since the last one.
+    /// When its sector's full, the record starts the spare sector off instead, and the full one becomes the
+    /// spare, left for SpareErase() (or erased here first next time round, if that never got to run).
     Errors_e Save();
 
-    /// @brief Strings storage struct for pages vector
-    typedef struct Pages_s {
-        char name[24];
-        uint32_t color;
-    } Pages_t;
+    /// @brief Erases the spare sector's old records, so the save that next fills the journal only has to program
+    /// @details Kept apart from Save() so each flash stall is at most one erase, and can wait for a quiet moment.
+    Errors_e SpareErase();
+
+    /// @brief Whether the spare sector still holds old records, i.e. SpareErase() has something to do
+    bool SpareDirty() const { return spareDirty; }
+
+    /// @brief Whether anything saved differs from what's in flash
+    bool Changed() const;
+
+    /// @brief One journal entry, a snapshot of everything saved
+    typedef struct Record_s {
+        uint8_t magic;      // PREFS_RECORD_MAGIC
+        uint8_t check;      // sum of the other bytes, catches records torn by a power cut
+        uint16_t curPage;
+        uint32_t saves;
+        uint64_t toggles;
+        uint8_t profile;    // profile slot in use
+        uint8_t reserved[15];   // records are a power of two in size, so whole ones fit in a flash page
+    } Record_t;
+
+    /// @brief Whether a key's icon is toggled on a page
+    /// @details Only the first PREFS_TOGGLE_PAGES pages keep toggle states, keys on any after are never toggled.
+    inline bool KeyToggled(const int &key, const int &page) const {
+        return page < PREFS_TOGGLE_PAGES && ((keyToggles >> (key * PREFS_TOGGLE_PAGES + page)) & 1);
+    }
+
+    /// @brief Flips a key's toggled state on a page
+    /// @details Core0 only; Core1 asks for it with a DECK_KEY_TOGGLE, so a save never reads half an update.
+    inline void KeyToggle(const int &key, const int &page) {
+        if(page < PREFS_TOGGLE_PAGES) keyToggles ^= 1ULL << (key * PREFS_TOGGLE_PAGES + page);
+    }
+
+    /// @brief Strings storage struct for pages vector, same as a profile's pages
+    typedef DeckProfile::Page_t Pages_t;
 
     /// @brief Pages metadata dynamic array
     /// @details Can be less than total available macro pages as defined in LightgunButtons::ButtonDesc
@@ -64,47 +108,131 @@ public:
     typedef struct {
         bool isPacked;
         const uint8_t *ptr;
+        /// @brief Frames & timings if animated (where ptr is its first frame), else left out/nullptr
+        const KeySprite_t *sprite;
     } KeyBM_t;
 
-    /// @brief Map of available pushkey bitmaps
-    /// @details Keys (effectively a filename) should be less than 16 characters
-    /// size should be
-    static inline std::unordered_map<std::string_view, KeyBM_t> bitmapsDB = {
-        {"none",            {false, no_icon}},
-        {"rec_start",       {true,  icon_rec_start}},
-        {"rec_pause",       {true,  icon_rec_pause}},
-        {"mic_toggle",      {true,  icon_mic_toggle}},
-        {"rallyx",          {true,  icon_rallyx}},
-        {"em_norm",         {false, em_norm}},
-        {"em_stern",        {false, em_stern}},
+    typedef struct {
+        const char *name;
+        KeyBM_t bm;
+    } KeyIcon_t;
+
+    /// @brief Every built-in pushkey bitmap, sorted by name so lookups can bisect it (checked at build time)
+    /// @details Names should be less than 16 characters. Use KEY_ICON("name") to pick one in code, which is resolved
+    /// when building (and won't build if there's no such icon); IconByName() is for names only known at runtime.
+    static constexpr KeyIcon_t Icons[] = {
+        {"dead",            {false, icon_dead}},
         {"em_angy",         {false, em_angy}},
-        {"em_sad",          {false, em_sad}},
-        {"em_smug",         {false, em_smug}},
+        {"em_blink",        {false, em_norm, &em_blink}},
+        {"em_confuzz",      {false, em_confuzz}},
         {"em_happy",        {false, em_happy}},
+        {"em_norm",         {false, em_norm}},
         {"em_pout",         {false, em_pout}},
-        {"em_confuzz",      {false, em_confuzz}},
+        {"em_sad",          {false, em_sad}},
+        {"em_smug",         {false, em_smug}},
+        {"em_stern",        {false, em_stern}},
         {"em_think",        {false, em_think}},
-        {"s_logo",          {false, icon_s_logo}},
-        {"dead",            {false, icon_dead}},
-        {"washed",          {false, icon_washed}},
+        {"mic_toggle",      {true,  icon_mic_toggle}},
+        {"none",            {false, no_icon}},
         {"pikohann",        {false, icon_pikohann}},
+        {"rallyx",          {true,  icon_rallyx}},
+        {"rec_pause",       {true,  icon_rec_pause}},
+        {"rec_start",       {true,  icon_rec_start}},
+        {"s_logo",          {false, icon_s_logo}},
+        {"scene_ar",        {true,  scene_arSwitch}},
+        {"scene_blank",     {false, scene_blank}},
+        {"scene_brb",       {false, scene_brb}},
+        {"scene_gaming",    {false, scene_gaming}},
         {"skit",            {false, icon_skit}},
         {"volHi",           {false, icon_volHi}},
-        {"volMid",          {false, icon_volMid}},
         {"volLow",          {false, icon_volLow}},
+        {"volMid",          {false, icon_volMid}},
         {"volOff",          {false, icon_volOff}},
+        {"washed",          {false, icon_washed}},
         {"zoom",            {true,  icon_zoom}},
-        {"scene_ar",        {true,  scene_arSwitch}},
-        {"scene_blank",     {false, scene_blank}},
-        {"scene_brb",       {false, scene_brb}},
-        {"scene_gaming",    {false, scene_gaming}},
     };
 
+    static constexpr int IconsCount = sizeof(Icons) / sizeof(Icons[0]);
+
+    /// @brief Index of a built-in icon by name
+    /// @return Its index in Icons, or -1 if there's none by that name
+    static constexpr int IconFind(const std::string_view &name) {
+        int lo = 0, hi = IconsCount;
+        while(lo < hi) {
+            const int mid = (lo + hi) >> 1;
+            const int cmp = name.compare(Icons[mid].name);
+            if(!cmp) return mid;
+            else if(cmp < 0) hi = mid;
+            else lo = mid + 1;
+        }
+        return -1;
+    }
+
+    /// @brief Built-in icon by name, for names that come in at runtime (e.g. from a profile)
+    /// @return nullptr if there's none by that name
+    static const KeyBM_t *IconByName(const char *name) {
+        const int id = IconFind(name);
+        return id < 0 ? nullptr : &Icons[id].bm;
+    }
+
+    /// @brief Passes a build-time icon index through, or fails the build if the name wasn't found
+    template<int id> static constexpr int IconId() {
+        static_assert(id >= 0, "no icon by that name in DeckPrefs::Icons");
+        return id;
+    }
+
+    /// @brief Whether Icons is sorted by name, which IconFind() depends on
+    static constexpr bool IconsSorted() {
+        for(int i = 1; i < IconsCount; ++i)
+            if(std::string_view(Icons[i-1].name).compare(Icons[i].name) >= 0) return false;
+        return true;
+    }
+
     /// @brief Local copy of current hotkeys page from LightgunButtons
     /// @details If comparison to LGB's page value returns false, signals page change for LEDs/OLED
     int curPage = 0;
 
+    /// @brief Profile slot in use (DeckProfile::Slot())
+    int profile = 0;
+
     bool pagesWrapAround = true;
 
     bool keyPicNullptrToText = true;
-};
\ No newline at end of file
+
+    /// @brief Slide the new page's keys in on page changes
+    bool pageSlide = true;
+
+    /// @brief Toggled state of every key's icon, bit (key * PREFS_TOGGLE_PAGES + page)
+    /// @details Only written by Core0 (see KeyToggle()); the display core reads single bits of it, which are
+    /// each in one word, so it never sees one half-flipped.
+    volatile uint64_t keyToggles = 0;
+
+    /// @brief Records ever written to the journal, kept across boots & erases
+    uint32_t saves = 0;
+
+private:
+    /// @brief Checksum for Record_t::check
+    static uint8_t Checksum(const Record_t &record);
+
+    /// @brief Start of one of the journal's sectors
+    static const uint8_t *Sector(const int &sector);
+
+    /// @brief Programs a record into a slot of a sector
+    /// @return Whether it reads back intact
+    static bool Program(const uint8_t *sector, const unsigned int &slot, const Record_t &record);
+
+    // last record written to/read from the journal, and whether there is one
+    Record_t last;
+    bool lastValid = false;
+
+    // sector being appended to, and its next free slot
+    int journalSector = 0;
+    unsigned int journalNext = 0;
+    // whether the other sector has anything in it
+    bool spareDirty = false;
+};
+
+static_assert(DeckPrefs::IconsSorted(), "DeckPrefs::Icons must be kept sorted by name");
+
+// Built-in icon by name, looked up while building
+#define KEY_ICON(name) (&DeckPrefs::Icons[DeckPrefs::IconId<DeckPrefs::IconFind(name)>()].bm)
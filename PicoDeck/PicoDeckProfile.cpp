@@ -0,0 +1,128 @@
+/*!
+ * @file PicoDeckProfile.cpp
+ * @brief Binary deck profile (pages, keymaps, icon references & colours), read in place from flash.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+
+#include "PicoDeckProfile.h"
+
+static_assert(DECK_FLASH_PROFILE_SECTORS % PROFILE_SLOTS == 0, "profile stores have to split the sectors evenly");
+static_assert(sizeof(DeckProfile::Header_t) % 4 == 0 && sizeof(DeckProfile::Page_t) % 4 == 0 &&
+              sizeof(DeckProfile::Binding_t) % 4 == 0 && sizeof(DeckProfile::Icon_t) % 4 == 0, "profile tables must stay 4-byte aligned");
+
+uint32_t DeckProfile::Checksum(const uint8_t *data, const size_t &len, const uint32_t &hash)
+{
+    uint32_t h = hash;
+    for(size_t i = 0; i < len; ++i)
+        h = (h ^ data[i]) * 16777619;
+    return h;
+}
+
+const DeckProfile::Header_t *DeckProfile::Validate(const uint8_t *blob, const size_t &len, const unsigned int &buttons)
+{
+    if(len < sizeof(Header_t)) return nullptr;
+
+    const Header_t *header = (const Header_t*)blob;
+    if(header->magic != PROFILE_MAGIC || header->version != PROFILE_VERSION || header->headerSize != sizeof(Header_t) ||
+       header->size > len || header->size < sizeof(Header_t) || header->buttons != buttons || !header->pages)
+        return nullptr;
+
+    // every table has to sit inside the blob, aligned
+    const auto fits = [&](const uint32_t &offset, const size_t &bytes) {
+        return !(offset & 3) && offset >= sizeof(Header_t) && offset <= header->size && bytes <= header->size - offset;
+    };
+    if(!fits(header->pagesOffset, header->pages * sizeof(Page_t)) ||
+       !fits(header->bindingsOffset, header->pages * buttons * sizeof(Binding_t)) ||
+       !fits(header->iconsOffset, header->icons * sizeof(Icon_t)))
+        return nullptr;
+
+    if(Checksum(blob + sizeof(Header_t), header->size - sizeof(Header_t)) != header->checksum)
+        return nullptr;
+
+    // strings get printed straight out of flash, so they have to end
+    const Page_t *pages = (const Page_t*)(blob + header->pagesOffset);
+    for(int i = 0; i < header->pages; ++i)
+        if(memchr(pages[i].name, 0, sizeof(pages[i].name)) == nullptr) return nullptr;
+    const Icon_t *icons = (const Icon_t*)(blob + header->iconsOffset);
+    for(int i = 0; i < header->icons; ++i)
+        if(memchr(icons[i].name, 0, sizeof(icons[i].name)) == nullptr) return nullptr;
+
+    return header;
+}
+
+bool DeckProfile::Begin(const unsigned int &buttons)
+{
+    // with the sketch over the stores, what's there is code rather than a profile
+    if(!DeckFlashRegionFree()) {
+        header = nullptr;
+        return false;
+    }
+    blob = Store();
+    header = Validate(blob, PROFILE_STORE_SIZE, buttons);
+    return header != nullptr;
+}
+
+bool DeckProfile::Stored() const
+{
+    if(!DeckFlashRegionFree()) return false;
+    const Header_t *stored = (const Header_t*)Store();
+    return stored->magic == PROFILE_MAGIC && stored->version == PROFILE_VERSION;
+}
+
+bool DeckProfile::StoreBegin()
+{
+    header = nullptr;
+    storeLen = PROFILE_STORE_SIZE;
+    if(!DeckFlashRegionFree()) return false;
+
+    storeLen = 0;
+    memset(pageBuf, 0xFF, sizeof(pageBuf));
+    // the header's gone with the first sector, so whatever's left after it can't be mistaken for a profile
+    DeckFlashErase(Store());
+    return true;
+}
+
+bool DeckProfile::StoreWrite(const uint8_t *data, const size_t &len)
+{
+    for(size_t i = 0; i < len; ++i) {
+        if(storeLen >= PROFILE_STORE_SIZE) return false;
+
+        pageBuf[storeLen % DECK_FLASH_PAGE_SIZE] = data[i];
+        if(!(++storeLen % DECK_FLASH_PAGE_SIZE)) {
+            StoreFlush(storeLen - DECK_FLASH_PAGE_SIZE);
+            memset(pageBuf, 0xFF, sizeof(pageBuf));
+        }
+    }
+    return true;
+}
+
+bool DeckProfile::StoreEnd(const unsigned int &buttons)
+{
+    if(storeLen % DECK_FLASH_PAGE_SIZE)
+        StoreFlush(storeLen & ~(size_t)(DECK_FLASH_PAGE_SIZE-1));
+    return Begin(buttons);
+}
+
+void DeckProfile::StoreClear()
+{
+    StoreBegin();
+    blob = nullptr;
+}
+
+void DeckProfile::StoreFlush(const size_t &offset)
+{
+    const uint8_t *store = Store();
+    // StoreBegin() already took care of the first sector
+    if(offset && !(offset % DECK_FLASH_SECTOR_SIZE))
+        DeckFlashErase(store + offset);
+    DeckFlashProgram(store + offset, pageBuf);
+}
+
+const uint8_t *DeckProfile::Store() const
+{
+    return DeckFlashProfiles() + slot * PROFILE_STORE_SIZE;
+}
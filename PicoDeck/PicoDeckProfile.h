@@ -0,0 +1,155 @@
+/*!
+ * @file PicoDeckProfile.h
+ * @brief Binary deck profile (pages, keymaps, icon references & colours), read in place from flash.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "PicoDeckPlatform.h"
+
+#define PROFILE_MAGIC 0x46504450    // "PDPF"
+// bumped whenever the layout changes; older blobs are rejected rather than misread
+#define PROFILE_VERSION 1
+// profiles kept in flash at once, each in its own store; slot 0 is the one used out of the box
+#define PROFILE_SLOTS 4
+// ms both page keys have to be held together before they switch to the next stored profile
+#define PROFILE_CHORD_HOLD_MS 800
+// flash set aside for each profile out of DeckFlashProfiles(), room for ~1000 pages of 16 buttons
+// (only read through XIP, so none of it has to fit in RAM)
+#define PROFILE_STORE_SIZE (DECK_FLASH_PROFILE_SECTORS / PROFILE_SLOTS * DECK_FLASH_SECTOR_SIZE)
+// Binding_t::icon of keys with no icon
+#define PROFILE_NO_ICON 0xFF
+// FNV-1a offset basis, Checksum() picks up from here
+#define PROFILE_CHECKSUM_SEED 2166136261
+
+/// @brief A deck's whole configuration as one blob, so reconfiguring doesn't need a firmware rebuild.
+/// @details Nothing is parsed or copied out of it; once Begin() has checked it over, every lookup reads flash through XIP.
+///
+/// Layout, all little endian, every table 4-byte aligned, offsets from the start of the blob:
+///   Header_t
+///   Page_t[pages]             at pagesOffset
+///   Binding_t[pages][buttons] at bindingsOffset, buttons in LightgunButtons::ButtonDesc order
+///   Icon_t[icons]             at iconsOffset, built-in icons (DeckPrefs::Icons) that bindings refer to by index
+/// checksum is FNV-1a over everything after the header. Without a valid profile, the compiled-in configuration is used.
+///
+/// Each slot is its own DeckProfile with its own store, so one can be checked over (by the display core)
+/// while another one is in use. The display core reads the one in use whenever it likes, so that one's never
+/// rewritten; a new blob goes into another slot, and is switched to from there.
+class DeckProfile {
+public:
+    /// @param storeSlot Which of the PROFILE_SLOTS stores this profile lives in
+    DeckProfile(const unsigned int &storeSlot = 0) : slot(storeSlot) {}
+
+    typedef struct Header_s {
+        uint32_t magic;             // PROFILE_MAGIC
+        uint16_t version;           // PROFILE_VERSION
+        uint16_t headerSize;        // sizeof(Header_t)
+        uint32_t size;              // whole blob, header included
+        uint32_t checksum;
+        uint16_t pages;
+        uint8_t buttons;            // must match the firmware's button count
+        uint8_t reserved;
+        uint16_t icons;
+        uint16_t reserved2;
+        uint32_t pagesOffset;
+        uint32_t bindingsOffset;
+        uint32_t iconsOffset;
+    } Header_t;
+
+    typedef struct Page_s {
+        char name[24];              // NUL terminated
+        uint32_t color;             // LEDs & TFT tint, 0x00BBGGRR
+    } Page_t;
+
+    enum BindingFlags_e {
+        Bind_Toggle = 1 << 0,       ///< Icon flips between its two halves on every press (icon must be packed)
+    };
+
+    typedef struct Binding_s {
+        uint16_t code;              // LightgunButtons report code, modifiers in the high byte
+        uint8_t icon;               // Icon_t index, or PROFILE_NO_ICON
+        uint8_t flags;              // BindingFlags_e
+    } Binding_t;
+
+    typedef struct Icon_s {
+        char name[16];              // DeckPrefs::Icons name, NUL terminated
+    } Icon_t;
+
+    /// @brief FNV-1a, as used for Header_t::checksum
+    /// @param hash Hash so far, to checksum a blob in parts
+    static uint32_t Checksum(const uint8_t *data, const size_t &len, const uint32_t &hash = PROFILE_CHECKSUM_SEED);
+
+    /// @brief Checks a blob's header, bounds, checksum and strings
+    /// @param buttons Button count the bindings have to be laid out for
+    /// @return Its header if it can be used, else nullptr
+    static const Header_t *Validate(const uint8_t *blob, const size_t &len, const unsigned int &buttons);
+
+    /// @brief Picks up the profile in flash, if there's a valid one
+    /// @details Goes over the whole blob to checksum it, so it takes a while for big profiles.
+    /// @return Whether one was loaded
+    bool Begin(const unsigned int &buttons);
+
+    /// @brief Whether there's something that looks like a profile in the store, going by its header alone
+    /// @details Cheap enough to call between polls, unlike Begin().
+    bool Stored() const;
+
+    unsigned int Slot() const { return slot; }
+
+    /// @brief Whether a profile is in use (otherwise, everything's compiled in)
+    bool Loaded() const { return header != nullptr; }
+
+    uint16_t Pages() const { return header->pages; }
+
+    const Page_t &Page(const unsigned int &page) const { return ((const Page_t*)(blob + header->pagesOffset))[page]; }
+
+    const Binding_t &Binding(const unsigned int &page, const unsigned int &button) const {
+        return ((const Binding_t*)(blob + header->bindingsOffset))[page * header->buttons + button];
+    }
+
+    /// @return Built-in icon name a binding refers to, or nullptr if it has none
+    const char *IconName(const Binding_t &binding) const {
+        return binding.icon < header->icons ? ((const Icon_t*)(blob + header->iconsOffset))[binding.icon].name : nullptr;
+    }
+
+    /// @brief Starts replacing the stored profile; the current one is dropped right away
+    /// @details Sectors past the first are only erased once the new blob gets to them.
+    /// Not for the profile in use, which the display core could be reading meanwhile.
+    /// @return false if the sketch overlaps the stores, so there's nowhere to write it
+    bool StoreBegin();
+
+    /// @brief Appends the next part of the new blob to the store
+    /// @return false once the blob won't fit
+    bool StoreWrite(const uint8_t *data, const size_t &len);
+
+    /// @brief Writes out what's left of the new blob, then loads it
+    /// @return Whether it's valid and loaded
+    bool StoreEnd(const unsigned int &buttons);
+
+    /// @brief Drops the stored profile, going back to the compiled-in configuration
+    void StoreClear();
+
+    /// @brief Size of the loaded profile, 0 if none
+    uint32_t Size() const { return header != nullptr ? header->size : 0; }
+
+private:
+    /// @brief Programs pageBuf at an offset into the store, erasing its sector first if it's the first page there
+    void StoreFlush(const size_t &offset);
+
+    /// @brief This slot's store, as it is now
+    const uint8_t *Store() const;
+
+    unsigned int slot;
+
+    const uint8_t *blob = nullptr;
+    const Header_t *header = nullptr;
+
+    // page being filled by StoreWrite(), and where in the store it goes
+    uint8_t pageBuf[DECK_FLASH_PAGE_SIZE];
+    size_t storeLen = 0;
+};
@@ -0,0 +1,59 @@
+/*!
+ * @file PicoDeckStats.cpp
+ * @brief Always-on per-stage latency histograms & counters, readable by the host through a vendor HID feature report.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <TinyUSB_Devices.h>
+#include <algorithm>
+
+#include "PicoDeckStats.h"
+
+static_assert(sizeof(DeckStats::Summary_t) <= HID_FEATURE_SIZE, "stats summary doesn't fit the feature report");
+static_assert(sizeof(DeckStats::Page_t) <= HID_FEATURE_SIZE, "stats page doesn't fit the feature report");
+
+void DeckStats::Sample(const Stage_e &stage, const uint32_t &us)
+{
+    Stage_t &s = stages[stage];
+    ++s.count;
+    s.sum += us;
+    if(us > s.max) s.max = us;
+
+    const int bucket = std::min(us ? 32 - __builtin_clz(us) : 0, STATS_BUCKETS-1);
+    if(s.buckets[bucket] != 0xFFFF) ++s.buckets[bucket];
+}
+
+uint16_t DeckStats::FeatureGet(uint8_t *buffer, uint16_t reqlen)
+{
+    const uint16_t len = std::min<uint16_t>(reqlen, HID_FEATURE_SIZE);
+    memset(buffer, 0, len);
+
+    if(!page || page > STATS_STAGES) {
+        Summary_t summary = { 0, STATS_VERSION, STATS_STAGES, STATS_COUNTERS, (uint32_t)millis(), {} };
+        for(int i = 0; i < STATS_COUNTERS; ++i)
+            summary.count[i] = counters[i];
+        memcpy(buffer, &summary, std::min<uint16_t>(len, sizeof(summary)));
+    } else {
+        const Stage_t &s = stages[page-1];
+        Page_t out = { page, (uint8_t)(page-1), 0, s.count, s.sum, s.max, {} };
+        memcpy(out.buckets, s.buckets, sizeof(out.buckets));
+        memcpy(buffer, &out, std::min<uint16_t>(len, sizeof(out)));
+    }
+
+    return len;
+}
+
+void DeckStats::FeatureSet(const uint8_t *buffer, uint16_t len)
+{
+    if(!len) return;
+
+    if(buffer[0] == STATS_PAGE_RESET) {
+        memset(stages, 0, sizeof(stages));
+        for(int i = 0; i < STATS_COUNTERS; ++i)
+            counters[i] = 0;
+        page = 0;
+    } else page = buffer[0];
+}
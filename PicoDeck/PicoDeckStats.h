@@ -0,0 +1,137 @@
+/*!
+ * @file PicoDeckStats.h
+ * @brief Always-on per-stage latency histograms & counters, readable by the host through a vendor HID feature report.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// log2 histogram buckets: bucket 0 is 0us, bucket n is [2^(n-1), 2^n) us, the last one takes everything above
+#define STATS_BUCKETS 16
+// bumped whenever the feature report layout changes
+#define STATS_VERSION 9
+// FIFO push timestamps in flight, more than the 8 the RP2040's FIFO can hold plus one blocked push
+#define STATS_FIFO_SLOTS 16
+
+/// @brief Latency stats for each stage between a key press and it reaching the host & screen.
+/// @details Each stage is only sampled from one core, so there's no locking; the host may read a count
+/// and its sum from slightly different moments, which is fine for monitoring.
+///
+/// The feature report is paged: the host writes the page it wants as the first byte of a SET_REPORT,
+/// then reads it back with GET_REPORT. Writing STATS_PAGE_RESET clears everything.
+/// Page 0 is Summary_t, page 1+n is stage n's Page_t. All fields are little endian.
+class DeckStats {
+public:
+    enum Stage_e {
+        Stage_Debounce = 0, ///< First sample of a pin edge -> Poll() reporting it
+        Stage_Report,       ///< Poll() reporting an edge -> HID report submitted
+        Stage_Fifo,         ///< Core0 pushing a command -> Core1 taking it
+        Stage_Render,       ///< DeckDisplay::Render()
+        Stage_Frame,        ///< Whole display frame, render & push
+        Stage_Flush,        ///< Render buffer push to the display
+        Stage_Save,         ///< DeckPrefs::Save()
+        Stage_FlashStall,   ///< Flash erase/program with Core1 parked & interrupts off (max is the worst-case stall)
+        Stage_PageLoad,     ///< Getting a page's data in DeckDisplay::PageUpdate(), ~0 when it was already resident
+        Stage_ProfileSwitch,///< Profile switch asked for -> new profile in use
+        Stage_SwitchPass,   ///< Longest Core0 loop pass during each profile switch
+        Stage_WakeReport,   ///< Press that woke a suspended host -> first report after the bus resumed
+        Stage_Core0Sleep,   ///< Each time Core0 slept: count is wakeups, sum is time asleep
+        Stage_Core1Sleep,   ///< Each time Core1 slept: count is wakeups, sum is time asleep
+        Stage_IrqOff,       ///< One flash erase/program with interrupts off, i.e. how long USB went unanswered
+        STATS_STAGES
+    };
+
+    enum Counter_e {
+        Count_FlushBytes = 0,   ///< Bytes pushed to the display (RGB565 tiles on TFTs)
+        Count_Reports,          ///< HID reports sent
+        Count_FifoFull,         ///< Core0 pushes that had to wait on Core1
+        Count_FramesDropped,    ///< Display frames skipped for running late
+        Count_FramesOverBudget, ///< Display frames that took longer than their budget
+        Count_PanelAborts,      ///< Secondary panel transfers NACK'd/aborted
+        Count_PrefsProgrammed,  ///< Flash bytes programmed saving prefs (whole pages)
+        Count_PrefsErases,      ///< Prefs journal sector erases
+        Count_PrefsSkipped,     ///< Autosaves skipped for having nothing new
+        Count_PageMisses,       ///< Page flips to a page that wasn't resident yet
+        Count_Wakeups,          ///< Remote wakeups signalled to a suspended host
+        Count_SpritesDeferred,  ///< Display frames that held animated key icons over to the next for the row budget
+        STATS_COUNTERS
+    };
+
+    /// @brief Short names for the stages & counters, in order, for printing them (e.g. the host's deckstats tool)
+    static constexpr const char *StageNames[] = {
+        "debounce", "report", "fifo", "render", "frame", "flush", "save", "flash_stall",
+        "page_load", "profile_switch", "switch_pass", "wake_report", "core0_sleep", "core1_sleep", "irq_off"
+    };
+    static constexpr const char *CounterNames[] = {
+        "flush_bytes", "reports", "fifo_full", "frames_dropped", "frames_over_budget", "panel_aborts",
+        "prefs_programmed", "prefs_erases", "prefs_skipped", "page_misses", "wakeups", "sprites_deferred"
+    };
+
+    #define STATS_PAGE_RESET 0xFF
+
+    typedef struct __attribute__((packed)) Summary_s {
+        uint8_t page;
+        uint8_t version;
+        uint8_t stages;
+        uint8_t counters;
+        uint32_t uptime;                    // ms
+        uint32_t count[STATS_COUNTERS];
+    } Summary_t;
+
+    typedef struct __attribute__((packed)) Page_s {
+        uint8_t page;
+        uint8_t stage;
+        uint16_t reserved;
+        uint32_t count;
+        uint32_t sum;                       // us, wraps
+        uint32_t max;                       // us
+        uint16_t buckets[STATS_BUCKETS];    // saturate at 0xFFFF
+    } Page_t;
+
+    /// @brief Adds a sample to a stage's histogram
+    /// @param us Stage duration, in microseconds
+    static void Sample(const Stage_e &stage, const uint32_t &us);
+
+    /// @brief Adds to a counter
+    static inline void Count(const Counter_e &counter, const uint32_t &n = 1) { counters[counter] += n; }
+
+    /// @brief A counter's value, since boot or the host last reset them
+    static inline uint32_t Counter(const Counter_e &counter) { return counters[counter]; }
+
+    /// @brief Core0 side of Stage_Fifo, call right before each push to Core1
+    static inline void FifoPushed(const uint32_t &now) { fifoPushTime[fifoPushSeq++ % STATS_FIFO_SLOTS] = now; }
+
+    /// @brief Core1 side of Stage_Fifo, call right after each pop from Core0
+    static inline void FifoPopped(const uint32_t &now) { Sample(Stage_Fifo, now - fifoPushTime[fifoPopSeq++ % STATS_FIFO_SLOTS]); }
+
+    /// @brief TinyUSBDevices_::featureGet hook
+    static uint16_t FeatureGet(uint8_t *buffer, uint16_t reqlen);
+
+    /// @brief TinyUSBDevices_::featureSet hook
+    static void FeatureSet(const uint8_t *buffer, uint16_t len);
+
+private:
+    typedef struct Stage_s {
+        uint32_t count;
+        uint32_t sum;
+        uint32_t max;
+        uint16_t buckets[STATS_BUCKETS];
+    } Stage_t;
+
+    static inline Stage_t stages[STATS_STAGES];
+    static inline volatile uint32_t counters[STATS_COUNTERS];
+
+    static inline volatile uint32_t fifoPushTime[STATS_FIFO_SLOTS];
+    static inline uint8_t fifoPushSeq = 0;     // Core0 only
+    static inline uint8_t fifoPopSeq = 0;      // Core1 only
+
+    // page the host asked for last
+    static inline uint8_t page = 0;
+};
+
+static_assert(sizeof(DeckStats::StageNames) / sizeof(DeckStats::StageNames[0]) == DeckStats::STATS_STAGES, "a stage has no name");
+static_assert(sizeof(DeckStats::CounterNames) / sizeof(DeckStats::CounterNames[0]) == DeckStats::STATS_COUNTERS, "a counter has no name");
@@ -0,0 +1,254 @@
+/*!
+ * @file PicoDeckTFT.cpp
+ * @brief Tile-streaming renderer for RGB565 SPI TFTs, without a colour framebuffer.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <algorithm>
+
+#include "PicoDeckTFT.h"
+
+// MIPI DCS commands shared by both controllers
+#define TFT_SWRESET 0x01
+#define TFT_SLPOUT  0x11
+#define TFT_NORON   0x13
+#define TFT_INVON   0x21
+#define TFT_DISPON  0x29
+#define TFT_CASET   0x2A
+#define TFT_RASET   0x2B
+#define TFT_RAMWR   0x2C
+#define TFT_MADCTL  0x36
+#define TFT_COLMOD  0x3A
+
+// MADCTL bits
+#define TFT_MADCTL_MX  0x40
+#define TFT_MADCTL_MV  0x20
+#define TFT_MADCTL_BGR 0x08
+
+DeckTFT::DeckTFT(SPIClass *spiBus, const Controller_e &ctrl, const uint16_t &w, const uint16_t &h,
+                 const int8_t &dc, const int8_t &rst, const int8_t &cs, const uint32_t &bitrate)
+    : controller(ctrl), spi(spiBus), dcPin(dc), rstPin(rst), csPin(cs), spiRate(bitrate), width(w), height(h)
+{
+    tint[Region_Banner] = 0xFFFF;
+    tint[Region_Keys] = 0xFFFF;
+}
+
+bool DeckTFT::Begin()
+{
+    if(width > TFT_MAX_SIDE || height > TFT_MAX_SIDE) return false;
+
+    pinMode(dcPin, OUTPUT);
+    pinMode(csPin, OUTPUT);
+    digitalWrite(csPin, HIGH);
+    spi->begin();
+
+    if(rstPin >= 0) {
+        pinMode(rstPin, OUTPUT);
+        digitalWrite(rstPin, LOW);
+        delay(10);
+        digitalWrite(rstPin, HIGH);
+    }
+    Command(TFT_SWRESET);
+    delay(150);
+    Command(TFT_SLPOUT);
+    delay(120);
+
+    const uint8_t colmod = 0x55; // 16bpp
+    Command(TFT_COLMOD, &colmod, 1);
+
+    // landscape panels get rows/columns exchanged, module mounting may still need MX/MY flipped
+    uint8_t madctl = (width > height) ? (TFT_MADCTL_MV | TFT_MADCTL_MX) : 0;
+    if(controller == TFT_ILI9341) madctl |= TFT_MADCTL_BGR;
+    Command(TFT_MADCTL, &madctl, 1);
+
+    // ST7789 IPS glass is inverted by default
+    if(controller == TFT_ST7789) Command(TFT_INVON);
+    Command(TFT_NORON);
+    Command(TFT_DISPON);
+
+    // logical layout is scaled by the largest (fractional) factor that fits both ways, in 8.8 fixed point
+    const uint32_t scale = std::min(((uint32_t)width << 8) / TFT_LOGICAL_WIDTH, ((uint32_t)height << 8) / TFT_LOGICAL_HEIGHT);
+    for(int lx = 0; lx <= TFT_LOGICAL_WIDTH; ++lx)
+        xStart[lx] = (lx * scale) >> 8;
+    for(int ly = 0; ly <= TFT_LOGICAL_HEIGHT; ++ly)
+        yStart[ly] = (ly * scale) >> 8;
+    for(int lx = 0; lx < TFT_LOGICAL_WIDTH; ++lx)
+        for(int px = xStart[lx]; px < xStart[lx+1]; ++px) xLut[px] = lx;
+    for(int ly = 0; ly < TFT_LOGICAL_HEIGHT; ++ly)
+        for(int py = yStart[ly]; py < yStart[ly+1]; ++py) yLut[py] = ly;
+    offsetX = (width - xStart[TFT_LOGICAL_WIDTH]) / 2;
+    offsetY = (height - yStart[TFT_LOGICAL_HEIGHT]) / 2;
+
+    // blank the whole glass once, borders around the scaled layout are never touched again
+    memset(lineBuf, 0, sizeof(lineBuf));
+    WindowSet(0, 0, width-1, height-1);
+    for(int pixels = width * height; pixels > 0; pixels -= TFT_LINE_PIXELS)
+        StripSend(lineBuf[0], std::min(pixels, TFT_LINE_PIXELS));
+    FlushWait();
+
+    canvas.fillScreen(0);
+    memset(shadow, 0, sizeof(shadow));
+    repaintBands = 0;
+
+    return true;
+}
+
+uint32_t DeckTFT::Flush(const uint8_t &first, const uint8_t &last)
+{
+    const uint8_t *buf = canvas.getBuffer();
+    const int stride = TFT_LOGICAL_WIDTH >> 3;
+    uint32_t streamed = 0;
+
+    for(int band = first; band <= last && band < TFT_TILE_ROWS; ++band) {
+        // compare each tile against the shadow, and take the new contents as it goes
+        uint8_t dirty = (repaintBands & (1 << band)) ? (1 << TFT_TILE_COLS) - 1 : 0;
+        for(int row = band * TFT_TILE_HEIGHT; row < (band+1) * TFT_TILE_HEIGHT; ++row) {
+            const int offset = row * stride;
+            for(int tile = 0; tile < TFT_TILE_COLS; ++tile) {
+                const int t = offset + tile * (TFT_TILE_WIDTH >> 3);
+                if(memcmp(buf + t, shadow + t, TFT_TILE_WIDTH >> 3)) {
+                    memcpy(shadow + t, buf + t, TFT_TILE_WIDTH >> 3);
+                    dirty |= 1 << tile;
+                }
+            }
+        }
+        repaintBands &= ~(1 << band);
+
+        // stream each run of adjacent dirty tiles as one window
+        for(int tile = 0; tile < TFT_TILE_COLS; ++tile) {
+            if(!(dirty & (1 << tile))) continue;
+            int runEnd = tile;
+            while(runEnd+1 < TFT_TILE_COLS && (dirty & (1 << (runEnd+1)))) ++runEnd;
+            streamed += RunStream(band, tile, runEnd);
+            tile = runEnd;
+        }
+    }
+
+    return streamed;
+}
+
+uint32_t DeckTFT::RunStream(const int &band, const int &firstTile, const int &lastTile)
+{
+    const uint8_t *buf = canvas.getBuffer();
+    const int stride = TFT_LOGICAL_WIDTH >> 3;
+
+    const int px0 = xStart[firstTile * TFT_TILE_WIDTH];
+    const int px1 = xStart[(lastTile+1) * TFT_TILE_WIDTH];
+    const int py0 = yStart[band * TFT_TILE_HEIGHT];
+    const int py1 = yStart[(band+1) * TFT_TILE_HEIGHT];
+    const int runWidth = px1 - px0;
+    const int rowsPerStrip = TFT_LINE_PIXELS / runWidth;
+
+    // banner is the top two bands (rows 0-15)
+    const uint16_t fg = tint[band < 2 ? Region_Banner : Region_Keys];
+    const uint16_t bg = background;
+
+    WindowSet(offsetX + px0, offsetY + py0, offsetX + px1 - 1, offsetY + py1 - 1);
+
+    for(int py = py0; py < py1; py += rowsPerStrip) {
+        const int rows = std::min(rowsPerStrip, py1 - py);
+
+        // safe to overwrite: the strip last sent from this buffer was waited out before the other one started
+        uint16_t *out = lineBuf[lineBufNext];
+        for(int r = 0; r < rows; ++r) {
+            const uint8_t *src = buf + yLut[py + r] * stride;
+            for(int px = px0; px < px1; ++px) {
+                const uint8_t lx = xLut[px];
+                *out++ = (src[lx >> 3] & (0x80 >> (lx & 7))) ? fg : bg;
+            }
+        }
+
+        StripSend(lineBuf[lineBufNext], rows * runWidth);
+        lineBufNext ^= 1;
+    }
+
+    return runWidth * (py1 - py0) * sizeof(uint16_t);
+}
+
+void DeckTFT::WindowSet(const int &x0, const int &y0, const int &x1, const int &y1)
+{
+    const uint8_t cols[4] = { (uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1 };
+    const uint8_t rows[4] = { (uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1 };
+
+    // D/C can't flip while pixels are still shifting out
+    StripWait();
+    TransactionBegin();
+
+    digitalWrite(dcPin, LOW);
+    spi->transfer(TFT_CASET);
+    digitalWrite(dcPin, HIGH);
+    spi->transfer(cols, nullptr, 4);
+
+    digitalWrite(dcPin, LOW);
+    spi->transfer(TFT_RASET);
+    digitalWrite(dcPin, HIGH);
+    spi->transfer(rows, nullptr, 4);
+
+    digitalWrite(dcPin, LOW);
+    spi->transfer(TFT_RAMWR);
+    digitalWrite(dcPin, HIGH);
+}
+
+void DeckTFT::StripSend(const uint16_t *buf, const int &pixels)
+{
+    StripWait();
+    DeckSPISend(spi, buf, pixels * sizeof(uint16_t));
+    stripPending = true;
+}
+
+void DeckTFT::StripWait()
+{
+    if(!stripPending) return;
+    while(!DeckSPIDone(spi)) tight_loop_contents();
+    stripPending = false;
+}
+
+void DeckTFT::TransactionBegin()
+{
+    if(inTransaction) return;
+    spi->beginTransaction(SPISettings(spiRate, MSBFIRST, SPI_MODE0));
+    digitalWrite(csPin, LOW);
+    inTransaction = true;
+}
+
+void DeckTFT::FlushWait()
+{
+    StripWait();
+    if(!inTransaction) return;
+    digitalWrite(csPin, HIGH);
+    spi->endTransaction();
+    inTransaction = false;
+}
+
+void DeckTFT::Command(const uint8_t &cmd, const uint8_t *args, const uint8_t &count)
+{
+    StripWait();
+    TransactionBegin();
+
+    digitalWrite(dcPin, LOW);
+    spi->transfer(cmd);
+    digitalWrite(dcPin, HIGH);
+    for(int i = 0; i < count; ++i)
+        spi->transfer(args[i]);
+
+    FlushWait();
+}
+
+void DeckTFT::SetTint(const Region_e &region, const uint32_t &rgb)
+{
+    const uint8_t r = rgb & 0xFF;
+    const uint8_t g = (rgb >> 8) & 0xFF;
+    const uint8_t b = (rgb >> 16) & 0xFF;
+    const uint16_t color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    const uint16_t swapped = __builtin_bswap16(color);
+
+    if(tint[region] == swapped) return;
+    tint[region] = swapped;
+
+    // colour changes don't show up in the 1bpp shadow, so repaint the region outright
+    repaintBands |= (region == Region_Banner) ? 0x03 : 0xFC;
+}
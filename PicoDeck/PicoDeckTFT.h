@@ -0,0 +1,124 @@
+/*!
+ * @file PicoDeckTFT.h
+ * @brief Tile-streaming renderer for RGB565 SPI TFTs, without a colour framebuffer.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <SPI.h>
+#include <Adafruit_GFX.h>
+
+#include "PicoDeckPlatform.h"
+
+// the deck's layout is still composed at OLED resolution, in 1bpp (1KB instead of 112-150KB of RGB565)
+#define TFT_LOGICAL_WIDTH 128
+#define TFT_LOGICAL_HEIGHT 64
+
+// dirty tracking granularity, in logical pixels: one key cell wide, one OLED page tall
+#define TFT_TILE_WIDTH 32
+#define TFT_TILE_HEIGHT 8
+#define TFT_TILE_COLS (TFT_LOGICAL_WIDTH / TFT_TILE_WIDTH)
+#define TFT_TILE_ROWS (TFT_LOGICAL_HEIGHT / TFT_TILE_HEIGHT)
+
+// largest supported panel side
+#define TFT_MAX_SIDE 320
+// pixels per line buffer, two of them are used in turns: one being composed while the other is DMA'd out
+#define TFT_LINE_PIXELS (2 * TFT_MAX_SIDE)
+
+class DeckTFT {
+public:
+    enum Controller_e {
+        TFT_ST7789 = 0,
+        TFT_ILI9341,
+    };
+
+    // areas of the layout that get their own foreground colour
+    enum Region_e {
+        Region_Banner = 0,
+        Region_Keys,
+        TFT_REGIONS
+    };
+
+    DeckTFT(SPIClass *spiBus, const Controller_e &ctrl, const uint16_t &w, const uint16_t &h,
+            const int8_t &dc, const int8_t &rst, const int8_t &cs, const uint32_t &bitrate);
+
+    /// @brief Resets & initializes the controller, and blanks the whole panel
+    /// @return false if the panel is bigger than TFT_MAX_SIDE
+    bool Begin();
+
+    /// @brief Streams every tile in the given bands that differs from what was last streamed
+    /// @details Horizontally adjacent dirty tiles go out as one window. Each window is composed a few scanlines
+    /// at a time into alternating line buffers, so the next strip is composed while the last one is DMA'd out.
+    /// Only the very last strip is left in flight, the canvas can be drawn to again as soon as this returns.
+    /// @param first First 8-row band (same numbering as OLED pages)
+    /// @param last Last 8-row band
+    /// @return RGB565 bytes streamed, 0 if nothing had changed
+    uint32_t Flush(const uint8_t &first, const uint8_t &last);
+
+    /// @brief Waits for the last strip of a Flush() to go out and ends the SPI transaction
+    void FlushWait();
+
+    /// @brief Sends a command with optional parameter bytes
+    void Command(const uint8_t &cmd, const uint8_t *args = nullptr, const uint8_t &count = 0);
+
+    /// @brief Sets a region's foreground colour, repainting it on the next Flush()
+    /// @param rgb Colour packed as 0x00BBGGRR, same as page colours
+    void SetTint(const Region_e &region, const uint32_t &rgb);
+
+    // logical render buffer, the same layout DeckDisplay draws to on OLEDs
+    GFXcanvas1 canvas = GFXcanvas1(TFT_LOGICAL_WIDTH, TFT_LOGICAL_HEIGHT);
+
+    Controller_e controller;
+
+private:
+    /// @brief Streams one run of adjacent tiles in a band
+    /// @return RGB565 bytes streamed
+    uint32_t RunStream(const int &band, const int &firstTile, const int &lastTile);
+
+    /// @brief Sets the controller's RAM window and starts a memory write into it
+    void WindowSet(const int &x0, const int &y0, const int &x1, const int &y1);
+
+    /// @brief Starts a DMA push of a line buffer, after waiting out the previous one
+    void StripSend(const uint16_t *buf, const int &pixels);
+
+    /// @brief Waits for the strip in flight (if any) to finish
+    void StripWait();
+
+    /// @brief Begins an SPI transaction with CS held low, if not already in one
+    void TransactionBegin();
+
+    SPIClass *spi;
+    int8_t dcPin;
+    int8_t rstPin;
+    int8_t csPin;
+    uint32_t spiRate;
+
+    uint16_t width;
+    uint16_t height;
+
+    // logical -> physical mapping: nearest-neighbour scale that fits the panel, centred
+    uint16_t xStart[TFT_LOGICAL_WIDTH+1];   // first physical column of each logical column
+    uint16_t yStart[TFT_LOGICAL_HEIGHT+1];  // first physical row of each logical row
+    uint8_t xLut[TFT_MAX_SIDE];             // logical column of each physical column
+    uint8_t yLut[TFT_MAX_SIDE];             // logical row of each physical row
+    uint16_t offsetX;
+    uint16_t offsetY;
+
+    // what the panel currently shows, for finding dirty tiles
+    uint8_t shadow[(TFT_LOGICAL_WIDTH >> 3) * TFT_LOGICAL_HEIGHT];
+    // set when everything has to be streamed regardless of the shadow
+    uint8_t repaintBands = 0xFF;
+
+    // foreground per region & background, byte-swapped RGB565 (SPI sends MSB first)
+    uint16_t tint[TFT_REGIONS];
+    uint16_t background = 0;
+
+    uint16_t lineBuf[2][TFT_LINE_PIXELS];
+    uint8_t lineBufNext = 0;
+    bool stripPending = false;
+    bool inTransaction = false;
+};
@@ -0,0 +1,73 @@
+/*!
+ * @file PicoDeckText.cpp
+ * @brief Prebaked Sega7x7 glyph atlas and text blitters for 1bpp canvases.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+
+#include "PicoDeckText.h"
+
+// both tables are baked by the compiler into flash, nothing is unpacked at runtime
+static constexpr DeckText::Atlas_t atlas PROGMEM = DeckText::AtlasBuild();
+static constexpr DeckText::Labels_t labels PROGMEM = DeckText::LabelsBuild(atlas);
+
+int DeckText::TextWidth(const char *str)
+{
+    int x = 0;
+    int minX = INT16_MAX, maxX = INT16_MIN;
+    for(; *str; ++str) {
+        const uint8_t c = (uint8_t)*str;
+        if(c < SEGAFONT7_FIRST || c > SEGAFONT7_LAST) continue;
+        const Glyph_t &glyph = atlas.glyphs[c - SEGAFONT7_FIRST];
+        if(x + glyph.inkLeft < minX) minX = x + glyph.inkLeft;
+        if(x + glyph.inkRight > maxX) maxX = x + glyph.inkRight;
+        x += glyph.advance;
+    }
+    return maxX >= minX ? maxX - minX + 1 : 0;
+}
+
+void DeckText::TextBlit(uint8_t *buf, const int &stride, const int &height, int x, const int &baseline, const char *str)
+{
+    const int top = baseline - SEGAFONT7_HEIGHT;
+    const int width = stride << 3;
+
+    for(; *str && x < width; ++str) {
+        const uint8_t c = (uint8_t)*str;
+        if(c < SEGAFONT7_FIRST || c > SEGAFONT7_LAST) continue;
+        const Glyph_t &glyph = atlas.glyphs[c - SEGAFONT7_FIRST];
+
+        // a glyph row straddles at most two canvas bytes
+        if(x > -8) {
+            const int col = x >> 3;
+            const int shift = x & 7;
+            for(int r = 0; r < SEGAFONT7_HEIGHT; ++r) {
+                const int y = top + r;
+                if(!glyph.rows[r] || y < 0 || y >= height) continue;
+                uint8_t *row = buf + y*stride;
+                if(col >= 0) row[col] |= glyph.rows[r] >> shift;
+                if(shift && col+1 < stride) row[col+1] |= glyph.rows[r] << (8-shift);
+            }
+        }
+        x += glyph.advance;
+    }
+}
+
+void DeckText::LabelBlit(uint8_t *buf, const int &stride, const int &height, const int &x, const int &baseline, const uint8_t &keyCode)
+{
+    if(keyCode < 0x20) return;
+
+    const uint32_t *rows = labels.rows[keyCode - 0x20];
+    const int top = baseline - SEGAFONT7_HEIGHT;
+
+    for(int r = 0; r < SEGAFONT7_HEIGHT; ++r) {
+        const int y = top + r;
+        if(!rows[r] || y < 0 || y >= height) continue;
+        const uint32_t bits = rows[r] >> x;
+        uint8_t *row = buf + y*stride;
+        for(int b = 0; b < stride; ++b)
+            row[b] |= bits >> (24 - (b << 3));
+    }
+}
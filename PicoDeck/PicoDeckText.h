@@ -0,0 +1,331 @@
+/*!
+ * @file PicoDeckText.h
+ * @brief Prebaked Sega7x7 glyph atlas and text blitters for 1bpp canvases.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "fontSega7x7.h"
+
+#define TEXT_GLYPHS     (SEGAFONT7_LAST - SEGAFONT7_FIRST + 1)
+// keyStrings covers every HID keycode from space onwards
+#define TEXT_KEY_LABELS (0x100 - 0x20)
+
+class DeckText {
+public:
+    // every Sega7x7 glyph fits in one byte per row, with all of its ink in the 7 rows above the baseline
+    typedef struct Glyph_s {
+        uint8_t rows[SEGAFONT7_HEIGHT]; // row 0 is baseline-7, MSB is the pen position (xOffset already applied)
+        uint8_t advance;
+        uint8_t inkLeft;                // first/last ink columns relative to the pen, for measuring
+        uint8_t inkRight;
+    } Glyph_t;
+
+    typedef struct Atlas_s {
+        Glyph_t glyphs[TEXT_GLYPHS];
+    } Atlas_t;
+
+    // key labels pre-laid out at x=0, MSB is column 0; a key box is only 31px wide so 32 bits holds any label
+    typedef struct Labels_s {
+        uint32_t rows[TEXT_KEY_LABELS][SEGAFONT7_HEIGHT];
+    } Labels_t;
+
+    /// @brief Measures the inked width of a string, matching what getTextBounds() returns for Sega7x7
+    /// @param str Null-terminated string
+    /// @return Width in pixels, or 0 if nothing would be drawn
+    static int TextWidth(const char *str);
+
+    /// @brief ORs a string into a row-major 1bpp buffer (GFXcanvas1 layout), clipped to its bounds
+    /// @param buf Canvas buffer
+    /// @param stride Bytes per row of the canvas
+    /// @param height Rows in the canvas
+    /// @param x Pen position of the first glyph, can be negative
+    /// @param baseline Baseline row, as for setCursor()
+    /// @param str Null-terminated string
+    static void TextBlit(uint8_t *buf, const int &stride, const int &height, int x, const int &baseline, const char *str);
+
+    /// @brief ORs the precomputed label of a keycode into a row-major 1bpp buffer
+    /// @param buf Canvas buffer
+    /// @param stride Bytes per row of the canvas, at most 4
+    /// @param height Rows in the canvas
+    /// @param x Pen position, 0-31
+    /// @param baseline Baseline row, as for setCursor()
+    /// @param keyCode HID keycode, anything below 0x20 draws nothing
+    static void LabelBlit(uint8_t *buf, const int &stride, const int &height, const int &x, const int &baseline, const uint8_t &keyCode);
+
+    /// @brief Unpacks the GFX font bitstream into the atlas, at compile time
+    static constexpr Atlas_t AtlasBuild()
+    {
+        Atlas_t atlas = {};
+        for(int g = 0; g < TEXT_GLYPHS; ++g) {
+            const GFXglyph &src = Sega7x7_Glyphs[g];
+            Glyph_t &dst = atlas.glyphs[g];
+
+            int offset = src.bitmapOffset;
+            int bit = 0;
+            uint8_t bits = 0;
+            for(int yy = 0; yy < src.height; ++yy)
+                for(int xx = 0; xx < src.width; ++xx) {
+                    if(!(bit++ & 7)) bits = Sega7x7_Bitmaps[offset++];
+                    if(bits & 0x80) dst.rows[src.yOffset+SEGAFONT7_HEIGHT+yy] |= 0x80 >> (src.xOffset+xx);
+                    bits <<= 1;
+                }
+
+            dst.advance = src.xAdvance;
+            dst.inkLeft = src.xOffset;
+            dst.inkRight = src.xOffset + src.width - 1;
+        }
+        return atlas;
+    }
+
+    /// @brief Lays out every keyStrings entry from the atlas, at compile time
+    static constexpr Labels_t LabelsBuild(const Atlas_t &atlas)
+    {
+        Labels_t labels = {};
+        for(int l = 0; l < TEXT_KEY_LABELS; ++l) {
+            int x = 0;
+            for(const char *str = keyStrings[l]; *str && x < 32; ++str) {
+                const uint8_t c = (uint8_t)*str;
+                if(c < SEGAFONT7_FIRST || c > SEGAFONT7_LAST) continue;
+                const Glyph_t &glyph = atlas.glyphs[c - SEGAFONT7_FIRST];
+                for(int r = 0; r < SEGAFONT7_HEIGHT; ++r)
+                    labels.rows[l][r] |= ((uint32_t)glyph.rows[r] << 24) >> x;
+                x += glyph.advance;
+            }
+        }
+        return labels;
+    }
+
+    // any method accessing this should always decrement the pointer by 0x20, which is where this map starts
+    static constexpr const char *keyStrings[TEXT_KEY_LABELS] = {
+        "   ", // 0x20 - space
+        " ! ",
+        " \" ",
+        " # ",
+        " $ ",
+        " % ",
+        " & ",
+        " ' ",
+        " ( ",
+        " ) ",
+        " * ",
+        " + ",
+        " , ",
+        " - ",
+        " . ",
+        " / ",
+        "#0 ",
+        "#1 ",
+        "#2 ",
+        "#3 ",
+        "#4 ",
+        "#5 ",
+        "#6 ",
+        "#7 ",
+        "#8 ",
+        "#9 ",
+        " : ",
+        " ; ",
+        " < ",
+        " = ",
+        " > ",
+        " ? ",
+        " @ ",
+        " A ",
+        " B ",
+        " C ",
+        " D ",
+        " E ",
+        " F ",
+        " G ",
+        " H ",
+        " I ",
+        " J ",
+        " K ",
+        " L ",
+        " M ",
+        " N ",
+        " O ",
+        " P ",
+        " Q ",
+        " R ",
+        " S ",
+        " T ",
+        " U ",
+        " V ",
+        " W ",
+        " X ",
+        " Y ",
+        " Z ",
+        " [ ",
+        " \\ ",
+        " ] ",
+        " ^ ",
+        " _ ",
+        " ` ",
+        " a ",
+        " b ",
+        " c ",
+        " d ",
+        " e ",
+        " f ",
+        " g ",
+        " h ",
+        " i ",
+        " j ",
+        " k ",
+        " l ",
+        " m ",
+        " n ",
+        " o ",
+        " p ",
+        " q ",
+        " r ",
+        " s ",
+        " t ",
+        " u ",
+        " v ",
+        " w ",
+        " x ",
+        " y ",
+        " z ",
+        " { ",
+        " | ",
+        " } ",
+        " ~ ",
+        "   ", // 0x7F - last ASCII printable
+        "CTRL",// 0x80 - left modifiers
+        "SHFT",
+        "ALT",
+        "META",
+        "CTRL",// 0x84 - right modifiers
+        "SHFT",
+        "ALT",
+        "META",
+        "",    // 0x88 - nothing
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",    // 0x90
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",    // 0xA0
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "ENTR",    // 0xB0 - Return/Enter
+        "ESC",
+        "RUB",
+        "TAB",
+        "",        // 0xB4 - nothing
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",        // 0xC0
+        "CAPS",    // 0xC1 - caps lock
+        "F1",
+        "F2",
+        "F3",
+        "F4",
+        "F5",
+        "F6",
+        "F7",
+        "F8",
+        "F9",
+        "F10",
+        "F11",
+        "F12",
+        "",       // 0xCE
+        "",
+        "",       // 0xD0
+        "INS",    // 0xD1 - insert
+        "",
+        "PgUp",
+        "DEL",
+        "END",
+        "PgDn",   // 0xD6 - page down
+        "Rght",
+        "Left",
+        "Dwn",
+        "Up",     // 0xDA - Up Arrow
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",       // 0xE0
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "",
+        "F13",    // 0xF0 - F13
+        "F14",
+        "F15",
+        "F16",
+        "F17",
+        "F18",
+        "F19",
+        "F20",
+        "F21",
+        "F22",
+        "F23",
+        "F24",    // 0xFB - F24
+        "",
+        "",
+        "",
+        ""
+    };
+};
@@ -0,0 +1,257 @@
+/*!
+ * @file PicoDeckTrace.cpp
+ * @brief Button input trace recording, and replay through the real input->HID->display pipeline.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+
+#include "PicoDeckTrace.h"
+
+void DeckTrace::RecordStart()
+{
+    Stop();
+    eventsCount = 0;
+    levels = 0xFFFFFFFF;
+    startTime = micros();
+    mode = Trace_Record;
+}
+
+void DeckTrace::Generate(const unsigned int &rate, const unsigned long &duration, uint32_t seed)
+{
+    Stop();
+    eventsCount = 0;
+    if(!rate) return;
+
+    // each button toggles on its own schedule, every half period give or take half of that again
+    const uint32_t halfPeriod = std::max(500000 / rate, 2u);
+    const uint32_t end = duration * 1000;
+    uint32_t next[32];
+    uint32_t state = 0xFFFFFFFF;
+
+    if(!seed) seed = 1;
+    auto random = [&seed]() {
+        // xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    };
+
+    for(unsigned int i = 0; i < buttonsCount; ++i)
+        next[i] = random() % halfPeriod;
+
+    while(eventsCount < TRACE_EVENTS_MAX) {
+        unsigned int b = 0;
+        for(unsigned int i = 1; i < buttonsCount; ++i)
+            if(next[i] < next[b]) b = i;
+        if(next[b] >= end) break;
+
+        state ^= 1 << b;
+        // buttons flipping on the same us share an event
+        if(eventsCount && events[eventsCount-1].time == next[b])
+            events[eventsCount-1].levels = state;
+        else events[eventsCount++] = { next[b], state };
+
+        next[b] += halfPeriod / 2 + random() % halfPeriod;
+    }
+}
+
+void DeckTrace::ReplayStart()
+{
+    Stop();
+    memset(&stats, 0, sizeof(stats));
+    memset(&displayStats, 0, sizeof(displayStats));
+    // FNV-1a offset basis
+    stats.reportsHash = 2166136261;
+    levels = 0xFFFFFFFF;
+    pending = 0;
+    cursor = 0;
+    clock = 0;
+    ending = false;
+    replayDone = false;
+    frameReady = false;
+
+    buttons.injectLevels = levels;
+    buttons.injectMask = 0xFFFFFFFF;
+    buttons.pageLock = true;
+    replaying = this;
+    LightgunButtons::Micros = ReplayClock;
+    mode = Trace_Replay;
+}
+
+void DeckTrace::ReplayEnd()
+{
+    if(mode != Trace_Replay) return;
+    cursor = eventsCount;
+    ending = true;
+}
+
+void DeckTrace::Stop()
+{
+    if(mode == Trace_Replay) {
+        // whatever was still in flight never made it
+        stats.edgesDropped += __builtin_popcount(pending);
+        pending = 0;
+        buttons.injectMask = 0;
+        buttons.pageLock = false;
+        LightgunButtons::Micros = nullptr;
+        replaying = nullptr;
+        replayDone = true;
+    }
+    mode = Trace_Off;
+}
+
+unsigned long DeckTrace::ReplayClock()
+{
+    return replaying->clock;
+}
+
+void DeckTrace::PrePoll()
+{
+    switch(mode) {
+    case Trace_Record:
+    {
+        const uint32_t now = micros() - startTime;
+        const uint32_t pins = PinsRead();
+        if(pins == levels) return;
+        levels = pins;
+
+        events[eventsCount++] = { now, pins };
+        if(eventsCount >= TRACE_EVENTS_MAX) Stop();
+        break;
+    }
+    case Trace_Replay:
+    {
+        // every pass is the same step on the replay clock, so the same trace debounces the same way each time
+        clock += TRACE_STEP_US;
+        while(cursor < eventsCount && events[cursor].time <= clock)
+            EdgesFeed(events[cursor++].levels, clock);
+
+        if(cursor >= eventsCount &&
+           (ending || !eventsCount || clock - events[eventsCount-1].time >= TRACE_SETTLE_TIME)) {
+            // anything the trace left held is let go of (not counted as its edges), and once that's
+            // gone through the buttons get their pins back with nothing down in the report
+            ending = true;
+            if(levels != 0xFFFFFFFF) {
+                levels = 0xFFFFFFFF;
+                buttons.injectLevels = levels;
+            } else if(!(buttons.debounced | buttons.debouncing | buttons.settling))
+                Stop();
+        }
+        break;
+    }
+    default: break;
+    }
+}
+
+void DeckTrace::PostPoll()
+{
+    if(mode != Trace_Replay) return;
+
+    uint32_t seen = (buttons.pressed | buttons.released) & pending;
+    if(!seen) return;
+    pending &= ~seen;
+
+    for(; seen; seen &= seen - 1) {
+        const uint32_t latency = clock - edgeTime[__builtin_ctz(seen)];
+        stats.inputMax = std::max(stats.inputMax, latency);
+        stats.inputSum += latency;
+        ++stats.inputCount;
+    }
+}
+
+void DeckTrace::DisplayHandled(const uint32_t &mask)
+{
+    if(mode != Trace_Replay) return;
+
+    // a button re-pressed before Core1 got to its last edge reads as shorter than it was, but those are
+    // at least debounceTicks apart, and Core1 running that far behind shows up in fifoFull anyways
+    const uint32_t now = micros();
+    for(uint32_t bits = mask & buttonsMask; bits; bits &= bits - 1) {
+        const uint32_t latency = now - edgeReal[__builtin_ctz(bits)];
+        displayStats.latencyMax = std::max(displayStats.latencyMax, latency);
+        displayStats.latencySum += latency;
+        ++displayStats.count;
+    }
+}
+
+void DeckTrace::ReportCaptured(const uint8_t *report, const size_t &len)
+{
+    if(mode != Trace_Replay) return;
+    ++stats.reports;
+    for(size_t i = 0; i < len; ++i)
+        stats.reportsHash = (stats.reportsHash ^ report[i]) * 16777619;
+}
+
+void DeckTrace::ReplayCompare()
+{
+    differs = -1;
+    if(lastValid) {
+        differs = 0;
+        if(stats.reports != lastReports || stats.reportsHash != lastReportsHash) differs |= Compare_Reports;
+        if(frameHash != lastFrameHash) differs |= Compare_Frame;
+    }
+
+    lastReports = stats.reports;
+    lastReportsHash = stats.reportsHash;
+    lastFrameHash = frameHash;
+    lastValid = true;
+}
+
+void DeckTrace::Dump(Print &out, const bool &events) const
+{
+    if(events) {
+        for(int i = 0; i < eventsCount; ++i)
+            out.printf("%lu %08lx\n", (unsigned long)this->events[i].time, (unsigned long)this->events[i].levels);
+        return;
+    }
+
+    out.printf("Edges: %lu, dropped: %lu\n", (unsigned long)stats.edges, (unsigned long)stats.edgesDropped);
+    if(stats.inputCount)
+        out.printf("Input latency: avg %lu us, max %lu us\n",
+                   (unsigned long)(stats.inputSum / stats.inputCount), (unsigned long)stats.inputMax);
+    if(displayStats.count)
+        out.printf("Display latency: avg %lu us, max %lu us\n",
+                   (unsigned long)(displayStats.latencySum / displayStats.count), (unsigned long)displayStats.latencyMax);
+    out.printf("HID reports: %lu (%08lx), final frame: %08lx, FIFO full: %lu\n", (unsigned long)stats.reports,
+               (unsigned long)stats.reportsHash, (unsigned long)frameHash, (unsigned long)stats.fifoFull);
+    if(differs < 0) out.println("First replay, nothing to compare with");
+    else if(!differs) out.println("Same reports & frame as the last replay");
+    else out.printf("Differs from the last replay:%s%s\n", (differs & Compare_Reports) ? " reports" : "",
+                    (differs & Compare_Frame) ? " frame" : "");
+}
+
+uint32_t DeckTrace::PinsRead() const
+{
+    uint32_t pins = 0xFFFFFFFF;
+    for(unsigned int i = 0; i < buttonsCount; ++i)
+        if(LightgunButtons::ButtonDesc[i].pin >= 0 && !digitalRead(LightgunButtons::ButtonDesc[i].pin))
+            pins &= ~(1 << i);
+
+    return pins;
+}
+
+void DeckTrace::EdgesFeed(const uint32_t &next, const uint32_t &now)
+{
+    for(uint32_t changed = (next ^ levels) & buttonsMask; changed; changed &= changed - 1) {
+        const int i = __builtin_ctz(changed);
+        ++stats.edges;
+
+        if(pending & (1 << i)) {
+            // flipped back before Poll() reported the last flip, so neither one will ever show
+            pending &= ~(1 << i);
+            stats.edgesDropped += 2;
+        } else {
+            pending |= 1 << i;
+            edgeTime[i] = now;
+            edgeReal[i] = micros();
+        }
+    }
+
+    levels = next;
+    buttons.injectLevels = next;
+}
@@ -0,0 +1,166 @@
+/*!
+ * @file PicoDeckTrace.h
+ * @brief Button input trace recording, and replay through the real input->HID->display pipeline.
+ * Replays run on a clock of their own and never reach the host, so the same trace always makes the same
+ * reports & final frame, which are checked against the last replay's.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <Arduino.h>
+#include <LightgunButtons.h>
+
+// 8 bytes each, so 4KB of RAM
+#define TRACE_EVENTS_MAX 512
+// how long replay keeps going after the last event, so the last edges get debounced & drawn
+#define TRACE_SETTLE_TIME 200000
+// replay clock time per Core0 pass, however long the pass really took
+#define TRACE_STEP_US 100
+
+class DeckTrace {
+public:
+    enum Mode_e {
+        Trace_Off = 0,
+        Trace_Record,   ///< Logging pin level changes as they happen
+        Trace_Replay,   ///< Feeding logged levels to the buttons in place of their pins
+    };
+
+    typedef struct Event_s {
+        uint32_t time;      ///< us since the start of the trace
+        uint32_t levels;    ///< Pin level of every button from this point on, bit per button, 1 if high (released)
+    } Event_t;
+
+    typedef struct Stats_s {
+        uint32_t edges;         ///< Level changes fed in
+        uint32_t edgesDropped;  ///< Level changes that reverted before Poll() ever reported them
+        uint32_t inputMax;      ///< Edge -> Poll() reporting it, in us
+        uint32_t inputSum;
+        uint32_t inputCount;
+        uint32_t reports;       ///< HID reports made (and held back from the host)
+        uint32_t fifoFull;      ///< Pushes to Core1 that found its FIFO full, and had to wait
+        uint32_t reportsHash;   ///< FNV-1a of every report made, in order
+    } Stats_t;
+
+    typedef struct DisplayStats_s {
+        uint32_t latencyMax;    ///< Edge -> Core1 picking up the press/release, in us
+        uint32_t latencySum;
+        uint32_t count;
+    } DisplayStats_t;
+
+    /// @brief Constructor
+    /// @param count Number of buttons in ButtonDesc
+    DeckTrace(LightgunButtons &btns, const unsigned int &count)
+        : buttons(btns), buttonsCount(count), buttonsMask(count < 32 ? (1 << count) - 1 : 0xFFFFFFFF) {}
+
+    /// @brief Starts logging pin levels, replacing whatever trace was held
+    void RecordStart();
+
+    /// @brief Fills the trace with synthetic mashing of every button, replacing whatever trace was held
+    /// @param rate Presses per second, per button (each press is held for about as long as the gap after it)
+    /// @param duration Length of the trace, in ms
+    /// @param seed Same seed, same trace
+    void Generate(const unsigned int &rate, const unsigned long &duration, uint32_t seed = 1);
+
+    /// @brief Starts feeding the held trace to the buttons, from the top
+    /// @details Presses go through Poll(), Keyboard_ and the Core1 FIFO exactly like real ones, timed by
+    /// a clock that moves TRACE_STEP_US per pass. The reports they make are taken with ReportCaptured() rather
+    /// than sent, and page keys don't change page. Replay ends by itself after the last event, once
+    /// everything still held has been let go.
+    void ReplayStart();
+
+    /// @brief Ends a replay early, letting go of everything still held first
+    void ReplayEnd();
+
+    /// @brief Stops recording or replaying, and gives the pins back to the buttons
+    /// @details Stopping a replay outright can leave keys held in the report; ReplayEnd() doesn't.
+    void Stop();
+
+    /// @brief Records or injects pin levels, call right before buttons.Poll()
+    void PrePoll();
+
+    /// @brief Tallies edges Poll() just reported, call right after it
+    void PostPoll();
+
+    /// @brief Takes a report a replayed edge made in place of the host, call with each one instead of sending it
+    void ReportCaptured(const uint8_t *report, const size_t &len);
+
+    /// @brief Core1 side: the frame left on screen once a replay's last edges were drawn
+    void FrameCaptured(const uint32_t &hash) { frameHash = hash; frameReady = true; }
+
+    /// @brief Counts a push to Core1 that had to wait for FIFO space
+    void FifoFull() { if(mode == Trace_Replay) ++stats.fifoFull; }
+
+    /// @brief Core1 side: times how long the buttons in mask took to reach the display
+    void DisplayHandled(const uint32_t &mask);
+
+    /// @brief Checks a finished replay's reports & final frame against the replay before it's, call once frameReady is set
+    /// @details The results are kept for the next replay to be checked against in turn.
+    void ReplayCompare();
+
+    /// @brief Dumps the trace's results (or events, if requested) as text
+    void Dump(Print &out, const bool &events = false) const;
+
+    volatile Mode_e mode = Trace_Off;
+
+    /// @brief Set when a replay has run to the end, until the next one starts
+    bool replayDone = false;
+
+    Stats_t stats;
+
+    // written by Core1 only
+    DisplayStats_t displayStats;
+
+    /// @brief Hash of the final frame (FNV-1a of the render buffer), and whether Core1 has got to it yet
+    volatile uint32_t frameHash = 0;
+    volatile bool frameReady = false;
+
+    Event_t events[TRACE_EVENTS_MAX];
+    int eventsCount = 0;
+
+private:
+    /// @brief Current level of every button's pin
+    uint32_t PinsRead() const;
+
+    /// @brief Counts edges between the last injected levels and these
+    void EdgesFeed(const uint32_t &next, const uint32_t &now);
+
+    /// @brief LightgunButtons::Micros while replaying
+    static unsigned long ReplayClock();
+
+    // the trace replaying, for ReplayClock()
+    static inline DeckTrace *replaying = nullptr;
+
+    LightgunButtons &buttons;
+    unsigned int buttonsCount;
+    uint32_t buttonsMask;
+
+    unsigned long startTime = 0;
+    int cursor = 0;
+    uint32_t levels = 0xFFFFFFFF;
+
+    // replay clock, us since the start of the trace
+    uint32_t clock = 0;
+    // set once the replay's only letting go of what's still held
+    bool ending = false;
+
+    // last finished replay's results, to check this one against
+    uint32_t lastReportsHash = 0;
+    uint32_t lastFrameHash = 0;
+    uint32_t lastReports = 0;
+    bool lastValid = false;
+
+    // Compare_e bits ReplayCompare() found different, or -1 if there was nothing to compare with
+    enum Compare_e { Compare_Reports = 1, Compare_Frame = 2 };
+    int differs = -1;
+
+    // buttons whose latest level change hasn't been reported by Poll() yet
+    uint32_t pending = 0;
+    // when each button's latest level change was fed, on the replay clock
+    uint32_t edgeTime[32];
+    // and in micros(), read by Core1 for how long drawing it really took
+    volatile uint32_t edgeReal[32];
+};
@@ -0,0 +1,82 @@
+/*!
+ * @file PicoDeckUI.cpp
+ * @brief Retained model of everything DeckDisplay draws, for diffing against what's already on screen.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+
+#include "PicoDeckUI.h"
+
+DeckUI::DeckUI()
+{
+    memset(&model, 0, sizeof(model));
+    memset(&drawn, 0, sizeof(drawn));
+}
+
+void DeckUI::SetBanner(const char *mainText, const uint8_t &mainAlign, const char *subText, const uint8_t &subAlign)
+{
+    strncpy(model.banner.mainText, mainText, UI_BANNER_TEXT_LEN-1);
+    model.banner.mainText[UI_BANNER_TEXT_LEN-1] = '\0';
+    model.banner.mainAlign = mainAlign;
+
+    model.banner.hasSub = (subText != nullptr);
+    if(model.banner.hasSub) {
+        strncpy(model.banner.subText, subText, UI_BANNER_TEXT_LEN-1);
+        model.banner.subText[UI_BANNER_TEXT_LEN-1] = '\0';
+        model.banner.subAlign = subAlign;
+    } else {
+        model.banner.subText[0] = '\0';
+        model.banner.subAlign = 0;
+    }
+}
+
+void DeckUI::Invalidate()
+{
+    bannerInvalid = true;
+    keysInvalid = 0xFFFF;
+    drawn.separators = 0;
+    drawn.status = Glyph_None;
+}
+
+bool DeckUI::KeyContentDirty(const int &cell) const
+{
+    if(keysInvalid & (1 << cell)) return true;
+
+    const KeyCell_t &want = model.keys[cell];
+    const KeyCell_t &have = drawn.keys[cell];
+    return want.binding != have.binding ||
+           want.icon != have.icon ||
+           KeyFrame(want) != KeyFrame(have);
+}
+
+bool DeckUI::KeyDirty(const int &cell) const
+{
+    return KeyContentDirty(cell) || (keysUnblitted & (1 << cell)) || model.keys[cell].pressed != drawn.keys[cell].pressed;
+}
+
+bool DeckUI::BannerDirty() const
+{
+    if(bannerInvalid) return true;
+
+    const Banner_t &want = model.banner;
+    const Banner_t &have = drawn.banner;
+    return want.mainAlign != have.mainAlign ||
+           want.hasSub != have.hasSub ||
+           (want.hasSub && want.subAlign != have.subAlign) ||
+           strcmp(want.mainText, have.mainText) ||
+           strcmp(want.subText, have.subText);
+}
+
+bool DeckUI::Dirty() const
+{
+    if(BannerDirty() || model.separators != drawn.separators || model.status != drawn.status)
+        return true;
+
+    for(int i = 0; i < UI_KEY_CELLS; ++i)
+        if(KeyDirty(i)) return true;
+
+    return false;
+}
@@ -0,0 +1,117 @@
+/*!
+ * @file PicoDeckUI.h
+ * @brief Retained model of everything DeckDisplay draws, for diffing against what's already on screen.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "PicoDeckPrefs.h"
+
+#define UI_KEY_CELLS 12
+#define UI_BANNER_TEXT_LEN 40
+
+class DeckUI {
+public:
+    /// @brief Glyph overlaid on the top right of the banner
+    enum StatusGlyph_e {
+        Glyph_None = 0,     ///< Banner contents are showing through
+        Glyph_Saving,
+        Glyph_SaveSuccess,
+        Glyph_SaveError     ///< Currently just a blanked box
+    };
+
+    /// @brief Bitmask of divider lines
+    enum Separators_e {
+        Sep_HeaderLine = 1 << 0,    ///< Horizontal line under the banner
+        Sep_KeysRightCol = 1 << 1   ///< Vertical line between the third and fourth key columns
+    };
+
+    /// @brief State of a single key box
+    typedef struct KeyCell_s {
+        uint16_t binding;                   ///< Key code + modifiers on the current page, 0 if unbound
+        const DeckPrefs::KeyBM_t *icon;     ///< Pixmap to display, or nullptr to fall back to text
+        bool pressed;                       ///< Held down (drawn inverted)
+        bool toggled;                       ///< Perpetual state of dual-frame icons
+    } KeyCell_t;
+
+    typedef struct Banner_s {
+        char mainText[UI_BANNER_TEXT_LEN];
+        char subText[UI_BANNER_TEXT_LEN];
+        uint8_t mainAlign;
+        uint8_t subAlign;
+        bool hasSub;
+    } Banner_t;
+
+    typedef struct Model_s {
+        Banner_t banner;
+        uint8_t separators;
+        KeyCell_t keys[UI_KEY_CELLS];
+        StatusGlyph_e status;
+    } Model_t;
+
+    /// @brief Constructor
+    DeckUI();
+
+    /// @brief Sets banner text in the wanted model (strings are copied)
+    void SetBanner(const char *mainText, const uint8_t &mainAlign, const char *subText, const uint8_t &subAlign);
+
+    /// @brief Marks everything as not drawn, i.e. after the render buffer was cleared
+    void Invalidate();
+
+    /// @brief Which frame of a key's icon should currently be visible
+    /// @details Dual-frame icons flip their toggle on press, but keep showing the old frame (inverted) until released.
+    static inline int KeyFrame(const KeyCell_t &cell) {
+        return (cell.icon != nullptr && cell.icon->isPacked && cell.toggled != cell.pressed) ? 1 : 0;
+    }
+
+    /// @brief Whether a key's (non-inverted) contents differ between wanted and drawn, i.e. needs rerendering
+    bool KeyContentDirty(const int &cell) const;
+
+    /// @brief Whether a key needs to be blitted again at all
+    bool KeyDirty(const int &cell) const;
+
+    /// @brief Whether banner text or alignment differs between wanted and drawn
+    bool BannerDirty() const;
+
+    /// @brief Whether anything at all is waiting to be drawn
+    bool Dirty() const;
+
+    /// @brief Records a key's wanted state as rendered
+    void KeyDrawn(const int &cell) {
+        drawn.keys[cell] = model.keys[cell];
+        keysInvalid &= ~(1 << cell);
+        keysUnblitted &= ~(1 << cell);
+    }
+
+    /// @brief Records a key's wanted contents as already in the key cache, so it's only blitted rather than rendered
+    void KeyContentCached(const int &cell) {
+        drawn.keys[cell] = model.keys[cell];
+        keysInvalid &= ~(1 << cell);
+        keysUnblitted |= 1 << cell;
+    }
+
+    /// @brief Records the wanted banner as rendered
+    void BannerDrawn() {
+        drawn.banner = model.banner;
+        bannerInvalid = false;
+    }
+
+    /// @brief State that should be shown
+    Model_t model;
+
+    /// @brief State that's currently in the render buffer
+    Model_t drawn;
+
+private:
+    // set when drawn doesn't reflect the render buffer at all (e.g. startup or cleared screen)
+    bool bannerInvalid = true;
+    // same as above, per key cell
+    uint16_t keysInvalid = 0xFFFF;
+    // key cells whose cached contents are up to date, but not in the render buffer yet
+    uint16_t keysUnblitted = 0;
+};
@@ -10,6 +10,26 @@
 
 #include <cstdint>
 
+// size of one 31x16 frame (4 bytes per row)
+#define KEYBM_ROW_BYTES 4
+#define KEYBM_FRAME_SIZE (KEYBM_ROW_BYTES * 16)
+
+/// @brief One frame of an animated key icon
+/// @details Full frames are KEYBM_FRAME_SIZE bytes, same layout as any other icon here.
+/// Delta frames are deltaRows records of {row index, KEYBM_ROW_BYTES bytes of row data}, applied atop the previous frame.
+typedef struct KeySpriteFrame_s {
+    const uint8_t *data;
+    uint16_t duration;      ///< How long this frame stays up, in ms
+    uint8_t deltaRows;      ///< 0 for a full frame
+} KeySpriteFrame_t;
+
+/// @brief Animated key icon (sprite sheet)
+/// @details Frame 0 must be a full frame; it's what's shown when the key is first drawn.
+typedef struct KeySprite_s {
+    const KeySpriteFrame_t *frames;
+    uint8_t count;
+} KeySprite_t;
+
 static constexpr uint8_t smiley_norm[] = {
     0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0x80, 0x02, 0x00, 0x00, 0x80, 0x02, 0x7c, 0x7c, 0x80,
     0x02, 0x00, 0x00, 0x80, 0x01, 0x18, 0x31, 0x00, 0x01, 0x18, 0x31, 0x00, 0x01, 0x18, 0x31, 0x00,
@@ -108,6 +128,22 @@ static constexpr uint8_t em_norm[] = {
     0x00, 0x30, 0x30, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+// em_norm, but blinking - eyes closed (delta atop em_norm)
+static constexpr uint8_t em_blink_closed[] = {
+    3, 0x00, 0x00, 0x00, 0x00,
+    4, 0x00, 0x00, 0x00, 0x00,
+    5, 0x00, 0x00, 0x00, 0x00,
+    6, 0x00, 0x3c, 0xf0, 0x00,
+    7, 0x00, 0x00, 0x00, 0x00
+};
+
+static constexpr KeySpriteFrame_t em_blink_frames[] = {
+    {em_norm,           2500, 0},
+    {em_blink_closed,   150,  5}
+};
+
+static constexpr KeySprite_t em_blink = {em_blink_frames, 2};
+
 
 static constexpr uint8_t em_happy[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x20, 0x00, 0x00, 0x28, 0x50, 0x00,
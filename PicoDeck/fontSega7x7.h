@@ -3,8 +3,10 @@
 #include <Adafruit_GFX.h>
 
 #define SEGAFONT7_HEIGHT 7
+#define SEGAFONT7_FIRST  0x20
+#define SEGAFONT7_LAST   0x87
 
-const uint8_t Sega7x7_Bitmaps[] PROGMEM = {
+constexpr uint8_t Sega7x7_Bitmaps[] PROGMEM = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x3C, 0x00, 0x5A, 0x09, 0x37, 0xB3, 
   0x7B, 0x24, 0x00, 0x10, 0xFB, 0x5B, 0x81, 0xDA, 0xDF, 0x00, 0x02, 0xCE, 
   0xB6, 0xC3, 0x6D, 0x73, 0x00, 0x79, 0xB1, 0xC3, 0xAD, 0xD1, 0xBD, 0x80, 
@@ -52,7 +54,7 @@ const uint8_t Sega7x7_Bitmaps[] PROGMEM = {
   0x24, 0xC0, 0x0F, 0x10, 0x71, 0x57, 0x75, 0x47, 0x04, 0x00
 };
 
-const GFXglyph Sega7x7_Glyphs[] PROGMEM = {
+constexpr GFXglyph Sega7x7_Glyphs[] PROGMEM = {
   {     0,   5,   7,   5,    0,   -7 },   // 0x20 ' '
   {     5,   2,   7,   3,    0,   -7 },   // 0x21 '!'
   {     8,   4,   2,   5,    0,   -7 },   // 0x22 '"'
@@ -161,4 +163,4 @@ const GFXglyph Sega7x7_Glyphs[] PROGMEM = {
 
 const GFXfont Sega7x7 PROGMEM = {(uint8_t*)Sega7x7_Bitmaps,
                                  (GFXglyph*)Sega7x7_Glyphs,
-                                 0x20, 0x87, 7};
\ No newline at end of file
+                                 SEGAFONT7_FIRST, SEGAFONT7_LAST, 7};
\ No newline at end of file
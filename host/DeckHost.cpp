@@ -0,0 +1,123 @@
+/*!
+ * @file DeckHost.cpp
+ * @brief Runs the sketch on a PC: both cores' loops interleaved on one thread, against a virtual clock and pins.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+
+#include "DeckHost.h"
+
+// the sketch's entry points
+void setup();
+void setup1();
+void loop();
+void loop1();
+
+namespace DeckHost {
+    uint8_t core = 0;
+    uint64_t now = 0;
+    uint32_t passTime = 20;
+    int8_t pinDrive[PINS] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                              -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+    // whether each core asked to sleep on its last pass, and until when
+    static bool asleep[2];
+    static uint64_t wakeAt[2];
+    // how deep blocking calls have nested into the other core
+    static int otherDepth = 0;
+
+    void PinChanged(const int &pin, const int &was);
+}
+
+static void LoopOf(const uint8_t &which)
+{
+    const uint8_t was = DeckHost::core;
+    DeckHost::core = which;
+    DeckHost::asleep[which] = false;
+    if(which) loop1();
+    else loop();
+    DeckHost::core = was;
+}
+
+void DeckHost::Boot()
+{
+    core = 0;
+    setup();
+    core = 1;
+    setup1();
+    core = 0;
+}
+
+void DeckHost::Step()
+{
+    LoopOf(0);
+    LoopOf(1);
+
+    if(asleep[0] && asleep[1]) {
+        const uint64_t next = wakeAt[0] < wakeAt[1] ? wakeAt[0] : wakeAt[1];
+        now = next > now ? next : now + 1;
+    } else now += passTime;
+}
+
+void DeckHost::Run(const uint64_t &us)
+{
+    const uint64_t end = now + us;
+    while(now < end) {
+        Step();
+        // don't overshoot into time the caller wanted to do something at
+        if(now > end) now = end;
+    }
+}
+
+bool DeckHost::RunUntil(bool (*done)(), const uint64_t &timeout)
+{
+    const uint64_t end = now + timeout;
+    while(!done()) {
+        if(now >= end) return false;
+        Step();
+        if(now > end) now = end;
+    }
+    return true;
+}
+
+void DeckHost::PinSet(const int &pin, const int &level)
+{
+    const int was = digitalRead(pin);
+    pinDrive[pin] = level ? HIGH : LOW;
+    PinChanged(pin, was);
+}
+
+void DeckHost::PinRelease(const int &pin)
+{
+    const int was = digitalRead(pin);
+    pinDrive[pin] = -1;
+    PinChanged(pin, was);
+}
+
+void DeckHost::RunOther()
+{
+    // two blocking calls waiting on each other would just recurse forever
+    if(++otherDepth > 64) {
+        fprintf(stderr, "DeckHost: cores deadlocked on blocking calls\n");
+        abort();
+    }
+    LoopOf(!core);
+    // the waiting core isn't getting anything done meanwhile
+    now += passTime;
+    --otherDepth;
+}
+
+void DeckHost::SleepUntil(const uint32_t &until)
+{
+    const int32_t left = until - (uint32_t)now;
+    asleep[core] = true;
+    wakeAt[core] = left > 0 ? now + left : now;
+}
+
+void DeckHost::Wake(const uint8_t &which)
+{
+    asleep[which] = false;
+}
@@ -0,0 +1,59 @@
+/*!
+ * @file DeckHost.h
+ * @brief Runs the sketch on a PC: both cores' loops interleaved on one thread, against a virtual clock and pins.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/// @brief Two emulated cores taking turns, plus the virtual time & pin levels the shims read from.
+/// @details Each Step() runs one pass of loop() then loop1(); if both then asked to sleep, the clock jumps
+/// to whichever deadline comes first, otherwise it moves on by passTime. Nothing runs in between, so any
+/// sequence of Step()s plays out the same every time.
+namespace DeckHost {
+    static constexpr int PINS = 30;
+
+    /// @brief Emulated core that's running right now
+    extern uint8_t core;
+
+    /// @brief Virtual us since reset
+    extern uint64_t now;
+
+    /// @brief How long a loop pass takes when it doesn't sleep
+    extern uint32_t passTime;
+
+    /// @brief Level each pin's being driven to from outside, or -1 to leave it to the pull (or the sketch)
+    extern int8_t pinDrive[PINS];
+
+    /// @brief Runs setup() on Core0 then setup1() on Core1, like the core does at reset
+    void Boot();
+
+    /// @brief One pass of each core's loop, then moves the clock on
+    void Step();
+
+    /// @brief Steps until us of virtual time have gone by
+    void Run(const uint64_t &us);
+
+    /// @brief Steps until done() says so, or timeout us have gone by
+    /// @return Whether done() came true
+    bool RunUntil(bool (*done)(), const uint64_t &timeout);
+
+    /// @brief Drives a pin from outside, firing whatever's attached to its edges
+    void PinSet(const int &pin, const int &level);
+
+    /// @brief Lets go of a pin, back to its pull
+    void PinRelease(const int &pin);
+
+    /// @brief Runs a pass of the other core's loop, for a blocking call that's waiting on it
+    void RunOther();
+
+    /// @brief Marks the running core as sleeping until a micros() deadline (32-bit, like DeckTimeUs())
+    void SleepUntil(const uint32_t &until);
+
+    /// @brief Cuts a core's sleep short, like an event from the other core would
+    void Wake(const uint8_t &which);
+}
@@ -0,0 +1,12 @@
+/*!
+ * @file PicoDeckSketch.cpp
+ * @brief The sketch itself, built as a plain C++ file for the host.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+// arduino-builder would add this, and prototypes for the sketch's functions - PicoDeck.h already declares those
+#include <Arduino.h>
+
+#include "PicoDeck.ino"
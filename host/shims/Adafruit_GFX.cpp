@@ -0,0 +1,237 @@
+/*!
+ * @file Adafruit_GFX.cpp
+ * @brief Host stand-in for Adafruit GFX: the same drawing primitives, all built on drawPixel().
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Adafruit_GFX.h>
+#include <stdlib.h>
+#include <utility>
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    for(int16_t i = 0; i < h; ++i) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    for(int16_t i = 0; i < w; ++i) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for(int16_t i = x; i < x + w; ++i) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    // Bresenham, stepping along whichever axis is longer
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if(steep) { std::swap(x0, y0); std::swap(x1, y1); }
+    if(x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+
+    const int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    const int16_t ystep = y0 < y1 ? 1 : -1;
+    int16_t err = dx / 2;
+    for(; x0 <= x1; ++x0) {
+        if(steep) drawPixel(y0, x0, color);
+        else drawPixel(x0, y0, color);
+        err -= dy;
+        if(err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    const int16_t stride = (w + 7) / 8;
+    for(int16_t j = 0; j < h; ++j)
+        for(int16_t i = 0; i < w; ++i)
+            if(bitmap[j * stride + i / 8] & (0x80 >> (i & 7)))
+                drawPixel(x + i, y + j, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
+{
+    drawBitmap(x, y, (const uint8_t*)bitmap, w, h, color);
+}
+
+void Adafruit_GFX::setFont(const GFXfont *f)
+{
+    // custom fonts are positioned by baseline, the classic one by its top; the cursor's moved to keep text in place
+    if(f && !gfxFont) cursor_y += 6;
+    else if(!f && gfxFont) cursor_y -= 6;
+    gfxFont = f;
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    if(!gfxFont) {
+        // the classic 5x7 font's data isn't carried here: each visible character is a hollow 5x7 box,
+        // which keeps text the same size & place as on the device, and still different from no text
+        if(c == ' ') return;
+        for(int8_t i = 0; i < 5; ++i) {
+            for(int8_t j = 0; j < 7; ++j) {
+                const bool on = i == 0 || i == 4 || j == 0 || j == 6;
+                if(on) fillRect(x + i * size, y + j * size, size, size, color);
+                else if(bg != color) fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+        return;
+    }
+
+    c -= gfxFont->first;
+    const GFXglyph *glyph = &gfxFont->glyph[c];
+    const uint8_t *bitmap = gfxFont->bitmap;
+    uint16_t bo = glyph->bitmapOffset;
+    uint8_t bits = 0, bit = 0;
+    for(uint8_t yy = 0; yy < glyph->height; ++yy) {
+        for(uint8_t xx = 0; xx < glyph->width; ++xx) {
+            if(!(bit++ & 7)) bits = bitmap[bo++];
+            if(bits & 0x80) {
+                if(size == 1) drawPixel(x + glyph->xOffset + xx, y + glyph->yOffset + yy, color);
+                else fillRect(x + (glyph->xOffset + xx) * size, y + (glyph->yOffset + yy) * size, size, size, color);
+            }
+            bits <<= 1;
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if(!gfxFont) {
+        if(c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        } else if(c != '\r') {
+            if(wrap && cursor_x + textsize_x * 6 > _width) {
+                cursor_x = 0;
+                cursor_y += textsize_y * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+            cursor_x += textsize_x * 6;
+        }
+        return 1;
+    }
+
+    if(c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize_y * gfxFont->yAdvance;
+    } else if(c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+        const GFXglyph *glyph = &gfxFont->glyph[c - gfxFont->first];
+        if(glyph->width > 0 && glyph->height > 0) {
+            if(wrap && cursor_x + textsize_x * (glyph->xOffset + glyph->width) > _width) {
+                cursor_x = 0;
+                cursor_y += textsize_y * gfxFont->yAdvance;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+        }
+        cursor_x += glyph->xAdvance * textsize_x;
+    }
+    return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
+{
+    if(!gfxFont) {
+        if(c == '\n') {
+            *x = 0;
+            *y += textsize_y * 8;
+        } else if(c != '\r') {
+            if(wrap && *x + textsize_x * 6 > _width) {
+                *x = 0;
+                *y += textsize_y * 8;
+            }
+            const int16_t x2 = *x + textsize_x * 6 - 1, y2 = *y + textsize_y * 8 - 1;
+            if(x2 > *maxx) *maxx = x2;
+            if(y2 > *maxy) *maxy = y2;
+            if(*x < *minx) *minx = *x;
+            if(*y < *miny) *miny = *y;
+            *x += textsize_x * 6;
+        }
+        return;
+    }
+
+    if(c == '\n') {
+        *x = 0;
+        *y += textsize_y * gfxFont->yAdvance;
+    } else if(c != '\r' && c >= gfxFont->first && c <= gfxFont->last) {
+        const GFXglyph *glyph = &gfxFont->glyph[c - gfxFont->first];
+        if(wrap && *x + (glyph->xOffset + glyph->width) * textsize_x > _width) {
+            *x = 0;
+            *y += textsize_y * gfxFont->yAdvance;
+        }
+        const int16_t x1 = *x + glyph->xOffset * textsize_x, y1 = *y + glyph->yOffset * textsize_y;
+        const int16_t x2 = x1 + glyph->width * textsize_x - 1, y2 = y1 + glyph->height * textsize_y - 1;
+        if(x1 < *minx) *minx = x1;
+        if(y1 < *miny) *miny = y1;
+        if(x2 > *maxx) *maxx = x2;
+        if(y2 > *maxy) *maxy = y2;
+        *x += glyph->xAdvance * textsize_x;
+    }
+}
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+    int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+
+    while(*str) charBounds(*str++, &x, &y, &minx, &miny, &maxx, &maxy);
+
+    if(maxx >= minx) {
+        *x1 = minx;
+        *w = maxx - minx + 1;
+    }
+    if(maxy >= miny) {
+        *y1 = miny;
+        *h = maxy - miny + 1;
+    }
+}
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h)
+{
+    buffer = (uint8_t*)calloc(((w + 7) / 8) * h, 1);
+}
+
+GFXcanvas1::~GFXcanvas1()
+{
+    free(buffer);
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+    if(color) *ptr |= 0x80 >> (x & 7);
+    else *ptr &= ~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color)
+{
+    memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
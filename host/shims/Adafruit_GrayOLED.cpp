@@ -0,0 +1,158 @@
+/*!
+ * @file Adafruit_GrayOLED.cpp
+ * @brief Host stand-in for the Adafruit GrayOLED base the SH110X drivers sit on, tracking the window drawn to.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Adafruit_GrayOLED.h>
+#include <algorithm>
+
+// bytes per I2C transmission, as in the Arduino Wire buffer
+#define WIRE_MAX 32
+
+Adafruit_GrayOLED::Adafruit_GrayOLED(uint8_t, uint16_t w, uint16_t h, TwoWire *twi, int8_t, uint32_t preclk, uint32_t postclk)
+    : Adafruit_GFX(w, h), controller(HostOLED::OLED_SH1107, w, h), wire(twi), i2c_preclk(preclk), i2c_postclk(postclk)
+{
+}
+
+Adafruit_GrayOLED::Adafruit_GrayOLED(uint8_t, uint16_t w, uint16_t h, SPIClass *spiBus, int8_t dc_pin, int8_t, int8_t cs_pin, uint32_t rate)
+    : Adafruit_GFX(w, h), controller(HostOLED::OLED_SH1107, w, h), spi(spiBus), dcPin(dc_pin), csPin(cs_pin),
+      i2c_preclk(0), i2c_postclk(0), bitrate(rate)
+{
+}
+
+Adafruit_GrayOLED::~Adafruit_GrayOLED()
+{
+    if(wire && i2caddr) wire->Attach(i2caddr, nullptr);
+    if(spi) spi->Attach(csPin, dcPin, nullptr);
+    free(buffer);
+}
+
+bool Adafruit_GrayOLED::_init(uint8_t addr, bool)
+{
+    if(!buffer && !(buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8))))
+        return false;
+    clearDisplay();
+    // everything gets pushed on the first display()
+    window_x1 = window_y1 = 0;
+    window_x2 = WIDTH - 1;
+    window_y2 = HEIGHT - 1;
+
+    if(wire) {
+        i2caddr = addr;
+        wire->begin();
+        wire->Attach(i2caddr, &controller);
+    } else {
+        pinMode(dcPin, OUTPUT);
+        pinMode(csPin, OUTPUT);
+        digitalWrite(csPin, HIGH);
+        spi->begin();
+        spi->Attach(csPin, dcPin, &controller);
+    }
+    return true;
+}
+
+bool Adafruit_GrayOLED::oled_commandList(const uint8_t *c, uint8_t n)
+{
+    if(wire) {
+        wire->setClock(i2c_preclk);
+        wire->beginTransmission(i2caddr);
+        wire->write((uint8_t)0x00);
+        uint16_t bytesOut = 1;
+        while(n--) {
+            if(bytesOut >= WIRE_MAX) {
+                if(wire->endTransmission()) return false;
+                wire->beginTransmission(i2caddr);
+                wire->write((uint8_t)0x00);
+                bytesOut = 1;
+            }
+            wire->write(*c++);
+            ++bytesOut;
+        }
+        const bool ok = !wire->endTransmission();
+        wire->setClock(i2c_postclk);
+        return ok;
+    }
+
+    spi->beginTransaction(SPISettings(bitrate, MSBFIRST, SPI_MODE0));
+    digitalWrite(dcPin, LOW);
+    digitalWrite(csPin, LOW);
+    while(n--) spi->transfer(*c++);
+    digitalWrite(csPin, HIGH);
+    spi->endTransaction();
+    return true;
+}
+
+void Adafruit_GrayOLED::dataList(const uint8_t *d, uint16_t n)
+{
+    if(wire) {
+        wire->setClock(i2c_preclk);
+        while(n) {
+            const uint16_t chunk = std::min<uint16_t>(n, WIRE_MAX - 1);
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x40);
+            wire->write(d, chunk);
+            wire->endTransmission();
+            d += chunk;
+            n -= chunk;
+        }
+        wire->setClock(i2c_postclk);
+        return;
+    }
+
+    spi->beginTransaction(SPISettings(bitrate, MSBFIRST, SPI_MODE0));
+    digitalWrite(dcPin, HIGH);
+    digitalWrite(csPin, LOW);
+    spi->transfer(d, nullptr, n);
+    digitalWrite(csPin, HIGH);
+    spi->endTransaction();
+}
+
+void Adafruit_GrayOLED::oled_command(uint8_t cmd)
+{
+    oled_commandList(&cmd, 1);
+}
+
+void Adafruit_GrayOLED::setContrast(uint8_t level)
+{
+    const uint8_t cmds[] = { GRAYOLED_SETCONTRAST, level };
+    oled_commandList(cmds, sizeof(cmds));
+}
+
+void Adafruit_GrayOLED::invertDisplay(bool i)
+{
+    oled_command(i ? GRAYOLED_INVERTDISPLAY : GRAYOLED_NORMALDISPLAY);
+}
+
+void Adafruit_GrayOLED::clearDisplay()
+{
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+    window_x1 = window_y1 = 0;
+    window_x2 = WIDTH - 1;
+    window_y2 = HEIGHT - 1;
+}
+
+void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return;
+
+    window_x1 = std::min(window_x1, x);
+    window_y1 = std::min(window_y1, y);
+    window_x2 = std::max(window_x2, x);
+    window_y2 = std::max(window_y2, y);
+
+    uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+    switch(color) {
+        case MONOOLED_WHITE: *ptr |= 1 << (y & 7); break;
+        case MONOOLED_BLACK: *ptr &= ~(1 << (y & 7)); break;
+        case MONOOLED_INVERSE: *ptr ^= 1 << (y & 7); break;
+    }
+}
+
+bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y)
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
@@ -0,0 +1,57 @@
+/*!
+ * @file Adafruit_GrayOLED.h
+ * @brief Host stand-in for the Adafruit GrayOLED base the SH110X drivers sit on, tracking the window drawn to.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+#include <SPI.h>
+
+#include "HostOLED.h"
+
+#define GRAYOLED_SETCONTRAST 0x81
+#define GRAYOLED_NORMALDISPLAY 0xA6
+#define GRAYOLED_INVERTDISPLAY 0xA7
+
+#define MONOOLED_BLACK 0
+#define MONOOLED_WHITE 1
+#define MONOOLED_INVERSE 2
+
+class Adafruit_GrayOLED : public Adafruit_GFX {
+public:
+    Adafruit_GrayOLED(uint8_t bpp, uint16_t w, uint16_t h, TwoWire *twi = &Wire, int8_t rst_pin = -1,
+                      uint32_t preclk = 400000, uint32_t postclk = 100000);
+    Adafruit_GrayOLED(uint8_t bpp, uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin,
+                      uint32_t bitrate = 8000000UL);
+    ~Adafruit_GrayOLED();
+
+    void oled_command(uint8_t cmd);
+    bool oled_commandList(const uint8_t *c, uint8_t n);
+    void setContrast(uint8_t level);
+    void invertDisplay(bool i) override;
+    void clearDisplay();
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y);
+    uint8_t *getBuffer() { return buffer; }
+
+    /// @brief The controller at the other end of the bus, whose RAM is what's on the glass
+    HostOLED controller;
+
+protected:
+    bool _init(uint8_t i2caddr, bool reset);
+    /// @brief Data bytes to the controller, same bus rules as commands
+    void dataList(const uint8_t *d, uint16_t n);
+
+    TwoWire *wire = nullptr;
+    SPIClass *spi = nullptr;
+    uint8_t *buffer = nullptr;
+    int8_t i2caddr = 0, dcPin = -1, csPin = -1;
+    uint32_t i2c_preclk, i2c_postclk, bitrate = 8000000UL;
+    // bounds of what's been drawn since the last display(), so only those pages go out
+    int16_t window_x1, window_y1, window_x2, window_y2;
+};
@@ -0,0 +1,86 @@
+/*!
+ * @file Adafruit_SH110X.cpp
+ * @brief Host stand-in for the Adafruit SH1106G/SH1107 drivers, talking to an emulated controller on the bus.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Adafruit_SH110X.h>
+
+void Adafruit_SH110X::display()
+{
+    // pages the drawing window touched, or nothing if it's empty
+    if(window_x2 >= window_x1 && window_y2 >= window_y1) {
+        const uint8_t firstPage = window_y1 / 8, lastPage = window_y2 / 8;
+        const uint8_t col = window_x1 + _page_start_offset;
+        for(uint8_t p = firstPage; p <= lastPage; ++p) {
+            const uint8_t cmds[] = {
+                (uint8_t)(SH110X_SETPAGEADDR + p),
+                (uint8_t)(SH110X_SETHIGHCOLUMN + (col >> 4)),
+                (uint8_t)(SH110X_SETLOWCOLUMN + (col & 0x0F))
+            };
+            oled_commandList(cmds, sizeof(cmds));
+            dataList(buffer + p * WIDTH + window_x1, window_x2 - window_x1 + 1);
+        }
+    }
+
+    // nothing's drawn until the next drawPixel()
+    window_x1 = 1024;
+    window_y1 = 1024;
+    window_x2 = -1;
+    window_y2 = -1;
+}
+
+static const uint8_t SH110X_INIT[] = {
+    SH110X_DISPLAYOFF,
+    0xD5, 0x80,         // clock divide
+    0x81, 0x2F,         // contrast
+    0x20,               // page addressing
+    0xA0, 0xC8,         // segment remap, COM scan direction
+    0xA8, 0x3F,         // multiplex
+    0xD3, 0x00,         // display offset
+    0xDB, 0x35,
+    0xA4, 0xA6,
+};
+
+Adafruit_SH1106G::Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire *twi, int8_t rst_pin, uint32_t preclk, uint32_t postclk)
+    : Adafruit_SH110X(w, h, twi, rst_pin, preclk, postclk)
+{
+    controller.type = HostOLED::OLED_SH1106;
+}
+
+Adafruit_SH1106G::Adafruit_SH1106G(uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin, uint32_t bitrate)
+    : Adafruit_SH110X(w, h, spi, dc_pin, rst_pin, cs_pin, bitrate)
+{
+    controller.type = HostOLED::OLED_SH1106;
+}
+
+bool Adafruit_SH1106G::begin(uint8_t addr, bool reset)
+{
+    if(!_init(addr, reset)) return false;
+    _page_start_offset = 2;
+    if(!oled_commandList(SH110X_INIT, sizeof(SH110X_INIT))) return false;
+    delay(100);
+    oled_command(SH110X_DISPLAYON);
+    return true;
+}
+
+Adafruit_SH1107::Adafruit_SH1107(uint16_t w, uint16_t h, TwoWire *twi, int8_t rst_pin, uint32_t preclk, uint32_t postclk)
+    : Adafruit_SH110X(w, h, twi, rst_pin, preclk, postclk)
+{
+}
+
+Adafruit_SH1107::Adafruit_SH1107(uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin, uint32_t bitrate)
+    : Adafruit_SH110X(w, h, spi, dc_pin, rst_pin, cs_pin, bitrate)
+{
+}
+
+bool Adafruit_SH1107::begin(uint8_t addr, bool reset)
+{
+    if(!_init(addr, reset)) return false;
+    if(!oled_commandList(SH110X_INIT, sizeof(SH110X_INIT))) return false;
+    delay(100);
+    oled_command(SH110X_DISPLAYON);
+    return true;
+}
@@ -0,0 +1,53 @@
+/*!
+ * @file Adafruit_SH110X.h
+ * @brief Host stand-in for the Adafruit SH1106G/SH1107 drivers, talking to an emulated controller on the bus.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Adafruit_GrayOLED.h>
+
+#define SH110X_BLACK 0
+#define SH110X_WHITE 1
+#define SH110X_INVERSE 2
+
+#define SH110X_SETPAGEADDR 0xB0
+#define SH110X_SETLOWCOLUMN 0x00
+#define SH110X_SETHIGHCOLUMN 0x10
+#define SH110X_DISPLAYOFF 0xAE
+#define SH110X_DISPLAYON 0xAF
+
+class Adafruit_SH110X : public Adafruit_GrayOLED {
+public:
+    Adafruit_SH110X(uint16_t w, uint16_t h, TwoWire *twi, int8_t rst_pin, uint32_t preclk, uint32_t postclk)
+        : Adafruit_GrayOLED(1, w, h, twi, rst_pin, preclk, postclk) {}
+    Adafruit_SH110X(uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin, uint32_t bitrate)
+        : Adafruit_GrayOLED(1, w, h, spi, dc_pin, rst_pin, cs_pin, bitrate) {}
+
+    /// @brief Pushes only the pages drawn to since the last call
+    void display();
+
+protected:
+    uint8_t _page_start_offset = 0;
+};
+
+class Adafruit_SH1106G : public Adafruit_SH110X {
+public:
+    Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire *twi = &Wire, int8_t rst_pin = -1,
+                     uint32_t preclk = 400000, uint32_t postclk = 100000);
+    Adafruit_SH1106G(uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin,
+                     uint32_t bitrate = 8000000UL);
+    bool begin(uint8_t i2caddr = 0x3C, bool reset = true);
+};
+
+class Adafruit_SH1107 : public Adafruit_SH110X {
+public:
+    Adafruit_SH1107(uint16_t w, uint16_t h, TwoWire *twi = &Wire, int8_t rst_pin = -1,
+                    uint32_t preclk = 400000, uint32_t postclk = 100000);
+    Adafruit_SH1107(uint16_t w, uint16_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin,
+                    uint32_t bitrate = 8000000UL);
+    bool begin(uint8_t i2caddr = 0x3C, bool reset = true);
+};
@@ -0,0 +1,187 @@
+/*!
+ * @file Adafruit_SSD1306.cpp
+ * @brief Host stand-in for the Adafruit SSD1306 driver, talking to an emulated controller on the bus.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Adafruit_SSD1306.h>
+
+// bytes per I2C transmission, as in the Arduino Wire buffer
+#define WIRE_MAX 32
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t, uint32_t clkDuring, uint32_t clkAfter)
+    : Adafruit_GFX(w, h), controller(HostOLED::OLED_SSD1306, w, h), wire(twi), wireClk(clkDuring), restoreClk(clkAfter)
+{
+}
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, SPIClass *spiBus, int8_t dc_pin, int8_t, int8_t cs_pin, uint32_t rate)
+    : Adafruit_GFX(w, h), controller(HostOLED::OLED_SSD1306, w, h), spi(spiBus), dcPin(dc_pin), csPin(cs_pin),
+      wireClk(0), restoreClk(0), bitrate(rate)
+{
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306()
+{
+    if(wire && i2caddr) wire->Attach(i2caddr, nullptr);
+    if(spi) spi->Attach(csPin, dcPin, nullptr);
+    free(buffer);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool, bool periphBegin)
+{
+    if(!buffer && !(buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8))))
+        return false;
+    clearDisplay();
+    vccstate = vcs;
+
+    if(wire) {
+        i2caddr = addr ? addr : (HEIGHT == 32 ? 0x3C : 0x3D);
+        if(periphBegin) wire->begin();
+        wire->Attach(i2caddr, &controller);
+    } else {
+        pinMode(dcPin, OUTPUT);
+        pinMode(csPin, OUTPUT);
+        digitalWrite(csPin, HIGH);
+        if(periphBegin) spi->begin();
+        spi->Attach(csPin, dcPin, &controller);
+    }
+
+    const uint8_t init[] = {
+        SSD1306_DISPLAYOFF,
+        0xD5, 0x80,                             // clock divide
+        0xA8, (uint8_t)(HEIGHT - 1),            // multiplex
+        0xD3, 0x00,                             // display offset
+        0x40,                                   // start line 0
+        SSD1306_CHARGEPUMP, (uint8_t)(vccstate == SSD1306_EXTERNALVCC ? 0x10 : 0x14),
+        SSD1306_MEMORYMODE, 0x00,               // horizontal addressing
+        0xA1, 0xC8,                             // segment remap, COM scan direction
+        0xDA, (uint8_t)(HEIGHT == 32 ? 0x02 : 0x12),
+        SSD1306_SETCONTRAST, (uint8_t)(vccstate == SSD1306_EXTERNALVCC ? 0x9F : 0xCF),
+        0xD9, (uint8_t)(vccstate == SSD1306_EXTERNALVCC ? 0x22 : 0xF1),
+        0xDB, 0x40,
+        SSD1306_DISPLAYALLON_RESUME,
+        SSD1306_NORMALDISPLAY,
+        SSD1306_DEACTIVATE_SCROLL,
+        SSD1306_DISPLAYON
+    };
+    commandList(init, sizeof(init));
+    return true;
+}
+
+void Adafruit_SSD1306::commandList(const uint8_t *c, uint8_t n)
+{
+    if(wire) {
+        wire->setClock(wireClk);
+        wire->beginTransmission(i2caddr);
+        wire->write((uint8_t)0x00);
+        uint16_t bytesOut = 1;
+        while(n--) {
+            if(bytesOut >= WIRE_MAX) {
+                wire->endTransmission();
+                wire->beginTransmission(i2caddr);
+                wire->write((uint8_t)0x00);
+                bytesOut = 1;
+            }
+            wire->write(*c++);
+            ++bytesOut;
+        }
+        wire->endTransmission();
+        wire->setClock(restoreClk);
+    } else {
+        spi->beginTransaction(SPISettings(bitrate, MSBFIRST, SPI_MODE0));
+        digitalWrite(dcPin, LOW);
+        digitalWrite(csPin, LOW);
+        while(n--) spi->transfer(*c++);
+        digitalWrite(csPin, HIGH);
+        spi->endTransaction();
+    }
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c)
+{
+    commandList(&c, 1);
+}
+
+void Adafruit_SSD1306::display()
+{
+    const uint8_t colStart = WIDTH == 64 ? 32 : 0;
+    const uint8_t window[] = {
+        SSD1306_PAGEADDR, 0, 0xFF,
+        SSD1306_COLUMNADDR, colStart, (uint8_t)(colStart + WIDTH - 1)
+    };
+    commandList(window, sizeof(window));
+
+    uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+    const uint8_t *ptr = buffer;
+    if(wire) {
+        wire->setClock(wireClk);
+        wire->beginTransmission(i2caddr);
+        wire->write((uint8_t)0x40);
+        uint16_t bytesOut = 1;
+        while(count--) {
+            if(bytesOut >= WIRE_MAX) {
+                wire->endTransmission();
+                wire->beginTransmission(i2caddr);
+                wire->write((uint8_t)0x40);
+                bytesOut = 1;
+            }
+            wire->write(*ptr++);
+            ++bytesOut;
+        }
+        wire->endTransmission();
+        wire->setClock(restoreClk);
+    } else {
+        spi->beginTransaction(SPISettings(bitrate, MSBFIRST, SPI_MODE0));
+        digitalWrite(dcPin, HIGH);
+        digitalWrite(csPin, LOW);
+        spi->transfer(ptr, nullptr, count);
+        digitalWrite(csPin, HIGH);
+        spi->endTransaction();
+    }
+}
+
+void Adafruit_SSD1306::clearDisplay()
+{
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i)
+{
+    ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool dim)
+{
+    const uint8_t cmds[] = { SSD1306_SETCONTRAST, (uint8_t)(dim ? 0 : (vccstate == SSD1306_EXTERNALVCC ? 0x9F : 0xCF)) };
+    commandList(cmds, sizeof(cmds));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+    switch(color) {
+        case SSD1306_WHITE: *ptr |= 1 << (y & 7); break;
+        case SSD1306_BLACK: *ptr &= ~(1 << (y & 7)); break;
+        case SSD1306_INVERSE: *ptr ^= 1 << (y & 7); break;
+    }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y)
+{
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
+
+void Adafruit_SSD1306::startscrollright(uint8_t start, uint8_t stop)
+{
+    const uint8_t cmds[] = { SSD1306_RIGHT_HORIZONTAL_SCROLL, 0x00, start, 0x00, stop, 0x00, 0xFF, SSD1306_ACTIVATE_SCROLL };
+    commandList(cmds, sizeof(cmds));
+}
+
+void Adafruit_SSD1306::stopscroll()
+{
+    ssd1306_command(SSD1306_DEACTIVATE_SCROLL);
+}
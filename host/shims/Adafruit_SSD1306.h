@@ -0,0 +1,74 @@
+/*!
+ * @file Adafruit_SSD1306.h
+ * @brief Host stand-in for the Adafruit SSD1306 driver, talking to an emulated controller on the bus.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+#include <SPI.h>
+
+#include "HostOLED.h"
+
+#define BLACK 0
+#define WHITE 1
+#define INVERSE 2
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+
+#define SSD1306_MEMORYMODE 0x20
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define SSD1306_SETCONTRAST 0x81
+#define SSD1306_CHARGEPUMP 0x8D
+#define SSD1306_DISPLAYALLON_RESUME 0xA4
+#define SSD1306_NORMALDISPLAY 0xA6
+#define SSD1306_INVERTDISPLAY 0xA7
+#define SSD1306_DISPLAYOFF 0xAE
+#define SSD1306_DISPLAYON 0xAF
+#define SSD1306_EXTERNALVCC 0x01
+#define SSD1306_SWITCHCAPVCC 0x02
+
+#define SSD1306_RIGHT_HORIZONTAL_SCROLL 0x26
+#define SSD1306_LEFT_HORIZONTAL_SCROLL 0x27
+#define SSD1306_DEACTIVATE_SCROLL 0x2E
+#define SSD1306_ACTIVATE_SCROLL 0x2F
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi = &Wire, int8_t rst_pin = -1,
+                     uint32_t clkDuring = 400000UL, uint32_t clkAfter = 100000UL);
+    Adafruit_SSD1306(uint8_t w, uint8_t h, SPIClass *spi, int8_t dc_pin, int8_t rst_pin, int8_t cs_pin,
+                     uint32_t bitrate = 8000000UL);
+    ~Adafruit_SSD1306();
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0, bool reset = true, bool periphBegin = true);
+    void display();
+    void clearDisplay();
+    void invertDisplay(bool i) override;
+    void dim(bool dim);
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void startscrollright(uint8_t start, uint8_t stop);
+    void stopscroll();
+    void ssd1306_command(uint8_t c);
+    bool getPixel(int16_t x, int16_t y);
+    uint8_t *getBuffer() { return buffer; }
+
+    /// @brief The controller at the other end of the bus, whose RAM is what's on the glass
+    HostOLED controller;
+
+protected:
+    TwoWire *wire = nullptr;
+    SPIClass *spi = nullptr;
+    uint8_t *buffer = nullptr;
+    int8_t i2caddr = 0, dcPin = -1, csPin = -1;
+    uint32_t wireClk, restoreClk, bitrate = 8000000UL;
+    uint8_t vccstate = SSD1306_SWITCHCAPVCC;
+
+    void commandList(const uint8_t *c, uint8_t n);
+};
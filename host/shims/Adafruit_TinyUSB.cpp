@@ -0,0 +1,71 @@
+/*!
+ * @file Adafruit_TinyUSB.cpp
+ * @brief Host stand-in for the TinyUSB device stack: keeps every HID report sent, and plays the host's side of the control requests.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Adafruit_TinyUSB.h>
+
+#include "DeckHost.h"
+
+Adafruit_USBD_Device TinyUSBDevice;
+Adafruit_USBD_HID *Adafruit_USBD_HID::active = nullptr;
+
+bool Adafruit_USBD_HID::begin()
+{
+    active = this;
+    return true;
+}
+
+bool Adafruit_USBD_HID::ready()
+{
+    return TinyUSBDevice.ready() && DeckHost::now >= readyAfter;
+}
+
+bool Adafruit_USBD_HID::sendReport(uint8_t report_id, const void *report, uint8_t len)
+{
+    if(!ready()) return false;
+    reports.push_back({ DeckHost::now, report_id, std::vector<uint8_t>((const uint8_t*)report, (const uint8_t*)report + len) });
+    readyAfter = DeckHost::now + pollInterval * 1000ULL;
+    return true;
+}
+
+bool Adafruit_USBD_HID::keyboardReport(uint8_t report_id, uint8_t modifier, uint8_t keycode[6])
+{
+    uint8_t report[8] = { modifier, 0 };
+    if(keycode) memcpy(report + 2, keycode, 6);
+    return sendReport(report_id, report, sizeof(report));
+}
+
+uint16_t Adafruit_USBD_HID::HostGetReport(const uint8_t &id, const hid_report_type_t &type, uint8_t *buffer, const uint16_t &len)
+{
+    return getCb ? getCb(id, type, buffer, len) : 0;
+}
+
+void Adafruit_USBD_HID::HostSetReport(const uint8_t &id, const hid_report_type_t &type, const uint8_t *buffer, uint16_t len)
+{
+    if(id != 0 && len > 1 && buffer[0] == id) {
+        ++buffer;
+        --len;
+    }
+    if(setCb) setCb(id, type, buffer, len);
+}
+
+bool Adafruit_USBD_Device::suspended()
+{
+    if(resumeAt && DeckHost::now >= resumeAt) {
+        suspendedState = false;
+        resumeAt = 0;
+    }
+    return suspendedState;
+}
+
+bool Adafruit_USBD_Device::remoteWakeup()
+{
+    if(!suspended() || !wakeupAllowed) return false;
+    ++wakeups;
+    if(!resumeAt) resumeAt = DeckHost::now + resumeTime;
+    return true;
+}
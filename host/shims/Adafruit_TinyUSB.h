@@ -0,0 +1,172 @@
+/*!
+ * @file Adafruit_TinyUSB.h
+ * @brief Host stand-in for the TinyUSB device stack: keeps every HID report sent, and plays the host's side of the control requests.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+//--------------------------------------------------------------------+
+// HID report descriptor items, same encoding as TinyUSB's hid.h
+//--------------------------------------------------------------------+
+
+#define HID_REPORT_DATA_0(data)
+#define HID_REPORT_DATA_1(data) , (data)
+#define HID_REPORT_DATA_2(data) , (uint8_t)((data) & 0xFF), (uint8_t)(((data) >> 8) & 0xFF)
+#define HID_REPORT_ITEM(data, tag, type, size) (((tag) << 4) | ((type) << 2) | (size)) HID_REPORT_DATA_##size(data)
+
+#define RI_TYPE_MAIN 0
+#define RI_TYPE_GLOBAL 1
+#define RI_TYPE_LOCAL 2
+
+#define HID_INPUT(x)          HID_REPORT_ITEM(x, 8, RI_TYPE_MAIN, 1)
+#define HID_OUTPUT(x)         HID_REPORT_ITEM(x, 9, RI_TYPE_MAIN, 1)
+#define HID_COLLECTION(x)     HID_REPORT_ITEM(x, 10, RI_TYPE_MAIN, 1)
+#define HID_FEATURE(x)        HID_REPORT_ITEM(x, 11, RI_TYPE_MAIN, 1)
+#define HID_COLLECTION_END    HID_REPORT_ITEM(x, 12, RI_TYPE_MAIN, 0)
+
+#define HID_USAGE_PAGE(x)         HID_REPORT_ITEM(x, 0, RI_TYPE_GLOBAL, 1)
+#define HID_USAGE_PAGE_N(x, n)    HID_REPORT_ITEM(x, 0, RI_TYPE_GLOBAL, n)
+#define HID_LOGICAL_MIN(x)        HID_REPORT_ITEM(x, 1, RI_TYPE_GLOBAL, 1)
+#define HID_LOGICAL_MAX(x)        HID_REPORT_ITEM(x, 2, RI_TYPE_GLOBAL, 1)
+#define HID_LOGICAL_MAX_N(x, n)   HID_REPORT_ITEM(x, 2, RI_TYPE_GLOBAL, n)
+#define HID_REPORT_SIZE(x)        HID_REPORT_ITEM(x, 7, RI_TYPE_GLOBAL, 1)
+#define HID_REPORT_ID(x)          HID_REPORT_ITEM(x, 8, RI_TYPE_GLOBAL, 1),
+#define HID_REPORT_COUNT(x)       HID_REPORT_ITEM(x, 9, RI_TYPE_GLOBAL, 1)
+
+#define HID_USAGE(x)              HID_REPORT_ITEM(x, 0, RI_TYPE_LOCAL, 1)
+#define HID_USAGE_MIN(x)          HID_REPORT_ITEM(x, 1, RI_TYPE_LOCAL, 1)
+#define HID_USAGE_MAX(x)          HID_REPORT_ITEM(x, 2, RI_TYPE_LOCAL, 1)
+#define HID_USAGE_MAX_N(x, n)     HID_REPORT_ITEM(x, 2, RI_TYPE_LOCAL, n)
+
+#define HID_DATA          (0<<0)
+#define HID_CONSTANT      (1<<0)
+#define HID_ARRAY         (0<<1)
+#define HID_VARIABLE      (1<<1)
+#define HID_ABSOLUTE      (0<<2)
+
+#define HID_COLLECTION_APPLICATION 0x01
+
+#define HID_USAGE_PAGE_DESKTOP  0x01
+#define HID_USAGE_PAGE_KEYBOARD 0x07
+#define HID_USAGE_PAGE_LED      0x08
+#define HID_USAGE_PAGE_VENDOR   0xFF00
+#define HID_USAGE_DESKTOP_KEYBOARD 0x06
+
+#define TUD_HID_REPORT_DESC_KEYBOARD(...) \
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP ), \
+    HID_USAGE      ( HID_USAGE_DESKTOP_KEYBOARD ), \
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION ), \
+      __VA_ARGS__ \
+      HID_USAGE_PAGE ( HID_USAGE_PAGE_KEYBOARD ), \
+        HID_USAGE_MIN    ( 224 ), \
+        HID_USAGE_MAX    ( 231 ), \
+        HID_LOGICAL_MIN  ( 0 ), \
+        HID_LOGICAL_MAX  ( 1 ), \
+        HID_REPORT_COUNT ( 8 ), \
+        HID_REPORT_SIZE  ( 1 ), \
+        HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ), \
+        HID_REPORT_COUNT ( 1 ), \
+        HID_REPORT_SIZE  ( 8 ), \
+        HID_INPUT        ( HID_CONSTANT ), \
+      HID_USAGE_PAGE ( HID_USAGE_PAGE_KEYBOARD ), \
+        HID_USAGE_MIN    ( 0 ), \
+        HID_USAGE_MAX_N  ( 255, 2 ), \
+        HID_LOGICAL_MIN  ( 0 ), \
+        HID_LOGICAL_MAX_N( 255, 2 ), \
+        HID_REPORT_COUNT ( 6 ), \
+        HID_REPORT_SIZE  ( 8 ), \
+        HID_INPUT        ( HID_DATA | HID_ARRAY | HID_ABSOLUTE ), \
+    HID_COLLECTION_END
+
+typedef enum {
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE
+} hid_report_type_t;
+
+class Adafruit_USBD_Interface {
+public:
+    virtual ~Adafruit_USBD_Interface() {}
+};
+
+class Adafruit_USBD_HID : public Adafruit_USBD_Interface {
+public:
+    typedef uint16_t (*get_report_callback_t)(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen);
+    typedef void (*set_report_callback_t)(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize);
+
+    typedef struct Report_s {
+        uint64_t time;                  // virtual us it was sent at
+        uint8_t id;
+        std::vector<uint8_t> data;      // not counting the ID
+    } Report_t;
+
+    void setPollInterval(uint8_t ms) { pollInterval = ms; }
+    void setReportDescriptor(const uint8_t *desc, uint16_t len) { descriptor = desc; descriptorLen = len; }
+    void setReportCallback(get_report_callback_t get, set_report_callback_t set) { getCb = get; setCb = set; }
+    bool begin();
+
+    /// @brief Whether the IN endpoint can take a report: mounted, awake and readyAfter has passed
+    bool ready();
+    bool sendReport(uint8_t report_id, const void *report, uint8_t len);
+    bool keyboardReport(uint8_t report_id, uint8_t modifier, uint8_t keycode[6]);
+
+    /// @brief GET_REPORT from the host, through the sketch's callback
+    uint16_t HostGetReport(const uint8_t &id, const hid_report_type_t &type, uint8_t *buffer, const uint16_t &len);
+
+    /// @brief SET_REPORT from the host, as it goes on the wire (ID first when there is one)
+    /// @details Like TinyUSB, the ID byte's taken off the front before the callback when it matches the requested ID.
+    void HostSetReport(const uint8_t &id, const hid_report_type_t &type, const uint8_t *buffer, uint16_t len);
+
+    /// @brief The one begin() was last called on, for tests to reach the sketch's
+    static Adafruit_USBD_HID *active;
+
+    uint8_t pollInterval = 1;
+    const uint8_t *descriptor = nullptr;
+    uint16_t descriptorLen = 0;
+    // sent reports, oldest first
+    std::vector<Report_t> reports;
+
+private:
+    get_report_callback_t getCb = nullptr;
+    set_report_callback_t setCb = nullptr;
+    // when the endpoint's next free: one report per poll interval
+    uint64_t readyAfter = 0;
+};
+
+class Adafruit_USBD_Device {
+public:
+    void setManufacturerDescriptor(const char *s) { manufacturer = s; }
+    void setProductDescriptor(const char *s) { product = s; }
+    void setID(uint16_t vendor, uint16_t prod) { vid = vendor; pid = prod; }
+    bool attach() { mountedState = true; return true; }
+    bool detach() { mountedState = false; return true; }
+
+    bool mounted() { return mountedState; }
+    bool suspended();
+    bool ready() { return mountedState && !suspended(); }
+    /// @brief Signals resume if the host allowed remote wakeup; the bus comes back resumeTime later
+    bool remoteWakeup();
+
+    const char *manufacturer = "";
+    const char *product = "";
+    uint16_t vid = 0, pid = 0;
+
+    bool mountedState = true;
+    bool suspendedState = false;
+    bool wakeupAllowed = true;
+    uint32_t resumeTime = 20000;
+    unsigned long wakeups = 0;
+
+private:
+    uint64_t resumeAt = 0;
+};
+
+extern Adafruit_USBD_Device TinyUSBDevice;
+#define USBDevice TinyUSBDevice
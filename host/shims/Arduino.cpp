@@ -0,0 +1,171 @@
+/*!
+ * @file Arduino.cpp
+ * @brief Host stand-in for the arduino-pico core: virtual clock, pins, Print/Stream, Serial and the inter-core FIFO.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Arduino.h>
+
+#include "DeckHost.h"
+
+SerialUSB Serial;
+RP2040 rp2040;
+
+static uint8_t pinModes[DeckHost::PINS];
+static uint8_t pinOut[DeckHost::PINS];
+static void (*pinIsr[DeckHost::PINS])();
+static uint8_t pinIsrMode[DeckHost::PINS];
+static int interruptsOff = 0;
+
+unsigned long millis() { return DeckHost::now / 1000; }
+unsigned long micros() { return DeckHost::now; }
+void delay(unsigned long ms) { DeckHost::now += ms * 1000ULL; }
+void delayMicroseconds(unsigned int us) { DeckHost::now += us; }
+void yield() {}
+
+void pinMode(int pin, int mode)
+{
+    if(pin < 0 || pin >= DeckHost::PINS) return;
+    pinModes[pin] = mode;
+}
+
+void digitalWrite(int pin, int level)
+{
+    if(pin < 0 || pin >= DeckHost::PINS) return;
+    pinOut[pin] = level ? HIGH : LOW;
+}
+
+int digitalRead(int pin)
+{
+    if(pin < 0 || pin >= DeckHost::PINS) return LOW;
+    if(DeckHost::pinDrive[pin] >= 0) return DeckHost::pinDrive[pin];
+    switch(pinModes[pin]) {
+        case OUTPUT: return pinOut[pin];
+        case INPUT_PULLUP: return HIGH;
+        default: return LOW;
+    }
+}
+
+void attachInterrupt(int pin, void (*isr)(), int mode)
+{
+    if(pin < 0 || pin >= DeckHost::PINS) return;
+    pinIsr[pin] = isr;
+    pinIsrMode[pin] = mode;
+}
+
+void detachInterrupt(int pin)
+{
+    if(pin < 0 || pin >= DeckHost::PINS) return;
+    pinIsr[pin] = nullptr;
+}
+
+namespace DeckHost {
+    void PinChanged(const int &pin, const int &was)
+    {
+        const int level = digitalRead(pin);
+        if(level == was || pinIsr[pin] == nullptr) return;
+        if(pinIsrMode[pin] == CHANGE || (pinIsrMode[pin] == RISING) == (level == HIGH)) {
+            // runs on Core0, which is where the sketch attaches them
+            const uint8_t was = core;
+            core = 0;
+            pinIsr[pin]();
+            core = was;
+            Wake(0);
+        }
+    }
+}
+
+void noInterrupts() { ++interruptsOff; }
+
+void interrupts()
+{
+    if(--interruptsOff < 0) {
+        fprintf(stderr, "interrupts() without noInterrupts()\n");
+        abort();
+    }
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while(size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if(len < 0) return 0;
+
+    if((size_t)len < sizeof(buf))
+        return write((const uint8_t*)buf, len);
+
+    std::string big(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+}
+
+int SerialUSB::read()
+{
+    if(input.empty()) return -1;
+    const uint8_t c = input.front();
+    input.pop_front();
+    return c;
+}
+
+void RP2040FIFO::push(uint32_t val)
+{
+    while(!push_nb(val)) DeckHost::RunOther();
+}
+
+bool RP2040FIFO::push_nb(uint32_t val)
+{
+    std::deque<uint32_t> &queue = queues[!DeckHost::core];
+    if(queue.size() >= DEPTH) return false;
+    queue.push_back(val);
+    // a push raises an event on the other core, same as __sev()
+    DeckHost::Wake(!DeckHost::core);
+    return true;
+}
+
+uint32_t RP2040FIFO::pop()
+{
+    uint32_t val;
+    while(!pop_nb(&val)) DeckHost::RunOther();
+    return val;
+}
+
+bool RP2040FIFO::pop_nb(uint32_t *val)
+{
+    std::deque<uint32_t> &queue = queues[DeckHost::core];
+    if(queue.empty()) return false;
+    *val = queue.front();
+    queue.pop_front();
+    return true;
+}
+
+int RP2040FIFO::available()
+{
+    return queues[DeckHost::core].size();
+}
+
+int RP2040::cpuid() { return DeckHost::core; }
+
+void RP2040::idleOtherCore()
+{
+    ++idles;
+    otherIdled = true;
+}
+
+void RP2040::resumeOtherCore()
+{
+    otherIdled = false;
+}
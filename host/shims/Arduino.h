@@ -0,0 +1,169 @@
+/*!
+ * @file Arduino.h
+ * @brief Host stand-in for the arduino-pico core: virtual clock, pins, Print/Stream, Serial and the inter-core FIFO.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+typedef unsigned int uint;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define __not_in_flash_func(func) func
+#define __time_critical_func(func) func
+
+#define LOW 0
+#define HIGH 1
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// all on the virtual clock, which only moves when the harness steps it (or something delays)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int digitalRead(int pin);
+inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(int pin, void (*isr)(), int mode);
+void detachInterrupt(int pin);
+
+// single-threaded host, so there's nothing to mask - only counted, for checking they're paired
+void noInterrupts();
+void interrupts();
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char *str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return printf("%d", n); }
+    size_t print(unsigned int n) { return printf("%u", n); }
+    size_t print(long n) { return printf("%ld", n); }
+    size_t print(unsigned long n) { return printf("%lu", n); }
+    size_t println() { return write("\r\n"); }
+    template<typename T> size_t println(const T &v) { return print(v) + println(); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    int getWriteError() { return writeError; }
+    void setWriteError(int err = 1) { writeError = err; }
+    void clearWriteError() { writeError = 0; }
+
+private:
+    int writeError = 0;
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long ms) { timeout = ms; }
+
+protected:
+    unsigned long timeout = 1000;
+};
+
+/// @brief USB CDC port: writes are kept for whoever's looking, reads come from what's been typed in
+class SerialUSB : public Stream {
+public:
+    void begin(unsigned long = 115200) {}
+    void end() {}
+    operator bool() { return dtrState; }
+    bool dtr() { return dtrState; }
+
+    size_t write(uint8_t c) override { output += (char)c; return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { output.append((const char*)buffer, size); return size; }
+    using Print::write;
+    int availableForWrite() override { return writeRoom; }
+
+    int available() override { return input.size(); }
+    int read() override;
+    int peek() override { return input.empty() ? -1 : (uint8_t)input.front(); }
+
+    /// @brief Queues text as if the host had typed it
+    void Type(const char *text) { input.insert(input.end(), text, text + strlen(text)); }
+
+    /// @brief Queues raw bytes as if the host had sent them, e.g. an upload
+    void Send(const std::vector<uint8_t> &data) { input.insert(input.end(), data.begin(), data.end()); }
+
+    /// @brief Hands over everything written since the last call
+    std::string Take() { std::string taken; taken.swap(output); return taken; }
+
+    bool dtrState = true;
+    int writeRoom = 4096;
+    std::string output;
+    std::deque<char> input;
+};
+
+extern SerialUSB Serial;
+
+/// @brief Inter-core FIFOs, 8 deep each way like the SIO's
+/// @details Blocking calls that can't go ahead run the other core's loop until they can, like the real one
+/// would be doing meanwhile.
+class RP2040FIFO {
+public:
+    static constexpr size_t DEPTH = 8;
+
+    void push(uint32_t val);
+    bool push_nb(uint32_t val);
+    uint32_t pop();
+    bool pop_nb(uint32_t *val);
+    int available();
+
+    /// @brief Empties both directions
+    void clear() { queues[0].clear(); queues[1].clear(); }
+
+    // indexed by the core that pops from it
+    std::deque<uint32_t> queues[2];
+};
+
+class RP2040 {
+public:
+    int cpuid();
+    /// @brief Nothing else runs while a core's in here anyway; only counted, and which core asked checked
+    void idleOtherCore();
+    void resumeOtherCore();
+    void reboot() { abort(); }
+    void wdt_reset() {}
+
+    RP2040FIFO fifo;
+    unsigned idles = 0;
+    bool otherIdled = false;
+};
+
+extern RP2040 rp2040;
@@ -0,0 +1,112 @@
+/*!
+ * @file FS.cpp
+ * @brief Host stand-in for the arduino-pico filesystem API, kept in a directory on the PC.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <LittleFS.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+
+fs::FS LittleFS;
+
+using namespace fs;
+
+int File::available()
+{
+    if(!fp) return 0;
+    return size() - position();
+}
+
+int File::peek()
+{
+    if(!fp) return -1;
+    const int c = fgetc(fp);
+    if(c != EOF) ungetc(c, fp);
+    return c;
+}
+
+size_t File::size() const
+{
+    if(!fp) return 0;
+    struct stat st;
+    fflush(fp);
+    return fstat(fileno(fp), &st) ? 0 : st.st_size;
+}
+
+const char *File::name() const
+{
+    const size_t slash = path.rfind('/');
+    return path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+std::string FS::HostPath(const char *path) const
+{
+    std::string full = root;
+    if(path[0] != '/') full += '/';
+    return full + path;
+}
+
+bool FS::begin()
+{
+    if(root.empty()) {
+        const char *env = getenv("DECK_HOST_FS");
+        root = env ? env : "littlefs";
+    }
+    struct stat st;
+    if(stat(root.c_str(), &st) && ::mkdir(root.c_str(), 0755)) return false;
+    mounted = true;
+    return true;
+}
+
+bool FS::format()
+{
+    DIR *dir = opendir(root.c_str());
+    if(dir) {
+        while(struct dirent *entry = readdir(dir)) {
+            if(entry->d_type != DT_REG) continue;
+            unlink((root + '/' + entry->d_name).c_str());
+        }
+        closedir(dir);
+    }
+    return begin();
+}
+
+bool FS::info(FSInfo &info)
+{
+    // same geometry as the default 1MB partition
+    info = { 1024 * 1024, 0, 4096, 256, 16, 32 };
+    DIR *dir = opendir(root.c_str());
+    if(!dir) return false;
+    while(struct dirent *entry = readdir(dir)) {
+        struct stat st;
+        if(entry->d_type == DT_REG && !stat((root + '/' + entry->d_name).c_str(), &st))
+            info.usedBytes += (st.st_size + info.blockSize - 1) / info.blockSize * info.blockSize;
+    }
+    closedir(dir);
+    return true;
+}
+
+File FS::open(const char *path, const char *mode)
+{
+    if(!mounted) return File();
+    // always binary, like the device
+    std::string hostMode = mode;
+    if(hostMode.find('b') == std::string::npos) hostMode += 'b';
+    FILE *fp = fopen(HostPath(path).c_str(), hostMode.c_str());
+    return File(fp, path);
+}
+
+bool FS::exists(const char *path)
+{
+    struct stat st;
+    return mounted && !stat(HostPath(path).c_str(), &st);
+}
+
+bool FS::remove(const char *path) { return mounted && !unlink(HostPath(path).c_str()); }
+bool FS::rename(const char *from, const char *to) { return mounted && !::rename(HostPath(from).c_str(), HostPath(to).c_str()); }
+bool FS::mkdir(const char *path) { return mounted && !::mkdir(HostPath(path).c_str(), 0755); }
+bool FS::rmdir(const char *path) { return mounted && !::rmdir(HostPath(path).c_str()); }
@@ -0,0 +1,95 @@
+/*!
+ * @file FS.h
+ * @brief Host stand-in for the arduino-pico filesystem API, kept in a directory on the PC.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+class File : public Stream {
+public:
+    File() {}
+    File(FILE *handle, const std::string &path) : fp(handle), path(path) {}
+    File(const File &other) = delete;
+    File(File &&other) : fp(other.fp), path(other.path) { other.fp = nullptr; }
+    File &operator=(File &&other) { close(); fp = other.fp; path = other.path; other.fp = nullptr; return *this; }
+    ~File() { close(); }
+
+    operator bool() const { return fp != nullptr; }
+
+    size_t write(uint8_t c) override { return fp ? fwrite(&c, 1, 1, fp) : 0; }
+    size_t write(const uint8_t *buf, size_t size) override { return fp ? fwrite(buf, 1, size, fp) : 0; }
+    using Print::write;
+    int available() override;
+    int read() override { return fp ? fgetc(fp) : -1; }
+    int peek() override;
+    size_t read(uint8_t *buf, size_t size) { return fp ? fread(buf, 1, size, fp) : 0; }
+    void flush() override { if(fp) fflush(fp); }
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) { return fp && !fseek(fp, pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END); }
+    size_t position() const { return fp ? ftell(fp) : 0; }
+    size_t size() const;
+    void close() { if(fp) fclose(fp); fp = nullptr; }
+    const char *name() const;
+    const char *fullName() const { return path.c_str(); }
+    bool isDirectory() const { return false; }
+
+private:
+    FILE *fp = nullptr;
+    std::string path;
+};
+
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+/// @brief Filesystem rooted at a directory; paths are the same "/Name" ones the sketch uses on the device
+class FS {
+public:
+    /// @brief Makes the root directory if it's not there yet ($DECK_HOST_FS, or ./littlefs)
+    bool begin();
+    void end() { mounted = false; }
+    bool format();
+    bool info(FSInfo &info);
+
+    File open(const char *path, const char *mode);
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *from, const char *to);
+    bool mkdir(const char *path);
+    bool rmdir(const char *path);
+
+    /// @brief Where on the PC a deck path ends up
+    std::string HostPath(const char *path) const;
+
+    std::string root;
+    bool mounted = false;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::FSInfo;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
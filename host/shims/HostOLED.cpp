@@ -0,0 +1,141 @@
+/*!
+ * @file HostOLED.cpp
+ * @brief Emulated SSD1306/SH110X controller: decodes the command & data bytes the drivers send into display RAM.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "HostOLED.h"
+
+HostOLED::HostOLED(const Controller_e &ctrl, const uint8_t &w, const uint8_t &h)
+    : type(ctrl), width(w), height(h)
+{
+    pageEnd = (height + 7) / 8 - 1;
+}
+
+void HostOLED::Receive(const uint8_t *data, const size_t &len)
+{
+    if(!len) return;
+    // control byte: D/C# in bit 6, and with Co clear everything after it is the same kind
+    const bool isData = data[0] & 0x40;
+    for(size_t i = 1; i < len; ++i) {
+        if(isData) Data(data[i]);
+        else Command(data[i]);
+    }
+}
+
+void HostOLED::Receive(const bool &data, const uint8_t *bytes, const size_t &len)
+{
+    for(size_t i = 0; i < len; ++i) {
+        if(data) Data(bytes[i]);
+        else Command(bytes[i]);
+    }
+}
+
+void HostOLED::Command(const uint8_t &cmd)
+{
+    ++commandBytes;
+
+    if(pendingLen < pendingWant) {
+        pending[pendingLen++] = cmd;
+        if(pendingLen == pendingWant) CommandDone();
+        return;
+    }
+
+    pending[0] = cmd;
+    pendingLen = 1;
+    pendingWant = 1;
+
+    if(type == OLED_SSD1306) {
+        switch(cmd) {
+            case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+                pendingWant = 2; break;
+            case 0x21: case 0x22: case 0xA3:
+                pendingWant = 3; break;
+            case 0x29: case 0x2A:
+                pendingWant = 6; break;
+            case 0x26: case 0x27:
+                pendingWant = 7; break;
+            default: break;
+        }
+    } else {
+        switch(cmd) {
+            case 0x81: case 0xA8: case 0xAD: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xDC:
+                pendingWant = 2; break;
+            default: break;
+        }
+    }
+
+    if(pendingLen == pendingWant) CommandDone();
+}
+
+void HostOLED::CommandDone()
+{
+    const uint8_t cmd = pending[0];
+
+    switch(cmd) {
+        case 0xAE: on = false; return;
+        case 0xAF: on = true; return;
+        case 0xA6: inverted = false; return;
+        case 0xA7: inverted = true; return;
+        case 0x81: contrast = pending[1]; return;
+        default: break;
+    }
+
+    if(type == OLED_SSD1306) {
+        switch(cmd) {
+            case 0x21:
+                colStart = col = pending[1];
+                colEnd = pending[2];
+                break;
+            case 0x22:
+                pageStart = page = pending[1] & 7;
+                pageEnd = pending[2] & 7;
+                break;
+            case 0x26: case 0x27: case 0x29: case 0x2A:
+                break;
+            case 0x2E: scrolling = false; break;
+            case 0x2F: scrolling = true; break;
+            default: break;
+        }
+    } else {
+        if(cmd >= 0xB0 && cmd <= 0xBF) page = cmd & 0x0F;
+        else if(cmd <= 0x0F) col = (col & 0xF0) | cmd;
+        else if(cmd >= 0x10 && cmd <= 0x17) col = (col & 0x0F) | ((cmd & 0x07) << 4);
+    }
+}
+
+void HostOLED::Data(const uint8_t &byte)
+{
+    ++dataBytes;
+    if(page < PAGES && col < COLUMNS) ram[page][col] = byte;
+
+    if(type == OLED_SSD1306) {
+        // horizontal addressing: wraps within the column window, then the page window
+        if(col >= colEnd) {
+            col = colStart;
+            page = page >= pageEnd ? pageStart : page + 1;
+        } else ++col;
+    } else if(col < COLUMNS - 1) ++col;
+}
+
+uint8_t HostOLED::ColOffset() const
+{
+    if(type == OLED_SH1106) return 2;
+    // 64px-wide SSD1306 glass sits in the middle of its 128 columns
+    if(type == OLED_SSD1306 && width == 64) return 32;
+    return 0;
+}
+
+bool HostOLED::Pixel(const int &x, const int &y) const
+{
+    if(x < 0 || y < 0 || x >= width || y >= height) return false;
+    return ram[y >> 3][x + ColOffset()] & (1 << (y & 7));
+}
+
+void HostOLED::Glass(uint8_t *out) const
+{
+    for(int p = 0; p < (height + 7) / 8; ++p)
+        memcpy(out + p * width, &ram[p][ColOffset()], width);
+}
@@ -0,0 +1,68 @@
+/*!
+ * @file HostOLED.h
+ * @brief Emulated SSD1306/SH110X controller: decodes the command & data bytes the drivers send into display RAM.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Wire.h>
+#include <SPI.h>
+
+/// @brief Page-organised 1bpp display RAM plus the controller state that decides what the glass shows.
+/// @details Takes the same bytes the real controllers do, over I2C (control byte first) or SPI (D/C pin),
+/// so anything the sketch pushes itself, not just what goes through the drivers, ends up where it would.
+class HostOLED : public HostI2CDevice, public HostSPIDevice {
+public:
+    enum Controller_e {
+        OLED_SSD1306 = 0,   ///< Horizontal addressing over column/page windows
+        OLED_SH1106,        ///< Page addressing, 132 columns with the glass from column 2
+        OLED_SH1107         ///< Page addressing
+    };
+
+    static constexpr int COLUMNS = 132;
+    static constexpr int PAGES = 16;
+
+    HostOLED(const Controller_e &type, const uint8_t &w, const uint8_t &h);
+
+    void Receive(const uint8_t *data, const size_t &len) override;
+    void Receive(const bool &data, const uint8_t *bytes, const size_t &len) override;
+
+    void Command(const uint8_t &cmd);
+    void Data(const uint8_t &byte);
+
+    /// @brief Whether a pixel of the glass is lit in RAM (not counting inversion or the panel being off)
+    bool Pixel(const int &x, const int &y) const;
+
+    /// @brief Glass as a page-major buffer, the same layout as the drivers' render buffers
+    void Glass(uint8_t *out) const;
+
+    Controller_e type;
+    uint8_t width, height;
+
+    uint8_t ram[PAGES][COLUMNS] = {};
+    bool on = false;
+    bool inverted = false;
+    bool scrolling = false;
+    uint8_t contrast = 0x7F;
+
+    // data bytes written so far, for checking how much went over the bus
+    unsigned long dataBytes = 0;
+    unsigned long commandBytes = 0;
+
+private:
+    /// @brief Where the glass starts in RAM
+    uint8_t ColOffset() const;
+
+    // SSD1306 addressing window
+    uint8_t colStart = 0, colEnd = 127, pageStart = 0, pageEnd = 7;
+    uint8_t col = 0, page = 0;
+
+    // a multi-byte command being collected
+    uint8_t pending[8];
+    uint8_t pendingLen = 0, pendingWant = 0;
+
+    void CommandDone();
+};
@@ -0,0 +1,13 @@
+/*!
+ * @file LittleFS.h
+ * @brief Host stand-in for the onboard LittleFS partition, kept in a directory on the PC.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <FS.h>
+
+extern fs::FS LittleFS;
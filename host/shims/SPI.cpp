@@ -0,0 +1,131 @@
+/*!
+ * @file SPI.cpp
+ * @brief Host stand-in for the SPI buses: every transfer is captured with the D/C level it went out at.
+ * Async transfers can be held in flight for a few polls, and are only read from their buffer once they finish.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <SPI.h>
+#include <algorithm>
+
+SPIClassRP2040 SPI, SPI1;
+
+void SPIClassRP2040::beginTransaction(SPISettings s)
+{
+    settings = s;
+    inTransaction = true;
+}
+
+void SPIClassRP2040::endTransaction()
+{
+    InFlightFinish();
+    inTransaction = false;
+}
+
+uint8_t SPIClassRP2040::transfer(uint8_t data)
+{
+    InFlightFinish();
+    Send(&data, 1, false);
+    return 0;
+}
+
+void SPIClassRP2040::transfer(const void *txbuf, void *rxbuf, size_t count)
+{
+    InFlightFinish();
+    if(txbuf) Send((const uint8_t*)txbuf, count, false);
+    if(rxbuf) memset(rxbuf, 0, count);
+}
+
+bool SPIClassRP2040::transferAsync(const void *send, void *recv, size_t count)
+{
+    InFlightFinish();
+    if(recv) memset(recv, 0, count);
+    if(!send) return true;
+
+    const uint8_t *from = (const uint8_t*)send;
+    if(!asyncPolls) {
+        sources.clear();
+        Send(from, count, true);
+        return true;
+    }
+
+    // composed before the one in flight was waited on, if its buffer already held all this back then
+    bool ahead = false;
+    bool known = false;
+    for(Source_t &source : sources) {
+        if(source.from != from) continue;
+        known = true;
+        ahead = source.seen.size() >= count && !memcmp(source.seen.data(), from, count);
+        source.len = std::max(source.len, count);
+    }
+    if(!known) sources.push_back({ from, count, {} });
+    for(Source_t &source : sources) source.seen.clear();
+
+    inFlight = { from, count, asyncPolls, ahead };
+    return true;
+}
+
+bool SPIClassRP2040::finishedAsync()
+{
+    if(!inFlight.from) return true;
+
+    // first time it's found busy, note what every other buffer holds
+    if(inFlight.polls == asyncPolls) {
+        for(Source_t &source : sources)
+            if(source.from != inFlight.from) source.seen.assign(source.from, source.from + source.len);
+    }
+    if(inFlight.polls-- > 0) return false;
+
+    const InFlight_t done = inFlight;
+    inFlight.from = nullptr;
+    Send(done.from, done.len, true, done.ahead);
+    return true;
+}
+
+void SPIClassRP2040::InFlightFinish()
+{
+    if(!inFlight.from) return;
+    ++overruns;
+    const InFlight_t done = inFlight;
+    inFlight.from = nullptr;
+    Send(done.from, done.len, true, done.ahead);
+}
+
+void SPIClassRP2040::Attach(const int &cs, const int &dc, HostSPIDevice *device)
+{
+    for(size_t i = 0; i < attached.size(); ++i) {
+        if(attached[i].cs == cs) {
+            if(device) attached[i] = { cs, dc, device };
+            else attached.erase(attached.begin() + i);
+            return;
+        }
+    }
+    if(device) attached.push_back({ cs, dc, device });
+}
+
+void SPIClassRP2040::Send(const uint8_t *data, const size_t &len, const bool &async, const bool &ahead)
+{
+    bytes += len;
+
+    int8_t cs = -1;
+    bool dc = false;
+    HostSPIDevice *device = nullptr;
+    for(const Attached_t &dev : attached) {
+        if(digitalRead(dev.cs) == LOW) {
+            cs = dev.cs;
+            dc = dev.dc >= 0 && digitalRead(dev.dc) == HIGH;
+            device = dev.device;
+            break;
+        }
+    }
+
+    if(capture) {
+        if(!captured.empty() && captured.back().cs == cs && captured.back().dc == dc && captured.back().async == async && !async)
+            captured.back().bytes.insert(captured.back().bytes.end(), data, data + len);
+        else captured.push_back({ cs, dc, async, ahead, std::vector<uint8_t>(data, data + len) });
+    }
+
+    if(device) device->Receive(dc, data, len);
+}
@@ -0,0 +1,115 @@
+/*!
+ * @file SPI.h
+ * @brief Host stand-in for the SPI buses: every transfer is captured with the D/C level it went out at.
+ * Async transfers can be held in flight for a few polls, and are only read from their buffer once they finish.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class SPISettings {
+public:
+    SPISettings() {}
+    SPISettings(uint32_t hz, uint8_t order, uint8_t mode) : clock(hz), bitOrder(order), dataMode(mode) {}
+    uint32_t clock = 4000000;
+    uint8_t bitOrder = MSBFIRST;
+    uint8_t dataMode = SPI_MODE0;
+};
+
+/// @brief Something on the bus selected by its CS pin, taking bytes as commands or data by its D/C pin
+class HostSPIDevice {
+public:
+    virtual ~HostSPIDevice() {}
+    virtual void Receive(const bool &data, const uint8_t *bytes, const size_t &len) = 0;
+};
+
+class SPIClassRP2040 {
+public:
+    typedef struct Transfer_s {
+        int8_t cs;                  // which attached CS pin was low, -1 if none was
+        bool dc;                    // level of that device's D/C pin
+        bool async;                 // sent with transferAsync()
+        bool ahead;                 // async, and already in its buffer when the one before it was first found busy
+        std::vector<uint8_t> bytes;
+    } Transfer_t;
+
+    void setRX(int pin) { rx = pin; }
+    void setTX(int pin) { tx = pin; }
+    void setSCK(int pin) { sck = pin; }
+    void setCS(int pin) { csHw = pin; }
+    void begin(bool = false) { started = true; }
+    void end() { started = false; }
+
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+
+    uint8_t transfer(uint8_t data);
+    void transfer(const void *txbuf, void *rxbuf, size_t count);
+    /// @brief Goes out straight away, unless asyncPolls holds it in flight
+    bool transferAsync(const void *send, void *recv, size_t bytes);
+    /// @brief Whether the async transfer in flight is done, sending it from its buffer as it finishes
+    bool finishedAsync();
+    void abortAsync() { inFlight.from = nullptr; }
+
+    /// @brief Puts a device on the bus behind its CS & D/C pins, or takes it off with nullptr
+    void Attach(const int &cs, const int &dc, HostSPIDevice *device);
+
+    int rx = -1, tx = -1, sck = -1, csHw = -1;
+    bool started = false;
+    bool inTransaction = false;
+    SPISettings settings;
+
+    // every transfer so far, consecutive bytes at the same CS/D/C merged into one
+    std::vector<Transfer_t> captured;
+    bool capture = true;
+    unsigned long bytes = 0;
+
+    // polls an async transfer reports busy for before it's done, like DMA still reading its buffer; 0 for never
+    int asyncPolls = 0;
+    // transfers & transaction ends that came while an async transfer was still in flight
+    unsigned long overruns = 0;
+
+private:
+    void Send(const uint8_t *data, const size_t &len, const bool &async, const bool &ahead = false);
+
+    /// @brief Sends whatever's in flight now, as if it had finished
+    void InFlightFinish();
+
+    typedef struct InFlight_s {
+        const uint8_t *from = nullptr;
+        size_t len = 0;
+        int polls = 0;
+        bool ahead = false;
+    } InFlight_t;
+    InFlight_t inFlight;
+
+    // every buffer async transfers have come from, and what each held when the last one in flight was first polled
+    typedef struct Source_s {
+        const uint8_t *from;
+        size_t len;
+        std::vector<uint8_t> seen;
+    } Source_t;
+    std::vector<Source_t> sources;
+
+    typedef struct Attached_s {
+        int cs, dc;
+        HostSPIDevice *device;
+    } Attached_t;
+    std::vector<Attached_t> attached;
+};
+
+typedef SPIClassRP2040 SPIClass;
+
+extern SPIClassRP2040 SPI, SPI1;
@@ -0,0 +1,38 @@
+/*!
+ * @file Wire.cpp
+ * @brief Host stand-in for the I2C buses: transmissions go to whichever emulated device answers at the address.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <Wire.h>
+
+TwoWire Wire, Wire1;
+
+void TwoWire::beginTransmission(uint8_t addr)
+{
+    address = addr & 0x7F;
+    pending.clear();
+}
+
+uint8_t TwoWire::endTransmission(bool)
+{
+    ++transmissions;
+    bytes += pending.size();
+    busTimeUs += (pending.size() + 2) * 9 * 1000000ULL / clock;
+
+    HostI2CDevice *device = devices[address];
+    if(device == nullptr) {
+        pending.clear();
+        return 2;
+    }
+    device->Receive(pending.data(), pending.size());
+    pending.clear();
+    return 0;
+}
+
+void TwoWire::Attach(const uint8_t &addr, HostI2CDevice *device)
+{
+    devices[addr & 0x7F] = device;
+}
@@ -0,0 +1,65 @@
+/*!
+ * @file Wire.h
+ * @brief Host stand-in for the I2C buses: transmissions go to whichever emulated device answers at the address.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+/// @brief Something that takes I2C writes, like a display controller
+class HostI2CDevice {
+public:
+    virtual ~HostI2CDevice() {}
+    /// @brief One whole transmission, from just after the address to the stop
+    virtual void Receive(const uint8_t *data, const size_t &len) = 0;
+};
+
+class TwoWire : public Stream {
+public:
+    void setSDA(int pin) { sda = pin; }
+    void setSCL(int pin) { scl = pin; }
+    void setClock(uint32_t hz) { clock = hz; }
+    void setTimeout(unsigned long ms) { timeout = ms; }
+    void begin() { started = true; }
+    void end() { started = false; }
+
+    void beginTransmission(uint8_t address);
+    /// @return 0 when the device took it, 2 when nothing answered at the address, like the core's
+    uint8_t endTransmission(bool stop = true);
+
+    size_t write(uint8_t c) override { pending.push_back(c); return 1; }
+    using Print::write;
+
+    uint8_t requestFrom(uint8_t, size_t, bool = true) { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    /// @brief Puts a device on the bus, or takes it off with nullptr
+    void Attach(const uint8_t &address, HostI2CDevice *device);
+
+    /// @brief Whatever's answering at an address, nullptr if nothing is
+    HostI2CDevice *Device(const uint8_t &addr) const { return devices[addr & 0x7F]; }
+
+    int sda = -1, scl = -1;
+    uint32_t clock = 100000;
+    bool started = false;
+
+    // everything that's gone over the bus so far, for checking traffic
+    unsigned long transmissions = 0;
+    unsigned long bytes = 0;
+    // bus time those bytes would've taken at the clock they went at (9 bits a byte, plus address & stop)
+    uint64_t busTimeUs = 0;
+
+private:
+    uint8_t address = 0;
+    std::vector<uint8_t> pending;
+    HostI2CDevice *devices[128] = {};
+};
+
+extern TwoWire Wire, Wire1;
@@ -0,0 +1,147 @@
+/*!
+ * @file AnimTest.cpp
+ * @brief Animation timeline: tweens follow the clock rather than the frame count, late frames are dropped,
+ * and there's no frame to wait for with nothing running.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "DeckCheck.h"
+#include "PicoDeckAnim.h"
+
+DECK_TEST(TweensFollowTheClock)
+{
+    DeckAnim anim(20, 5000);
+    anim.Start(DeckAnim::Anim_PageSlide, 0, 100, 200, 1000);
+    anim.Start(DeckAnim::Anim_Fade, 0, 100, 200, 1000, DeckAnim::Tween_EaseOut);
+
+    CHECK_EQ(anim.Tick(1050), 1 << DeckAnim::Anim_PageSlide | 1 << DeckAnim::Anim_Fade);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_PageSlide), 25);
+    // easing out's ahead of linear early on, and never past the end
+    CHECK(anim.Value(DeckAnim::Anim_Fade) > 25 && anim.Value(DeckAnim::Anim_Fade) < 100);
+
+    // however many frames were skipped, it's where the time says it should be
+    CHECK(anim.Tick(1150));
+    CHECK_EQ(anim.Value(DeckAnim::Anim_PageSlide), 75);
+    CHECK(anim.Value(DeckAnim::Anim_Fade) > 75);
+
+    CHECK_EQ(anim.Tick(1200), 1 << DeckAnim::Anim_PageSlide | 1 << DeckAnim::Anim_Fade);
+    CHECK_EQ(anim.finished, 1 << DeckAnim::Anim_PageSlide | 1 << DeckAnim::Anim_Fade);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_PageSlide), 100);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_Fade), 100);
+    CHECK(!anim.Active(DeckAnim::Anim_PageSlide));
+
+    // finishing only counts for the tick it happened on
+    CHECK_EQ(anim.Tick(1300), 0);
+    CHECK_EQ(anim.finished, 0);
+}
+
+DECK_TEST(DelayHoldsAtStart)
+{
+    DeckAnim anim(20, 5000);
+    anim.Start(DeckAnim::Anim_BannerSlide, 10, 50, 100, 0, DeckAnim::Tween_Linear, false, 500);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_BannerSlide), 10);
+    CHECK_EQ(anim.Tick(499), 0);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_BannerSlide), 10);
+    anim.Tick(550);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_BannerSlide), 30);
+
+    // stopped, it stays where it got to without finishing
+    anim.Stop(DeckAnim::Anim_BannerSlide);
+    CHECK_EQ(anim.Tick(700), 0);
+    CHECK_EQ(anim.finished, 0);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_BannerSlide), 30);
+}
+
+DECK_TEST(StepsAndRepeats)
+{
+    // on/off blinking: each value gets an even share, and it wraps round rather than finishing
+    DeckAnim anim(20, 5000);
+    anim.Start(DeckAnim::Anim_Blink, 0, 1, 400, 0, DeckAnim::Tween_Step, true);
+    anim.Tick(100);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_Blink), 0);
+    CHECK_EQ(anim.Tick(250), 1 << DeckAnim::Anim_Blink);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_Blink), 1);
+    anim.Tick(399);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_Blink), 1);
+    anim.Tick(4100);
+    CHECK_EQ(anim.Value(DeckAnim::Anim_Blink), 0);
+    CHECK(anim.Active(DeckAnim::Anim_Blink));
+    CHECK_EQ(anim.finished, 0);
+
+    // a zero duration's done on the first tick, rather than dividing by it
+    anim.Start(DeckAnim::Anim_StatusHold, 0, 1, 0, 5000);
+    CHECK_EQ(anim.Tick(5001) & 1 << DeckAnim::Anim_StatusHold, 1 << DeckAnim::Anim_StatusHold);
+    CHECK_EQ(anim.finished, 1 << DeckAnim::Anim_StatusHold);
+}
+
+DECK_TEST(LateFramesDropped)
+{
+    DeckAnim anim(20, 5000);
+    CHECK(anim.FrameDue(0));
+    anim.FrameDone(0, 1000);
+    CHECK(!anim.FrameDue(19));
+    CHECK_EQ(anim.FrameIn(5), 15);
+    CHECK(anim.FrameDue(20));
+
+    // on time, nothing's dropped
+    anim.FrameDone(21, 1000);
+    CHECK_EQ(anim.framesDropped, 0);
+    CHECK_EQ(anim.FrameIn(21), 19);
+
+    // three frames' worth late: those are skipped, and the next's a whole period from now
+    anim.FrameDone(105, 1000);
+    CHECK_EQ(anim.framesDropped, 3);
+    CHECK_EQ(anim.FrameIn(105), 20);
+    CHECK_EQ(anim.framesOverBudget, 0);
+
+    anim.FrameDone(125, 6000);
+    CHECK_EQ(anim.framesOverBudget, 1);
+}
+
+DECK_TEST(SlowerIntervalKeepsNextFrame)
+{
+    DeckAnim anim(20, 5000);
+    anim.FrameDone(1000, 0);
+
+    // slowing down doesn't push back a frame that's already due sooner
+    anim.Interval(100, 1005);
+    CHECK_EQ(anim.FrameIn(1005), 15);
+    anim.FrameDone(1020, 0);
+    CHECK_EQ(anim.FrameIn(1020), 100);
+
+    // speeding back up brings one that's further off than a period forward to now
+    anim.Interval(20, 1030);
+    CHECK(anim.FrameDue(1030));
+}
+
+DECK_TEST(NothingRunningNothingToWaitFor)
+{
+    DeckAnim anim(20, 5000);
+    anim.FrameDone(1000, 0);
+    CHECK(anim.FrameWait(1005) == ~0UL);
+
+    // a track waiting out its delay wants a frame once it starts moving, then every frame on time...
+    anim.Start(DeckAnim::Anim_Fade, 0, 100, 100, 1005, DeckAnim::Tween_Linear, false, 50);
+    CHECK(anim.Running());
+    CHECK_EQ(anim.FrameWait(1005), 50);
+    CHECK_EQ(anim.FrameWait(1040), 15);
+    CHECK_EQ(anim.FrameWait(1060), 0);
+    anim.FrameDone(1060, 0);
+    CHECK_EQ(anim.FrameWait(1065), 15);
+
+    // ...with frames no closer together than the interval, however soon it starts
+    anim.Start(DeckAnim::Anim_Blink, 0, 1, 400, 1065, DeckAnim::Tween_Step, true, 2);
+    CHECK_EQ(anim.FrameWait(1065), 15);
+    anim.Stop(DeckAnim::Anim_Blink);
+
+    // ...until it's finished, or been stopped
+    anim.Tick(1155);
+    CHECK(!anim.Running());
+    CHECK(anim.FrameWait(1155) == ~0UL);
+    anim.Start(DeckAnim::Anim_Blink, 0, 1, 400, 1155, DeckAnim::Tween_Step, true);
+    CHECK(anim.FrameWait(1155) != ~0UL);
+    anim.Stop(DeckAnim::Anim_Blink);
+    CHECK(anim.FrameWait(1155) == ~0UL);
+}
@@ -0,0 +1,242 @@
+/*!
+ * @file AuditTest.cpp
+ * @brief Render audit: every state's frame matches the checked-in goldens, and auditing changes nothing it renders.
+ *
+ * Goldens live in host/tests/golden: audit.txt has every state's frame hash, and each page at rest & mid-scroll
+ * is kept as a PBM too, so a changed page shows where it changed. After a deliberate rendering change,
+ * rerun with DECK_GOLDEN_UPDATE=1 to write new ones (and look them over before checking them in).
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+
+typedef struct {
+    std::string label;
+    std::string hash;
+    std::vector<std::string> rows;   // PBM rows, '0'/'1' per pixel
+} State_t;
+
+static std::string printed;
+
+static std::string GoldenDir() { return getenv("DECK_GOLDEN_DIR") ? getenv("DECK_GOLDEN_DIR") : "golden"; }
+
+static std::string ActualDir() { return getenv("DECK_GOLDEN_ACTUAL") ? getenv("DECK_GOLDEN_ACTUAL") : "."; }
+
+// page states get a PBM golden, key states only their hash
+static bool Pictured(const std::string &label) { return label.find(" k") == std::string::npos; }
+
+static std::string FileName(std::string label)
+{
+    for(char &c : label) if(c == ' ') c = '_';
+    return label + ".pbm";
+}
+
+static bool AuditDone()
+{
+    printed += Serial.Take();
+    const std::string last = "p" + std::to_string(DeckCommon::pagesCount) + " scroll";
+    return printed.find(last) != std::string::npos && !consoleRelay.Pending();
+}
+
+// runs an audit through the console, and splits what it printed back into states
+static std::vector<State_t> Audit(const char *command)
+{
+    printed.clear();
+    Serial.Take();
+    Serial.Type(command);
+    CHECK(DeckHost::RunUntil(AuditDone, 5000000));
+
+    std::vector<State_t> states;
+    std::istringstream in(printed);
+    std::string line;
+    while(std::getline(in, line)) {
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        // the console's prompt can land in front of anything
+        while(!line.compare(0, 2, "> ")) line.erase(0, 2);
+        if(line == "P1") {
+            // comment & size, then a row per line
+            int width = 0, height = 0;
+            std::getline(in, line);
+            in >> width >> height;
+            std::getline(in, line);
+            for(int y = 0; y < height && std::getline(in, line); ++y) {
+                if(!line.empty() && line.back() == '\r') line.pop_back();
+                if(!states.empty()) states.back().rows.push_back(line);
+            }
+            continue;
+        }
+        // "<label>: <hash> <time> us", render times left out as they're never the same twice on hardware
+        const size_t colon = line.rfind(": ");
+        if(colon == std::string::npos || line.size() < 3 || line.compare(line.size() - 3, 3, " us")) continue;
+        states.push_back({ line.substr(0, colon), line.substr(colon + 2, 8), {} });
+    }
+    return states;
+}
+
+static std::vector<std::string> PbmRead(const std::string &path)
+{
+    std::vector<std::string> rows;
+    std::ifstream in(path);
+    std::string line;
+    int width = 0, height = 0;
+    if(!std::getline(in, line) || line != "P1") return rows;
+    while(in.peek() == '#') std::getline(in, line);
+    in >> width >> height;
+    std::getline(in, line);
+    while(std::getline(in, line) && (int)rows.size() < height) rows.push_back(line);
+    return rows;
+}
+
+static void PbmWrite(const std::string &path, const State_t &state)
+{
+    std::ofstream out(path);
+    out << "P1\n# " << state.label << "\n" << state.rows[0].size() << " " << state.rows.size() << "\n";
+    for(const std::string &row : state.rows) out << row << "\n";
+}
+
+// where & how much a page differs from its golden, with the differing pixels drawn in
+static void PbmDiff(const std::vector<std::string> &golden, const State_t &state)
+{
+    if(golden.size() != state.rows.size() || golden.empty() || golden[0].size() != state.rows[0].size()) {
+        printf("    %s: size differs from the golden\n", state.label.c_str());
+        return;
+    }
+    int count = 0, left = 1 << 30, top = 1 << 30, right = -1, bottom = -1;
+    for(int y = 0; y < (int)golden.size(); ++y) {
+        for(int x = 0; x < (int)golden[y].size(); ++x) {
+            if(golden[y][x] == state.rows[y][x]) continue;
+            ++count;
+            left = std::min(left, x); right = std::max(right, x);
+            top = std::min(top, y); bottom = std::max(bottom, y);
+        }
+    }
+    printf("    %s: %d pixels differ in (%d,%d)-(%d,%d); + now on, - now off\n", state.label.c_str(), count, left, top, right, bottom);
+    for(int y = top; y <= bottom; ++y) {
+        std::string row;
+        for(int x = left; x <= right; ++x) {
+            const char was = golden[y][x], now = state.rows[y][x];
+            row += was == now ? (now == '1' ? '#' : '.') : (now == '1' ? '+' : '-');
+        }
+        printf("    |%s|\n", row.c_str());
+    }
+}
+
+DECK_TEST(MatchesGoldens)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    DeckHost::Run(500000);
+
+    const std::vector<State_t> states = Audit("audit img\n");
+    CHECK(states.size() > (size_t)DeckCommon::pagesCount * 2);
+    for(const State_t &state : states) CHECK(!state.rows.empty());
+
+    if(getenv("DECK_GOLDEN_UPDATE") != nullptr) {
+        std::ofstream hashes(GoldenDir() + "/audit.txt");
+        for(const State_t &state : states) {
+            hashes << state.label << ": " << state.hash << "\n";
+            if(Pictured(state.label)) PbmWrite(GoldenDir() + "/" + FileName(state.label), state);
+        }
+        printf("    goldens written to %s\n", GoldenDir().c_str());
+        return;
+    }
+
+    std::ifstream in(GoldenDir() + "/audit.txt");
+    CHECK(in.good());
+    std::vector<std::pair<std::string, std::string>> golden;
+    std::string line;
+    while(std::getline(in, line)) {
+        const size_t colon = line.rfind(": ");
+        if(colon != std::string::npos) golden.push_back({ line.substr(0, colon), line.substr(colon + 2) });
+    }
+
+    CHECK_EQ(states.size(), golden.size());
+    for(size_t i = 0; i < std::min(states.size(), golden.size()); ++i) {
+        const State_t &state = states[i];
+        if(state.label == golden[i].first && state.hash == golden[i].second) continue;
+        DeckCheck::Fail(__FILE__, __LINE__, ("state " + state.label + " differs from golden " + golden[i].first).c_str());
+
+        // kept for a look, next to what it should've been
+        const std::string actual = ActualDir() + "/" + FileName(state.label);
+        PbmWrite(actual, state);
+        printf("    written to %s\n", actual.c_str());
+        if(Pictured(state.label)) PbmDiff(PbmRead(GoldenDir() + "/" + FileName(state.label)), state);
+    }
+}
+
+static uint8_t glassBefore[SCREEN_WIDTH * SCREEN_HEIGHT / 8], glass[sizeof(glassBefore)];
+
+DECK_TEST(AuditChangesNothing)
+{
+    // a toggle that's on, which the audit flips back and forth while drawing it
+    DeckSketch::Press(7);
+    DeckHost::Run(50000);
+    DeckSketch::Release(7);
+    DeckHost::Run(3000000);
+
+    const uint64_t toggles = DeckCommon::Prefs->keyToggles;
+    const uint32_t saves = DeckCommon::Prefs->saves;
+    const int page = DeckCommon::Prefs->curPage;
+    CHECK(DeckCommon::Prefs->KeyToggled(7, 0));
+    DeckSketch::Glass(glassBefore);
+
+    Audit("audit\n");
+    for(const uint16_t pending : OLED.togglesPending) CHECK_EQ(pending, 0);
+    DeckHost::Run(3000000);
+
+    CHECK_EQ(DeckCommon::Prefs->keyToggles, toggles);
+    CHECK_EQ(DeckCommon::Prefs->saves, saves);
+    CHECK_EQ(DeckCommon::Prefs->curPage, page);
+    // and the page that was up is back as it was
+    DeckSketch::Glass(glass);
+    CHECK(!memcmp(glass + SCREEN_WIDTH * 2, glassBefore + SCREEN_WIDTH * 2, sizeof(glass) - SCREEN_WIDTH * 2));
+}
+
+DECK_TEST(RelayPassesTextOnInOrder)
+{
+    DeckConsoleRelay relay;
+    std::string sent;
+    Serial.Take();
+
+    // twice round the ring, wrapping partway through a write
+    for(int i = 0; i < 3; ++i) {
+        std::string text;
+        for(int n = 0; n < CONSOLE_RELAY_SIZE / 2 - 100; ++n) text += (char)('a' + (n + i) % 26);
+        relay.print(text.c_str());
+        relay.Drain(Serial, true);
+        sent += text;
+    }
+    CHECK(!relay.Pending());
+    CHECK(Serial.Take() == sent);
+
+    // the port only takes so much at a time, and the rest waits
+    relay.print(sent.c_str() + sent.size() - 1000);
+    Serial.writeRoom = 300;
+    relay.Drain(Serial, true);
+    CHECK_EQ(Serial.Take().size(), 300);
+    CHECK(relay.Pending());
+    Serial.writeRoom = 4096;
+    relay.Drain(Serial, true);
+    CHECK_EQ(Serial.Take().size(), 700);
+}
+
+DECK_TEST(NobodyListeningNeverStalls)
+{
+    // far more than the ring holds, all thrown away rather than waited on
+    DeckConsoleRelay relay;
+    relay.Drain(Serial, false);
+    const std::string text(CONSOLE_RELAY_SIZE * 3, 'x');
+    CHECK_EQ(relay.print(text.c_str()), text.size());
+    relay.Drain(Serial, false);
+    CHECK(!relay.Pending());
+    CHECK(Serial.Take().empty());
+}
@@ -0,0 +1,60 @@
+/*!
+ * @file DeckCheck.cpp
+ * @brief Bare-bones test registry & checks for the host tests, so they need nothing beyond the compiler.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <LittleFS.h>
+#include <vector>
+
+#include "DeckCheck.h"
+
+namespace DeckCheck {
+    typedef struct Test_s {
+        const char *name;
+        TestFunc_t func;
+    } Test_t;
+
+    static std::vector<Test_t> &Tests()
+    {
+        static std::vector<Test_t> tests;
+        return tests;
+    }
+
+    static int failures = 0;
+    static const char *current = "";
+
+    bool Register(const char *name, TestFunc_t func)
+    {
+        Tests().push_back({ name, func });
+        return true;
+    }
+
+    void Fail(const char *file, const int &line, const char *what)
+    {
+        fprintf(stderr, "%s:%d: %s: check failed: %s\n", file, line, current, what);
+        ++failures;
+    }
+}
+
+int main()
+{
+    // every run starts from an empty filesystem, like a freshly flashed board
+    LittleFS.begin();
+    LittleFS.format();
+
+    int failed = 0;
+    for(const DeckCheck::Test_t &test : DeckCheck::Tests()) {
+        const int before = DeckCheck::failures;
+        DeckCheck::current = test.name;
+        test.func();
+        const bool ok = DeckCheck::failures == before;
+        printf("[%s] %s\n", ok ? " OK " : "FAIL", test.name);
+        failed += !ok;
+    }
+
+    printf("%d/%d passed\n", (int)DeckCheck::Tests().size() - failed, (int)DeckCheck::Tests().size());
+    return failed ? 1 : 0;
+}
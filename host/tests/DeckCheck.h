@@ -0,0 +1,42 @@
+/*!
+ * @file DeckCheck.h
+ * @brief Bare-bones test registry & checks for the host tests, so they need nothing beyond the compiler.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+namespace DeckCheck {
+    typedef void (*TestFunc_t)();
+
+    /// @brief Adds a test to the ones main() runs, in the order they're defined
+    bool Register(const char *name, TestFunc_t func);
+
+    /// @brief Records a failed check against the test that's running
+    void Fail(const char *file, const int &line, const char *what);
+}
+
+/// @brief Defines & registers a test case
+#define DECK_TEST(name) \
+    static void name(); \
+    static const bool name##_registered = DeckCheck::Register(#name, name); \
+    static void name()
+
+/// @brief Fails the test (and carries on) if cond is false
+#define CHECK(cond) \
+    do { if(!(cond)) DeckCheck::Fail(__FILE__, __LINE__, #cond); } while(0)
+
+/// @brief Fails the test with both values if they differ
+#define CHECK_EQ(a, b) \
+    do { \
+        const long long _a = (long long)(a), _b = (long long)(b); \
+        if(_a != _b) { \
+            char _what[256]; \
+            snprintf(_what, sizeof(_what), "%s == %s (%lld vs %lld)", #a, #b, _a, _b); \
+            DeckCheck::Fail(__FILE__, __LINE__, _what); \
+        } \
+    } while(0)
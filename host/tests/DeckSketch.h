@@ -0,0 +1,58 @@
+/*!
+ * @file DeckSketch.h
+ * @brief The sketch's globals & entry points, for tests reaching into a running deck.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#pragma once
+
+#include <Adafruit_TinyUSB.h>
+
+#include "PicoDeckCommon.h"
+#include "PicoDeckDisplay.h"
+#include "PicoDeckPanels.h"
+#include "PicoDeckTrace.h"
+#include "PicoDeckConsole.h"
+#include "PicoDeckPixels.h"
+#include "PicoDeckGovernor.h"
+#include "PicoDeckBoot.h"
+#include "DeckHost.h"
+
+// defined in PicoDeck.h, which only the sketch itself can include
+extern DeckDisplay OLED;
+extern DeckPanels keyPanels;
+extern DeckTrace inputTrace;
+extern DeckConsole console;
+extern DeckConsoleRelay consoleRelay;
+extern DeckPixels pixels;
+extern DeckGovernor governor;
+extern unsigned long reportInterval;
+extern DeckProfile *profiles[PROFILE_SLOTS];
+extern bool core1Parked;
+
+namespace DeckSketch {
+    /// @brief Reports the sketch has sent so far
+    inline std::vector<Adafruit_USBD_HID::Report_t> &Reports() { return Adafruit_USBD_HID::active->reports; }
+
+    /// @brief Holds a button down (pins are active low, with pull-ups)
+    inline void Press(const int &button) { DeckHost::PinSet(LightgunButtons::ButtonDesc[button].pin, LOW); }
+
+    /// @brief Lets a button go
+    inline void Release(const int &button) { DeckHost::PinRelease(LightgunButtons::ButtonDesc[button].pin); }
+
+    /// @brief Controller RAM behind the main display, as a page-major buffer the same size as the render buffer
+    inline void Glass(uint8_t *out)
+    {
+        switch(OLED.display->dispType) {
+            case Adafruit_MultiDisplay::I2C_SSD1306:
+            case Adafruit_MultiDisplay::SPI_SSD1306: OLED.display->display1306->controller.Glass(out); break;
+            case Adafruit_MultiDisplay::I2C_SH1106:
+            case Adafruit_MultiDisplay::SPI_SH1106: OLED.display->display1106->controller.Glass(out); break;
+            case Adafruit_MultiDisplay::I2C_SH1107:
+            case Adafruit_MultiDisplay::SPI_SH1107: OLED.display->display1107->controller.Glass(out); break;
+            default: break;
+        }
+    }
+}
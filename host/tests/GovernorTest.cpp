@@ -0,0 +1,109 @@
+/*!
+ * @file GovernorTest.cpp
+ * @brief Activity governor: steps down a tier at each threshold, gets the time in each right however late it's
+ * updated, and goes straight back to active on a key edge.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "DeckCheck.h"
+#include "PicoDeckGovernor.h"
+
+#define IDLE_AFTER   DeckGovernor::Tiers[DeckGovernor::Tier_Idle].after
+#define DIMMED_AFTER DeckGovernor::Tiers[DeckGovernor::Tier_Dimmed].after
+#define OFF_AFTER    DeckGovernor::Tiers[DeckGovernor::Tier_Off].after
+
+DECK_TEST(TiersInOrder)
+{
+    // each tier takes over later than the last, and winds something further down
+    for(int t = 1; t < DeckGovernor::GOVERNOR_TIERS; ++t) {
+        const DeckGovernor::Tier_t &tier = DeckGovernor::Tiers[t], &prev = DeckGovernor::Tiers[t-1];
+        CHECK(tier.after > prev.after);
+        CHECK(tier.frameInterval >= prev.frameInterval && tier.pixelsBrightness <= prev.pixelsBrightness);
+        CHECK(tier.pollTicks >= prev.pollTicks && (prev.animations || !tier.animations));
+    }
+}
+
+DECK_TEST(StepsDownAtEachThreshold)
+{
+    DeckGovernor governor;
+    governor.Activity(1000);
+    CHECK_EQ(governor.Wait(1000), IDLE_AFTER);
+
+    CHECK(!governor.Update(1000 + IDLE_AFTER - 1));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Active);
+    CHECK_EQ(governor.Wait(1000 + IDLE_AFTER - 1), 1);
+
+    CHECK(governor.Update(1000 + IDLE_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Idle);
+    CHECK(!governor.Update(1000 + IDLE_AFTER + 5));
+    CHECK_EQ(governor.Wait(1000 + IDLE_AFTER), DIMMED_AFTER - IDLE_AFTER);
+
+    CHECK(governor.Update(1000 + DIMMED_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Dimmed);
+    CHECK(governor.Update(1000 + OFF_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Off);
+
+    // nothing past off to wait for
+    CHECK(governor.Wait(1000 + OFF_AFTER) == ~0UL);
+    CHECK(!governor.Update(1000 + OFF_AFTER * 4));
+}
+
+DECK_TEST(ClockJumpCountsEveryTier)
+{
+    // not updated for the whole way down (e.g. asleep through it): it lands in off in one go,
+    // with each tier it passed through credited from its own threshold rather than the lot going to active
+    DeckGovernor governor;
+    governor.Activity(1000);
+    CHECK(governor.Update(1000 + OFF_AFTER + 500));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Off);
+
+    const unsigned long now = 1000 + OFF_AFTER + 500;
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Active, now), 1000 + IDLE_AFTER);
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Idle, now), DIMMED_AFTER - IDLE_AFTER);
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Dimmed, now), OFF_AFTER - DIMMED_AFTER);
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Off, now), 500);
+
+    // a smaller jump stops at the tier it's in, part way through it
+    DeckGovernor partway;
+    partway.Activity(0);
+    CHECK(partway.Update(DIMMED_AFTER + 10));
+    CHECK_EQ(partway.tier, DeckGovernor::Tier_Dimmed);
+    CHECK_EQ(partway.TimeIn(DeckGovernor::Tier_Idle, DIMMED_AFTER + 10), DIMMED_AFTER - IDLE_AFTER);
+    CHECK_EQ(partway.Wait(DIMMED_AFTER + 10), OFF_AFTER - DIMMED_AFTER - 10);
+}
+
+DECK_TEST(ActivityStraightBackToActive)
+{
+    DeckGovernor governor;
+    governor.Activity(0);
+    governor.Update(OFF_AFTER);
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Off);
+
+    CHECK(governor.Activity(OFF_AFTER + 100));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Active);
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Off, OFF_AFTER + 100), 100);
+    // already there, so no change to pass on
+    CHECK(!governor.Activity(OFF_AFTER + 200));
+    CHECK_EQ(governor.Wait(OFF_AFTER + 200), IDLE_AFTER);
+
+    // thresholds count from the latest activity, not the first
+    CHECK(!governor.Update(OFF_AFTER + 200 + IDLE_AFTER - 1));
+    CHECK(governor.Update(OFF_AFTER + 200 + IDLE_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Idle);
+}
+
+DECK_TEST(MillisWrapAround)
+{
+    // millis() rolls over every ~49 days; tiers still come from how long it's been
+    const unsigned long start = ~0UL - IDLE_AFTER / 2;
+    DeckGovernor governor;
+    governor.Activity(start);
+    CHECK(!governor.Update(start + IDLE_AFTER - 1));
+    CHECK(governor.Update(start + IDLE_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Idle);
+    CHECK(governor.Update(start + OFF_AFTER));
+    CHECK_EQ(governor.tier, DeckGovernor::Tier_Off);
+    CHECK_EQ(governor.TimeIn(DeckGovernor::Tier_Idle, start + OFF_AFTER), DIMMED_AFTER - IDLE_AFTER);
+}
@@ -0,0 +1,53 @@
+/*!
+ * @file IconsTest.cpp
+ * @brief Built-in icon table: every name bisects to its own entry, at build time or at runtime, and nothing else does.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+#include <string>
+
+#include "DeckCheck.h"
+#include "PicoDeckPrefs.h"
+#include "PicoDeckProfile.h"
+
+// resolved while building, so these are compile-time constants (a typo wouldn't build at all)
+static_assert(DeckPrefs::IconFind("dead") == 0, "first icon");
+static_assert(DeckPrefs::IconFind("zoom") == DeckPrefs::IconsCount - 1, "last icon");
+static constexpr const DeckPrefs::KeyBM_t *micToggle = KEY_ICON("mic_toggle");
+
+DECK_TEST(EveryNameFindsItself)
+{
+    CHECK(DeckPrefs::IconsSorted());
+    for(int i = 0; i < DeckPrefs::IconsCount; ++i) {
+        const char *name = DeckPrefs::Icons[i].name;
+        CHECK_EQ(DeckPrefs::IconFind(name), i);
+        CHECK(DeckPrefs::IconByName(name) == &DeckPrefs::Icons[i].bm);
+        // profiles carry icon names in a fixed-size field, with room for the terminator
+        CHECK(strlen(name) < sizeof(DeckProfile::Icon_t::name));
+    }
+
+    // the same entry whichever way it's looked up
+    CHECK(micToggle == DeckPrefs::IconByName("mic_toggle"));
+    CHECK(micToggle->isPacked);
+}
+
+DECK_TEST(UnknownNamesNotFound)
+{
+    // off either end, between neighbours, prefixes & extensions of real names, and the wrong case
+    const char *names[] = {"", "a", "zzz", "em_", "em_blinky", "em_b", "scene", "scene_arr", "vol", "volhi", "Dead",
+                           "mic_toggle ", " zoom"};
+    for(const char *name : names) {
+        CHECK_EQ(DeckPrefs::IconFind(name), -1);
+        CHECK(DeckPrefs::IconByName(name) == nullptr);
+    }
+
+    // one past each real name sorts between it and the next, where there's nothing
+    for(int i = 0; i < DeckPrefs::IconsCount; ++i) {
+        std::string name = DeckPrefs::Icons[i].name;
+        name.push_back('\x01');
+        CHECK_EQ(DeckPrefs::IconFind(name), -1);
+    }
+}
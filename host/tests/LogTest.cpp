@@ -0,0 +1,228 @@
+/*!
+ * @file LogTest.cpp
+ * @brief Binary event log: nothing's kept until a host listens, the stream starts with a sync record, both rings fill,
+ * wrap & drop without losing their order, drops are reported once each, a closed port throws the queue away, and
+ * Drain() only ever writes whole records the port has room for.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckLog.h"
+
+typedef DeckLog::Record_t Record_t;
+
+// a CDC port of its own, so the sketch's console doesn't get in the way
+static SerialUSB port;
+
+static std::vector<Record_t> Records(const std::string &bytes)
+{
+    CHECK_EQ(bytes.size() % sizeof(Record_t), 0);
+    std::vector<Record_t> records(bytes.size() / sizeof(Record_t));
+    memcpy(records.data(), bytes.data(), records.size() * sizeof(Record_t));
+    return records;
+}
+
+static void Log(const uint8_t &core, const int &count, const uint8_t &event, const uint16_t &first = 0)
+{
+    DeckHost::core = core;
+    for(int i = 0; i < count; ++i) DeckLog::Event(event, first + i);
+    DeckHost::core = 0;
+}
+
+// one pass with room for so many bytes
+static std::vector<Record_t> Drain(const int &room)
+{
+    port.writeRoom = room;
+    DeckLog::Drain(port, true);
+    return Records(port.Take());
+}
+
+// passes until there's nothing left, with room for so many records each
+static std::vector<Record_t> DrainAll(const int &records)
+{
+    std::vector<Record_t> all, pass;
+    while(!(pass = Drain(records * sizeof(Record_t))).empty()) {
+        CHECK(pass.size() <= (size_t)records);
+        all.insert(all.end(), pass.begin(), pass.end());
+    }
+    return all;
+}
+
+// a core's records, which have to carry on from each other's payloads
+static bool InOrder(const std::vector<Record_t> &records, const uint8_t &core, const uint16_t &first, const int &count)
+{
+    int seen = 0;
+    for(const Record_t &record : records) {
+        if(record.core != core || record.event == DeckLog::Log_Dropped) continue;
+        if(record.payload != (uint16_t)(first + seen)) return false;
+        ++seen;
+    }
+    return seen == count;
+}
+
+DECK_TEST(NothingUntilListening)
+{
+    // not listening, so events aren't even kept
+    Log(0, 10, DeckLog::Log_Press);
+    CHECK(!DeckLog::enabled);
+
+    // listening, but no room for the sync record yet
+    CHECK(Drain(sizeof(Record_t) - 1).empty());
+    CHECK(!DeckLog::enabled);
+
+    std::vector<Record_t> records = Drain(sizeof(Record_t));
+    CHECK_EQ(records.size(), 1);
+    CHECK(records[0].event == DeckLog::Log_Sync && records[0].core == 0 && records[0].payload == LOG_SYNC_WORD);
+    CHECK(DeckLog::enabled);
+    CHECK(DrainAll(64).empty());
+}
+
+DECK_TEST(FillAndWrapBothRings)
+{
+    // Core0 overruns its ring, Core1 half fills its own
+    Log(0, LOG_RING_RECORDS + 10, DeckLog::Log_Press);
+    Log(1, LOG_RING_RECORDS / 2, DeckLog::Log_FrameEnd);
+
+    // room for three records and a bit: three whole ones go out, the drop report first
+    std::vector<Record_t> records = Drain(3 * sizeof(Record_t) + 5);
+    CHECK_EQ(records.size(), 3);
+    CHECK(records[0].event == DeckLog::Log_Dropped && records[0].core == 0 && records[0].payload == 10);
+    CHECK(records[1].event == DeckLog::Log_Press && records[1].payload == 0 && records[2].payload == 1);
+
+    // the rest, a bit at a time: both rings whole & in order, with nothing lost but the overrun
+    std::vector<Record_t> rest = DrainAll(37);
+    records.insert(records.end(), rest.begin(), rest.end());
+    CHECK(InOrder(records, 0, 0, LOG_RING_RECORDS));
+    CHECK(InOrder(records, 1, 0, LOG_RING_RECORDS / 2));
+    CHECK_EQ(records.size(), 1 + LOG_RING_RECORDS + LOG_RING_RECORDS / 2);
+
+    // round and round each ring, past the end of its records and its 16-bit indices, drained in smaller bites
+    // than it's filled so every pass splits somewhere different
+    uint16_t next = 0;
+    for(int round = 0; round < 0x10000 / 200 + 10; ++round) {
+        Log(0, 200, DeckLog::Log_Report, next);
+        Log(1, 150, DeckLog::Log_Push, next);
+        records = DrainAll(47);
+        CHECK(InOrder(records, 0, next, 200));
+        CHECK(InOrder(records, 1, next, 150));
+        CHECK_EQ(records.size(), 350);
+        next += 200;
+    }
+}
+
+DECK_TEST(DroppedReportedOnce)
+{
+    Log(1, LOG_RING_RECORDS + 3, DeckLog::Log_FifoCmd);
+
+    // with room for one record, the drop report goes first
+    std::vector<Record_t> records = Drain(sizeof(Record_t));
+    CHECK_EQ(records.size(), 1);
+    CHECK(records[0].event == DeckLog::Log_Dropped && records[0].core == 1 && records[0].payload == 3);
+
+    // then it's the ring's own, with no second report for the same loss
+    records = Drain(sizeof(Record_t));
+    CHECK(records.size() == 1 && records[0].event == DeckLog::Log_FifoCmd && records[0].payload == 0);
+
+    // one slot's free now, so of five more it's only the last four that are lost - and reported as just those
+    Log(1, 5, DeckLog::Log_FifoCmd, LOG_RING_RECORDS + 3);
+    records = DrainAll(LOG_RING_RECORDS);
+    CHECK(records[0].event == DeckLog::Log_Dropped && records[0].payload == 4);
+    CHECK_EQ(records.size(), 1 + LOG_RING_RECORDS);
+    CHECK(InOrder(std::vector<Record_t>(records.begin(), records.end() - 1), 1, 1, LOG_RING_RECORDS - 1));
+    CHECK_EQ(records.back().payload, LOG_RING_RECORDS + 3);
+}
+
+DECK_TEST(CloseDiscards)
+{
+    Log(0, 20, DeckLog::Log_Press);
+    Log(1, LOG_RING_RECORDS + 5, DeckLog::Log_FrameStart);
+
+    // the port closing stops the log, writes nothing, and leaves nothing queued
+    port.writeRoom = 4096;
+    DeckLog::Drain(port, false);
+    CHECK(port.Take().empty());
+    CHECK(!DeckLog::enabled);
+    Log(0, 5, DeckLog::Log_Press);
+
+    // reopened, it's a fresh stream: just the sync record, without the old queue or its drops
+    std::vector<Record_t> records = DrainAll(64);
+    CHECK_EQ(records.size(), 1);
+    CHECK(records[0].event == DeckLog::Log_Sync);
+
+    DeckLog::Drain(port, false);
+}
+
+static std::string printed;
+
+static bool LogStarted()
+{
+    printed += Serial.Take();
+    return printed.find("close the port to stop\r\n") != std::string::npos;
+}
+
+DECK_TEST(SketchStreamsWhileOpen)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    DeckHost::Run(500000);
+
+    // asked for on the open console, with the port only taking a few records a pass
+    Serial.Take();
+    Serial.writeRoom = 5 * sizeof(Record_t) + 3;
+    Serial.Type("log\n");
+    CHECK(DeckHost::RunUntil(LogStarted, 1000000));
+    DeckHost::Run(100000);
+    DeckSketch::Press(0);
+    DeckHost::Run(100000);
+    DeckSketch::Release(0);
+    DeckHost::Run(100000);
+
+    printed += Serial.Take();
+    const std::string stream = printed.substr(printed.find("close the port to stop\r\n") + 24);
+    const std::vector<Record_t> records = Records(stream);
+    CHECK(records.size() > 1);
+    CHECK(records[0].event == DeckLog::Log_Sync && records[0].payload == LOG_SYNC_WORD);
+
+    // each core's records come in time order, nothing's lost, and both cores are in there
+    uint32_t last[2] = { records[0].time, records[0].time };
+    bool press = false, report = false, frame = false;
+    for(const Record_t &record : records) {
+        CHECK(record.event < DeckLog::LOG_EVENTS && record.core < 2);
+        CHECK(record.event != DeckLog::Log_Dropped);
+        CHECK((int32_t)(record.time - last[record.core]) >= 0);
+        last[record.core] = record.time;
+        press |= record.event == DeckLog::Log_Press && record.core == 0 && record.payload == 1;
+        report |= record.event == DeckLog::Log_Report && record.core == 0;
+        frame |= record.event == DeckLog::Log_FrameStart && record.core == 1;
+    }
+    CHECK(press && report && frame);
+
+    // kept for decklog to read back
+    if(const char *capture = getenv("DECK_LOG_CAPTURE")) {
+        FILE *file = fopen(capture, "wb");
+        CHECK(file != nullptr);
+        fwrite(printed.data(), 1, printed.size(), file);
+        fclose(file);
+    }
+
+    // closing the port stops it, and the console's back in text once it's open again
+    Serial.dtrState = false;
+    DeckSketch::Press(1);
+    DeckHost::Run(100000);
+    DeckSketch::Release(1);
+    DeckHost::Run(100000);
+    CHECK(!DeckLog::enabled);
+    CHECK(Serial.Take().empty());
+
+    Serial.writeRoom = 4096;
+    Serial.dtrState = true;
+    DeckHost::Run(100000);
+    CHECK(Serial.Take() == "PicoDeck console, 'help' for commands\n> ");
+}
@@ -0,0 +1,101 @@
+/*!
+ * @file PagesTest.cpp
+ * @brief Page working set: a page costs the same to load whatever the page count (500 pages benched against 3),
+ * and flips to a neighbour never have to load one.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <chrono>
+#include <string>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckStats.h"
+
+static std::string Command(const char *line)
+{
+    Serial.Take();
+    Serial.Type(line);
+    DeckHost::Run(50000);
+    return Serial.Take();
+}
+
+static int switchTo;
+
+static bool Switched() { return DeckCommon::Profile->Slot() == (unsigned int)switchTo && DeckCommon::Profile->Loaded(); }
+
+// host time per cold page load, best of a few batches so a busy machine doesn't skew it
+static double LoadNs(const DeckProfile *profile)
+{
+    DeckPages pages;
+    pages.Begin(&OLED.keyPics[0][0], OLED_KEYPICS_PAGES, profile);
+    const int count = profile->Pages();
+
+    double best = 1e12;
+    uint32_t seed = 2463534242;
+    for(int batch = 0; batch < 7; ++batch) {
+        const auto start = std::chrono::steady_clock::now();
+        for(int r = 0; r < 20000; ++r) {
+            seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+            pages.Invalidate();
+            const DeckPages::Page_t &page = pages.Get(seed % count);
+            if(page.page < 0) return 0;
+        }
+        const std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+        best = std::min(best, took.count() / 20000);
+    }
+    return best;
+}
+
+DECK_TEST(LoadCostFlatWithPageCount)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+
+    CHECK(Command("profile gen 3 2\n").find("stored in slot 2") != std::string::npos);
+    switchTo = 2;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK(Command("profile gen 500 1\n").find("stored in slot 1") != std::string::npos);
+    switchTo = 1;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK_EQ(DeckCommon::pagesCount, 500);
+
+    const double few = LoadNs(profiles[2]), many = LoadNs(profiles[1]);
+    printf("    cold page load: %.0f ns with 3 pages, %.0f ns with 500 pages\n", few, many);
+    CHECK(few > 0 && many > 0);
+    CHECK(many < few * 2);
+
+    // what got loaded is that page's, however far in
+    DeckPages pages;
+    pages.Begin(&OLED.keyPics[0][0], OLED_KEYPICS_PAGES, profiles[1]);
+    for(const int page : {0, 1, 250, 498, 499}) {
+        const DeckPages::Page_t &loaded = pages.Get(page);
+        CHECK_EQ(loaded.page, page);
+        CHECK(loaded.info == &profiles[1]->Page(page));
+        for(int i = 0, b = 0; b < (int)ButtonCount; ++b) {
+            if(DeckCommon::PageKey(profiles[1], b)) continue;
+            CHECK_EQ(loaded.codes[i++], profiles[1]->Binding(page, b).code);
+        }
+    }
+}
+
+DECK_TEST(NeighbourFlipsAreHits)
+{
+    // page keys both ways from wherever it is, wrapping around the ends
+    const int pageKeys[] = {13, 13, 12, 12, 12, 13};
+    DeckHost::Run(200000);
+    for(const int button : pageKeys) {
+        const uint32_t misses = DeckStats::Counter(DeckStats::Count_PageMisses);
+        const int page = DeckCommon::Prefs->curPage;
+        DeckSketch::Press(button);
+        DeckHost::Run(30000);
+        DeckSketch::Release(button);
+        DeckHost::Run(300000);
+
+        const int expect = button == 13 ? (page + 1) % 500 : (page + 499) % 500;
+        CHECK_EQ(DeckCommon::Prefs->curPage, expect);
+        CHECK_EQ(DeckStats::Counter(DeckStats::Count_PageMisses), misses);
+    }
+}
@@ -0,0 +1,213 @@
+/*!
+ * @file PanelsTest.cpp
+ * @brief Key panels: each mirrors its keys, both buses push at once, panels on a bus take turns a page at a time,
+ * only changed pages go out, and an unplugged panel is given up on without holding the rest back.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "HostOLED.h"
+
+// two magnified key cells behind a mux, plus a key row straight on each bus
+enum { Panel_Cell0 = 0, Panel_Cell1, Panel_Row1, Panel_Row2, PANELS };
+
+typedef struct {
+    uint64_t time;
+    int panel;
+    size_t len;
+} Transfer_t;
+
+static std::vector<Transfer_t> transfers;
+
+/// @brief Sits in front of a panel's controller, noting each page of data that reaches it
+class Tap : public HostI2CDevice {
+public:
+    void Receive(const uint8_t *data, const size_t &len) override {
+        if(device == nullptr) return;
+        if(len && data[0] == 0x40) transfers.push_back({ DeckHost::now, panel, len });
+        device->Receive(data, len);
+    }
+
+    HostOLED *device = nullptr;
+    int panel = 0;
+};
+
+/// @brief TCA9548A: whichever channel's selected answers at its address, with nothing when it's closed
+class Mux : public HostI2CDevice {
+public:
+    void Receive(const uint8_t *data, const size_t &len) override {
+        if(!len) return;
+        const int channel = data[0] ? __builtin_ctz(data[0]) : -1;
+        behind[selected + 1] = Wire.Device(0x3C);
+        Wire.Attach(0x3C, behind[channel + 1]);
+        selected = channel;
+    }
+
+    /// @brief What's on a channel, wherever it is right now
+    HostI2CDevice *&On(const int &channel) {
+        static HostI2CDevice *live;
+        if(channel != selected) return behind[channel + 1];
+        live = Wire.Device(0x3C);
+        return live;
+    }
+
+    /// @brief Swaps what's on a channel
+    void Put(const int &channel, HostI2CDevice *device) {
+        if(channel == selected) Wire.Attach(0x3C, device);
+        else behind[channel + 1] = device;
+    }
+
+    // closed, then each channel
+    HostI2CDevice *behind[9] = {};
+    int selected = -1;
+};
+
+static Mux mux;
+static Tap taps[PANELS];
+
+static uint8_t glass[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+
+static bool MainPixel(const int &x, const int &y) { return glass[(y / 8) * SCREEN_WIDTH + x] & (1 << (y % 8)); }
+
+static bool PanelsIdle() { return keyPanels.Idle(); }
+
+// pages flip on the press, so that's what the panels are pushing by the time it's let go
+static void PageFlip()
+{
+    DeckSketch::Press(13);
+    CHECK(DeckHost::RunUntil([]() { return !keyPanels.Idle(); }, 500000));
+    CHECK(DeckHost::RunUntil(PanelsIdle, 500000));
+    DeckSketch::Release(13);
+    DeckHost::Run(100000);
+}
+
+static int Count(const int &panel)
+{
+    int count = 0;
+    for(const Transfer_t &transfer : transfers) count += transfer.panel == panel;
+    return count;
+}
+
+DECK_TEST(PanelsMirrorKeys)
+{
+    DeckPanels::PanelDesc = {
+        {Adafruit_MultiDisplay::I2C_SSD1306, 0, 0x3C, 0, 64, 32, DeckPanels::Layout_KeyCell, 0},
+        {Adafruit_MultiDisplay::I2C_SSD1306, 0, 0x3C, 1, 64, 32, DeckPanels::Layout_KeyCell, 1},
+        {Adafruit_MultiDisplay::I2C_SSD1306, 0, 0x3D, -1, 128, 32, DeckPanels::Layout_KeyRow, 1},
+        {Adafruit_MultiDisplay::I2C_SSD1306, 1, 0x3D, -1, 128, 32, DeckPanels::Layout_KeyRow, 2},
+    };
+    Wire.Attach(PANEL_MUX_ADDR, &mux);
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    CHECK(DeckHost::RunUntil(PanelsIdle, 1000000));
+    DeckHost::Run(500000);
+
+    // every panel's controller, with a tap in front
+    taps[Panel_Cell0].device = static_cast<HostOLED*>(mux.On(0));
+    taps[Panel_Cell1].device = static_cast<HostOLED*>(mux.On(1));
+    taps[Panel_Row1].device = static_cast<HostOLED*>(Wire.Device(0x3D));
+    taps[Panel_Row2].device = static_cast<HostOLED*>(Wire1.Device(0x3D));
+    for(int p = 0; p < PANELS; ++p) {
+        CHECK(taps[p].device != nullptr);
+        taps[p].panel = p;
+    }
+    mux.Put(0, &taps[Panel_Cell0]);
+    mux.Put(1, &taps[Panel_Cell1]);
+    Wire.Attach(0x3D, &taps[Panel_Row1]);
+    Wire1.Attach(0x3D, &taps[Panel_Row2]);
+
+    // cells are doubled up & centred on the small panels, rows are 1:1 & centred on the strips
+    DeckSketch::Glass(glass);
+    int lit = 0;
+    for(int y = 0; y < OLED_KEY_BOX_HEIGHT; ++y) {
+        for(int x = 0; x < OLED_KEY_BOX_WIDTH; ++x) {
+            for(int cell = 0; cell < 2; ++cell) {
+                const bool on = MainPixel(32 * cell + x, 16 + y);
+                lit += on;
+                const HostOLED *panel = taps[Panel_Cell0 + cell].device;
+                CHECK(panel->Pixel(1 + 2 * x, 2 * y) == on && panel->Pixel(2 + 2 * x, 2 * y + 1) == on);
+            }
+            for(int row = 1; row <= 2; ++row) {
+                for(int column = 0; column < OLED_KEYS_COLUMNS; ++column) {
+                    const bool on = MainPixel(32 * column + x, 16 + 16 * row + y);
+                    CHECK(taps[Panel_Row1 + row - 1].device->Pixel(32 * column + x, 8 + y) == on);
+                }
+            }
+        }
+    }
+    // and there was something to compare
+    CHECK(lit > 0);
+}
+
+DECK_TEST(BusesPushTogetherPanelsTakeTurns)
+{
+    // every key changes, so every panel has its whole key area to push again
+    transfers.clear();
+    PageFlip();
+    const uint64_t took = transfers.back().time - transfers.front().time;
+
+    // key cells fill their panels; rows only cover the middle two of their four pages
+    CHECK_EQ(Count(Panel_Cell0), 4);
+    CHECK_EQ(Count(Panel_Cell1), 4);
+    CHECK_EQ(Count(Panel_Row1), 2);
+    CHECK_EQ(Count(Panel_Row2), 2);
+
+    // the first few pages on the shared bus come from each of its panels in turn, rather than all of one first
+    std::vector<int> order;
+    for(const Transfer_t &transfer : transfers)
+        if(transfer.panel != Panel_Row2 && order.size() < 3) order.push_back(transfer.panel);
+    CHECK(order.size() == 3 && order[0] != order[1] && order[1] != order[2] && order[0] != order[2]);
+
+    // pages go out on both buses at once, so it's all done sooner than back to back
+    uint64_t busy = 0;
+    bool overlapped = false;
+    for(const Transfer_t &a : transfers) {
+        const uint64_t span = (a.len + 2) * 9 * 1000000ULL / PANEL_I2C_CLOCK;
+        busy += span;
+        for(const Transfer_t &b : transfers)
+            if((a.panel == Panel_Row2) != (b.panel == Panel_Row2) && b.time >= a.time && b.time < a.time + span) overlapped = true;
+    }
+    CHECK(overlapped);
+    CHECK(took < busy);
+    printf("    %zu pages over both buses: %llu us of bus time, done in %llu us\n",
+           transfers.size(), (unsigned long long)busy, (unsigned long long)took);
+}
+
+DECK_TEST(OnlyChangedPagesGoOut)
+{
+    // a press only changes the one key, on the one panel mirroring it
+    transfers.clear();
+    DeckSketch::Press(0);
+    CHECK(DeckHost::RunUntil([]() { return !transfers.empty(); }, 500000));
+    CHECK(DeckHost::RunUntil(PanelsIdle, 500000));
+    DeckSketch::Release(0);
+    CHECK(DeckHost::RunUntil([]() { return transfers.size() > 4; }, 500000));
+    CHECK(DeckHost::RunUntil(PanelsIdle, 500000));
+    DeckHost::Run(200000);
+    CHECK_EQ(Count(Panel_Cell0), 8);
+    CHECK_EQ((int)transfers.size(), 8);
+}
+
+DECK_TEST(UnpluggedPanelGivenUp)
+{
+    // the second cell goes quiet: it's retried a few times, then left alone while the others carry on
+    mux.Put(1, nullptr);
+    transfers.clear();
+    const unsigned int aborts = keyPanels.aborts;
+    PageFlip();
+    CHECK_EQ(keyPanels.aborts - aborts, PANEL_RETRIES_MAX);
+    CHECK_EQ(Count(Panel_Cell0), 4);
+    CHECK_EQ(Count(Panel_Row1), 2);
+    CHECK_EQ(Count(Panel_Row2), 2);
+
+    transfers.clear();
+    PageFlip();
+    CHECK_EQ(keyPanels.aborts - aborts, PANEL_RETRIES_MAX);
+    CHECK_EQ(Count(Panel_Cell0), 4);
+    CHECK_EQ(Count(Panel_Cell1), 0);
+}
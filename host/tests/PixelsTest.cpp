@@ -0,0 +1,130 @@
+/*!
+ * @file PixelsTest.cpp
+ * @brief Pixels effects engine: fades & flashes land where they should, frames only go out when they change,
+ * and late frames are dropped rather than caught up on.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "DeckCheck.h"
+#include "PicoDeckPixels.h"
+
+// a pixel's word for a colour, as Render() packs it
+static uint32_t Packed(const DeckPixels &strip, const uint8_t &r, const uint8_t &g, const uint8_t &b)
+{
+    return (uint32_t)strip.Level(g) << 24 | (uint32_t)strip.Level(r) << 16 | (uint32_t)strip.Level(b) << 8;
+}
+
+// ticks every ms from one time to another, as the sketch's loop would
+static void TickThrough(DeckPixels &strip, const uint32_t &from, const uint32_t &to)
+{
+    for(uint32_t now = from; now <= to; ++now) strip.Tick(now);
+}
+
+DECK_TEST(NoStripOffTarget)
+{
+    DeckPixels strip;
+    CHECK(!strip.Begin(28));
+
+    // frames are still worked out, they just don't go anywhere
+    strip.Fade(0x0000FF, 0);
+    CHECK(strip.Tick(PIXELS_FADE_MS));
+    CHECK_EQ(strip.framesSent, 1);
+}
+
+DECK_TEST(FadeLandsOnColourThenSettles)
+{
+    DeckPixels strip;
+    strip.Fade(0x804020, 0);
+    TickThrough(strip, 0, PIXELS_FADE_MS);
+    for(int p = 0; p < PIXELS_COUNT; ++p) CHECK_EQ(strip.Frame()[p], Packed(strip, 0x20, 0x40, 0x80));
+
+    // about a frame per PIXELS_FRAME_MS while it's fading, then nothing once it's there
+    const uint32_t sent = strip.framesSent;
+    CHECK(sent > 1 && sent <= PIXELS_FADE_MS / PIXELS_FRAME_MS + 1);
+    TickThrough(strip, PIXELS_FADE_MS + 1, PIXELS_BREATHE_AFTER - 1);
+    CHECK_EQ(strip.framesSent, sent);
+
+    // nothing to wake for until breathing's due
+    CHECK_EQ(strip.Wait(5000), PIXELS_BREATHE_AFTER - 5000);
+}
+
+DECK_TEST(FadeCarriesOnFromMidway)
+{
+    DeckPixels strip;
+    strip.Fade(0x0000FF, 0);
+    TickThrough(strip, 0, PIXELS_FADE_MS / 2);
+    const uint32_t halfway = strip.Frame()[0];
+
+    // turning round halfway starts from where it got to, not from either end
+    strip.Fade(0x000000, PIXELS_FADE_MS / 2);
+    TickThrough(strip, PIXELS_FADE_MS / 2 + 1, PIXELS_FADE_MS / 2 + PIXELS_FRAME_MS);
+    CHECK(strip.Frame()[0] > 0);
+    CHECK(strip.Frame()[0] < Packed(strip, 0xFF, 0, 0));
+    CHECK(strip.Frame()[0] >= Packed(strip, 0x60, 0, 0) && halfway >= Packed(strip, 0x60, 0, 0));
+    TickThrough(strip, PIXELS_FADE_MS / 2 + PIXELS_FRAME_MS + 1, PIXELS_FADE_MS * 2);
+    CHECK_EQ(strip.Frame()[0], 0);
+}
+
+DECK_TEST(FlashDecaysOnItsOwnPixel)
+{
+    DeckPixels strip;
+    strip.Fade(0x000080, 0);
+    TickThrough(strip, 0, PIXELS_FADE_MS);
+    const uint32_t base = strip.Frame()[0];
+
+    strip.Flash(2, 1000);
+    CHECK(strip.Tick(1000 + PIXELS_FRAME_MS));
+    CHECK(strip.Frame()[2] > base);
+    for(int p = 0; p < PIXELS_COUNT; ++p) if(p != 2) CHECK_EQ(strip.Frame()[p], base);
+
+    TickThrough(strip, 1000 + PIXELS_FRAME_MS, 1000 + PIXELS_FLASH_MS + PIXELS_FRAME_MS);
+    CHECK_EQ(strip.Frame()[2], base);
+
+    // off the end of the strip is ignored
+    const uint32_t sent = strip.framesSent;
+    strip.Flash(PIXELS_COUNT, 2000);
+    TickThrough(strip, 2000, 2000 + PIXELS_FLASH_MS);
+    CHECK_EQ(strip.framesSent, sent);
+}
+
+DECK_TEST(LateFramesDropped)
+{
+    DeckPixels strip;
+    strip.Fade(0xFFFFFF, 0);
+
+    // a long stall is one frame late, not a burst of them to catch up
+    CHECK(strip.Tick(100));
+    CHECK(!strip.Tick(101));
+    CHECK(!strip.Tick(100 + PIXELS_FRAME_MS - 1));
+    CHECK_EQ(strip.Wait(101), PIXELS_FRAME_MS - 1);
+    CHECK(strip.Tick(100 + PIXELS_FRAME_MS));
+}
+
+DECK_TEST(BreathesOnlyWhenLit)
+{
+    DeckPixels lit;
+    lit.Fade(0x00FF00, 0);
+    TickThrough(lit, 0, PIXELS_BREATHE_AFTER - 1);
+    const uint32_t sent = lit.framesSent, full = lit.Frame()[0];
+
+    // left alone, it starts dimming by itself, and back up to full
+    TickThrough(lit, PIXELS_BREATHE_AFTER, PIXELS_BREATHE_AFTER + PIXELS_BREATHE_MS / 2);
+    CHECK(lit.framesSent > sent);
+    CHECK(lit.Frame()[0] < full);
+    CHECK(lit.Wait(PIXELS_BREATHE_AFTER + PIXELS_BREATHE_MS / 2 + 1) <= PIXELS_FRAME_MS);
+    TickThrough(lit, PIXELS_BREATHE_AFTER + PIXELS_BREATHE_MS / 2 + 1, PIXELS_BREATHE_AFTER + PIXELS_BREATHE_MS);
+    CHECK_EQ(lit.Frame()[0], full);
+
+    // unlit, there's never anything to send
+    DeckPixels unlit;
+    unlit.Fade(0, 0);
+    TickThrough(unlit, 0, PIXELS_BREATHE_AFTER * 2);
+    CHECK_EQ(unlit.Wait(PIXELS_BREATHE_AFTER * 2), UINT32_MAX);
+
+    // nor at no brightness, where it settles as soon as the dark frame's out
+    lit.Brightness(0);
+    TickThrough(lit, PIXELS_BREATHE_AFTER + PIXELS_BREATHE_MS, PIXELS_BREATHE_AFTER * 2);
+    CHECK_EQ(lit.Wait(PIXELS_BREATHE_AFTER * 2), UINT32_MAX);
+}
@@ -0,0 +1,156 @@
+/*!
+ * @file PrefsTest.cpp
+ * @brief Prefs journal: ping-ponging between its sectors, surviving power cuts, and what each save costs.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckStats.h"
+
+static uint8_t *Flash() { return const_cast<uint8_t*>(DeckFlashRegion()); }
+
+static void FlashWipe() { memset(Flash(), 0xFF, DECK_FLASH_PREFS_SECTORS * DECK_FLASH_SECTOR_SIZE); }
+
+// saves one new state, returning how long flash held everything up for
+static uint64_t SaveAs(DeckPrefs &prefs, const int &n)
+{
+    prefs.curPage = n % 3;
+    prefs.keyToggles = n;
+    const uint64_t start = DeckHost::now;
+    CHECK_EQ(prefs.Save(), DeckPrefs::Error_Success);
+    return DeckHost::now - start;
+}
+
+DECK_TEST(SurvivesSectorRollovers)
+{
+    FlashWipe();
+    DeckPrefs prefs;
+    // a few times around both sectors
+    for(int n = 1; n <= (int)PREFS_JOURNAL_RECORDS * 5 + 7; ++n) {
+        SaveAs(prefs, n);
+        if(n % 37 && n % (int)PREFS_JOURNAL_RECORDS > 2) continue;
+
+        DeckPrefs reloaded;
+        CHECK_EQ(reloaded.keyToggles, n);
+        CHECK_EQ(reloaded.curPage, n % 3);
+        CHECK_EQ(reloaded.saves, n);
+    }
+
+    // carrying on from a reload picks up where it left off
+    DeckPrefs reloaded;
+    SaveAs(reloaded, 10000);
+    DeckPrefs again;
+    CHECK_EQ(again.keyToggles, 10000);
+}
+
+DECK_TEST(NothingChangedNothingWritten)
+{
+    FlashWipe();
+    DeckPrefs prefs;
+    SaveAs(prefs, 1);
+    const uint32_t programmed = DeckStats::Counter(DeckStats::Count_PrefsProgrammed);
+    CHECK(!prefs.Changed());
+    CHECK_EQ(prefs.Save(), DeckPrefs::Error_Success);
+    CHECK_EQ(DeckStats::Counter(DeckStats::Count_PrefsProgrammed), programmed);
+}
+
+DECK_TEST(PowerCutMidCompaction)
+{
+    FlashWipe();
+    DeckPrefs prefs;
+    for(int n = 1; n <= (int)PREFS_JOURNAL_RECORDS; ++n)
+        SaveAs(prefs, n);
+    std::vector<uint8_t> full(Flash(), Flash() + DECK_FLASH_SECTOR_SIZE);
+
+    // the next save starts the spare sector off, and the full one's only erased later on;
+    // cut before that erase, and both are there - the newer one wins
+    SaveAs(prefs, 5000);
+    memcpy(Flash(), full.data(), full.size());
+    {
+        DeckPrefs reloaded;
+        CHECK_EQ(reloaded.keyToggles, 5000);
+        CHECK_EQ(reloaded.saves, PREFS_JOURNAL_RECORDS + 1);
+
+        // and the stale sector's erased before it's used again, rather than mixed in
+        for(int n = 1; n < (int)PREFS_JOURNAL_RECORDS; ++n)
+            SaveAs(reloaded, 6000 + n);
+        SaveAs(reloaded, 7000);
+        DeckPrefs after;
+        CHECK_EQ(after.keyToggles, 7000);
+    }
+
+    // cut partway through the erase: whatever's left of the old sector is older, so it's ignored
+    FlashWipe();
+    DeckPrefs fresh;
+    for(int n = 1; n <= (int)PREFS_JOURNAL_RECORDS + 1; ++n)
+        SaveAs(fresh, n);
+    memcpy(Flash(), full.data(), DECK_FLASH_SECTOR_SIZE / 2);
+    DeckPrefs reloaded;
+    CHECK_EQ(reloaded.keyToggles, PREFS_JOURNAL_RECORDS + 1);
+}
+
+DECK_TEST(SpareLeftDirtyStillErasedFirst)
+{
+    // no quiet moment for SpareErase() all the way round: compacting erases the spare itself
+    FlashWipe();
+    DeckPrefs prefs;
+    for(int n = 1; n <= (int)PREFS_JOURNAL_RECORDS * 2 + 1; ++n)
+        SaveAs(prefs, n);
+    CHECK(prefs.SpareDirty());
+    const uint64_t stall = SaveAs(prefs, 9000);
+    CHECK_EQ(stall, DECK_FLASH_PROGRAM_US);
+
+    for(int n = 2; n < (int)PREFS_JOURNAL_RECORDS; ++n)
+        SaveAs(prefs, 9000 + n);
+    CHECK_EQ(SaveAs(prefs, 9500), DECK_FLASH_PROGRAM_US + DECK_FLASH_ERASE_US);
+    DeckPrefs reloaded;
+    CHECK_EQ(reloaded.keyToggles, 9500);
+    CHECK(reloaded.SpareDirty());
+}
+
+DECK_TEST(WriteAmplificationAndStall)
+{
+    FlashWipe();
+    DeckPrefs prefs;
+    const uint32_t programmed = DeckStats::Counter(DeckStats::Count_PrefsProgrammed);
+    const uint32_t erases = DeckStats::Counter(DeckStats::Count_PrefsErases);
+
+    const int saves = PREFS_JOURNAL_RECORDS * 10;
+    uint64_t worst = 0, total = 0, appendWorst = 0, eraseWorst = 0;
+    for(int n = 1; n <= saves; ++n) {
+        const uint64_t stall = SaveAs(prefs, n);
+        worst = std::max(worst, stall);
+        total += stall;
+        if(n % PREFS_JOURNAL_RECORDS != 1 || n == 1) appendWorst = std::max(appendWorst, stall);
+
+        // the sketch erases the spare in a quiet moment of its own, between saves
+        if(prefs.SpareDirty()) {
+            const uint64_t start = DeckHost::now;
+            CHECK_EQ(prefs.SpareErase(), DeckPrefs::Error_Success);
+            eraseWorst = std::max(eraseWorst, DeckHost::now - start);
+            total += DeckHost::now - start;
+            CHECK(!prefs.SpareDirty());
+        }
+    }
+
+    const uint32_t bytes = DeckStats::Counter(DeckStats::Count_PrefsProgrammed) - programmed;
+    const uint32_t erased = DeckStats::Counter(DeckStats::Count_PrefsErases) - erases;
+    printf("    %d saves: %u page bytes programmed for %u record bytes (x%u), %u sector erases (1 per %d saves)\n",
+           saves, bytes, (unsigned)(saves * sizeof(DeckPrefs::Record_t)), (unsigned)(bytes / (saves * sizeof(DeckPrefs::Record_t))),
+           erased, saves / std::max<uint32_t>(erased, 1));
+    printf("    stall per save at typical flash timings: %llu us appending, %llu us compacting, %llu us erasing apart, %llu us average\n",
+           (unsigned long long)appendWorst, (unsigned long long)worst, (unsigned long long)eraseWorst, (unsigned long long)(total / saves));
+
+    // one page per record, and one erase per sector's worth of them (the first sector needed none)
+    CHECK_EQ(bytes, saves * DECK_FLASH_PAGE_SIZE);
+    CHECK_EQ(erased, saves / PREFS_JOURNAL_RECORDS - 1);
+    // no save ever waits behind an erase, and no stall is longer than one
+    CHECK_EQ(appendWorst, DECK_FLASH_PROGRAM_US);
+    CHECK_EQ(worst, DECK_FLASH_PROGRAM_US);
+    CHECK_EQ(eraseWorst, DECK_FLASH_ERASE_US);
+}
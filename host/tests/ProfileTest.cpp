@@ -0,0 +1,197 @@
+/*!
+ * @file ProfileTest.cpp
+ * @brief Profile slots: new ones only ever go into a slot that's not in use, then get switched to through Core1.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string>
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+
+static std::string Command(const char *line, const uint64_t &us = 50000)
+{
+    Serial.Take();
+    Serial.Type(line);
+    DeckHost::Run(us);
+    return Serial.Take();
+}
+
+static bool Contains(const std::string &out, const char *text) { return out.find(text) != std::string::npos; }
+
+static int switchTo;
+
+static bool Switched() { return DeckCommon::Profile->Slot() == (unsigned int)switchTo && DeckCommon::Profile->Loaded(); }
+
+// the compiled-in keymap's two page keys
+#define PAGE_PREV 12
+#define PAGE_NEXT 13
+
+// both page keys, held together for a while
+static void Chord(const unsigned long &ms)
+{
+    DeckSketch::Press(PAGE_PREV);
+    DeckSketch::Press(PAGE_NEXT);
+    DeckHost::Run(ms * 1000ULL);
+    DeckSketch::Release(PAGE_PREV);
+    DeckSketch::Release(PAGE_NEXT);
+}
+
+DECK_TEST(InUseSlotNeverRewritten)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    CHECK_EQ(DeckCommon::Profile->Slot(), 0);
+
+    CHECK(Contains(Command("profile build 0\n"), "in use"));
+    CHECK(Contains(Command("profile clear 0\n"), "in use"));
+    CHECK(!profiles[0]->Stored());
+
+    // goes in the next slot, then Core1 gets it ready and it's swapped in
+    CHECK(Contains(Command("profile gen 500\n"), "stored in slot 1"));
+    switchTo = 1;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK_EQ(DeckCommon::pagesCount, 500);
+    CHECK_EQ(DeckCommon::Prefs->profile, 1);
+    CHECK(Contains(Command("profile gen 10 1\n"), "in use"));
+    CHECK_EQ(DeckCommon::Profile->Pages(), 500);
+
+    // and again, back into slot 0 - the old one wasn't touched while it was in use
+    CHECK(Contains(Command("profile build\n"), "stored in slot 2"));
+    switchTo = 2;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK(!profiles[0]->Stored());
+    CHECK(profiles[1]->Stored());
+}
+
+DECK_TEST(CompiledProfileLoads)
+{
+    const char *path = getenv("DECK_PROFILE_EXAMPLE");
+    CHECK(path != nullptr);
+    if(path == nullptr) return;
+    FILE *in = fopen(path, "rb");
+    CHECK(in != nullptr);
+    if(in == nullptr) return;
+    std::vector<uint8_t> blob(PROFILE_STORE_SIZE);
+    blob.resize(fread(blob.data(), 1, blob.size(), in));
+    fclose(in);
+
+    const std::string size = std::to_string(blob.size());
+    CHECK(Contains(Command(("profile load " + size + " 3\n").c_str()), ("Send " + size + " bytes").c_str()));
+    Serial.Send(blob);
+    DeckHost::Run(200000);
+    CHECK(Contains(Serial.Take(), "stored in slot 3, 3 pages"));
+    switchTo = 3;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+
+    // the text's first page is the compiled-in one
+    const DeckProfile &profile = *DeckCommon::Profile;
+    CHECK(!strcmp(profile.Page(0).name, "Avatar Actions"));
+    CHECK_EQ(profile.Page(0).color, 0x000000FF);
+    CHECK_EQ(profile.Page(2).color, 0x00FF0000);
+    for(unsigned int b = 0; b < ButtonCount; ++b)
+        for(int page = 0; page < 3; ++page)
+            CHECK_EQ(profile.Binding(page, b).code, LightgunButtons::ButtonDesc[b].keys.at(b < 12 ? page : 0));
+    CHECK(!strcmp(profile.IconName(profile.Binding(0, 7)), "zoom"));
+    CHECK(profile.Binding(0, 7).flags & DeckProfile::Bind_Toggle);
+    CHECK(profile.IconName(profile.Binding(2, 0)) == nullptr);
+
+    // and it's what goes out
+    DeckHost::Run(100000);
+    DeckSketch::Reports().clear();
+    DeckSketch::Press(0);
+    CHECK(DeckHost::RunUntil([]() { return !DeckSketch::Reports().empty(); }, 3000));
+    if(!DeckSketch::Reports().empty()) {
+        CHECK_EQ(DeckSketch::Reports().back().data[0], 0x40);
+        CHECK_EQ(DeckSketch::Reports().back().data[2], 0x68);
+    }
+    DeckSketch::Release(0);
+    DeckHost::Run(100000);
+}
+
+DECK_TEST(BadOrCutShortUploadsLeaveSlotEmpty)
+{
+    CHECK(Contains(Command("profile load 64 1\n"), "Send 64 bytes"));
+    Serial.Send(std::vector<uint8_t>(64, 0x5A));
+    DeckHost::Run(100000);
+    CHECK(Contains(Serial.Take(), "No valid profile, slot 1 left empty"));
+    CHECK(!profiles[1]->Stored());
+
+    // the profile combo skips a slot that's still coming in (the console's busy taking it, so can't be asked)
+    std::vector<uint8_t> header(sizeof(DeckProfile::Header_t));
+    const DeckProfile::Header_t stored = { PROFILE_MAGIC, PROFILE_VERSION, sizeof(DeckProfile::Header_t), 4096 };
+    memcpy(header.data(), &stored, sizeof(stored));
+    header.resize(DECK_FLASH_PAGE_SIZE, 0);
+    CHECK(Contains(Command("profile load 4096 0\n"), "Send 4096 bytes"));
+    Serial.Send(header);
+    DeckHost::Run(100000);
+    CHECK(profiles[0]->Stored());
+    CHECK_EQ(DeckCommon::Profile->Slot(), 3);
+
+    Chord(PROFILE_CHORD_HOLD_MS + 50);
+    switchTo = 2;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+
+    // port closed halfway: the slot's wiped, and can be written again
+    Serial.dtrState = false;
+    DeckHost::Run(100000);
+    Serial.dtrState = true;
+    DeckHost::Run(100000);
+    CHECK(!profiles[0]->Stored());
+    CHECK(Contains(Command("profile gen 5 0\n"), "stored in slot 0"));
+    switchTo = 0;
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK_EQ(DeckCommon::pagesCount, 5);
+}
+
+// whether a report has any key down at all
+static bool AnyKey(const Adafruit_USBD_HID::Report_t &report)
+{
+    for(const uint8_t &b : report.data)
+        if(b) return true;
+    return false;
+}
+
+// defined in PicoDeck.h
+extern uint32_t profileChord;
+
+static unsigned int switchFrom;
+
+static bool SwitchedAway() { return DeckCommon::Profile->Slot() != switchFrom && DeckCommon::Profile->Loaded(); }
+
+DECK_TEST(ChordNeverReachesHost)
+{
+    // the page keys are the chord, in the compiled-in keymap & the generated profiles alike
+    CHECK_EQ(profileChord, (1u << PAGE_PREV) | (1u << PAGE_NEXT));
+
+    // held: the profile switches, and nothing the host sees was ever down
+    DeckHost::Run(200000);
+    DeckSketch::Reports().clear();
+    switchFrom = DeckCommon::Profile->Slot();
+    Chord(PROFILE_CHORD_HOLD_MS + 50);
+    CHECK(DeckHost::RunUntil(SwitchedAway, 5000000));
+    for(const Adafruit_USBD_HID::Report_t &report : DeckSketch::Reports())
+        CHECK(!AnyKey(report));
+
+    // tapped together, or let go early: only the page keys' own flips, no switch
+    DeckHost::Run(200000);
+    switchFrom = DeckCommon::Profile->Slot();
+    Chord(50);
+    DeckHost::Run(PROFILE_CHORD_HOLD_MS * 2000ULL);
+    Chord(PROFILE_CHORD_HOLD_MS - 100);
+    DeckHost::Run(PROFILE_CHORD_HOLD_MS * 2000ULL);
+    CHECK_EQ(DeckCommon::Profile->Slot(), switchFrom);
+
+    // nor with a key cell held alongside, which does go to the host as usual
+    DeckSketch::Reports().clear();
+    DeckSketch::Press(0);
+    DeckHost::Run(50000);
+    Chord(PROFILE_CHORD_HOLD_MS + 50);
+    DeckSketch::Release(0);
+    DeckHost::Run(PROFILE_CHORD_HOLD_MS * 2000ULL);
+    CHECK_EQ(DeckCommon::Profile->Slot(), switchFrom);
+    CHECK(!DeckSketch::Reports().empty());
+}
@@ -0,0 +1,94 @@
+/*!
+ * @file ScrollTest.cpp
+ * @brief Idle banner scrolling: only the banner's pages go out while it slides, SSD1306 rotates a mirrored banner on
+ * its own for a handful of command bytes, and the bus is left at the driver's clock afterwards.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+
+// one slide and the rest before the next, lined up with when the banner's drawn
+#define SCROLL_CYCLE_MS (OLED_SCROLL_INTERVAL + OLED_SCROLL_TIME)
+#define CYCLES 2
+
+// a whole frame over I2C: every page, in transfers of at most OLED_WIRE_MAX
+#define FULL_FRAME_BYTES (SCREEN_HEIGHT / 8 * (SCREEN_WIDTH + SCREEN_WIDTH / (OLED_WIRE_MAX - 1) + 1))
+
+static unsigned long perSecond[2];
+
+// the main display swapped for another controller, showing a page banner or just a title with nothing to slide to
+static void DisplayAs(const Adafruit_MultiDisplay::ScreenType_e &type, const bool &title)
+{
+    OLED.Begin(DISP_SCL, DISP_SDA, type);
+    if(title) OLED.TopPanelUpdate("PicoDeck", DeckDisplay::Align_Center);
+    DeckHost::Run(50000);
+}
+
+// I2C bytes a second over a couple of slides, with nothing pressed
+static unsigned long IdleBytes()
+{
+    const unsigned long bytes = Wire1.bytes;
+    DeckHost::Run(CYCLES * SCROLL_CYCLE_MS * 1000ULL);
+    return (Wire1.bytes - bytes) * 1000 / (CYCLES * SCROLL_CYCLE_MS);
+}
+
+DECK_TEST(SoftwareSlidePushesBannerOnly)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_FirstFrame); }, 1000000));
+
+    // SH1106 can't rotate on its own, so the slide's drawn a frame at a time...
+    DisplayAs(Adafruit_MultiDisplay::I2C_SH1106, true);
+    CHECK(!OLED.display->hwScrollSupported());
+    perSecond[0] = IdleBytes();
+
+    // ...but only the banner's two pages of each frame go out, not the whole screen
+    const unsigned long slideFrames = OLED_SCROLL_TIME / OLED_IDLE_INTERVAL;
+    const unsigned long wholeScreens = (unsigned long)slideFrames * FULL_FRAME_BYTES * 1000 / SCROLL_CYCLE_MS;
+    CHECK(perSecond[0] > 0);
+    CHECK(perSecond[0] < wholeScreens / 3);
+    CHECK_EQ(Wire1.clock, OLED_I2C_RATE_AFTER);
+}
+
+DECK_TEST(HardwareScrollOnSSD1306)
+{
+    DisplayAs(Adafruit_MultiDisplay::I2C_SSD1306, true);
+    CHECK(OLED.display->hwScrollSupported());
+    const HostOLED &controller = OLED.display->display1306->controller;
+
+    // the controller does the stepping: a few commands to start it & stop it, and a banner redraw each slide
+    CHECK(DeckHost::RunUntil([]() { return OLED.display->display1306->controller.scrolling; }, SCROLL_CYCLE_MS * 1000));
+    CHECK(DeckHost::RunUntil([]() { return !OLED.display->display1306->controller.scrolling; }, SCROLL_CYCLE_MS * 1000));
+    perSecond[1] = IdleBytes();
+    printf("    idle banner: %lu I2C bytes/s drawn a frame at a time, %lu bytes/s scrolled by the controller\n",
+           perSecond[0], perSecond[1]);
+    CHECK(perSecond[1] * 10 < perSecond[0]);
+
+    // anything drawn stops the rotation first, so RAM's never written under it
+    CHECK(DeckHost::RunUntil([]() { return OLED.display->display1306->controller.scrolling; }, SCROLL_CYCLE_MS * 1000));
+    DeckSketch::Press(0);
+    DeckHost::Run(50000);
+    CHECK(!controller.scrolling);
+    DeckSketch::Release(0);
+    DeckHost::Run(50000);
+    CHECK(!controller.scrolling);
+
+    // and it's the banner's rest, counted from the press, that brings it back
+    const uint64_t released = DeckHost::now;
+    CHECK(DeckHost::RunUntil([]() { return OLED.display->display1306->controller.scrolling; }, SCROLL_CYCLE_MS * 1000));
+    CHECK(DeckHost::now - released >= (OLED_SCROLL_INTERVAL - 100) * 1000ULL);
+}
+
+DECK_TEST(PageBannerSlidesOnSSD1306)
+{
+    // a page banner has somewhere to slide to, so it's drawn even where the controller could rotate it,
+    // with its partial pushes back down to the driver's clock afterwards
+    DisplayAs(Adafruit_MultiDisplay::I2C_SSD1306, false);
+    const unsigned long bytes = IdleBytes();
+    CHECK(!OLED.display->display1306->controller.scrolling);
+    CHECK(bytes > perSecond[1] * 10);
+    CHECK_EQ(Wire1.clock, OLED_I2C_RATE_AFTER);
+}
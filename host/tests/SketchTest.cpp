@@ -0,0 +1,299 @@
+/*!
+ * @file SketchTest.cpp
+ * @brief Smoke test: boots the whole sketch on the host, presses a key, and checks it reaches USB and the display.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckStats.h"
+#include "TinyUSB_Devices.h"
+
+static uint8_t glass[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+
+static bool GlassLit()
+{
+    DeckSketch::Glass(glass);
+    for(const uint8_t &b : glass)
+        if(b) return true;
+    return false;
+}
+
+DECK_TEST(BootsBothCores)
+{
+    DeckHost::Boot();
+    CHECK(DeckBoot::Reached(DeckBoot::Boot_InputReady));
+
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_FirstFrame); }, 1000000));
+    CHECK(OLED.display != nullptr);
+
+    // the first frame made it all the way to the controller: banner & key grid
+    DeckHost::Run(100000);
+    CHECK(GlassLit());
+}
+
+DECK_TEST(KeyPressReachesHostAndDisplay)
+{
+    DeckHost::Run(100000);
+    DeckSketch::Reports().clear();
+    uint8_t before[sizeof(glass)];
+    DeckSketch::Glass(before);
+
+    // a held key settles and goes out within a couple of report intervals, even though its pin edge only woke Core0 once
+    DeckSketch::Press(0);
+    CHECK(DeckHost::RunUntil([]() { return !DeckSketch::Reports().empty(); }, 3000));
+
+    // page 1's first key is Right Alt + F13
+    CHECK(!DeckSketch::Reports().empty());
+    if(!DeckSketch::Reports().empty()) {
+        const Adafruit_USBD_HID::Report_t &report = DeckSketch::Reports().back();
+        CHECK_EQ(report.id, 1);
+        CHECK_EQ(report.data.size(), 8);
+        CHECK_EQ(report.data[0], 0x40);
+        CHECK_EQ(report.data[2], 0x68);
+    }
+
+    // the pressed key's cell is drawn inverted
+    DeckHost::Run(100000);
+    DeckSketch::Glass(glass);
+    CHECK(memcmp(before, glass, sizeof(glass)) != 0);
+
+    DeckSketch::Reports().clear();
+    DeckSketch::Release(0);
+    CHECK(DeckHost::RunUntil([]() { return !DeckSketch::Reports().empty(); }, 200000));
+    if(!DeckSketch::Reports().empty()) {
+        const Adafruit_USBD_HID::Report_t &report = DeckSketch::Reports().back();
+        CHECK_EQ(report.data[0], 0);
+        CHECK_EQ(report.data[2], 0);
+    }
+
+    // and back to how it was
+    DeckHost::Run(100000);
+    DeckSketch::Glass(glass);
+    CHECK(memcmp(before, glass, sizeof(glass)) == 0);
+}
+
+DECK_TEST(ConsoleAnswers)
+{
+    Serial.Take();
+    Serial.Type("boot\n");
+    DeckHost::Run(50000);
+    const std::string out = Serial.Take();
+    CHECK(out.find("first frame") != std::string::npos);
+    CHECK(out.find("first report") != std::string::npos);
+}
+
+static uint64_t togglesBefore;
+
+DECK_TEST(IconToggleSavedFromCore0)
+{
+    // page 1's eighth key has a two-state icon; Core1 flips it on screen, Core0 flips & saves the state
+    const uint64_t bit = 1ULL << (7 * PREFS_TOGGLE_PAGES + 0);
+    CHECK_EQ(DeckCommon::Prefs->curPage, 0);
+    togglesBefore = DeckCommon::Prefs->keyToggles;
+
+    DeckSketch::Press(7);
+    DeckHost::Run(20000);
+    DeckSketch::Release(7);
+    CHECK(DeckHost::RunUntil([]() { return DeckCommon::Prefs->keyToggles != togglesBefore; }, 100000));
+    CHECK_EQ(DeckCommon::Prefs->keyToggles, togglesBefore ^ bit);
+    CHECK(!OLED.togglesPending[0]);
+
+    // autosaved once things have been quiet for a second
+    DeckHost::Run(1500000);
+    DeckPrefs saved;
+    CHECK_EQ(saved.keyToggles, togglesBefore ^ bit);
+}
+
+static void (*sketchPark)() = nullptr;
+static int flashWrites = 0, unparkedWrites = 0;
+
+static void ParkChecked()
+{
+    sketchPark();
+    ++flashWrites;
+    // Core1 said it's parked, and has nothing left on the display's bus
+    if(!core1Parked || !OLED.display->flushDone()) ++unparkedWrites;
+}
+
+DECK_TEST(FlashOnlyWrittenWithCore1Parked)
+{
+    sketchPark = deckFlashPark;
+    deckFlashPark = ParkChecked;
+
+    // once round the journal, so it compacts and the full sector gets its erase later on
+    const uint32_t erases = DeckStats::Counter(DeckStats::Count_PrefsErases);
+    for(int n = 0; n <= (int)PREFS_JOURNAL_RECORDS; ++n) {
+        DeckCommon::Prefs->keyToggles ^= 1ULL << 63;
+        Serial.Type("save\n");
+        DeckHost::Run(20000);
+    }
+    CHECK(DeckHost::RunUntil([]() { return !DeckCommon::Prefs->SpareDirty(); }, 1000000));
+    CHECK(DeckStats::Counter(DeckStats::Count_PrefsErases) > erases);
+
+    CHECK(flashWrites > (int)PREFS_JOURNAL_RECORDS);
+    CHECK_EQ(unparkedWrites, 0);
+
+    // and let go afterwards, frames & presses carrying on as before
+    DeckHost::Run(100000);
+    CHECK(!core1Parked);
+    DeckSketch::Reports().clear();
+    DeckSketch::Press(0);
+    CHECK(DeckHost::RunUntil([]() { return !DeckSketch::Reports().empty(); }, 3000));
+    DeckSketch::Release(0);
+    DeckHost::Run(100000);
+    deckFlashPark = sketchPark;
+}
+
+extern volatile uint32_t sleepCount[2];
+
+DECK_TEST(Core1SleepsThroughIdle)
+{
+    // between the banner's slides there's nothing animating, so Core1 only wakes for the sleep cap, not every frame
+    CHECK(DeckHost::RunUntil([]() { return OLED.IdleWait(millis()) > 1000; }, 10000000));
+    const uint32_t sleeps = sleepCount[1];
+    DeckHost::Run(2000000);
+    const uint32_t perSecond = (sleepCount[1] - sleeps) / 2;
+    printf("    Core1 idle: %u wakeups/s\n", perSecond);
+    // (SLEEP_MAX_MS is 100ms)
+    CHECK(perSecond <= 11);
+}
+
+extern Adafruit_USBD_HID usbHid;
+
+// a stage's histogram, read back the way a host does
+static DeckStats::Page_t StagePage(const DeckStats::Stage_e &stage)
+{
+    uint8_t report[1 + HID_FEATURE_SIZE] = { 2, (uint8_t)(1 + stage) };
+    usbHid.HostSetReport(2, HID_REPORT_TYPE_FEATURE, report, sizeof(report));
+    usbHid.HostGetReport(2, HID_REPORT_TYPE_FEATURE, report, HID_FEATURE_SIZE);
+    DeckStats::Page_t page;
+    memcpy(&page, report, sizeof(page));
+    return page;
+}
+
+// reports with the first key's F13 down, counting each press once however many reports it's held through
+static int KeyPresses()
+{
+    int presses = 0;
+    bool down = false;
+    for(const Adafruit_USBD_HID::Report_t &report : DeckSketch::Reports()) {
+        const bool now = report.data[2] == 0x68;
+        presses += now && !down;
+        down = now;
+    }
+    return presses;
+}
+
+static bool Resumed() { return !TinyUSBDevice.suspended(); }
+
+DECK_TEST(KeyWakesSuspendedHost)
+{
+    DeckHost::Run(100000);
+    const DeckStats::Page_t before = StagePage(DeckStats::Stage_WakeReport);
+
+    // a tap that's over before the host's back: it asks for the bus, and nothing goes out meanwhile
+    TinyUSBDevice.suspendedState = true;
+    DeckHost::Run(50000);
+    DeckSketch::Reports().clear();
+    const unsigned long wakeups = TinyUSBDevice.wakeups;
+    DeckSketch::Press(0);
+    DeckHost::Run(5000);
+    CHECK_EQ(TinyUSBDevice.wakeups, wakeups + 1);
+    DeckSketch::Release(0);
+    CHECK(DeckHost::RunUntil(Resumed, TinyUSBDevice.resumeTime * 2));
+    CHECK(DeckSketch::Reports().empty());
+
+    // once it's back the press is replayed, then let go, and just the once
+    DeckHost::Run(100000);
+    CHECK_EQ(KeyPresses(), 1);
+    CHECK(!DeckSketch::Reports().empty() && DeckSketch::Reports().back().data[2] == 0);
+    CHECK_EQ(TinyUSBDevice.wakeups, wakeups + 1);
+
+    // timed from the press to the report that carried it, which is mostly the host resuming
+    const DeckStats::Page_t after = StagePage(DeckStats::Stage_WakeReport);
+    CHECK_EQ(after.count, before.count + 1);
+    CHECK(after.max >= TinyUSBDevice.resumeTime && after.max < TinyUSBDevice.resumeTime + 10000);
+
+    // held through the resume instead: the one press goes out as the key's still down, then its release
+    TinyUSBDevice.suspendedState = true;
+    DeckHost::Run(50000);
+    DeckSketch::Reports().clear();
+    DeckSketch::Press(0);
+    CHECK(DeckHost::RunUntil(Resumed, TinyUSBDevice.resumeTime * 2));
+    CHECK(DeckSketch::Reports().empty());
+    DeckHost::Run(100000);
+    DeckSketch::Release(0);
+    DeckHost::Run(100000);
+    CHECK_EQ(KeyPresses(), 1);
+    CHECK_EQ(DeckSketch::Reports().back().data[2], 0);
+    CHECK_EQ(StagePage(DeckStats::Stage_WakeReport).count, before.count + 2);
+
+    // a host that hasn't allowed remote wakeup isn't woken, and a tap it slept through isn't sent once it's back
+    TinyUSBDevice.suspendedState = true;
+    TinyUSBDevice.wakeupAllowed = false;
+    DeckHost::Run(50000);
+    DeckSketch::Reports().clear();
+    DeckSketch::Press(0);
+    DeckHost::Run(50000);
+    DeckSketch::Release(0);
+    DeckHost::Run(50000);
+    CHECK_EQ(TinyUSBDevice.wakeups, wakeups + 2);
+    TinyUSBDevice.suspendedState = false;
+    TinyUSBDevice.wakeupAllowed = true;
+    DeckHost::Run(100000);
+    CHECK_EQ(KeyPresses(), 0);
+}
+
+extern volatile uint32_t loopCount[2];
+
+typedef struct {
+    unsigned long bytes;
+    unsigned long passes;
+} Traffic_t;
+
+// tier being waited for, where RunUntil()'s check can see it
+static DeckGovernor::Tier_e waited;
+
+// display bytes & loop passes (both cores) a second, over a couple of the banner's slide cycles
+static Traffic_t TrafficIn(const DeckGovernor::Tier_e &tier)
+{
+    waited = tier;
+    CHECK(DeckHost::RunUntil([]() { return governor.tier == waited; }, 2 * OLED_TIMEOUT * 1000ULL));
+    // settled into it: the LEDs have had long enough to start breathing, whichever tier it is
+    DeckHost::Run((PIXELS_BREATHE_AFTER + 1000) * 1000ULL);
+
+    const unsigned long seconds = 2 * (OLED_SCROLL_INTERVAL + OLED_SCROLL_TIME) / 1000;
+    const unsigned long bytes = Wire1.bytes, passes = loopCount[0] + loopCount[1];
+    DeckHost::Run(seconds * 1000000ULL);
+    CHECK_EQ(governor.tier, waited);
+    return { (Wire1.bytes - bytes) / seconds, (loopCount[0] + loopCount[1] - passes) / seconds };
+}
+
+DECK_TEST(TiersWindDown)
+{
+    // a key edge puts it back in active, then it's left alone all the way down to off
+    DeckSketch::Press(0);
+    DeckHost::Run(100000);
+    DeckSketch::Release(0);
+    CHECK(DeckHost::RunUntil([]() { return governor.tier == DeckGovernor::Tier_Active; }, 100000));
+
+    Traffic_t traffic[DeckGovernor::GOVERNOR_TIERS];
+    for(int t = 0; t < DeckGovernor::GOVERNOR_TIERS; ++t) {
+        traffic[t] = TrafficIn((DeckGovernor::Tier_e)t);
+        printf("    %-7s %6lu display bytes/s, %6lu loop passes/s\n", DeckGovernor::Tiers[t].name, traffic[t].bytes, traffic[t].passes);
+    }
+
+    // each tier costs less than the one before, in bus traffic & in how often the cores run
+    for(int t = 1; t < DeckGovernor::GOVERNOR_TIERS; ++t) {
+        CHECK(traffic[t].bytes <= traffic[t-1].bytes);
+        CHECK(traffic[t].passes < traffic[t-1].passes);
+    }
+    CHECK(traffic[DeckGovernor::Tier_Idle].bytes < traffic[DeckGovernor::Tier_Active].bytes);
+    CHECK_EQ(traffic[DeckGovernor::Tier_Off].bytes, 0);
+}
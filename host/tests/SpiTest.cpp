@@ -0,0 +1,123 @@
+/*!
+ * @file SpiTest.cpp
+ * @brief SPI OLED variants: pages go out as a command/data pair each way the controller addresses them, with D/C
+ * low for the window and high for the pixels, CS held until the push is waited out, and the glass ends up right.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+#include <vector>
+
+#include "DeckCheck.h"
+#include "PicoDeckDisplay.h"
+
+#define TEST_DC  22
+#define TEST_RST 26
+#define TEST_CS  17
+
+typedef SPIClassRP2040::Transfer_t Transfer_t;
+
+// something different in every byte, so a page sent from the wrong place shows up
+static void Pattern(uint8_t *buf)
+{
+    for(int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT / 8; ++i) buf[i] = (uint8_t)(i * 7 + (i >> 7));
+}
+
+static bool IsCommand(const Transfer_t &transfer, const std::vector<uint8_t> &bytes)
+{
+    return transfer.cs == TEST_CS && !transfer.dc && transfer.bytes == bytes;
+}
+
+static bool IsData(const Transfer_t &transfer, const uint8_t *buf, const int &page, const int &pages)
+{
+    return transfer.cs == TEST_CS && transfer.dc &&
+           transfer.bytes == std::vector<uint8_t>(buf + page * SCREEN_WIDTH, buf + (page + pages) * SCREEN_WIDTH);
+}
+
+static bool GlassMatches(const HostOLED &controller, const uint8_t *buf)
+{
+    uint8_t glass[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+    controller.Glass(glass);
+    return !memcmp(glass, buf, sizeof(glass));
+}
+
+DECK_TEST(SSD1306OneWindowOneTransfer)
+{
+    Adafruit_MultiDisplay display(&SPI1, Adafruit_MultiDisplay::SPI_SSD1306, TEST_DC, TEST_RST, TEST_CS);
+    CHECK(display.begin());
+    CHECK_EQ(display.spiRate, OLED_SPI_RATE);
+
+    uint8_t *buf = display.getBuffer();
+    Pattern(buf);
+    SPI1.captured.clear();
+    display.displayPages(2, 4);
+
+    // the whole range is one window, then one run of data straight out of the render buffer
+    CHECK_EQ(SPI1.captured.size(), 2);
+    CHECK(IsCommand(SPI1.captured[0], { SSD1306_PAGEADDR, 2, 4, SSD1306_COLUMNADDR, 0, SCREEN_WIDTH - 1 }));
+    CHECK(IsData(SPI1.captured[1], buf, 2, 3));
+    CHECK_EQ(SPI1.settings.clock, OLED_SPI_RATE);
+
+    // still selected (& the transaction held) until something waits the push out
+    CHECK(SPI1.inTransaction);
+    CHECK_EQ(digitalRead(TEST_CS), LOW);
+    display.flushWait();
+    CHECK(!SPI1.inTransaction);
+    CHECK_EQ(digitalRead(TEST_CS), HIGH);
+
+    // a whole frame lands the same as the drivers' own display() would
+    display.display();
+    display.flushWait();
+    CHECK(GlassMatches(display.display1306->controller, buf));
+}
+
+DECK_TEST(SH110XPageAtATime)
+{
+    Adafruit_MultiDisplay display(&SPI1, Adafruit_MultiDisplay::SPI_SH1106, TEST_DC, TEST_RST, TEST_CS, 0, 0, 8000000);
+    CHECK(display.begin());
+    CHECK_EQ(display.spiRate, 8000000);
+
+    uint8_t *buf = display.getBuffer();
+    Pattern(buf);
+    SPI1.captured.clear();
+    display.displayPages(1, 3);
+
+    // page addressing only: each page gets its own address, with the glass two columns into SH1106's RAM
+    CHECK_EQ(SPI1.captured.size(), 6);
+    for(int page = 1; page <= 3; ++page) {
+        const Transfer_t *pair = &SPI1.captured[2 * (page - 1)];
+        CHECK(IsCommand(pair[0], { (uint8_t)(0xB0 + page), 0x10, 0x02 }));
+        CHECK(IsData(pair[1], buf, page, 1));
+    }
+    CHECK_EQ(SPI1.settings.clock, 8000000);
+    display.flushWait();
+    CHECK_EQ(digitalRead(TEST_CS), HIGH);
+
+    display.display();
+    display.flushWait();
+    CHECK(GlassMatches(display.display1106->controller, buf));
+}
+
+DECK_TEST(SH1107FullFrame)
+{
+    Adafruit_MultiDisplay display(&SPI1, Adafruit_MultiDisplay::SPI_SH1107, TEST_DC, TEST_RST, TEST_CS);
+    CHECK(display.begin());
+
+    uint8_t *buf = display.getBuffer();
+    Pattern(buf);
+    SPI1.captured.clear();
+    display.display();
+    display.flushWait();
+
+    CHECK_EQ(SPI1.captured.size(), 2 * SCREEN_HEIGHT / 8);
+    for(int page = 0; page < SCREEN_HEIGHT / 8; ++page) {
+        CHECK(IsCommand(SPI1.captured[2 * page], { (uint8_t)(0xB0 + page), 0x10, 0x00 }));
+        CHECK(IsData(SPI1.captured[2 * page + 1], buf, page, 1));
+    }
+    CHECK(GlassMatches(display.display1107->controller, buf));
+
+    // none of it went over I2C at the drivers' 1MHz
+    CHECK_EQ(display.wire, nullptr);
+}
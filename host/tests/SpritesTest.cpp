@@ -0,0 +1,108 @@
+/*!
+ * @file SpritesTest.cpp
+ * @brief Animated key icons: more changed rows than a frame's budget are held over to the next frame, not dropped.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string>
+#include <vector>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckStats.h"
+#include "TinyUSB_Devices.h"
+
+static uint8_t glass[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+
+// em_blink's eyes-closed frame lights a pixel on its seventh row that the open one doesn't
+static bool EyesClosed(const int &cell)
+{
+    const int x = 32 * (cell % OLED_KEYS_COLUMNS) + 10, y = 16 + 16 * (cell / OLED_KEYS_COLUMNS) + 6;
+    return glass[(y / 8) * SCREEN_WIDTH + x] & (1 << (y % 8));
+}
+
+static int blinking;
+
+static int Closed()
+{
+    DeckSketch::Glass(glass);
+    int closed = 0;
+    for(int cell = 0; cell < blinking; ++cell) closed += EyesClosed(cell);
+    return closed;
+}
+
+// a profile with a page of 12 blinking keys, and one of 9
+static std::vector<uint8_t> BlinkProfile()
+{
+    const int counts[] = {UI_KEY_CELLS, 9};
+    std::vector<DeckProfile::Page_t> pages(2);
+    std::vector<DeckProfile::Binding_t> bindings;
+    DeckProfile::Icon_t icon = {};
+    strncpy(icon.name, "em_blink", sizeof(icon.name)-1);
+    for(int page = 0; page < 2; ++page) {
+        snprintf(pages[page].name, sizeof(pages[page].name), "Blink %d", counts[page]);
+        for(int i = 0, b = 0; b < (int)ButtonCount; ++b) {
+            if(DeckCommon::PageKey(nullptr, b)) bindings.push_back({ DeckCommon::KeyCode(nullptr, b, 0), PROFILE_NO_ICON, 0 });
+            else if(i++ < counts[page]) bindings.push_back({ (uint16_t)(KEY_F13 + i), 0, 0 });
+            else bindings.push_back({ 0, PROFILE_NO_ICON, 0 });
+        }
+    }
+
+    DeckProfile::Header_t header = { PROFILE_MAGIC, PROFILE_VERSION, sizeof(DeckProfile::Header_t), 0, 0,
+                                     (uint16_t)pages.size(), (uint8_t)ButtonCount, 0, 1, 0, 0, 0, 0 };
+    header.pagesOffset = sizeof(header);
+    header.bindingsOffset = header.pagesOffset + pages.size() * sizeof(DeckProfile::Page_t);
+    header.iconsOffset = header.bindingsOffset + bindings.size() * sizeof(DeckProfile::Binding_t);
+    header.size = header.iconsOffset + sizeof(icon);
+
+    std::vector<uint8_t> blob(header.size);
+    memcpy(blob.data() + header.pagesOffset, pages.data(), pages.size() * sizeof(DeckProfile::Page_t));
+    memcpy(blob.data() + header.bindingsOffset, bindings.data(), bindings.size() * sizeof(DeckProfile::Binding_t));
+    memcpy(blob.data() + header.iconsOffset, &icon, sizeof(icon));
+    header.checksum = DeckProfile::Checksum(blob.data() + sizeof(header), header.size - sizeof(header));
+    memcpy(blob.data(), &header, sizeof(header));
+    return blob;
+}
+
+static bool Switched() { return DeckCommon::Profile->Slot() == 1 && DeckCommon::Profile->Loaded(); }
+
+DECK_TEST(OverBudgetHeldToNextFrame)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+
+    const std::vector<uint8_t> blob = BlinkProfile();
+    CHECK(DeckProfile::Validate(blob.data(), blob.size(), ButtonCount) != nullptr);
+    Serial.Take();
+    Serial.Type(("profile load " + std::to_string(blob.size()) + " 1\n").c_str());
+    DeckHost::Run(50000);
+    Serial.Send(blob);
+    CHECK(DeckHost::RunUntil(Switched, 5000000));
+    CHECK_EQ(DeckCommon::Prefs->curPage, 0);
+
+    // 12 keys' 5 changed rows a blink is more than a frame's worth, so some wait for the next one...
+    blinking = UI_KEY_CELLS;
+    DeckHost::Run(1000000);
+    CHECK_EQ(Closed(), 0);
+    const uint32_t deferred = DeckStats::Counter(DeckStats::Count_SpritesDeferred);
+    CHECK(DeckHost::RunUntil([]() { return Closed() > 0; }, 3000000));
+    CHECK(DeckStats::Counter(DeckStats::Count_SpritesDeferred) > deferred);
+
+    // ...and still blink with the rest, a frame later rather than a whole loop
+    CHECK(DeckHost::RunUntil([]() { return Closed() == blinking; }, 3 * OLED_IDLE_INTERVAL * 1000));
+    CHECK(DeckHost::RunUntil([]() { return Closed() == 0; }, 300000));
+
+    // 9 keys' worth fits in one frame
+    DeckSketch::Press(13);
+    DeckHost::Run(30000);
+    DeckSketch::Release(13);
+    DeckHost::Run(500000);
+    CHECK_EQ(DeckCommon::Prefs->curPage, 1);
+    blinking = 9;
+    const uint32_t fits = DeckStats::Counter(DeckStats::Count_SpritesDeferred);
+    CHECK(DeckHost::RunUntil([]() { return Closed() == blinking; }, 3000000));
+    CHECK(DeckHost::RunUntil([]() { return Closed() == 0; }, 300000));
+    CHECK_EQ(DeckStats::Counter(DeckStats::Count_SpritesDeferred), fits);
+}
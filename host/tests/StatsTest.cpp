@@ -0,0 +1,73 @@
+/*!
+ * @file StatsTest.cpp
+ * @brief Stats feature report: picking pages by SET_REPORT, however the report ID arrives, and reading them back.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+#include "PicoDeckStats.h"
+#include "TinyUSB_Devices.h"
+
+extern Adafruit_USBD_HID usbHid;
+
+// report ID of the stats feature report
+#define STATS_RID 2
+
+static uint8_t ReadPage()
+{
+    uint8_t report[HID_FEATURE_SIZE] = {};
+    CHECK_EQ(usbHid.HostGetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, report, sizeof(report)), HID_FEATURE_SIZE);
+    return report[0];
+}
+
+DECK_TEST(PagesPickedBySetReport)
+{
+    DeckHost::Boot();
+
+    // a full-size report with its ID in front (TinyUSB takes it off), for every page including the one equal to the ID
+    for(uint8_t page = 0; page <= DeckStats::STATS_STAGES; ++page) {
+        uint8_t report[1 + HID_FEATURE_SIZE] = { STATS_RID, page };
+        usbHid.HostSetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, report, sizeof(report));
+        CHECK_EQ(ReadPage(), page);
+    }
+
+    // just the page byte, as hidraw lets a host send
+    const uint8_t shortReport[] = { STATS_RID, STATS_RID };
+    usbHid.HostSetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, shortReport, sizeof(shortReport));
+    CHECK_EQ(ReadPage(), STATS_RID);
+
+    // other reports' IDs are left alone
+    const uint8_t keyboard[] = { 1, 5 };
+    usbHid.HostSetReport(1, HID_REPORT_TYPE_FEATURE, keyboard, sizeof(keyboard));
+    CHECK_EQ(ReadPage(), STATS_RID);
+}
+
+DECK_TEST(StagePageDecodes)
+{
+    DeckStats::Sample(DeckStats::Stage_Save, 0);
+    DeckStats::Sample(DeckStats::Stage_Save, 3);
+    DeckStats::Sample(DeckStats::Stage_Save, 700);
+
+    uint8_t request[1 + HID_FEATURE_SIZE] = { STATS_RID, STATS_PAGE_RESET };
+    usbHid.HostSetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, request, sizeof(request));
+    DeckStats::Sample(DeckStats::Stage_Save, 3);
+    DeckStats::Sample(DeckStats::Stage_Save, 700);
+
+    request[1] = 1 + DeckStats::Stage_Save;
+    usbHid.HostSetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, request, sizeof(request));
+    uint8_t report[HID_FEATURE_SIZE] = {};
+    usbHid.HostGetReport(STATS_RID, HID_REPORT_TYPE_FEATURE, report, sizeof(report));
+    DeckStats::Page_t page;
+    memcpy(&page, report, sizeof(page));
+    CHECK_EQ(page.stage, DeckStats::Stage_Save);
+    CHECK_EQ(page.count, 2);
+    CHECK_EQ(page.sum, 703);
+    CHECK_EQ(page.max, 700);
+    // 3 us is in [2, 4), 700 in [512, 1024)
+    CHECK_EQ(page.buckets[2], 1);
+    CHECK_EQ(page.buckets[10], 1);
+    CHECK_EQ(page.buckets[0], 0);
+}
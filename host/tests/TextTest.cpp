@@ -0,0 +1,102 @@
+/*!
+ * @file TextTest.cpp
+ * @brief Glyph atlas text: lays out, measures and clips exactly as Adafruit GFX draws the same Sega7x7 font.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+
+#include "DeckCheck.h"
+#include "PicoDeckText.h"
+#include "Adafruit_GFX.h"
+
+#define CANVAS_W 40
+#define CANVAS_H 12
+// a key box, which labels have to fit in
+#define KEY_BOX_W 31
+
+// what GFX draws for a string, the slow way the atlas replaced
+static void GfxDraw(GFXcanvas1 &canvas, const int &x, const int &baseline, const char *str)
+{
+    canvas.fillScreen(0);
+    canvas.setFont(&Sega7x7);
+    canvas.setTextWrap(false);
+    canvas.setTextColor(1);
+    canvas.setCursor(x, baseline);
+    canvas.print(str);
+}
+
+static bool Matches(const GFXcanvas1 &canvas, const uint8_t *buf, const int &stride)
+{
+    for(int y = 0; y < canvas.height(); ++y)
+        for(int x = 0; x < canvas.width(); ++x)
+            if(canvas.getPixel(x, y) != (bool)(buf[y * stride + (x >> 3)] & (0x80 >> (x & 7)))) return false;
+    return true;
+}
+
+DECK_TEST(BlitMatchesGfx)
+{
+    GFXcanvas1 canvas(CANVAS_W, CANVAS_H);
+    const int stride = (CANVAS_W + 7) / 8;
+    uint8_t buf[stride * CANVAS_H];
+
+    // every glyph, at every bit offset within a byte, plus clipping off each edge
+    const char *strings[] = {" !\"#$%&'()*+,-./0123", "456789:;<=>?@ABCDEFG", "HIJKLMNOPQRSTUVWXYZ[",
+                             "\\]^_`abcdefghijklmno", "pqrstuvwxyz{|}~", "Page 1", ""};
+    for(const char *str : strings) {
+        for(int x = -12; x < 12; ++x) {
+            for(const int baseline : {7, 10, 3, 14}) {
+                memset(buf, 0, sizeof(buf));
+                DeckText::TextBlit(buf, stride, CANVAS_H, x, baseline, str);
+                GfxDraw(canvas, x, baseline, str);
+                if(!Matches(canvas, buf, stride)) {
+                    printf("    \"%s\" at %d,%d differs\n", str, x, baseline);
+                    CHECK(false);
+                }
+            }
+        }
+    }
+}
+
+DECK_TEST(WidthMatchesGfxBounds)
+{
+    GFXcanvas1 canvas(CANVAS_W, CANVAS_H);
+    canvas.setFont(&Sega7x7);
+    canvas.setTextWrap(false);
+
+    const char *strings[] = {"A", "i", "Page 1", " lead", "trail ", "  ", "", "Avatar Actions", "{|}"};
+    for(const char *str : strings) {
+        int16_t x1, y1;
+        uint16_t w, h;
+        canvas.getTextBounds(str, 0, 7, &x1, &y1, &w, &h);
+        CHECK_EQ(DeckText::TextWidth(str), w);
+    }
+}
+
+DECK_TEST(LabelsMatchGfx)
+{
+    // key labels are laid out ahead of time in a 31px wide box
+    GFXcanvas1 canvas(KEY_BOX_W, CANVAS_H);
+    const int stride = (KEY_BOX_W + 7) / 8;
+    uint8_t buf[stride * CANVAS_H];
+
+    for(int code = 0x20; code < 0x100; ++code) {
+        const char *label = DeckText::keyStrings[code - 0x20];
+        for(const int x : {0, 4, 7}) {
+            memset(buf, 0, sizeof(buf));
+            DeckText::LabelBlit(buf, stride, CANVAS_H, x, 8, code);
+            GfxDraw(canvas, x, 8, label);
+            if(!Matches(canvas, buf, stride)) {
+                printf("    label 0x%02X \"%s\" at %d differs\n", code, label, x);
+                CHECK(false);
+            }
+        }
+    }
+
+    // nothing below the table
+    memset(buf, 0, sizeof(buf));
+    DeckText::LabelBlit(buf, stride, CANVAS_H, 0, 8, 0x1F);
+    for(const uint8_t b : buf) CHECK_EQ(b, 0);
+}
@@ -0,0 +1,259 @@
+/*!
+ * @file TftTest.cpp
+ * @brief Colour TFT tile streamer: the 1bpp layout lands on the glass scaled, centred & tinted per region, only the
+ * cells that changed are streamed (adjacent ones as one window), each strip is composed while the last one's still
+ * going out without the one in flight being touched, and what's counted as pushed is the RGB565 that was streamed.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "DeckCheck.h"
+#include "PicoDeckDisplay.h"
+
+#define TEST_DC  22
+#define TEST_RST 26
+#define TEST_CS  17
+
+#define PANEL_W 240
+#define PANEL_H 240
+
+typedef SPIClassRP2040::Transfer_t Transfer_t;
+
+/// @brief Just enough of an ST7789 to take column/row windows and the RGB565 written into them
+class HostTFT : public HostSPIDevice {
+public:
+    void Receive(const bool &data, const uint8_t *bytes, const size_t &len) override {
+        for(size_t i = 0; i < len; ++i) {
+            if(!data) Command(bytes[i]);
+            else Data(bytes[i]);
+        }
+    }
+
+    void Command(const uint8_t &byte) {
+        cmd = byte;
+        argCount = 0;
+        if(cmd == 0x2C) {
+            x = x0;
+            y = y0;
+            half = false;
+            ++windows;
+        }
+    }
+
+    void Data(const uint8_t &byte) {
+        if(cmd == 0x2A || cmd == 0x2B) {
+            if(argCount < 4) args[argCount++] = byte;
+            if(argCount == 4) {
+                if(cmd == 0x2A) { x0 = (args[0] << 8) | args[1]; x1 = (args[2] << 8) | args[3]; }
+                else { y0 = (args[0] << 8) | args[1]; y1 = (args[2] << 8) | args[3]; }
+            }
+        } else if(cmd == 0x2C) {
+            ++pixelBytes;
+            // MSB first, so it's RGB565 as it was before the streamer swapped it
+            if(!half) high = byte;
+            else if(y <= y1 && x < PANEL_W && y < PANEL_H) ram[y][x] = (high << 8) | byte;
+            if(half && ++x > x1) { x = x0; ++y; }
+            half = !half;
+        }
+    }
+
+    uint16_t ram[PANEL_H][PANEL_W];
+    int x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+    unsigned long pixelBytes = 0;
+    unsigned long windows = 0;
+
+private:
+    uint8_t cmd = 0;
+    uint8_t args[4];
+    int argCount = 0;
+    int x = 0, y = 0;
+    bool half = false;
+    uint8_t high = 0;
+};
+
+static HostTFT panel;
+static Adafruit_MultiDisplay *display;
+
+// 8.8 fixed point scale that fits the layout on the panel, and where each logical row & column starts there
+static const uint32_t scale = std::min((PANEL_W << 8) / TFT_LOGICAL_WIDTH, (PANEL_H << 8) / TFT_LOGICAL_HEIGHT);
+static int ColumnAt(const int &lx) { return lx * scale >> 8; }
+static int RowAt(const int &ly) { return ly * scale >> 8; }
+static const int offsetX = (PANEL_W - ColumnAt(TFT_LOGICAL_WIDTH)) / 2;
+static const int offsetY = (PANEL_H - RowAt(TFT_LOGICAL_HEIGHT)) / 2;
+
+// the same pixels every run, but nothing regular enough for a strip from the wrong place to still match
+static void Pattern(const uint32_t &seed)
+{
+    uint32_t x = seed;
+    uint8_t *buf = display->getBuffer();
+    for(int i = 0; i < TFT_LOGICAL_WIDTH * TFT_LOGICAL_HEIGHT / 8; ++i) {
+        x = x * 1664525 + 1013904223;
+        buf[i] = x >> 24;
+    }
+}
+
+// each logical pixel a block of its colour, banner rows in one tint & keys in the other, black all round
+static bool GlassMatches(const uint16_t &banner, const uint16_t &keys)
+{
+    const GFXcanvas1 &canvas = display->displayTFT->canvas;
+    int mismatches = 0;
+    for(int py = 0; py < PANEL_H; ++py) {
+        for(int px = 0; px < PANEL_W; ++px) {
+            uint16_t want = 0;
+            if(px >= offsetX && px < offsetX + ColumnAt(TFT_LOGICAL_WIDTH) &&
+               py >= offsetY && py < offsetY + RowAt(TFT_LOGICAL_HEIGHT)) {
+                int lx = 0, ly = 0;
+                while(ColumnAt(lx + 1) <= px - offsetX) ++lx;
+                while(RowAt(ly + 1) <= py - offsetY) ++ly;
+                if(canvas.getPixel(lx, ly)) want = ly < 2 * TFT_TILE_HEIGHT ? banner : keys;
+            }
+            mismatches += panel.ram[py][px] != want;
+        }
+    }
+    return !mismatches;
+}
+
+// RGB565 bytes in a run of tiles in a band, as scaled onto the panel
+static uint32_t RunBytes(const int &band, const int &firstTile, const int &lastTile)
+{
+    return (ColumnAt((lastTile + 1) * TFT_TILE_WIDTH) - ColumnAt(firstTile * TFT_TILE_WIDTH)) *
+           (RowAt((band + 1) * TFT_TILE_HEIGHT) - RowAt(band * TFT_TILE_HEIGHT)) * 2;
+}
+
+// a logical pixel flipped, dirtying just the tile it's in
+static void Flip(const int &lx, const int &ly)
+{
+    GFXcanvas1 &canvas = display->displayTFT->canvas;
+    canvas.drawPixel(lx, ly, !canvas.getPixel(lx, ly));
+}
+
+static bool IsWindow(const Transfer_t *transfer, const int &x0, const int &y0, const int &x1, const int &y1)
+{
+    const std::vector<uint8_t> cols = { (uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1 };
+    const std::vector<uint8_t> rows = { (uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1 };
+    return !transfer[0].dc && transfer[0].bytes == std::vector<uint8_t>{ 0x2A } && transfer[1].dc && transfer[1].bytes == cols &&
+           !transfer[2].dc && transfer[2].bytes == std::vector<uint8_t>{ 0x2B } && transfer[3].dc && transfer[3].bytes == rows &&
+           !transfer[4].dc && transfer[4].bytes == std::vector<uint8_t>{ 0x2C };
+}
+
+DECK_TEST(FullFrameScaledAndTinted)
+{
+    SPI1.Attach(TEST_CS, TEST_DC, &panel);
+    display = new Adafruit_MultiDisplay(&SPI1, Adafruit_MultiDisplay::SPI_ST7789, TEST_DC, TEST_RST, TEST_CS,
+                                        PANEL_W, PANEL_H);
+    CHECK(display->begin());
+    CHECK_EQ(display->spiRate, TFT_SPI_RATE);
+
+    // the whole glass blanked once, borders included
+    CHECK_EQ(panel.pixelBytes, PANEL_W * PANEL_H * 2);
+    CHECK(GlassMatches(0, 0));
+
+    // red banner & green keys, as 0x00BBGGRR
+    display->setTint(DeckTFT::Region_Banner, 0x0000FF);
+    display->setTint(DeckTFT::Region_Keys, 0x00FF00);
+    Pattern(1);
+    panel.pixelBytes = 0;
+    panel.windows = 0;
+    display->display();
+    display->flushWait();
+
+    // every band as one window right across, and nothing but the layout's own pixels
+    CHECK_EQ(panel.windows, TFT_TILE_ROWS);
+    CHECK_EQ(display->pushedBytes, ColumnAt(TFT_LOGICAL_WIDTH) * RowAt(TFT_LOGICAL_HEIGHT) * 2);
+    CHECK_EQ(panel.pixelBytes, display->pushedBytes);
+    CHECK(GlassMatches(0xF800, 0x07E0));
+    CHECK_EQ(SPI1.settings.clock, TFT_SPI_RATE);
+    CHECK_EQ(digitalRead(TEST_CS), HIGH);
+}
+
+DECK_TEST(OnlyDirtyCellsStream)
+{
+    // nothing drawn, nothing sent
+    SPI1.captured.clear();
+    display->display();
+    display->flushWait();
+    CHECK_EQ(display->pushedBytes, 0);
+    CHECK(SPI1.captured.empty());
+
+    // one cell: a window around just that key's slice of the band, and the glass still right all over
+    Flip(70, 43);
+    display->display();
+    display->flushWait();
+    CHECK_EQ(display->pushedBytes, RunBytes(5, 2, 2));
+    CHECK(SPI1.captured.size() > 5);
+    CHECK(IsWindow(&SPI1.captured[0], offsetX + ColumnAt(64), offsetY + RowAt(40),
+                   offsetX + ColumnAt(96) - 1, offsetY + RowAt(48) - 1));
+    for(size_t i = 5; i < SPI1.captured.size(); ++i) CHECK(SPI1.captured[i].async && SPI1.captured[i].dc);
+    CHECK(GlassMatches(0xF800, 0x07E0));
+
+    // neighbouring cells go as one window, the one past the gap as another
+    panel.windows = 0;
+    Flip(5, 30);
+    Flip(40, 25);
+    Flip(100, 31);
+    display->display();
+    display->flushWait();
+    CHECK_EQ(panel.windows, 2);
+    CHECK_EQ(display->pushedBytes, RunBytes(3, 0, 1) + RunBytes(3, 3, 3));
+    CHECK(GlassMatches(0xF800, 0x07E0));
+
+    // a change outside the bands asked for waits for its own band to be pushed
+    Flip(10, 50);
+    display->displayPages(0, 1);
+    CHECK_EQ(display->pushedBytes, 0);
+    display->displayPages(6, 6);
+    display->flushWait();
+    CHECK_EQ(display->pushedBytes, RunBytes(6, 0, 0));
+    CHECK(GlassMatches(0xF800, 0x07E0));
+
+    // a tint's not in the 1bpp shadow, so its region's repainted outright, and only that region
+    panel.windows = 0;
+    display->setTint(DeckTFT::Region_Keys, 0xFF0000);
+    display->display();
+    display->flushWait();
+    CHECK_EQ(panel.windows, TFT_TILE_ROWS - 2);
+    CHECK_EQ(display->pushedBytes, ColumnAt(TFT_LOGICAL_WIDTH) * (RowAt(TFT_LOGICAL_HEIGHT) - RowAt(16)) * 2);
+    CHECK(GlassMatches(0xF800, 0x001F));
+}
+
+DECK_TEST(ComposeOverlapsDma)
+{
+    // each strip stays in flight for a few polls, and is only read from its buffer once it's done
+    SPI1.asyncPolls = 3;
+    SPI1.overruns = 0;
+    for(int frame = 0; frame < 2; ++frame) {
+        // every byte different, so every cell's dirty
+        uint8_t *buf = display->getBuffer();
+        for(int i = 0; i < TFT_LOGICAL_WIDTH * TFT_LOGICAL_HEIGHT / 8; ++i) buf[i] = ~buf[i];
+
+        SPI1.captured.clear();
+        panel.windows = 0;
+        display->display();
+
+        // the last strip's left going out, still selected, for flushWait() to see off
+        CHECK(SPI1.inTransaction);
+        CHECK_EQ(digitalRead(TEST_CS), LOW);
+        display->flushWait();
+        CHECK_EQ(digitalRead(TEST_CS), HIGH);
+
+        // nothing written to the bus (or the buffer it was reading) under a strip in flight
+        CHECK_EQ(SPI1.overruns, 0);
+        CHECK(GlassMatches(0xF800, 0x001F));
+
+        // every strip but each window's first was composed before the one ahead of it was waited on
+        int strips = 0, ahead = 0;
+        for(const Transfer_t &transfer : SPI1.captured) {
+            strips += transfer.async;
+            ahead += transfer.ahead;
+        }
+        // the line buffers are only both known to the bus after the first frame
+        if(frame) CHECK_EQ(ahead, strips - (int)panel.windows);
+        CHECK(strips > 2 * (int)panel.windows);
+    }
+    SPI1.asyncPolls = 0;
+}
@@ -0,0 +1,110 @@
+/*!
+ * @file TraceTest.cpp
+ * @brief Input replay: held back from the host & saved state, and the same every time for the same trace.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string>
+
+#include "DeckSketch.h"
+#include "DeckCheck.h"
+
+static std::string printed;
+
+static bool ReplayDumped()
+{
+    printed += Serial.Take();
+    return printed.find("replay") != std::string::npos && printed.find("final frame") != std::string::npos;
+}
+
+// runs a console command and gives back what it printed, up to the replay's results if it started one
+static std::string Replay(const char *commands)
+{
+    printed.clear();
+    Serial.Take();
+    Serial.Type(commands);
+    CHECK(DeckHost::RunUntil(ReplayDumped, 60000000));
+    return printed;
+}
+
+static std::string Field(const std::string &out, const char *name)
+{
+    const size_t at = out.find(name);
+    if(at == std::string::npos) return "";
+    return out.substr(at + strlen(name), out.find_first_of(",\r\n", at) - at - strlen(name));
+}
+
+static uint8_t glassBefore[SCREEN_WIDTH * SCREEN_HEIGHT / 8], glass[sizeof(glassBefore)];
+
+DECK_TEST(ReplayChangesNothingOutside)
+{
+    DeckHost::Boot();
+    CHECK(DeckHost::RunUntil([]() { return DeckBoot::Reached(DeckBoot::Boot_UsbMounted); }, 1000000));
+    DeckHost::Run(500000);
+
+    const size_t reports = DeckSketch::Reports().size();
+    const int page = DeckCommon::Prefs->curPage;
+    const uint64_t toggles = DeckCommon::Prefs->keyToggles;
+    const uint32_t saves = DeckCommon::Prefs->saves;
+    DeckSketch::Glass(glassBefore);
+
+    // every button mashed, page keys & the profile chord included
+    const std::string out = Replay("trace gen 20 3000 7\ntrace play\n");
+    CHECK(out.find("First replay") != std::string::npos);
+    CHECK(atoi(Field(out, "HID reports: ").c_str()) > 50);
+
+    // none of it went to the host, moved the page, or got saved
+    CHECK_EQ(DeckSketch::Reports().size(), reports);
+    CHECK_EQ(DeckCommon::Prefs->curPage, page);
+    CHECK_EQ(DeckCommon::Prefs->keyToggles, toggles);
+    DeckHost::Run(2000000);
+    CHECK_EQ(DeckCommon::Prefs->saves, saves);
+    CHECK_EQ(DeckSketch::Reports().size(), reports);
+
+    // and the screen's back to the saved page's keys
+    DeckSketch::Glass(glass);
+    CHECK(!memcmp(glass + SCREEN_WIDTH * 2, glassBefore + SCREEN_WIDTH * 2, sizeof(glass) - SCREEN_WIDTH * 2));
+
+    // real presses still go out as normal afterwards
+    DeckSketch::Press(0);
+    DeckHost::Run(50000);
+    DeckSketch::Release(0);
+    DeckHost::Run(50000);
+    CHECK_EQ(DeckSketch::Reports().size(), reports + 2);
+}
+
+DECK_TEST(SameTraceSameResults)
+{
+    const std::string first = Replay("trace play\n");
+    const std::string second = Replay("trace play\n");
+    CHECK(first.find("Same reports & frame as the last replay") != std::string::npos);
+    CHECK(second.find("Same reports & frame as the last replay") != std::string::npos);
+    CHECK(Field(first, "HID reports: ") == Field(second, "HID reports: "));
+    CHECK(Field(first, "final frame: ") != "");
+
+    // the same seed makes the same trace again
+    const std::string regenerated = Replay("trace gen 20 3000 7\ntrace play\n");
+    CHECK(regenerated.find("Same reports & frame as the last replay") != std::string::npos);
+
+    const std::string other = Replay("trace gen 20 3000 8\ntrace play\n");
+    CHECK(other.find("Differs from the last replay: reports") != std::string::npos);
+}
+
+DECK_TEST(StoppedReplayLeavesNothingHeld)
+{
+    const size_t reports = DeckSketch::Reports().size();
+
+    // stopped partway, with some keys down in the report
+    Serial.Take();
+    Serial.Type("trace gen 2 600000 3\ntrace play\n");
+    DeckHost::Run(200000);
+    CHECK(inputTrace.mode == DeckTrace::Trace_Replay);
+    const std::string out = Replay("trace stop\n");
+    CHECK(out.find("Stopped") != std::string::npos);
+
+    DeckHost::Run(500000);
+    CHECK_EQ(DeckSketch::Reports().size(), reports);
+    CHECK(inputTrace.mode == DeckTrace::Trace_Off);
+}
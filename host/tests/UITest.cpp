@@ -0,0 +1,154 @@
+/*!
+ * @file UITest.cpp
+ * @brief Retained UI model: only what changed since it was drawn comes up dirty, and invalidating redraws the lot.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <string.h>
+
+#include "DeckCheck.h"
+#include "PicoDeckUI.h"
+
+// everything in the model marked as drawn, as DeckDisplay does after a full frame
+static void AllDrawn(DeckUI &ui)
+{
+    for(int i = 0; i < UI_KEY_CELLS; ++i) ui.KeyDrawn(i);
+    ui.BannerDrawn();
+    ui.drawn.separators = ui.model.separators;
+    ui.drawn.status = ui.model.status;
+}
+
+static int DirtyKeys(const DeckUI &ui)
+{
+    int dirty = 0;
+    for(int i = 0; i < UI_KEY_CELLS; ++i) dirty += ui.KeyDirty(i);
+    return dirty;
+}
+
+DECK_TEST(StartsAllDirty)
+{
+    DeckUI ui;
+    CHECK(ui.Dirty());
+    CHECK(ui.BannerDirty());
+    CHECK_EQ(DirtyKeys(ui), UI_KEY_CELLS);
+
+    AllDrawn(ui);
+    CHECK(!ui.Dirty());
+}
+
+DECK_TEST(OnlyChangedKeysDirty)
+{
+    DeckUI ui;
+    for(int i = 0; i < UI_KEY_CELLS; ++i) ui.model.keys[i].binding = 0xF0 + i;
+    AllDrawn(ui);
+
+    // a new binding needs rerendering; a press only needs the cell inverted & blitted again
+    ui.model.keys[3].binding = 0x0168;
+    ui.model.keys[7].pressed = true;
+    CHECK_EQ(DirtyKeys(ui), 2);
+    CHECK(ui.KeyContentDirty(3));
+    CHECK(!ui.KeyContentDirty(7));
+    CHECK(ui.KeyDirty(7));
+    CHECK(!ui.BannerDirty());
+
+    ui.KeyDrawn(3);
+    ui.KeyDrawn(7);
+    CHECK(!ui.Dirty());
+
+    // setting it back to what's drawn is no change at all
+    ui.model.keys[5].binding = 0;
+    ui.model.keys[5].binding = 0xF5;
+    CHECK(!ui.Dirty());
+}
+
+DECK_TEST(DualFrameIconsFlipOnRelease)
+{
+    DeckUI ui;
+    const DeckPrefs::KeyBM_t *dual = KEY_ICON("mic_toggle");
+    const DeckPrefs::KeyBM_t *single = KEY_ICON("dead");
+    ui.model.keys[0].icon = dual;
+    ui.model.keys[1].icon = single;
+    AllDrawn(ui);
+
+    // pressed, a dual-frame icon's toggle flips but the old frame stays up (inverted) until it's let go
+    ui.model.keys[0].pressed = true;
+    ui.model.keys[0].toggled = true;
+    CHECK_EQ(DeckUI::KeyFrame(ui.model.keys[0]), 0);
+    CHECK(!ui.KeyContentDirty(0));
+    ui.KeyDrawn(0);
+    ui.model.keys[0].pressed = false;
+    CHECK_EQ(DeckUI::KeyFrame(ui.model.keys[0]), 1);
+    CHECK(ui.KeyContentDirty(0));
+    ui.KeyDrawn(0);
+
+    // a single-frame one only ever has the one frame
+    ui.model.keys[1].toggled = true;
+    CHECK_EQ(DeckUI::KeyFrame(ui.model.keys[1]), 0);
+    CHECK(!ui.KeyContentDirty(1));
+    CHECK(!ui.Dirty());
+}
+
+DECK_TEST(CachedContentStillBlitted)
+{
+    DeckUI ui;
+    AllDrawn(ui);
+
+    // contents already sitting in the key cache aren't rendered again, but do still have to reach the buffer
+    ui.model.keys[2].binding = 0x68;
+    ui.KeyContentCached(2);
+    CHECK(!ui.KeyContentDirty(2));
+    CHECK(ui.KeyDirty(2));
+    ui.KeyDrawn(2);
+    CHECK(!ui.KeyDirty(2));
+}
+
+DECK_TEST(BannerComparedByText)
+{
+    DeckUI ui;
+    ui.SetBanner("Page 1", 1, nullptr, 0);
+    AllDrawn(ui);
+
+    // the same text from a different buffer isn't a change
+    char same[] = "Page 1";
+    ui.SetBanner(same, 1, nullptr, 0);
+    CHECK(!ui.BannerDirty());
+
+    ui.SetBanner("Page 1", 2, nullptr, 0);
+    CHECK(ui.BannerDirty());
+    ui.SetBanner("Page 1", 1, "sub", 0);
+    CHECK(ui.BannerDirty());
+    ui.BannerDrawn();
+    ui.SetBanner("Page 1", 1, "sub", 1);
+    CHECK(ui.BannerDirty());
+    ui.SetBanner("Page 1", 1, "sub", 0);
+    CHECK(!ui.BannerDirty());
+
+    // too long for the model is cut off rather than overrun
+    const char *longText = "a banner far longer than the model has any room for at all";
+    ui.SetBanner(longText, 1, nullptr, 0);
+    CHECK_EQ(strlen(ui.model.banner.mainText), UI_BANNER_TEXT_LEN - 1);
+    CHECK(!strncmp(ui.model.banner.mainText, longText, UI_BANNER_TEXT_LEN - 1));
+}
+
+DECK_TEST(InvalidateRedrawsEverything)
+{
+    DeckUI ui;
+    ui.model.separators = DeckUI::Sep_HeaderLine | DeckUI::Sep_KeysRightCol;
+    ui.model.status = DeckUI::Glyph_Saving;
+    AllDrawn(ui);
+    CHECK(!ui.Dirty());
+
+    // after the buffer's cleared, nothing that was drawn is there any more
+    ui.Invalidate();
+    CHECK(ui.BannerDirty());
+    CHECK_EQ(DirtyKeys(ui), UI_KEY_CELLS);
+    CHECK(ui.drawn.separators == 0 && ui.drawn.status == DeckUI::Glyph_None);
+
+    AllDrawn(ui);
+    CHECK(!ui.Dirty());
+    ui.model.status = DeckUI::Glyph_SaveSuccess;
+    CHECK(ui.Dirty());
+    CHECK_EQ(DirtyKeys(ui), 0);
+}
@@ -0,0 +1,228 @@
+/*!
+ * @file decklog.cpp
+ * @brief Reads a PicoDeck's binary event log (its CDC port, or a capture of one) and prints both cores' events as one
+ * timeline, each with how long it came after the last event anywhere and the last one on its own core.
+ *
+ * Usage: decklog /dev/ttyACMn [-s seconds]
+ *        decklog capture.bin
+ *   -s  how long to listen to a port for before printing, 5 by default (or until ^C)
+ *
+ * A port is switched to the log with the console's "log" command and closed again afterwards, which stops it.
+ * A capture is read from the first sync record on, so it can start with the console's text.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <algorithm>
+#include <vector>
+
+#include "PicoDeckLog.h"
+
+typedef DeckLog::Record_t Record_t;
+
+/// @brief A record placed on the timeline: us since its stream's sync, unwrapped
+typedef struct {
+    uint64_t at;
+    Record_t record;
+    uint16_t lostBefore;
+} Event_t;
+
+/// @brief One stream, from its sync record up to the next (the log being restarted) or the end
+typedef struct {
+    Record_t sync;
+    std::vector<Event_t> events;
+    // where each core's clock has got to, since each core's records only come in order amongst themselves
+    uint64_t coreAt[2];
+    uint16_t lost[2];
+    uint32_t droppedTotal[2];
+} Stream_t;
+
+static volatile bool stopping = false;
+
+static void Stop(int) { stopping = true; }
+
+static bool IsSync(const Record_t &record)
+{
+    return record.event == DeckLog::Log_Sync && record.core < 2 && record.payload == LOG_SYNC_WORD;
+}
+
+/// @brief Puts a record on its stream's timeline
+/// @details Times are 32-bit us, so each core's are unwrapped against its own last one. Log_Dropped is timed when
+/// drained rather than when anything was lost, so it's kept back and noted on that core's next event instead.
+static void StreamAdd(Stream_t &stream, const Record_t &record)
+{
+    const int core = record.core & 1;
+    if(record.event == DeckLog::Log_Dropped) {
+        stream.lost[core] += record.payload;
+        stream.droppedTotal[core] += record.payload;
+        return;
+    }
+
+    stream.coreAt[core] += (uint32_t)(record.time - (uint32_t)(stream.sync.time + stream.coreAt[core]));
+    stream.events.push_back({ stream.coreAt[core], record, stream.lost[core] });
+    stream.lost[core] = 0;
+}
+
+static void PayloadPrint(const Record_t &record)
+{
+    switch(record.event) {
+    case DeckLog::Log_Press:
+    case DeckLog::Log_Release:   printf("buttons 0x%04x", record.payload); break;
+    case DeckLog::Log_FifoFull:
+    case DeckLog::Log_FifoCmd:   printf("cmd 0x%02x", record.payload); break;
+    case DeckLog::Log_Page:      printf("page %u", record.payload); break;
+    case DeckLog::Log_SaveEnd:   printf("result %u", record.payload); break;
+    case DeckLog::Log_FrameEnd:  printf("work %u us%s", record.payload, record.payload == 0xFFFF ? "+" : ""); break;
+    case DeckLog::Log_Push:      printf("pages %u-%u", record.payload >> 8, record.payload & 0xFF); break;
+    case DeckLog::Log_Profile:   printf("slot %u", record.payload); break;
+    case DeckLog::Log_Usb: {
+        static const char *states[] = { "unmounted", "mounted", "suspended" };
+        printf("%s", record.payload < 3 ? states[record.payload] : "?");
+        break;
+    }
+    case DeckLog::Log_Tier: {
+        static const char *tiers[] = { "active", "idle", "dimmed", "off" };
+        printf("%s", record.payload < 4 ? tiers[record.payload] : "?");
+        break;
+    }
+    default: if(record.payload) printf("0x%04x", record.payload); break;
+    }
+}
+
+static void StreamPrint(Stream_t &stream)
+{
+    // cores were drained in turns, so it's only in order once sorted
+    std::stable_sort(stream.events.begin(), stream.events.end(),
+                     [](const Event_t &a, const Event_t &b) { return a.at < b.at; });
+
+    printf("-- sync, deck at %u us\n", stream.sync.time);
+    printf("%12s %10s %4s %10s  %s\n", "us", "+us", "core", "+us core", "event");
+
+    uint64_t last = 0, coreLast[2] = { 0, 0 };
+    bool coreSeen[2] = { false, false };
+    for(const Event_t &event : stream.events) {
+        const int core = event.record.core & 1;
+        printf("%12llu %10llu %4d ", (unsigned long long)event.at, (unsigned long long)(event.at - last), core);
+        if(coreSeen[core]) printf("%10llu  ", (unsigned long long)(event.at - coreLast[core]));
+        else printf("%10s  ", "-");
+        printf("%-12s ", event.record.event < DeckLog::LOG_EVENTS ? DeckLog::EventNames[event.record.event] : "?");
+        PayloadPrint(event.record);
+        if(event.lostBefore) printf("  (%u lost before this)", event.lostBefore);
+        putchar('\n');
+
+        last = event.at;
+        coreLast[core] = event.at;
+        coreSeen[core] = true;
+    }
+
+    printf("-- %zu events", stream.events.size());
+    for(int core = 0; core < 2; ++core)
+        if(stream.droppedTotal[core]) printf(", %u dropped on core %d", stream.droppedTotal[core], core);
+    printf("\n\n");
+}
+
+/// @brief Switches a port to raw 8-bit and asks the console for the log
+static bool PortOpen(const int &fd)
+{
+    termios tio;
+    if(tcgetattr(fd, &tio) < 0) return false;
+    cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 1;
+    if(tcsetattr(fd, TCSANOW, &tio) < 0) return false;
+    tcflush(fd, TCIFLUSH);
+
+    // a fresh line first, in case something was half typed
+    static const char command[] = "\nlog\n";
+    return write(fd, command, sizeof(command) - 1) == sizeof(command) - 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = nullptr;
+    double seconds = 5;
+    for(int i = 1; i < argc; ++i) {
+        if(!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atof(argv[++i]);
+        else path = argv[i];
+    }
+    if(path == nullptr) {
+        fprintf(stderr, "usage: %s /dev/ttyACMn [-s seconds] | capture.bin\n", argv[0]);
+        return 2;
+    }
+
+    const int fd = open(path, O_RDWR | O_NOCTTY);
+    if(fd < 0) {
+        perror(path);
+        return 1;
+    }
+    const bool port = isatty(fd);
+    if(port && !PortOpen(fd)) {
+        perror(path);
+        return 1;
+    }
+    signal(SIGINT, Stop);
+
+    timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    std::vector<Stream_t> streams;
+    std::vector<uint8_t> pending;
+    uint8_t buf[4096];
+    while(!stopping) {
+        if(port) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if(now.tv_sec - start.tv_sec + (now.tv_nsec - start.tv_nsec) / 1e9 >= seconds) break;
+        }
+
+        const ssize_t n = read(fd, buf, sizeof(buf));
+        if(n < 0) {
+            perror(path);
+            break;
+        }
+        if(!n) {
+            if(port) continue;
+            break;
+        }
+        pending.insert(pending.end(), buf, buf + n);
+
+        size_t at = 0;
+        // until the first sync there's no telling where records start, so it's looked for a byte at a time
+        while(streams.empty() && at + sizeof(Record_t) <= pending.size()) {
+            Record_t record;
+            memcpy(&record, &pending[at], sizeof(record));
+            if(IsSync(record)) break;
+            ++at;
+        }
+        if(streams.empty() && at + sizeof(Record_t) > pending.size()) {
+            pending.erase(pending.begin(), pending.begin() + at);
+            continue;
+        }
+
+        for(; at + sizeof(Record_t) <= pending.size(); at += sizeof(Record_t)) {
+            Record_t record;
+            memcpy(&record, &pending[at], sizeof(record));
+            if(IsSync(record)) streams.push_back({ record, {}, { 0, 0 }, { 0, 0 }, { 0, 0 } });
+            else StreamAdd(streams.back(), record);
+        }
+        pending.erase(pending.begin(), pending.begin() + at);
+    }
+    // closing the port is what stops the deck logging
+    close(fd);
+
+    if(streams.empty()) {
+        fprintf(stderr, "%s: no sync record, is the deck's console switched to the log?\n", path);
+        return 1;
+    }
+    for(Stream_t &stream : streams) StreamPrint(stream);
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*!
+ * @file deckprofile.cpp
+ * @brief Compiles a text deck profile into the binary blob 'profile load' takes, checked against this firmware's buttons & icons.
+ *
+ * Usage: deckprofile <profile.txt> <profile.bin>
+ *
+ * Text format, one thing per line, lines starting with '#' are comments:
+ *   page <#RRGGBB> <name>                  starts a page, with its LED colour and title (up to 23 characters)
+ *   <button> <key> [icon <name>] [toggle]  binds a button (1-based, in ButtonDesc order) on the last page
+ * Buttons left out of a page are unbound. A key is a character ('a', '5', '/'), a name (f1-f24, up, down, left,
+ * right, enter, esc, tab, space, backspace, insert, delete, home, end, pageup, pagedown, capslock), a number
+ * (0xF0), or prev/next for the page keys; modifiers go in front with '+' (lctrl, lshift, lalt, lgui and their
+ * r... versions), e.g. ralt+f13. icon is a built-in icon's name; toggle flips it between its halves on each press.
+ *
+ * Then send it to the deck with 'profile load <bytes> [slot]' followed by the file's bytes.
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+
+#include "PicoDeckCommon.h"
+
+typedef struct {
+    const char *name;
+    uint8_t code;
+} KeyName_t;
+
+static const KeyName_t KeyNames[] = {
+    {"up", KEY_UP_ARROW}, {"down", KEY_DOWN_ARROW}, {"left", KEY_LEFT_ARROW}, {"right", KEY_RIGHT_ARROW},
+    {"enter", KEY_RETURN}, {"esc", KEY_ESC}, {"tab", KEY_TAB}, {"space", ' '}, {"backspace", KEY_BACKSPACE},
+    {"insert", KEY_INSERT}, {"delete", KEY_DELETE}, {"home", KEY_HOME}, {"end", KEY_END},
+    {"pageup", KEY_PAGE_UP}, {"pagedown", KEY_PAGE_DOWN}, {"capslock", KEY_CAPS_LOCK},
+    {"prev", LightgunButtons::LGB_PREV}, {"next", LightgunButtons::LGB_NEXT},
+};
+
+static const KeyName_t ModNames[] = {
+    {"lctrl", 1 << 0}, {"lshift", 1 << 1}, {"lalt", 1 << 2}, {"lgui", 1 << 3},
+    {"rctrl", 1 << 4}, {"rshift", 1 << 5}, {"ralt", 1 << 6}, {"rgui", 1 << 7},
+};
+
+static const char *path;
+static int lineNum;
+
+static bool Fail(const std::string &what, const std::string &token)
+{
+    fprintf(stderr, "%s:%d: %s '%s'\n", path, lineNum, what.c_str(), token.c_str());
+    return false;
+}
+
+/// @brief Report code of a key's text, modifiers in the high byte like ButtonDesc[].keys
+/// @return false (having said why) if it's not a key
+static bool KeyParse(std::string text, uint16_t &code)
+{
+    code = 0;
+    for(size_t plus; (plus = text.find('+')) != std::string::npos && plus + 1 < text.size(); text.erase(0, plus + 1)) {
+        const std::string mod = text.substr(0, plus);
+        const KeyName_t *found = nullptr;
+        for(const KeyName_t &name : ModNames)
+            if(!strcasecmp(mod.c_str(), name.name)) found = &name;
+        if(found == nullptr) return Fail("no modifier", mod);
+        code |= found->code << 8;
+    }
+
+    if(text.size() == 1 && isprint((unsigned char)text[0])) {
+        code |= (uint8_t)tolower(text[0]);
+        return true;
+    }
+    for(const KeyName_t &name : KeyNames) {
+        if(!strcasecmp(text.c_str(), name.name)) {
+            if(name.code < LightgunButtons::LGB_PAGEKEYS && code) return Fail("page keys take no modifiers", text);
+            code |= name.code;
+            return true;
+        }
+    }
+    int f;
+    char end;
+    if(sscanf(text.c_str(), "%*[fF]%d%c", &f, &end) == 1 && f >= 1 && f <= 24) {
+        code |= f <= 12 ? KEY_F1 + f-1 : KEY_F13 + f-13;
+        return true;
+    }
+    char *numEnd;
+    const unsigned long raw = strtoul(text.c_str(), &numEnd, 0);
+    if(!*numEnd && numEnd != text.c_str() && raw && raw <= 0xFF) {
+        code |= raw;
+        return true;
+    }
+    return Fail("no key", text);
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s <profile.txt> <profile.bin>\n", argv[0]);
+        return 2;
+    }
+    path = argv[1];
+    FILE *in = fopen(path, "r");
+    if(in == nullptr) {
+        perror(path);
+        return 1;
+    }
+
+    std::vector<DeckProfile::Page_t> pages;
+    std::vector<DeckProfile::Binding_t> bindings;
+    std::vector<DeckProfile::Icon_t> icons;
+    bool ok = true;
+
+    char text[256];
+    for(lineNum = 1; fgets(text, sizeof(text), in) != nullptr; ++lineNum) {
+        std::string line = text;
+        line.erase(line.find_last_not_of("\r\n") + 1);
+
+        std::vector<std::string> tokens;
+        for(char *tok = strtok(line.data(), " \t"); tok != nullptr; tok = strtok(nullptr, " \t"))
+            tokens.push_back(tok);
+        if(tokens.empty() || tokens[0][0] == '#') continue;
+
+        if(tokens[0] == "page") {
+            // the name's the rest of the line, spaces and all
+            DeckProfile::Page_t page = {};
+            unsigned int rgb;
+            char end;
+            if(tokens.size() < 3 || sscanf(tokens[1].c_str(), "#%6x%c", &rgb, &end) != 1) {
+                ok = Fail("page <#RRGGBB> <name>, not", text);
+                continue;
+            }
+            std::string name = tokens[2];
+            for(size_t i = 3; i < tokens.size(); ++i) name += " " + tokens[i];
+            if(name.size() >= sizeof(page.name)) ok = Fail("page name's too long", name);
+            strncpy(page.name, name.c_str(), sizeof(page.name)-1);
+            page.color = (rgb >> 16 & 0xFF) | (rgb & 0xFF00) | (rgb & 0xFF) << 16;
+            pages.push_back(page);
+            bindings.resize(pages.size() * ButtonCount, DeckProfile::Binding_t{ 0, PROFILE_NO_ICON, 0 });
+            continue;
+        }
+
+        char *numEnd;
+        const long button = strtol(tokens[0].c_str(), &numEnd, 10);
+        if(*numEnd || button < 1 || button > (long)ButtonCount) {
+            ok = Fail("not a page or a button (1-" + std::to_string(ButtonCount) + ")", tokens[0]);
+            continue;
+        }
+        if(pages.empty()) {
+            ok = Fail("button bound before any page", tokens[0]);
+            continue;
+        }
+        if(tokens.size() < 2) {
+            ok = Fail("no key for button", tokens[0]);
+            continue;
+        }
+
+        DeckProfile::Binding_t &binding = bindings[(pages.size()-1) * ButtonCount + button-1];
+        if(!KeyParse(tokens[1], binding.code)) {
+            ok = false;
+            continue;
+        }
+        for(size_t i = 2; i < tokens.size(); ++i) {
+            if(tokens[i] == "toggle") {
+                binding.flags |= DeckProfile::Bind_Toggle;
+            } else if(tokens[i] == "icon" && i+1 < tokens.size()) {
+                const std::string &name = tokens[++i];
+                if(DeckPrefs::IconFind(name) < 0) {
+                    ok = Fail("no built-in icon", name);
+                    continue;
+                }
+                if((binding.code & 0xFF) < LightgunButtons::LGB_PAGEKEYS) {
+                    ok = Fail("page keys have no icon", name);
+                    continue;
+                }
+                size_t icon = 0;
+                while(icon < icons.size() && name != icons[icon].name) ++icon;
+                if(icon == icons.size()) {
+                    DeckProfile::Icon_t entry = {};
+                    strncpy(entry.name, name.c_str(), sizeof(entry.name)-1);
+                    icons.push_back(entry);
+                }
+                binding.icon = icon;
+            } else ok = Fail("expected icon <name> or toggle, not", tokens[i]);
+        }
+        // only two-state icons can flip
+        if(binding.flags & DeckProfile::Bind_Toggle &&
+           (binding.icon == PROFILE_NO_ICON || !DeckPrefs::Icons[DeckPrefs::IconFind(icons[binding.icon].name)].bm.isPacked))
+            ok = Fail("toggle needs a two-state icon, for button", tokens[0]);
+    }
+    fclose(in);
+
+    if(pages.empty()) ok = Fail("no pages in", path);
+    if(icons.size() >= PROFILE_NO_ICON) ok = Fail("too many different icons in", path);
+    if(!ok) return 1;
+
+    DeckProfile::Header_t header = { PROFILE_MAGIC, PROFILE_VERSION, sizeof(DeckProfile::Header_t), 0, 0,
+                                     (uint16_t)pages.size(), (uint8_t)ButtonCount, 0, (uint16_t)icons.size(), 0, 0, 0, 0 };
+    header.pagesOffset = sizeof(header);
+    header.bindingsOffset = header.pagesOffset + pages.size() * sizeof(DeckProfile::Page_t);
+    header.iconsOffset = header.bindingsOffset + bindings.size() * sizeof(DeckProfile::Binding_t);
+    header.size = header.iconsOffset + icons.size() * sizeof(DeckProfile::Icon_t);
+
+    std::vector<uint8_t> blob(header.size);
+    memcpy(blob.data() + header.pagesOffset, pages.data(), pages.size() * sizeof(DeckProfile::Page_t));
+    memcpy(blob.data() + header.bindingsOffset, bindings.data(), bindings.size() * sizeof(DeckProfile::Binding_t));
+    memcpy(blob.data() + header.iconsOffset, icons.data(), icons.size() * sizeof(DeckProfile::Icon_t));
+    header.checksum = DeckProfile::Checksum(blob.data() + sizeof(header), header.size - sizeof(header));
+    memcpy(blob.data(), &header, sizeof(header));
+
+    // the firmware's own check, so anything written here gets loaded there
+    if(header.size > PROFILE_STORE_SIZE || DeckProfile::Validate(blob.data(), blob.size(), ButtonCount) == nullptr) {
+        fprintf(stderr, "%s: doesn't make a valid profile (%u bytes, store takes %u)\n", path, header.size, PROFILE_STORE_SIZE);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "wb");
+    if(out == nullptr || fwrite(blob.data(), 1, blob.size(), out) != blob.size() || fclose(out)) {
+        perror(argv[2]);
+        return 1;
+    }
+    printf("%s: %u pages, %u icons, %u bytes\n", argv[2], (unsigned)pages.size(), (unsigned)icons.size(), header.size);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*!
+ * @file deckstats.cpp
+ * @brief Reads a PicoDeck's latency stats from its vendor HID feature report (Linux hidraw) and prints them decoded.
+ *
+ * Usage: deckstats /dev/hidrawN [-h] [--reset]
+ *   -h       also draw each stage's histogram
+ *   --reset  clear everything on the deck after reading it
+ *
+ * @copyright That One Seong, 2025
+ * @copyright GNU General Public License
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/hidraw.h>
+
+#include "PicoDeckStats.h"
+
+// as in TinyUSB_Devices: the feature report's ID, and its size not counting that
+#define STATS_REPORT_ID 2
+#define STATS_REPORT_SIZE 63
+
+static_assert(sizeof(DeckStats::Summary_t) <= STATS_REPORT_SIZE && sizeof(DeckStats::Page_t) <= STATS_REPORT_SIZE,
+              "stats pages don't fit the feature report");
+
+/// @brief Asks for a page, then reads it back
+/// @return Whether both went through
+static bool PageRead(const int &fd, const uint8_t &page, uint8_t *out)
+{
+    uint8_t report[1 + STATS_REPORT_SIZE] = { STATS_REPORT_ID, page };
+    if(ioctl(fd, HIDIOCSFEATURE(sizeof(report)), report) < 0) return false;
+
+    memset(report, 0, sizeof(report));
+    report[0] = STATS_REPORT_ID;
+    if(ioctl(fd, HIDIOCGFEATURE(sizeof(report)), report) < 0) return false;
+    memcpy(out, report + 1, STATS_REPORT_SIZE);
+    return true;
+}
+
+/// @brief Upper bound of a log2 bucket, in us
+static uint32_t BucketTop(const int &bucket)
+{
+    return bucket ? (1u << bucket) - 1 : 0;
+}
+
+/// @brief Smallest bucket top that at least a fraction of the samples fall under
+static uint32_t Percentile(const DeckStats::Page_t &page, const double &fraction)
+{
+    uint32_t total = 0;
+    for(const uint16_t &n : page.buckets) total += n;
+    if(!total) return 0;
+
+    uint32_t seen = 0;
+    for(int b = 0; b < STATS_BUCKETS; ++b) {
+        seen += page.buckets[b];
+        if(seen >= fraction * total)
+            return b == STATS_BUCKETS-1 ? page.max : BucketTop(b);
+    }
+    return page.max;
+}
+
+static void HistogramPrint(const DeckStats::Page_t &page)
+{
+    uint16_t most = 0;
+    for(const uint16_t &n : page.buckets) most = n > most ? n : most;
+    if(!most) return;
+
+    for(int b = 0; b < STATS_BUCKETS; ++b) {
+        if(!page.buckets[b]) continue;
+        char range[24];
+        if(!b) snprintf(range, sizeof(range), "0");
+        else if(b == STATS_BUCKETS-1) snprintf(range, sizeof(range), ">=%u", 1u << (b-1));
+        else snprintf(range, sizeof(range), "%u-%u", 1u << (b-1), BucketTop(b));
+        printf("      %12s us %6u ", range, page.buckets[b]);
+        for(int i = 0; i < page.buckets[b] * 40 / most; ++i) putchar('#');
+        putchar('\n');
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = nullptr;
+    bool histograms = false, reset = false;
+    for(int i = 1; i < argc; ++i) {
+        if(!strcmp(argv[i], "-h")) histograms = true;
+        else if(!strcmp(argv[i], "--reset")) reset = true;
+        else path = argv[i];
+    }
+    if(path == nullptr) {
+        fprintf(stderr, "usage: %s /dev/hidrawN [-h] [--reset]\n", argv[0]);
+        return 2;
+    }
+
+    const int fd = open(path, O_RDWR);
+    if(fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    uint8_t raw[STATS_REPORT_SIZE];
+    if(!PageRead(fd, 0, raw)) {
+        perror("feature report");
+        return 1;
+    }
+    DeckStats::Summary_t summary;
+    memcpy(&summary, raw, sizeof(summary));
+    if(summary.version != STATS_VERSION)
+        fprintf(stderr, "warning: deck reports stats version %u, this reads version %u\n", summary.version, STATS_VERSION);
+
+    printf("up %u.%03u s\n", summary.uptime / 1000, summary.uptime % 1000);
+    for(int i = 0; i < summary.counters && i < DeckStats::STATS_COUNTERS; ++i)
+        printf("  %-20s %10u\n", DeckStats::CounterNames[i], summary.count[i]);
+
+    printf("\n  %-16s %8s %10s %8s %8s %8s\n", "stage", "count", "mean us", "p50 <=", "p99 <=", "max us");
+    for(int stage = 0; stage < summary.stages && stage < DeckStats::STATS_STAGES; ++stage) {
+        if(!PageRead(fd, stage + 1, raw)) {
+            perror("feature report");
+            return 1;
+        }
+        DeckStats::Page_t page;
+        memcpy(&page, raw, sizeof(page));
+
+        printf("  %-16s %8u %10.1f %8u %8u %8u\n", DeckStats::StageNames[stage], page.count,
+               page.count ? (double)page.sum / page.count : 0.0, Percentile(page, 0.5), Percentile(page, 0.99), page.max);
+        if(histograms) HistogramPrint(page);
+    }
+
+    if(reset && !PageRead(fd, STATS_PAGE_RESET, raw)) {
+        perror("reset");
+        return 1;
+    }
+
+    close(fd);
+    return 0;
+}
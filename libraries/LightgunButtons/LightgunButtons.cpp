@@ -28,19 +28,24 @@ LightgunButtons::LightgunButtons(Data_t _data, unsigned int _count) :
     repeat(0),
     debounced(0),
     debouncing(0),
+    settling(0),
     pressedReleased(0),
     interval(33),
+    debounceTicks(DEBOUNCE_TICKS),
     report(0),
+    injectMask(0),
+    injectLevels(0xFFFFFFFF),
+    pagesCount(0),
+    pageWrap(0),
+    pageLock(false),
     lastMillis(0),
     lastRepeatMillis(0),
     pinState(0xFFFFFFFF),
     internalPressedReleased(0),
     reportedPressed(0),
-    count(_count),
-    pagesCount(0),
-    pageWrap(0),
     stateFifo(_data.pArrFifo),
-    debounceCount(_data.pArrDebounceCount)
+    debounceCount(_data.pArrDebounceCount),
+    count(_count)
 {
 }
 
@@ -61,6 +66,13 @@ int LightgunButtons::Begin()
     return pagesCount;
 }
 
+uint16_t LightgunButtons::KeyCode(const int &button, const int &page)
+{
+    if(Keymap != nullptr)
+        return Keymap(button, page);
+    return ButtonDesc[button].keys.size() > (uint)page ? ButtonDesc[button].keys.at(page) : 0;
+}
+
 void LightgunButtons::Unset()
 {
     // set button pins to normal input
@@ -75,6 +87,7 @@ void LightgunButtons::Unset()
     released = 0;
     debounced = 0;
     debouncing = 0;
+    settling = 0;
     pressedReleased = 0;
     lastMillis = 0;
     lastRepeatMillis = 0;
@@ -85,7 +98,7 @@ void LightgunButtons::Unset()
 
 uint32_t LightgunButtons::Poll(unsigned long minTicks)
 {
-    unsigned long m = millis();
+    unsigned long m = Micros != nullptr ? Micros() / 1000 : millis();
     unsigned long ticks = m - lastMillis;
     uint32_t bitMask;
     
@@ -124,7 +137,11 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
             // if not debouncing
             if(!debounceCount[i]) {
                 // read the pin, expected to return 0 or 1
-                uint32_t state = digitalRead(btn.pin);
+                uint32_t state = (injectMask & bitMask) ? (injectLevels & bitMask) != 0 : digitalRead(btn.pin);
+
+                // first sample to disagree with a settled state starts the clock on this edge
+                if(state != ((pinState & bitMask) != 0) && (stateFifo[i] & 1) == ((pinState & bitMask) != 0))
+                    edgeTime[i] = Micros != nullptr ? Micros() : micros();
 
                 // add the state to the fifo
                 stateFifo[i] <<= 1;
@@ -139,8 +156,10 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
                     state = bitMask;
                 } else {
                     // button is bouncing, continue to next button
+                    settling |= bitMask;
                     continue;
                 }
+                settling &= ~bitMask;
 
                 // if existing pin state does not match new state
                 if((pinState & bitMask) != state) {
@@ -148,14 +167,14 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
                     pinState = (pinState & ~bitMask) | state;
 
                     // set the debounce counter and set the flag
-                    debounceCount[i] = DEBOUNCE_TICKS;
+                    debounceCount[i] = debounceTicks;
                     debouncing |= bitMask;
 
                     if(!state) {
                         // state is low, button is pressed
 
-                        if((btn.keys.at(0) & 0xFF) < LGB_PAGEKEYS) {
-                            switch(btn.keys.at(0) & 0xFF) {
+                        if(!pageLock && (KeyCode(i, 0) & 0xFF) < LGB_PAGEKEYS) {
+                            switch(KeyCode(i, 0) & 0xFF) {
                             case LGB_PREV:
                                 if(page) --page;
                                 else if(pageWrap) page = pagesCount-1;
@@ -172,13 +191,7 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
 
                         // if reporting is enabled for the button
                         if(report & bitMask) {
-                            if(btn.keys.size() > (uint)page) {
-                                if(btn.keys.at(page) & 0xFF00)
-                                    Keyboard.pressModifiers(btn.keys.at(page) >> 8);
-
-                                if((btn.keys.at(page) & 0xFF) > LGB_PAGEKEYS)
-                                    Keyboard.press(btn.keys.at(page) & 0xFF);
-                            }
+                            ReportPress(i);
                             reportedPressed |= bitMask;
                         }
 
@@ -195,14 +208,7 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
                         // in case the reporting is disabled while button(s) are pressed
                         if(reportedPressed & bitMask) {
                             reportedPressed &= ~bitMask;
-
-                            if(btn.keys.size() > (uint)page) {
-                                if(btn.keys.at(page) & 0xFF00)
-                                    Keyboard.releaseModifiers(btn.keys.at(page) >> 8);
-
-                                if((btn.keys.at(page) & 0xFF) > LGB_PAGEKEYS)
-                                    Keyboard.release(btn.keys.at(page));
-                            }
+                            ReportRelease(i);
                         }
 
                         // clear the debounced state and button is released
@@ -224,10 +230,31 @@ uint32_t LightgunButtons::Poll(unsigned long minTicks)
     return pressed;
 }
 
-void LightgunButtons::SendReports()
+bool LightgunButtons::SendReports()
 {
     if(TinyUSBDevices.newReport)
-        Keyboard.report();
+        return Keyboard.report();
+    return false;
+}
+
+void LightgunButtons::ReportPress(const int &button)
+{
+    const uint16_t code = KeyCode(button, page);
+    if(code & 0xFF00)
+        Keyboard.pressModifiers(code >> 8);
+
+    if((code & 0xFF) > LGB_PAGEKEYS)
+        Keyboard.press(code & 0xFF);
+}
+
+void LightgunButtons::ReportRelease(const int &button)
+{
+    const uint16_t code = KeyCode(button, page);
+    if(code & 0xFF00)
+        Keyboard.releaseModifiers(code >> 8);
+
+    if((code & 0xFF) > LGB_PAGEKEYS)
+        Keyboard.release(code & 0xFF);
 }
 
 void LightgunButtons::ReleaseAll()
@@ -25,9 +25,8 @@
 #include <vector>
 
 #define DEBOUNCE_TICKS 15
-#ifdef ARDUINO_ARCH_RP2040
+// stateFifo samples that must agree before a state change is taken
 #define BTN_AG_MASK 0xFFFFFFFF
-#endif
 
 /// @brief Relatively simple buttons with some decent per-button confirgurable debouncing.
 /// @details While intended for a Light gun, can be used for any HID using AbsMouse5 and/or Keyboard.
@@ -70,6 +69,17 @@ public:
         uint8_t* pArrDebounceCount;     ///< Pointer to button debounce counters.
     } Data_t;
     
+    /// @brief Optional report code lookup that takes over from ButtonDesc[].keys, e.g. for keymaps loaded at runtime.
+    /// @details Returns a button's report code on a page, 0 if unbound. pagesCount should be set to match.
+    static inline uint16_t (*Keymap)(const int &button, const int &page) = nullptr;
+
+    /// @brief Optional clock in us that takes over from micros()/millis() for debouncing, e.g. to replay input on time of its own.
+    static inline unsigned long (*Micros)() = nullptr;
+
+    /// @brief Report code of a button on a page, from Keymap if set.
+    /// @return The code, or 0 if the button has nothing on that page.
+    static uint16_t KeyCode(const int &button, const int &page);
+
     /// @brief Constructor.
     LightgunButtons(Data_t data, unsigned int count);
 
@@ -87,10 +97,16 @@ public:
     uint32_t Poll(unsigned long minTicks = 0);
 
     /// @brief Send reports queued up from Poll (and separate analog updates)
-    /// @param bool
-    ///        Whether to report on every channel sequentially
-    ///        Default behavior returns after the first flagged report channel
-    void SendReports();
+    /// @details Never waits on the bus: if the host can't take a report (suspended, unmounted, busy),
+    ///          it's left pending for the next call.
+    /// @return Whether a report went out
+    bool SendReports();
+
+    /// @brief Queues a button's key press on the current page into the HID report, the same as Poll() does
+    void ReportPress(const int &button);
+
+    /// @brief Queues a button's key release on the current page into the HID report, the same as Poll() does
+    void ReportRelease(const int &button);
 
     /// @brief Macro that signals all releaseAlls for each input device,
     ///        and then force-sends each report sequentially.
@@ -123,6 +139,10 @@ public:
     /// @brief Bit mask of buttons currently debouncing.
     /// @details Buttons can be debouncing after being pressed or released.
     uint32_t debouncing;
+
+    /// @brief Bit mask of buttons whose last samples don't all agree yet.
+    /// @details An edge on these is still being confirmed, so they need polling again straight away.
+    uint32_t settling;
     
     /// @brief Bit mask of debounced buttons pressed and released since last poll.
     /// @details Track all pressed buttons and set only when all buttons release.
@@ -132,6 +152,9 @@ public:
     /// @brief Interval for pulsing the repeat value while buttons are pressed for Repeat().
     unsigned int interval;
 
+    /// @brief Ticks (ms) a button ignores its pin for after changing state, DEBOUNCE_TICKS by default.
+    uint8_t debounceTicks;
+
     /// @brief Bit mask of buttons to enable reporting HID events to host.
     uint32_t report;
 
@@ -141,6 +164,17 @@ public:
     /// @brief Disable reporting for all buttons. Clear report to 0.
     void ReportDisable() { report = 0; }
 
+    /// @brief Bit mask of buttons whose pin is not read, taking their level from injectLevels instead.
+    /// @details For replaying recorded or generated input through everything downstream of the pins.
+    uint32_t injectMask;
+
+    /// @brief Pin levels used for buttons in injectMask, 1 if high (released).
+    uint32_t injectLevels;
+
+    /// @brief micros() of each button's first sample that disagreed with its debounced state.
+    /// @details Once a button is reported pressed/released, the time since this is how long debouncing took.
+    unsigned long edgeTime[32];
+
     /// @brief Flag that determines which page of the inputs map to use
     int page;
 
@@ -150,6 +184,9 @@ public:
     /// @brief Flag that determines if page navigation should wrap
     bool pageWrap;
 
+    /// @brief While set, page keys press & release like any other button but leave the page alone
+    bool pageLock;
+
     /// @brief Test if pressed button(s) in comibination with already held buttons match given values.
     /// @details Test the pressed buttons equals a given value along with a modifer bit mask
     /// match with the debounced value.
@@ -20,16 +20,54 @@
 Adafruit_USBD_HID usbHid;
 
 enum HID_RID_e{
-    HID_RID_KEYBOARD = 1
+    HID_RID_KEYBOARD = 1,
+    HID_RID_FEATURE
 };
 
+// vendor-defined collection holding a single opaque feature report, readable without disturbing the keyboard
+#define TUD_HID_REPORT_DESC_VENDOR_FEATURE(report_size, ...) \
+    HID_USAGE_PAGE_N ( HID_USAGE_PAGE_VENDOR, 2 ),\
+    HID_USAGE        ( 0x01 ),\
+    HID_COLLECTION   ( HID_COLLECTION_APPLICATION ),\
+      __VA_ARGS__ \
+      HID_USAGE         ( 0x02 ),\
+      HID_LOGICAL_MIN   ( 0x00 ),\
+      HID_LOGICAL_MAX_N ( 0xff, 2 ),\
+      HID_REPORT_SIZE   ( 8 ),\
+      HID_REPORT_COUNT  ( report_size ),\
+      HID_FEATURE       ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ),\
+    HID_COLLECTION_END
+
 uint8_t desc_hid_report[] = {
-    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(1))
+    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(HID_RID_KEYBOARD)),
+    TUD_HID_REPORT_DESC_VENDOR_FEATURE(HID_FEATURE_SIZE, HID_REPORT_ID(HID_RID_FEATURE))
 };
 
+static uint16_t hidGetReport(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen)
+{
+    if(report_id != HID_RID_FEATURE || report_type != HID_REPORT_TYPE_FEATURE || TinyUSBDevices_::featureGet == nullptr)
+        return 0;
+    return TinyUSBDevices_::featureGet(buffer, reqlen);
+}
+
+static void hidSetReport(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize)
+{
+    if(report_id != HID_RID_FEATURE || report_type != HID_REPORT_TYPE_FEATURE || TinyUSBDevices_::featureSet == nullptr)
+        return;
+
+    // the report ID comes in report_id, and TinyUSB takes it off the front of the data; versions that don't
+    // only show it by the data being a byte longer than the report, as its value is just as much a valid first byte
+    if(bufsize > HID_FEATURE_SIZE) {
+        ++buffer;
+        --bufsize;
+    }
+    TinyUSBDevices_::featureSet(buffer, bufsize);
+}
+
 void TinyUSBDevices_::begin(int polRate) {
     usbHid.setPollInterval(polRate);
     usbHid.setReportDescriptor(desc_hid_report, sizeof(desc_hid_report));
+    usbHid.setReportCallback(hidGetReport, hidSetReport);
     usbHid.begin();
 }
 
@@ -43,11 +81,13 @@ TinyUSBDevices_ TinyUSBDevices;
     memset(modsBuffer, 0, sizeof(modsBuffer));
   }
   
-  void Keyboard_::report()
+  bool Keyboard_::report()
   {
-    while(!usbHid.ready()) yield();
+    // suspended, unmounted or the last one's still going out; it stays pending rather than spinning on the bus
+    if(!usbHid.ready()) return false;
     usbHid.keyboardReport(HID_RID_KEYBOARD, _keyReport.modifiers, _keyReport.keys);
     TinyUSBDevices.newReport = false;
+    return true;
   }
   
   #define SHIFT 0x80
@@ -304,7 +344,8 @@ TinyUSBDevices_ TinyUSBDevices;
   
   void Keyboard_::releaseAll(void)
   {
-    if(memcmp(_keyReport.keys, (char[]){0,0,0,0,0,0}, sizeof(KeyReport::keys)) || _keyReport.modifiers) {
+    static const uint8_t noKeys[sizeof(KeyReport::keys)] = {0};
+    if(memcmp(_keyReport.keys, noKeys, sizeof(noKeys)) || _keyReport.modifiers) {
       _keyReport.keys[0] = 0;
       _keyReport.keys[1] = 0;
       _keyReport.keys[2] = 0;
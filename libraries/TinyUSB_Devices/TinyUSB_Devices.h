@@ -61,7 +61,17 @@ public:
 
   /// @brief Array of which of the three devices have new data that should be reported.
   bool newReport = false;
+
+  /// @brief Fills the vendor feature report when the host asks for it (GET_REPORT), returns its length.
+  /// @details Set before begin(). Runs from the USB stack, so it should only copy out, not compute.
+  static inline uint16_t (*featureGet)(uint8_t *buffer, uint16_t reqlen) = nullptr;
+
+  /// @brief Takes a vendor feature report the host sent (SET_REPORT).
+  static inline void (*featureSet)(const uint8_t *buffer, uint16_t len) = nullptr;
 };
+
+// size of the vendor feature report, not counting the report ID
+#define HID_FEATURE_SIZE 63
 extern TinyUSBDevices_ TinyUSBDevices;
 
 /******************************
@@ -143,7 +153,11 @@ extern TinyUSBDevices_ TinyUSBDevices;
     uint8_t modsBuffer[8];
   public:
     Keyboard_(void);
-    void report();
+    /// @brief Sends the key report, if the host can take one right now
+    /// @return Whether it went out (if not, newReport is left set)
+    bool report();
+    /// @brief The key report as it stands, sent or not
+    const KeyReport &keyReport() const { return _keyReport; }
     size_t write(uint8_t k);
     size_t write(const uint8_t *buffer, size_t size);
     bool press(uint8_t k);